@@ -83,6 +83,24 @@ QuicAckTrackerReset(
     QuicRangeReset(&Tracker->PacketNumbersReceived);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAckTrackerCompact(
+    _Inout_ QUIC_ACK_TRACKER* Tracker
+    )
+{
+    uint64_t Low, High;
+    if (QuicRangeGetMinSafe(&Tracker->PacketNumbersReceived, &Low) &&
+        QuicRangeGetMaxSafe(&Tracker->PacketNumbersReceived, &High)) {
+        BOOLEAN RangeUpdated;
+        QuicRangeReset(&Tracker->PacketNumbersReceived);
+        QuicRangeCompact(&Tracker->PacketNumbersReceived);
+        (void)QuicRangeAddRange( // Never needs to grow an empty range.
+            &Tracker->PacketNumbersReceived, Low, High - Low + 1, &RangeUpdated);
+    }
+    QuicRangeCompact(&Tracker->PacketNumbersToAck);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicAckTrackerAddPacketNumber(
@@ -85,6 +85,17 @@ QuicAckTrackerReset(
     _Inout_ QUIC_ACK_TRACKER* Tracker
     );
 
+//
+// Shrinks the ranges back to their preallocated size, for an idle connection.
+// Any gaps in the received packet numbers are treated as received from then
+// on, so duplicate detection stays conservative.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAckTrackerCompact(
+    _Inout_ QUIC_ACK_TRACKER* Tracker
+    );
+
 //
 // Returns TRUE if the packet is a duplicate.
 //
@@ -1018,6 +1018,136 @@ Error:
     return Status;
 }
 
+//
+// Queues an initialized send request on the stream, to be flushed inline or
+// by a STRM_SEND operation. Frees the request on failure.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicStreamQueueApiSendRequest(
+    _In_ QUIC_STREAM* Stream,
+    _In_ __drv_aliasesMem QUIC_SEND_REQUEST* SendRequest
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_CONNECTION* Connection = Stream->Connection;
+    BOOLEAN QueueOper = TRUE;
+    const BOOLEAN IsPriority = !!(SendRequest->Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
+    BOOLEAN SendInline;
+    QUIC_OPERATION* Oper;
+
+#pragma warning(push)
+#pragma warning(disable:6240) // CXPLAT_AT_DISPATCH only really does anything for kernel mode
+    SendInline =
+        !Connection->Settings.SendBufferingEnabled &&
+        !CXPLAT_AT_DISPATCH() && // Never run inline if at DISPATCH
+        Connection->WorkerThreadID == CxPlatCurThreadID();
+#pragma warning(pop)
+
+    CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
+    if (!Stream->Flags.SendEnabled) {
+        Status =
+            (Connection->State.ClosedRemotely || Stream->Flags.ReceivedStopSending) ?
+                QUIC_STATUS_ABORTED :
+                QUIC_STATUS_INVALID_STATE;
+    } else {
+        QUIC_SEND_REQUEST** ApiSendRequestsTail = &Stream->ApiSendRequests;
+        while (*ApiSendRequestsTail != NULL) {
+            ApiSendRequestsTail = &((*ApiSendRequestsTail)->Next);
+            QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
+        }
+        *ApiSendRequestsTail = SendRequest;
+        Status = QUIC_STATUS_SUCCESS;
+
+        if (!SendInline && QueueOper) {
+            //
+            // Async stream operations need to hold a ref on the stream so that
+            // the stream isn't freed before the operation can be processed. The
+            // ref is released after the operation is processed.
+            //
+            QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+        }
+    }
+    CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
+
+    if (QUIC_FAILED(Status)) {
+        CxPlatPoolFree(SendRequest);
+        return Status;
+    }
+
+    //
+    // From here on, we cannot fail the call because the stream has been queued
+    // and possibly already started to be processed.
+    //
+    Status = QUIC_STATUS_PENDING;
+
+    if (SendInline) {
+
+        CXPLAT_PASSIVE_CODE();
+
+        BOOLEAN AlreadyInline = Connection->State.InlineApiExecution;
+        if (!AlreadyInline) {
+            Connection->State.InlineApiExecution = TRUE;
+        }
+        QuicStreamSendFlush(Stream);
+        if (!AlreadyInline) {
+            Connection->State.InlineApiExecution = FALSE;
+        }
+
+    } else if (QueueOper) {
+        Oper = QuicConnAllocOperation(Connection, QUIC_OPER_TYPE_API_CALL);
+        if (Oper == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "STRM_SEND operation",
+                0);
+
+            //
+            // We failed to alloc the operation we needed to queue, so make sure
+            // to release the ref we took above.
+            //
+            QuicStreamRelease(Stream, QUIC_STREAM_REF_OPERATION);
+
+            //
+            // We can't fail the send at this point, because we're already queued
+            // the send above. So instead, we're just going to abort the whole
+            // connection.
+            //
+            if (InterlockedCompareExchange16(
+                    (short*)&Connection->BackUpOperUsed, 1, 0) != 0) {
+                return Status; // It's already started the shutdown.
+            }
+            Oper = &Connection->BackUpOper;
+            Oper->FreeAfterProcess = FALSE;
+            Oper->Type = QUIC_OPER_TYPE_API_CALL;
+            Oper->API_CALL.Context = &Connection->BackupApiContext;
+            Oper->API_CALL.Context->Type = QUIC_API_TYPE_CONN_SHUTDOWN;
+            Oper->API_CALL.Context->CONN_SHUTDOWN.Flags =
+                QUIC_CONNECTION_SHUTDOWN_FLAG_SILENT | QUIC_CONNECTION_SHUTDOWN_FLAG_STATUS;
+            Oper->API_CALL.Context->CONN_SHUTDOWN.ErrorCode = (QUIC_VAR_INT)QUIC_STATUS_OUT_OF_MEMORY;
+            Oper->API_CALL.Context->CONN_SHUTDOWN.RegistrationShutdown = FALSE;
+            Oper->API_CALL.Context->CONN_SHUTDOWN.TransportShutdown = TRUE;
+            QuicConnQueueHighestPriorityOper(Connection, Oper);
+            return Status;
+        }
+
+        Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_SEND;
+        Oper->API_CALL.Context->STRM_SEND.Stream = Stream;
+
+        //
+        // Queue the operation but don't wait for the completion.
+        //
+        if (IsPriority) {
+            QuicConnQueuePriorityOper(Connection, Oper);
+        } else {
+            QuicConnQueueOper(Connection, Oper);
+        }
+    }
+
+    return Status;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -1035,10 +1165,6 @@ MsQuicStreamSend(
     QUIC_CONNECTION* Connection;
     uint64_t TotalLength;
     QUIC_SEND_REQUEST* SendRequest;
-    BOOLEAN QueueOper = TRUE;
-    const BOOLEAN IsPriority = !!(Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
-    BOOLEAN SendInline;
-    QUIC_OPERATION* Oper;
 
     QuicTraceEvent(
         ApiEnter,
@@ -1107,6 +1233,184 @@ MsQuicStreamSend(
     SendRequest->TotalLength = TotalLength;
     SendRequest->ClientContext = ClientSendContext;
 
+    Status = QuicStreamQueueApiSendRequest(Stream, SendRequest);
+
+Exit:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+#ifndef _KERNEL_MODE
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSendFile(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_ QUIC_FILE File,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_STREAM* Stream;
+    QUIC_CONNECTION* Connection;
+    QUIC_SEND_REQUEST* SendRequest;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_SEND_FILE,
+        Handle);
+
+    if (!IS_STREAM_HANDLE(Handle) ||
+        Offset + Length < Offset) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Stream = (QUIC_STREAM*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+    Connection = Stream->Connection;
+
+    if (Connection->State.ClosedRemotely) {
+        Status = QUIC_STATUS_ABORTED;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
+    SendRequest = CxPlatPoolAlloc(&Connection->Partition->SendRequestPool);
+    if (SendRequest == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Stream Send request",
+            0);
+        goto Exit;
+    }
+
+    QuicTraceEvent(
+        StreamAppSend,
+        "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
+        Stream,
+        (uint64_t)Length,
+        1,
+        Flags);
+
+    //
+    // The file range is described by a single internal buffer with no data
+    // pointer. The data is read from the file when frames are written.
+    //
+    SendRequest->Next = NULL;
+    SendRequest->InternalBuffer.Buffer = NULL;
+    SendRequest->InternalBuffer.Length = Length;
+    SendRequest->Buffers = &SendRequest->InternalBuffer;
+    SendRequest->BufferCount = 1;
+    SendRequest->Flags = (Flags & ~QUIC_SEND_FLAGS_INTERNAL) | QUIC_SEND_FLAG_FILE;
+    SendRequest->TotalLength = Length;
+    SendRequest->ClientContext = ClientSendContext;
+    SendRequest->File = File;
+    SendRequest->FileOffset = Offset;
+    SendRequest->ReadStatus = QUIC_STATUS_SUCCESS;
+
+    //
+    // Start the OS reading the beginning of the range now, on the app's
+    // thread. The worker keeps reading ahead as the data is sent.
+    //
+    SendRequest->ReadAheadLength = CXPLAT_MIN(Length, QUIC_SEND_FILE_READ_AHEAD);
+    if (SendRequest->ReadAheadLength != 0) {
+        CxPlatFileReadAhead(File, Offset, SendRequest->ReadAheadLength);
+    }
+
+    Status = QuicStreamQueueApiSendRequest(Stream, SendRequest);
+
+Exit:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+#endif
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _Inout_updates_(EntryCount) _Pre_defensive_
+        QUIC_STREAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_CONNECTION* Connection;
+    QUIC_OPERATION* Oper = NULL;
+    QUIC_STREAM** Streams = NULL;
+    uint32_t StreamCount = 0;
+    BOOLEAN IsPriority = FALSE;
+    BOOLEAN SendInline;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_SEND_BATCH,
+        Handle);
+
+    if (!IS_CONN_HANDLE(Handle) ||
+        Entries == NULL ||
+        EntryCount == 0) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Connection = (QUIC_CONNECTION*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Connection->State.Freed);
+
+    //
+    // Validate every entry before queuing any of them, so that a bad parameter
+    // fails the whole call with nothing sent.
+    //
+    for (uint32_t i = 0; i < EntryCount; ++i) {
+        const QUIC_STREAM_SEND_BATCH_ENTRY* Entry = &Entries[i];
+        if (!IS_STREAM_HANDLE(Entry->Stream) ||
+            ((QUIC_STREAM*)Entry->Stream)->Connection != Connection ||
+            (Entry->Buffers == NULL && Entry->BufferCount != 0)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Exit;
+        }
+        CXPLAT_TEL_ASSERT(!((QUIC_STREAM*)Entry->Stream)->Flags.HandleClosed);
+        CXPLAT_TEL_ASSERT(!((QUIC_STREAM*)Entry->Stream)->Flags.Freed);
+        uint64_t TotalLength = 0;
+        for (uint32_t j = 0; j < Entry->BufferCount; ++j) {
+            TotalLength += Entry->Buffers[j].Length;
+        }
+        if (TotalLength > UINT32_MAX) {
+            QuicTraceEvent(
+                StreamError,
+                "[strm][%p] ERROR, %s.",
+                Entry->Stream,
+                "Send request total length exceeds max");
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Exit;
+        }
+    }
+
 #pragma warning(push)
 #pragma warning(disable:6240) // CXPLAT_AT_DISPATCH only really does anything for kernel mode
     SendInline =
@@ -1115,42 +1419,130 @@ MsQuicStreamSend(
         Connection->WorkerThreadID == CxPlatCurThreadID();
 #pragma warning(pop)
 
-    CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
-    if (!Stream->Flags.SendEnabled) {
-        Status =
-            (Connection->State.ClosedRemotely || Stream->Flags.ReceivedStopSending) ?
-                QUIC_STATUS_ABORTED :
-                QUIC_STATUS_INVALID_STATE;
-    } else {
-        QUIC_SEND_REQUEST** ApiSendRequestsTail = &Stream->ApiSendRequests;
-        while (*ApiSendRequestsTail != NULL) {
-            ApiSendRequestsTail = &((*ApiSendRequestsTail)->Next);
-            QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
-        }
-        *ApiSendRequestsTail = SendRequest;
-        Status = QUIC_STATUS_SUCCESS;
-
-        if (!SendInline && QueueOper) {
-            //
-            // Async stream operations need to hold a ref on the stream so that
-            // the stream isn't freed before the operation can be processed. The
-            // ref is released after the operation is processed.
-            //
-            QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
-        }
+    //
+    // Everything the call needs is allocated up front. Unlike a single send,
+    // a failure here can still fail the whole call, so there is no need for
+    // the backup operation.
+    //
+    Streams =
+        CXPLAT_ALLOC_NONPAGED(EntryCount * sizeof(QUIC_STREAM*), QUIC_POOL_SEND_BATCH);
+    if (Streams == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Stream send batch",
+            EntryCount * sizeof(QUIC_STREAM*));
+        goto Exit;
     }
-    CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
 
-    if (QUIC_FAILED(Status)) {
-        CxPlatPoolFree(SendRequest);
-        goto Exit;
+    if (!SendInline) {
+        Oper = QuicConnAllocOperation(Connection, QUIC_OPER_TYPE_API_CALL);
+        if (Oper == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "STRM_SEND_BATCH operation",
+                0);
+            goto Exit;
+        }
+        Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_SEND_BATCH;
+        Oper->API_CALL.Context->STRM_SEND_BATCH.Streams = Streams;
+        Oper->API_CALL.Context->STRM_SEND_BATCH.StreamCount = 0;
+        Streams = NULL; // Owned by the operation now.
     }
 
     //
-    // From here on, we cannot fail the call because the stream has been queued
-    // and possibly already started to be processed.
+    // Queue each entry like MsQuicStreamSend would. Only streams that had no
+    // sends pending are flushed by this call; the others already have a flush
+    // queued, which picks up the new requests too.
     //
     Status = QUIC_STATUS_PENDING;
+    for (uint32_t i = 0; i < EntryCount; ++i) {
+        QUIC_STREAM_SEND_BATCH_ENTRY* Entry = &Entries[i];
+        QUIC_STREAM* Stream = (QUIC_STREAM*)Entry->Stream;
+        QUIC_SEND_REQUEST* SendRequest;
+        uint64_t TotalLength = 0;
+        for (uint32_t j = 0; j < Entry->BufferCount; ++j) {
+            TotalLength += Entry->Buffers[j].Length;
+        }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
+        SendRequest = CxPlatPoolAlloc(&Connection->Partition->SendRequestPool);
+        if (SendRequest == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Stream Send request",
+                0);
+            Entry->Status = QUIC_STATUS_OUT_OF_MEMORY;
+            if (Status == QUIC_STATUS_PENDING) {
+                Status = Entry->Status;
+            }
+            continue;
+        }
+
+        QuicTraceEvent(
+            StreamAppSend,
+            "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
+            Stream,
+            TotalLength,
+            Entry->BufferCount,
+            Entry->Flags);
+
+        SendRequest->Next = NULL;
+        SendRequest->Buffers = Entry->Buffers;
+        SendRequest->BufferCount = Entry->BufferCount;
+        SendRequest->Flags = Entry->Flags & ~QUIC_SEND_FLAGS_INTERNAL;
+        SendRequest->TotalLength = TotalLength;
+        SendRequest->ClientContext = Entry->ClientSendContext;
+
+        BOOLEAN NeedsFlush = TRUE;
+        CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
+        if (!Stream->Flags.SendEnabled) {
+            Entry->Status =
+                (Connection->State.ClosedRemotely || Stream->Flags.ReceivedStopSending) ?
+                    QUIC_STATUS_ABORTED :
+                    QUIC_STATUS_INVALID_STATE;
+        } else {
+            QUIC_SEND_REQUEST** ApiSendRequestsTail = &Stream->ApiSendRequests;
+            while (*ApiSendRequestsTail != NULL) {
+                ApiSendRequestsTail = &((*ApiSendRequestsTail)->Next);
+                NeedsFlush = FALSE;
+            }
+            *ApiSendRequestsTail = SendRequest;
+            Entry->Status = QUIC_STATUS_PENDING;
+
+            if (NeedsFlush && !SendInline) {
+                //
+                // Held until the operation is freed, like for STRM_SEND.
+                //
+                QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+            }
+        }
+        CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
+
+        if (QUIC_FAILED(Entry->Status)) {
+            CxPlatPoolFree(SendRequest);
+            if (Status == QUIC_STATUS_PENDING) {
+                Status = Entry->Status;
+            }
+            continue;
+        }
+
+        if (Entry->Flags & QUIC_SEND_FLAG_PRIORITY_WORK) {
+            IsPriority = TRUE;
+        }
+        if (NeedsFlush) {
+            if (SendInline) {
+                Streams[StreamCount++] = Stream;
+            } else {
+                Oper->API_CALL.Context->STRM_SEND_BATCH.Streams[
+                    Oper->API_CALL.Context->STRM_SEND_BATCH.StreamCount++] = Stream;
+            }
+        }
+    }
 
     if (SendInline) {
 
@@ -1160,64 +1552,32 @@ MsQuicStreamSend(
         if (!AlreadyInline) {
             Connection->State.InlineApiExecution = TRUE;
         }
-        QuicStreamSendFlush(Stream);
+        for (uint32_t i = 0; i < StreamCount; ++i) {
+            QuicStreamSendFlush(Streams[i]);
+        }
         if (!AlreadyInline) {
             Connection->State.InlineApiExecution = FALSE;
         }
 
-    } else if (QueueOper) {
-        Oper = QuicConnAllocOperation(Connection, QUIC_OPER_TYPE_API_CALL);
-        if (Oper == NULL) {
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "STRM_SEND operation",
-                0);
-
-            //
-            // We failed to alloc the operation we needed to queue, so make sure
-            // to release the ref we took above.
-            //
-            QuicStreamRelease(Stream, QUIC_STREAM_REF_OPERATION);
+    } else if (Oper->API_CALL.Context->STRM_SEND_BATCH.StreamCount == 0) {
+        QuicOperationFree(Oper); // Nothing new to flush.
 
-            //
-            // We can't fail the send at this point, because we're already queued
-            // the send above. So instead, we're just going to abort the whole
-            // connection.
-            //
-            if (InterlockedCompareExchange16(
-                    (short*)&Connection->BackUpOperUsed, 1, 0) != 0) {
-                goto Exit; // It's already started the shutdown.
-            }
-            Oper = &Connection->BackUpOper;
-            Oper->FreeAfterProcess = FALSE;
-            Oper->Type = QUIC_OPER_TYPE_API_CALL;
-            Oper->API_CALL.Context = &Connection->BackupApiContext;
-            Oper->API_CALL.Context->Type = QUIC_API_TYPE_CONN_SHUTDOWN;
-            Oper->API_CALL.Context->CONN_SHUTDOWN.Flags =
-                QUIC_CONNECTION_SHUTDOWN_FLAG_SILENT | QUIC_CONNECTION_SHUTDOWN_FLAG_STATUS;
-            Oper->API_CALL.Context->CONN_SHUTDOWN.ErrorCode = (QUIC_VAR_INT)QUIC_STATUS_OUT_OF_MEMORY;
-            Oper->API_CALL.Context->CONN_SHUTDOWN.RegistrationShutdown = FALSE;
-            Oper->API_CALL.Context->CONN_SHUTDOWN.TransportShutdown = TRUE;
-            QuicConnQueueHighestPriorityOper(Connection, Oper);
-            goto Exit;
-        }
-
-        Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_SEND;
-        Oper->API_CALL.Context->STRM_SEND.Stream = Stream;
-
-        //
-        // Queue the operation but don't wait for the completion.
-        //
-        if (IsPriority) {
-            QuicConnQueuePriorityOper(Connection, Oper);
-        } else {
-            QuicConnQueueOper(Connection, Oper);
-        }
+    } else if (IsPriority) {
+        QuicConnQueuePriorityOper(Connection, Oper);
+    } else {
+        QuicConnQueueOper(Connection, Oper);
     }
+    Oper = NULL;
 
 Exit:
 
+    if (Oper != NULL) {
+        QuicOperationFree(Oper);
+    }
+    if (Streams != NULL) {
+        CXPLAT_FREE(Streams, QUIC_POOL_SEND_BATCH);
+    }
+
     QuicTraceEvent(
         ApiExitStatus,
         "[ api] Exit %u",
@@ -1860,6 +2220,9 @@ MsQuicDatagramSend(
     SendRequest->BufferCount = BufferCount;
     SendRequest->Flags = Flags;
     SendRequest->TotalLength = TotalLength;
+    SendRequest->DatagramPriority =
+        (Flags & QUIC_SEND_FLAG_DGRAM_PRIORITY) ? QUIC_DATAGRAM_PRIORITY_FLAGGED : 0;
+    SendRequest->DatagramKey = 0;
     SendRequest->ClientContext = ClientSendContext;
 
     Status = QuicDatagramQueueSend(&Connection->Datagram, SendRequest);
@@ -1874,6 +2237,107 @@ Error:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicDatagramSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(EntryCount) _Pre_defensive_
+        const QUIC_DATAGRAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_CONNECTION* Connection;
+    QUIC_SEND_REQUEST* Chain = NULL;
+    QUIC_SEND_REQUEST** ChainTail = &Chain;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_DATAGRAM_SEND_BATCH,
+        Handle);
+
+    if (!IS_CONN_HANDLE(Handle) ||
+        Entries == NULL ||
+        EntryCount == 0) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Connection = (QUIC_CONNECTION*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Connection->State.Freed);
+
+    //
+    // Build the whole chain of send requests first, so it can be queued with
+    // a single lock acquisition and at most one operation.
+    //
+    for (uint32_t i = 0; i < EntryCount; ++i) {
+        const QUIC_DATAGRAM_SEND_BATCH_ENTRY* Entry = &Entries[i];
+        if (Entry->Buffers == NULL || Entry->BufferCount == 0) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+
+        uint64_t TotalLength = 0;
+        for (uint32_t j = 0; j < Entry->BufferCount; ++j) {
+            TotalLength += Entry->Buffers[j].Length;
+        }
+
+        if (TotalLength > UINT16_MAX) {
+            QuicTraceEvent(
+                ConnError,
+                "[conn][%p] ERROR, %s.",
+                Connection,
+                "Send request total length exceeds max");
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (...).")
+        QUIC_SEND_REQUEST* SendRequest =
+            CxPlatPoolAlloc(&Connection->Partition->SendRequestPool);
+        if (SendRequest == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+
+        SendRequest->Next = NULL;
+        SendRequest->Buffers = Entry->Buffers;
+        SendRequest->BufferCount = Entry->BufferCount;
+        SendRequest->Flags = Entry->Flags;
+        SendRequest->TotalLength = TotalLength;
+        SendRequest->DatagramPriority =
+            (Entry->Flags & QUIC_SEND_FLAG_DGRAM_PRIORITY) ?
+                QUIC_DATAGRAM_PRIORITY_FLAGGED : Entry->Priority;
+        SendRequest->DatagramKey = Entry->ReplaceKey;
+        SendRequest->ClientContext = Entry->ClientSendContext;
+
+        *ChainTail = SendRequest;
+        ChainTail = &SendRequest->Next;
+    }
+
+    Status = QuicDatagramQueueSend(&Connection->Datagram, Chain);
+    Chain = NULL; // Queued or freed.
+
+Error:
+
+    while (Chain != NULL) {
+        QUIC_SEND_REQUEST* Next = Chain->Next;
+        CxPlatPoolFree(Chain);
+        Chain = Next;
+    }
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -261,6 +261,30 @@ MsQuicStreamReceiveComplete(
     _In_ uint64_t BufferLength
     );
 
+#ifndef _KERNEL_MODE
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSendFile(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_ QUIC_FILE File,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    );
+#endif
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _Inout_updates_(EntryCount) _Pre_defensive_
+        QUIC_STREAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -316,6 +340,16 @@ MsQuicDatagramSend(
     _In_opt_ void* ClientSendContext
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicDatagramSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(EntryCount) _Pre_defensive_
+        const QUIC_DATAGRAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -0,0 +1,187 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    The connection arena carves the small objects a connection keeps for its
+    lifetime out of a few growing slabs, instead of making a separate heap
+    allocation for each. That saves the allocator's per-block overhead and
+    fragmentation, which adds up when a server holds a very large number of
+    mostly idle connections, and lets the whole lot be released at once when
+    the connection is freed.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "arena.c.clog.h"
+#endif
+
+CXPLAT_STATIC_ASSERT(
+    IS_POWER_OF_TWO(QUIC_ARENA_BLOCK_ALIGNMENT),
+    "Block sizes are rounded by masking");
+CXPLAT_STATIC_ASSERT(
+    QUIC_ARENA_BLOCK_ALIGNMENT >= sizeof(CXPLAT_SLIST_ENTRY),
+    "Freed blocks must fit a free list entry");
+CXPLAT_STATIC_ASSERT(
+    QUIC_ARENA_MAX_BLOCK_SIZE <= QUIC_ARENA_MIN_SLAB_SIZE,
+    "The largest block must fit in the smallest slab");
+
+#define QUIC_ARENA_ROUND_UP(Size) \
+    (((Size) + QUIC_ARENA_BLOCK_ALIGNMENT - 1) & ~(QUIC_ARENA_BLOCK_ALIGNMENT - 1))
+
+//
+// The header is padded so every block carved after it stays aligned.
+//
+#define QUIC_ARENA_SLAB_HEADER_SIZE \
+    QUIC_ARENA_ROUND_UP((uint32_t)sizeof(QUIC_ARENA_SLAB))
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicArenaInitialize(
+    _Out_ QUIC_ARENA* Arena,
+    _In_ uint32_t SlabSize
+    )
+{
+    CXPLAT_DBG_ASSERT(
+        SlabSize == 0 ||
+        (SlabSize >= QUIC_ARENA_MIN_SLAB_SIZE && SlabSize <= QUIC_ARENA_MAX_SLAB_SIZE));
+    CxPlatZeroMemory(Arena, sizeof(*Arena));
+    Arena->NextSlabSize = SlabSize;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicArenaUninitialize(
+    _Inout_ QUIC_ARENA* Arena
+    )
+{
+    while (Arena->Slabs != NULL) {
+        QUIC_ARENA_SLAB* Slab = Arena->Slabs;
+        Arena->Slabs = Slab->Next;
+        CXPLAT_FREE(Slab, QUIC_POOL_CONN_ARENA);
+    }
+    CxPlatZeroMemory(Arena->FreeLists, sizeof(Arena->FreeLists));
+    Arena->SlabCount = 0;
+    Arena->SlabBytes = 0;
+    Arena->UsedBytes = 0;
+}
+
+//
+// Carves BlockSize bytes from the current slab, starting a new (bigger) slab
+// if there isn't enough room left. What's left of the old slab is abandoned.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void*
+QuicArenaCarve(
+    _Inout_ QUIC_ARENA* Arena,
+    _In_ uint32_t BlockSize
+    )
+{
+    QUIC_ARENA_SLAB* Slab = Arena->Slabs;
+    if (Slab == NULL || Slab->Size - Slab->Used < BlockSize) {
+        const uint32_t SlabSize = Arena->NextSlabSize;
+        Slab =
+            CXPLAT_ALLOC_NONPAGED(
+                QUIC_ARENA_SLAB_HEADER_SIZE + SlabSize,
+                QUIC_POOL_CONN_ARENA);
+        if (Slab == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "arena slab",
+                QUIC_ARENA_SLAB_HEADER_SIZE + SlabSize);
+            return NULL;
+        }
+        Slab->Next = Arena->Slabs;
+        Slab->Size = SlabSize;
+        Slab->Used = 0;
+        Arena->Slabs = Slab;
+        Arena->SlabCount++;
+        Arena->SlabBytes += QUIC_ARENA_SLAB_HEADER_SIZE + SlabSize;
+        if (SlabSize < QUIC_ARENA_MAX_SLAB_SIZE) {
+            Arena->NextSlabSize = SlabSize * 2;
+        }
+    }
+
+    void* Block = (uint8_t*)Slab + QUIC_ARENA_SLAB_HEADER_SIZE + Slab->Used;
+    Slab->Used += BlockSize;
+    return Block;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+void*
+QuicArenaAlloc(
+    _Inout_ QUIC_ARENA* Arena,
+    _In_ uint32_t Size,
+    _In_ uint32_t Tag
+    )
+{
+    CXPLAT_DBG_ASSERT(Size != 0);
+    const uint32_t BlockSize = QUIC_ARENA_ROUND_UP(Size);
+    if (Arena->NextSlabSize == 0 || BlockSize > QUIC_ARENA_MAX_BLOCK_SIZE) {
+        void* Memory = CXPLAT_ALLOC_NONPAGED(Size, Tag);
+        if (Memory != NULL) {
+            Arena->HeapBytes += Size;
+        }
+        return Memory;
+    }
+
+    CXPLAT_SLIST_ENTRY* FreeList =
+        &Arena->FreeLists[BlockSize / QUIC_ARENA_BLOCK_ALIGNMENT - 1];
+    void* Block = CxPlatListPopEntry(FreeList);
+    if (Block == NULL) {
+        Block = QuicArenaCarve(Arena, BlockSize);
+        if (Block == NULL) {
+            return NULL;
+        }
+    }
+
+    Arena->UsedBytes += BlockSize;
+    if (Arena->UsedBytes > Arena->PeakUsedBytes) {
+        Arena->PeakUsedBytes = Arena->UsedBytes;
+    }
+    return Block;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicArenaFree(
+    _Inout_ QUIC_ARENA* Arena,
+    _In_ void* Memory,
+    _In_ uint32_t Size,
+    _In_ uint32_t Tag
+    )
+{
+    const uint32_t BlockSize = QUIC_ARENA_ROUND_UP(Size);
+    if (Arena->NextSlabSize == 0 || BlockSize > QUIC_ARENA_MAX_BLOCK_SIZE) {
+        CXPLAT_DBG_ASSERT(Arena->HeapBytes >= Size);
+        Arena->HeapBytes -= Size;
+        CXPLAT_FREE(Memory, Tag);
+        return;
+    }
+
+    CXPLAT_DBG_ASSERT(Arena->UsedBytes >= BlockSize);
+    Arena->UsedBytes -= BlockSize;
+    CxPlatListPushEntry(
+        &Arena->FreeLists[BlockSize / QUIC_ARENA_BLOCK_ALIGNMENT - 1],
+        (CXPLAT_SLIST_ENTRY*)Memory);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicArenaGetStatistics(
+    _In_ const QUIC_ARENA* Arena,
+    _Out_ QUIC_CONN_ARENA_STATISTICS* Stats
+    )
+{
+    Stats->SlabCount = Arena->SlabCount;
+    Stats->SlabBytes = Arena->SlabBytes;
+    Stats->UsedBytes = Arena->UsedBytes;
+    Stats->PeakUsedBytes = Arena->PeakUsedBytes;
+    Stats->HeapBytes = Arena->HeapBytes;
+}
@@ -0,0 +1,136 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// A slab of memory owned by an arena. The blocks carved from it follow the
+// header.
+//
+typedef struct QUIC_ARENA_SLAB {
+
+    struct QUIC_ARENA_SLAB* Next;
+
+    //
+    // Number of bytes (after the header) in the slab.
+    //
+    uint32_t Size;
+
+    //
+    // Number of bytes (after the header) carved so far.
+    //
+    uint32_t Used;
+
+} QUIC_ARENA_SLAB;
+
+#define QUIC_ARENA_SIZE_CLASS_COUNT \
+    (QUIC_ARENA_MAX_BLOCK_SIZE / QUIC_ARENA_BLOCK_ALIGNMENT)
+
+//
+// A per-connection arena for small objects that mostly live as long as the
+// connection. Blocks are carved from a short chain of growing slabs, so they
+// don't each pay for a heap header, and are all released at once when the
+// connection is freed. Blocks freed earlier are kept on per-size free lists
+// and reused, so objects that churn (like the peer's CIDs) don't grow it.
+//
+// Not thread safe; only used from the connection's worker.
+//
+typedef struct QUIC_ARENA {
+
+    //
+    // The slabs, most recent (the one being carved) first.
+    //
+    QUIC_ARENA_SLAB* Slabs;
+
+    //
+    // Freed blocks, by size class.
+    //
+    CXPLAT_SLIST_ENTRY FreeLists[QUIC_ARENA_SIZE_CLASS_COUNT];
+
+    //
+    // Size of the next slab to allocate. Zero if the arena is disabled.
+    //
+    uint32_t NextSlabSize;
+
+    //
+    // Number of slabs and bytes (including slab headers) taken from the heap.
+    //
+    uint32_t SlabCount;
+    uint32_t SlabBytes;
+
+    //
+    // Bytes currently handed out, and the most there has ever been.
+    //
+    uint32_t UsedBytes;
+    uint32_t PeakUsedBytes;
+
+    //
+    // Bytes of requests too large for the arena, currently on the heap.
+    //
+    uint32_t HeapBytes;
+
+} QUIC_ARENA;
+
+//
+// Sets up an empty arena. SlabSize is the size of the first slab, between
+// QUIC_ARENA_MIN_SLAB_SIZE and QUIC_ARENA_MAX_SLAB_SIZE, or zero to leave the
+// arena disabled so every allocation goes straight to the heap.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicArenaInitialize(
+    _Out_ QUIC_ARENA* Arena,
+    _In_ uint32_t SlabSize
+    );
+
+//
+// Releases every slab, and with them every block still handed out.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicArenaUninitialize(
+    _Inout_ QUIC_ARENA* Arena
+    );
+
+//
+// Allocates Size bytes. The same Size must be passed to QuicArenaFree.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+void*
+QuicArenaAlloc(
+    _Inout_ QUIC_ARENA* Arena,
+    _In_ uint32_t Size,
+    _In_ uint32_t Tag
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicArenaFree(
+    _Inout_ QUIC_ARENA* Arena,
+    _In_ void* Memory,
+    _In_ uint32_t Size,
+    _In_ uint32_t Tag
+    );
+
+//
+// Fills in the stats for QUIC_PARAM_CONN_ARENA_STATISTICS.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicArenaGetStatistics(
+    _In_ const QUIC_ARENA* Arena,
+    _Out_ QUIC_CONN_ARENA_STATISTICS* Stats
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -306,6 +306,22 @@ BbrCongestionControlIsAppLimited(
     return Cc->Bbr.BandwidthFilter.AppLimited;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlNeedsFrequentAcks(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    //
+    // Only PROBE_BW runs long enough at a stable rate to tolerate sparse ACKs.
+    // STARTUP and DRAIN need delivery rate samples every round, and PROBE_RTT
+    // has only a handful of packets in flight.
+    //
+    return
+        Cc->Bbr.BbrState != BBR_STATE_PROBE_BW ||
+        BbrCongestionControlInRecovery(Cc);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicConnLogBbr(
@@ -1354,12 +1370,54 @@ BbrCongestionControlReset(
     QuicConnLogBbr(Connection);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlResume(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t CongestionWindow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    BbrCongestionControlReset(Cc, FALSE);
+
+    //
+    // Run STARTUP from half the window last used on the path. Until the first
+    // bandwidth sample, the target window is derived from the initial window,
+    // so raise that too.
+    //
+    if (CongestionWindow / 2 > Bbr->CongestionWindow) {
+        Bbr->CongestionWindow = CongestionWindow / 2;
+        Bbr->InitialCongestionWindow = Bbr->CongestionWindow;
+        Bbr->BytesInFlightMax = Bbr->CongestionWindow / 2;
+        BbrCongestionControlLogOutFlowStatus(Cc);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlGetTelemetry(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc,
+    _Inout_ QUIC_CONN_TELEMETRY_SAMPLE* Sample
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    Sample->CongestionWindow = BbrCongestionControlGetCongestionWindow(Cc);
+    Sample->BytesInFlight = Bbr->BytesInFlight;
+    Sample->BandwidthEstimate = BbrCongestionControlGetBandwidth(Cc) / BW_UNIT;
+    if (Connection->Settings.PacingEnabled) {
+        Sample->PacingRate = Sample->BandwidthEstimate * Bbr->PacingGain / GAIN_UNIT;
+    }
+}
 
 static const QUIC_CONGESTION_CONTROL QuicCongestionControlBbr = {
     .Name = "BBR",
     .QuicCongestionControlCanSend = BbrCongestionControlCanSend,
     .QuicCongestionControlSetExemption = BbrCongestionControlSetExemption,
     .QuicCongestionControlReset = BbrCongestionControlReset,
+    .QuicCongestionControlResume = BbrCongestionControlResume,
     .QuicCongestionControlGetSendAllowance = BbrCongestionControlGetSendAllowance,
     .QuicCongestionControlGetCongestionWindow = BbrCongestionControlGetCongestionWindow,
     .QuicCongestionControlOnDataSent = BbrCongestionControlOnDataSent,
@@ -1374,6 +1432,8 @@ static const QUIC_CONGESTION_CONTROL QuicCongestionControlBbr = {
     .QuicCongestionControlIsAppLimited = BbrCongestionControlIsAppLimited,
     .QuicCongestionControlSetAppLimited = BbrCongestionControlSetAppLimited,
     .QuicCongestionControlLogPacketSent = BbrCongestionControlLogPacketSent,
+    .QuicCongestionControlNeedsFrequentAcks = BbrCongestionControlNeedsFrequentAcks,
+    .QuicCongestionControlGetTelemetry = BbrCongestionControlGetTelemetry,
 };
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
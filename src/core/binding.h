@@ -166,6 +166,12 @@ typedef struct QUIC_RX_PACKET {
     // Flag indicating the packet contained a non-probing frame.
     //
     BOOLEAN HasNonProbingFrame : 1;
+
+    //
+    // Flag indicating the packet contained a frame other than PADDING, PING
+    // or ACK, i.e. more than keep alive traffic.
+    //
+    BOOLEAN HasActiveFrame : 1;
     };
     };
 
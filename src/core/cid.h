@@ -236,11 +236,13 @@ QUIC_INLINE
 _Success_(return != NULL)
 QUIC_CID_LIST_ENTRY*
 QuicCidNewRandomDestination(
+    _Inout_ QUIC_ARENA* Arena
     )
 {
     QUIC_CID_LIST_ENTRY* Entry =
         (QUIC_CID_LIST_ENTRY*)
-        CXPLAT_ALLOC_NONPAGED(
+        QuicArenaAlloc(
+            Arena,
             sizeof(QUIC_CID_LIST_ENTRY) +
             QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH,
             QUIC_POOL_CIDLIST);
@@ -262,6 +264,7 @@ QUIC_INLINE
 _Success_(return != NULL)
 QUIC_CID_LIST_ENTRY*
 QuicCidNewDestination(
+    _Inout_ QUIC_ARENA* Arena,
     _In_ uint8_t Length,
     _In_reads_(Length)
         const uint8_t* const Data
@@ -269,7 +272,8 @@ QuicCidNewDestination(
 {
     QUIC_CID_LIST_ENTRY* Entry =
         (QUIC_CID_LIST_ENTRY*)
-        CXPLAT_ALLOC_NONPAGED(
+        QuicArenaAlloc(
+            Arena,
             sizeof(QUIC_CID_LIST_ENTRY) +
             Length,
             QUIC_POOL_CIDLIST);
@@ -286,6 +290,24 @@ QuicCidNewDestination(
     return Entry;
 }
 
+//
+// Frees a destination connection ID. Its length must not have changed since it
+// was created.
+//
+QUIC_INLINE
+void
+QuicCidFreeDestination(
+    _Inout_ QUIC_ARENA* Arena,
+    _In_ __drv_freesMem(Mem) QUIC_CID_LIST_ENTRY* Entry
+    )
+{
+    QuicArenaFree(
+        Arena,
+        Entry,
+        sizeof(QUIC_CID_LIST_ENTRY) + Entry->CID.Length,
+        QUIC_POOL_CIDLIST);
+}
+
 //
 // Helpers for logging connection IDs.
 //
@@ -8,6 +8,10 @@
 #include "bbr.h"
 #include "cubic.h"
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_ACK_EVENT {
 
     uint64_t TimeNow; // microsecond
@@ -96,6 +100,11 @@ typedef struct QUIC_CONGESTION_CONTROL {
         _In_ BOOLEAN FullReset
         );
 
+    void (*QuicCongestionControlResume)(
+        _In_ struct QUIC_CONGESTION_CONTROL* Cc,
+        _In_ uint32_t CongestionWindow
+        );
+
     uint32_t (*QuicCongestionControlGetSendAllowance)(
         _In_ struct QUIC_CONGESTION_CONTROL* Cc,
         _In_ uint64_t TimeSinceLastSend,
@@ -160,6 +169,15 @@ typedef struct QUIC_CONGESTION_CONTROL {
         _In_ uint32_t PacketSize
         );
 
+    BOOLEAN (*QuicCongestionControlNeedsFrequentAcks)(
+        _In_ const struct QUIC_CONGESTION_CONTROL* Cc
+        );
+
+    void (*QuicCongestionControlGetTelemetry)(
+        _In_ const struct QUIC_CONGESTION_CONTROL* Cc,
+        _Inout_ QUIC_CONN_TELEMETRY_SAMPLE* Sample
+        );
+
     //
     // Algorithm specific state.
     //
@@ -215,6 +233,26 @@ QuicCongestionControlReset(
     Cc->QuicCongestionControlReset(Cc, FullReset);
 }
 
+//
+// Resets the algorithm for a path it previously controlled, starting from a
+// conservative estimate based on the congestion window last used on the path
+// instead of the initial window.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicCongestionControlResume(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t CongestionWindow
+    )
+{
+    if (Cc->QuicCongestionControlResume != NULL) {
+        Cc->QuicCongestionControlResume(Cc, CongestionWindow);
+    } else {
+        Cc->QuicCongestionControlReset(Cc, FALSE);
+    }
+}
+
 //
 // Returns the number of bytes that can be sent immediately.
 //
@@ -388,3 +426,44 @@ QuicCongestionControlLogPacketSent(
         Cc->QuicCongestionControlLogPacketSent(Cc, PacketSize);
     }
 }
+
+//
+// Returns TRUE if the algorithm is in a state (i.e. growing the window or
+// recovering from loss) where it relies on prompt ACK feedback, and the peer
+// shouldn't be asked to acknowledge less often than the default.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+BOOLEAN
+QuicCongestionControlNeedsFrequentAcks(
+    _In_ const struct QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    if (Cc->QuicCongestionControlNeedsFrequentAcks != NULL) {
+        return Cc->QuicCongestionControlNeedsFrequentAcks(Cc);
+    }
+    return TRUE;
+}
+
+//
+// Fills in the algorithm's view of the congestion window, bytes in flight,
+// bandwidth estimate and pacing rate for a telemetry sample.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicCongestionControlGetTelemetry(
+    _In_ const struct QUIC_CONGESTION_CONTROL* Cc,
+    _Inout_ QUIC_CONN_TELEMETRY_SAMPLE* Sample
+    )
+{
+    if (Cc->QuicCongestionControlGetTelemetry != NULL) {
+        Cc->QuicCongestionControlGetTelemetry(Cc, Sample);
+    } else {
+        Sample->CongestionWindow = Cc->QuicCongestionControlGetCongestionWindow(Cc);
+    }
+}
+
+#if defined(__cplusplus)
+}
+#endif
@@ -38,6 +38,7 @@ Abstract:
 
 typedef struct QUIC_RECEIVE_PROCESSING_STATE {
     BOOLEAN ResetIdleTimeout;
+    BOOLEAN Rehydrate;
     BOOLEAN UpdatePartitionId;
     uint16_t PartitionIndex;
 } QUIC_RECEIVE_PROCESSING_STATE;
@@ -112,6 +113,7 @@ QuicConnAlloc(
     Connection->AckDelayExponent = QUIC_ACK_DELAY_EXPONENT;
     Connection->PacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
     Connection->PeerPacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
+    Connection->MinPeerPacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
     Connection->ReorderingThreshold = QUIC_MIN_REORDERING_THRESHOLD;
     Connection->PeerReorderingThreshold = QUIC_MIN_REORDERING_THRESHOLD;
     Connection->PeerTransportParams.AckDelayExponent = QUIC_TP_ACK_DELAY_EXPONENT_DEFAULT;
@@ -120,6 +122,7 @@ QuicConnAlloc(
     Connection->Settings.IsSetFlags = 0; // Just grab the global values, not IsSet flags.
     CxPlatDispatchLockInitialize(&Connection->ReceiveQueueLock);
     CxPlatListInitializeHead(&Connection->DestCids);
+    QuicArenaInitialize(&Connection->Arena, MsQuicLib.ConnArenaSlabSize);
     QuicStreamSetInitialize(&Connection->Streams);
     QuicSendBufferInitialize(&Connection->SendBuffer);
     QuicOperationQueueInitialize(&Connection->OperQ);
@@ -195,7 +198,8 @@ QuicConnAlloc(
             CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress));
 
         Path->DestCid =
-            QuicCidNewDestination(Packet->SourceCidLen, Packet->SourceCid);
+            QuicCidNewDestination(
+                &Connection->Arena, Packet->SourceCidLen, Packet->SourceCid);
         if (Path->DestCid == NULL) {
             Status = QUIC_STATUS_OUT_OF_MEMORY;
             goto Error;
@@ -236,7 +240,7 @@ QuicConnAlloc(
         Path->IsPeerValidated = TRUE;
         Path->Allowance = UINT32_MAX;
 
-        Path->DestCid = QuicCidNewRandomDestination();
+        Path->DestCid = QuicCidNewRandomDestination(&Connection->Arena);
         if (Path->DestCid == NULL) {
             Status = QUIC_STATUS_OUT_OF_MEMORY;
             goto Error;
@@ -295,7 +299,7 @@ Error:
                 CxPlatListRemoveHead(&Connection->DestCids),
                 QUIC_CID_LIST_ENTRY,
                 Link);
-        CXPLAT_FREE(CID, QUIC_POOL_CIDLIST);
+        QuicCidFreeDestination(&Connection->Arena, CID);
     }
     QuicConnRelease(Connection, QUIC_CONN_REF_HANDLE_OWNER);
 
@@ -342,7 +346,7 @@ QuicConnFree(
                 CxPlatListRemoveHead(&Connection->DestCids),
                 QUIC_CID_LIST_ENTRY,
                 Link);
-        CXPLAT_FREE(CID, QUIC_POOL_CIDLIST);
+        QuicCidFreeDestination(&Connection->Arena, CID);
     }
     QuicConnUnregister(Connection);
     if (Connection->Worker != NULL) {
@@ -368,6 +372,7 @@ QuicConnFree(
     QuicSendBufferUninitialize(&Connection->SendBuffer);
     QuicDatagramSendShutdown(&Connection->Datagram);
     QuicDatagramUninitialize(&Connection->Datagram);
+    QuicTelemetryUninitialize(&Connection->Telemetry);
     if (Connection->Configuration != NULL) {
         QuicConfigurationRelease(Connection->Configuration);
         Connection->Configuration = NULL;
@@ -376,7 +381,11 @@ QuicConnFree(
         CXPLAT_FREE(Connection->RemoteServerName, QUIC_POOL_SERVERNAME);
     }
     if (Connection->OrigDestCID != NULL) {
-        CXPLAT_FREE(Connection->OrigDestCID, QUIC_POOL_CID);
+        QuicArenaFree(
+            &Connection->Arena,
+            Connection->OrigDestCID,
+            sizeof(QUIC_CID) + Connection->OrigDestCID->Length,
+            QUIC_POOL_CID);
     }
     if (Connection->HandshakeTP != NULL) {
         QuicCryptoTlsCleanupTransportParameters(Connection->HandshakeTP);
@@ -397,6 +406,7 @@ QuicConnFree(
     if (Connection->CloseReasonPhrase != NULL) {
         CXPLAT_FREE(Connection->CloseReasonPhrase, QUIC_POOL_CLOSE_REASON);
     }
+    QuicArenaUninitialize(&Connection->Arena);
     Connection->State.Freed = TRUE;
     QuicTraceEvent(
         ConnDestroyed,
@@ -786,6 +796,7 @@ QuicConnUpdateRtt(
 
     BOOLEAN NewMinRtt = FALSE;
     Path->LatestRttSample = LatestRtt;
+    QuicPerfHistogramRecord(Connection->Partition, QUIC_PERF_HISTOGRAM_RTT, LatestRtt);
     if (LatestRtt < Path->MinRtt) {
         Path->MinRtt = LatestRtt;
         NewMinRtt = TRUE;
@@ -2245,8 +2256,10 @@ QuicConnCleanupServerResumptionState(
         if (Crypto->Initialized) {
             QuicRecvBufferUninitialize(&Crypto->RecvBuffer);
             QuicRangeUninitialize(&Crypto->SparseAckRanges);
-            CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
-            Crypto->TlsState.Buffer = NULL;
+            if (Crypto->TlsState.Buffer != NULL) {
+                CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
+                Crypto->TlsState.Buffer = NULL;
+            }
             Crypto->Initialized = FALSE;
         }
     }
@@ -2499,7 +2512,8 @@ QuicConnSetConfiguration(
         // Save the original CID for later validation in the TP.
         //
         Connection->OrigDestCID =
-            CXPLAT_ALLOC_NONPAGED(
+            QuicArenaAlloc(
+                &Connection->Arena,
                 sizeof(QUIC_CID) +
                 DestCid->CID.Length,
                 QUIC_POOL_CID);
@@ -3370,23 +3384,25 @@ QuicConnUpdateDestCid(
         // server (which we randomly generated) and replace it with
         // the one we have just received.
         //
-        if (Packet->SourceCidLen <= DestCid->CID.Length) {
+        if (Packet->SourceCidLen == DestCid->CID.Length) {
             //
-            // Since the current structure has enough room for the
-            // new CID, we will just reuse it.
+            // Since the new CID is the same length, we will just reuse the
+            // current structure. (It's freed by length, so it can't be reused
+            // for a shorter CID.)
             //
             DestCid->CID.IsInitial = FALSE;
             DestCid->CID.Length = Packet->SourceCidLen;
             CxPlatCopyMemory(DestCid->CID.Data, Packet->SourceCid, DestCid->CID.Length);
         } else {
             //
-            // There isn't enough room in the existing structure,
-            // so we must allocate a new one and free the old one.
+            // The length differs, so we must allocate a new structure and
+            // free the old one.
             //
             CxPlatListEntryRemove(&DestCid->Link);
-            CXPLAT_FREE(DestCid, QUIC_POOL_CIDLIST);
+            QuicCidFreeDestination(&Connection->Arena, DestCid);
             DestCid =
                 QuicCidNewDestination(
+                    &Connection->Arena,
                     Packet->SourceCidLen,
                     Packet->SourceCid);
             if (DestCid == NULL) {
@@ -3894,11 +3910,16 @@ QuicConnRecvHeader(
                 CXPLAT_DBG_ASSERT(QuicAddrCompare(&Path->Route.RemoteAddress, &Token.Encrypted.RemoteAddress));
 
                 if (Connection->OrigDestCID != NULL) {
-                    CXPLAT_FREE(Connection->OrigDestCID, QUIC_POOL_CID);
+                    QuicArenaFree(
+                        &Connection->Arena,
+                        Connection->OrigDestCID,
+                        sizeof(QUIC_CID) + Connection->OrigDestCID->Length,
+                        QUIC_POOL_CID);
                 }
 
                 Connection->OrigDestCID =
-                    CXPLAT_ALLOC_NONPAGED(
+                    QuicArenaAlloc(
+                        &Connection->Arena,
                         sizeof(QUIC_CID) +
                         Token.Encrypted.OrigConnIdLength,
                         QUIC_POOL_CID);
@@ -3926,7 +3947,8 @@ QuicConnRecvHeader(
         if (Connection->OrigDestCID == NULL) {
 
             Connection->OrigDestCID =
-                CXPLAT_ALLOC_NONPAGED(
+                QuicArenaAlloc(
+                    &Connection->Arena,
                     sizeof(QUIC_CID) +
                     Packet->DestCidLen,
                     QUIC_POOL_CID);
@@ -4448,9 +4470,25 @@ QuicConnRecvFrames(
         Connection->State.GotFirstServerResponse = TRUE;
     }
 
+    //
+    // For a sample of packets, time each frame for the profiler. A frame's
+    // time is recorded when the next one starts, or after the last one.
+    //
+    const BOOLEAN Profile =
+        QuicProfileShouldSample(Connection->Stats.Recv.TotalPackets);
+    uint32_t ProfileFrameIndex = UINT32_MAX;
+    uint64_t ProfileStart = 0;
+
     uint16_t Offset = 0;
     while (Offset < PayloadLength) {
 
+        if (ProfileFrameIndex != UINT32_MAX) {
+            QuicProfileRecord(
+                &Connection->Partition->Profile.Frames[ProfileFrameIndex],
+                CxPlatCycleCount() - ProfileStart);
+            ProfileFrameIndex = UINT32_MAX;
+        }
+
         //
         // Read the frame type.
         //
@@ -4475,6 +4513,11 @@ QuicConnRecvFrames(
             return FALSE;
         }
 
+        if (Profile) {
+            ProfileFrameIndex = QuicProfileFrameIndex(FrameType);
+            ProfileStart = CxPlatCycleCount();
+        }
+
         //
         // Validate allowable frames based on the packet type.
         //
@@ -4528,6 +4571,13 @@ QuicConnRecvFrames(
             }
         }
 
+        if (FrameType != QUIC_FRAME_PADDING &&
+            FrameType != QUIC_FRAME_PING &&
+            FrameType != QUIC_FRAME_ACK &&
+            FrameType != QUIC_FRAME_ACK_1) {
+            Packet->HasActiveFrame = TRUE;
+        }
+
         //
         // Process the frame based on the frame type.
         //
@@ -4554,6 +4604,14 @@ QuicConnRecvFrames(
         case QUIC_FRAME_ACK:
         case QUIC_FRAME_ACK_1: {
             BOOLEAN InvalidAckFrame;
+            //
+            // Only a sample of ACK frames is timed, to keep the clock reads
+            // off the common receive path.
+            //
+            const BOOLEAN TimeAckFrame =
+                (Connection->Stats.Recv.ValidAckFrames &
+                    (QUIC_ACK_PROCESSING_SAMPLE_INTERVAL - 1)) == 0;
+            const uint64_t AckStartTime = TimeAckFrame ? CxPlatTimeUs64() : 0;
             if (!QuicLossDetectionProcessAckFrame(
                     &Connection->LossDetection,
                     Path,
@@ -4575,6 +4633,12 @@ QuicConnRecvFrames(
                 return FALSE;
             }
 
+            if (TimeAckFrame) {
+                QuicPerfHistogramRecord(
+                    Connection->Partition,
+                    QUIC_PERF_HISTOGRAM_ACK_PROCESSING_TIME,
+                    CxPlatTimeDiff64(AckStartTime, CxPlatTimeUs64()));
+            }
             Connection->Stats.Recv.ValidAckFrames++;
             Packet->HasNonProbingFrame = TRUE;
             break;
@@ -4971,7 +5035,8 @@ QuicConnRecvFrames(
                 // Create the new destination connection ID.
                 //
                 QUIC_CID_LIST_ENTRY* DestCid =
-                    QuicCidNewDestination(Frame.Length, Frame.Buffer);
+                    QuicCidNewDestination(
+                        &Connection->Arena, Frame.Length, Frame.Buffer);
                 if (DestCid == NULL) {
                     QuicTraceEvent(
                         AllocFailure,
@@ -5128,6 +5193,8 @@ QuicConnRecvFrames(
                     !memcmp(Frame.Data, TempPath->Challenge, sizeof(Frame.Data))) {
                     QuicPerfCounterIncrement(
                         Connection->Partition, QUIC_PERF_COUNTER_PATH_VALIDATED);
+                    Connection->Stats.Misc.LastPathValidationTimeUs =
+                        CxPlatTimeDiff64(TempPath->PathValidationStartTime, CxPlatTimeUs64());
                     QuicPathSetValid(Connection, TempPath, QUIC_PATH_VALID_PATH_RESPONSE);
                     break;
                 }
@@ -5349,6 +5416,12 @@ QuicConnRecvFrames(
 
 Done:
 
+    if (ProfileFrameIndex != UINT32_MAX) {
+        QuicProfileRecord(
+            &Connection->Partition->Profile.Frames[ProfileFrameIndex],
+            CxPlatCycleCount() - ProfileStart);
+    }
+
     if (UpdatedFlowControl) {
         QuicConnLogOutFlowStats(Connection);
     }
@@ -5583,6 +5656,7 @@ QuicConnRecvDatagramBatch(
 
             QuicConnRecvPostProcessing(Connection, &Path, Packet);
             RecvState->ResetIdleTimeout |= Packet->CompletelyValid;
+            RecvState->Rehydrate |= Packet->CompletelyValid && Packet->HasActiveFrame;
 
             if (Connection->Registration != NULL && !Connection->Registration->NoPartitioning &&
                 Path->IsActive && !Path->PartitionUpdated && Packet->CompletelyValid &&
@@ -5617,7 +5691,7 @@ QuicConnRecvDatagrams(
     QUIC_RX_PACKET* ReleaseChain = NULL;
     QUIC_RX_PACKET** ReleaseChainTail = &ReleaseChain;
     uint32_t ReleaseChainCount = 0;
-    QUIC_RECEIVE_PROCESSING_STATE RecvState = { FALSE, FALSE, 0 };
+    QUIC_RECEIVE_PROCESSING_STATE RecvState = { FALSE, FALSE, FALSE, 0 };
     RecvState.PartitionIndex = QuicPartitionIdGetIndex(Connection->PartitionID);
 
     UNREFERENCED_PARAMETER(PacketChainCount);
@@ -5793,6 +5867,7 @@ QuicConnRecvDatagrams(
             Packet->CompletelyValid = FALSE;
             Packet->NewLargestPacketNumber = FALSE;
             Packet->HasNonProbingFrame = FALSE;
+            Packet->HasActiveFrame = FALSE;
 
         } while (Packet->AvailBuffer - Packet->Buffer < Packet->BufferLength);
 
@@ -5850,6 +5925,14 @@ QuicConnRecvDatagrams(
         QuicConnResetIdleTimeout(Connection);
     }
 
+    if (RecvState.Rehydrate) {
+        //
+        // Keep alive PINGs and ACKs are handled without waking up a
+        // hibernated connection.
+        //
+        QuicConnRehydrate(Connection);
+    }
+
     if (ReleaseChain != NULL) {
         CxPlatRecvDataReturn((CXPLAT_RECV_DATA*)ReleaseChain);
     }
@@ -6186,6 +6269,125 @@ QuicConnProcessKeepAliveOperation(
         MS_TO_US(Connection->Settings.KeepAliveIntervalMs));
 }
 
+QUIC_INLINE
+uint64_t
+QuicConnStreamBytes(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    return
+        Connection->Stats.Send.TotalStreamBytes +
+        Connection->Stats.Recv.TotalStreamBytes;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnResetHibernateTimer(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (Connection->Settings.HibernateTimeoutMs != 0 &&
+        Connection->State.HandshakeConfirmed) {
+        Connection->HibernateCheckStreamBytes = QuicConnStreamBytes(Connection);
+        QuicConnTimerSet(
+            Connection,
+            QUIC_CONN_TIMER_HIBERNATE,
+            MS_TO_US(Connection->Settings.HibernateTimeoutMs));
+    } else {
+        QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_HIBERNATE);
+    }
+}
+
+//
+// A connection is quiescent if it has no open streams and nothing to send or
+// in flight, and no stream data was exchanged since the last check. Keep
+// alive PINGs and their ACKs don't count as activity.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnIsQuiescent(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    return
+        !QuicConnIsClosed(Connection) &&
+        Connection->LossDetection.PacketsInFlight == 0 &&
+        Connection->LossDetection.LostPackets == NULL &&
+        Connection->Send.SendFlags == 0 &&
+        CxPlatListIsEmpty(&Connection->Send.SendStreams) &&
+        Connection->Datagram.SendQueue == NULL &&
+        !QuicStreamSetHasOpenStreams(&Connection->Streams) &&
+        Connection->HibernateCheckStreamBytes == QuicConnStreamBytes(Connection);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnProcessHibernateTimerOperation(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (Connection->State.Hibernated) {
+        //
+        // Only keep alive traffic happened since the last check, but the ACKs
+        // sent for it are tracked in the sent packet store. Free it again.
+        //
+        (void)QuicLossDetectionHibernate(&Connection->LossDetection);
+        QuicConnResetHibernateTimer(Connection);
+        return;
+    }
+
+    if (!QuicConnIsQuiescent(Connection)) {
+        QuicConnResetHibernateTimer(Connection);
+        return;
+    }
+
+    //
+    // Release everything that is reallocated on demand. The congestion
+    // control, pacing and loss detection state is inline in the connection
+    // and is kept as is.
+    //
+    (void)QuicCryptoHibernate(&Connection->Crypto);
+    (void)QuicLossDetectionHibernate(&Connection->LossDetection);
+    QUIC_PACKET_SPACE* Packets = Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT];
+    if (Packets != NULL) {
+        QuicAckTrackerCompact(&Packets->AckTracker);
+    }
+    QuicStreamSetCompact(&Connection->Streams);
+
+    Connection->State.Hibernated = TRUE;
+    Connection->Stats.Misc.HibernationCount++;
+    QuicTraceLogConnInfo(
+        ConnHibernated,
+        Connection,
+        "Hibernated after %u ms idle",
+        Connection->Settings.HibernateTimeoutMs);
+
+    //
+    // Keep checking while hibernated, to free the sent packet store again
+    // after answering keep alives.
+    //
+    QuicConnResetHibernateTimer(Connection);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRehydrate(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (!Connection->State.Hibernated) {
+        return;
+    }
+
+    Connection->State.Hibernated = FALSE;
+    Connection->Stats.Misc.RehydrationCount++;
+    QuicTraceLogConnInfo(
+        ConnRehydrated,
+        Connection,
+        "Rehydrated");
+    QuicConnResetHibernateTimer(Connection);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnUpdatePeerPacketTolerance(
@@ -6208,6 +6410,102 @@ QuicConnUpdatePeerPacketTolerance(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdateAckFrequency(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint8_t MinPacketTolerance
+    )
+{
+    if (!(Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_MIN_ACK_DELAY)) {
+        return;
+    }
+
+    //
+    // The scheduling limited hint is remembered, so that later updates driven
+    // by congestion control don't drop the tolerance back below it.
+    //
+    if (MinPacketTolerance > Connection->MinPeerPacketTolerance) {
+        Connection->MinPeerPacketTolerance = MinPacketTolerance;
+    }
+    MinPacketTolerance = Connection->MinPeerPacketTolerance;
+
+    //
+    // In steady state, ask for a fixed number of ACKs per congestion window
+    // instead of one every couple of packets. For bulk transfers this cuts the
+    // ACK rate by an order of magnitude.
+    //
+    uint32_t PacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
+    if (!QuicCongestionControlNeedsFrequentAcks(&Connection->CongestionControl)) {
+        const uint16_t DatagramPayloadSize =
+            QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+        PacketTolerance =
+            QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl) /
+            ((uint32_t)DatagramPayloadSize * QUIC_ACK_FREQUENCY_ACKS_PER_CWND);
+        if (PacketTolerance > QUIC_MAX_ACK_FREQUENCY_PACKET_TOLERANCE) {
+            PacketTolerance = QUIC_MAX_ACK_FREQUENCY_PACKET_TOLERANCE;
+        } else if (PacketTolerance < QUIC_MIN_ACK_SEND_NUMBER) {
+            PacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
+        }
+    }
+    if (PacketTolerance < MinPacketTolerance) {
+        PacketTolerance = MinPacketTolerance;
+    }
+
+    //
+    // Every update costs an ACK_FREQUENCY frame, so ignore small movements of
+    // the congestion window. Apply increases of at least a quarter (or any
+    // required by the caller), and decreases to half or less (or back to the
+    // default).
+    //
+    const uint32_t Current = Connection->PeerPacketTolerance;
+    if (PacketTolerance > Current) {
+        if (MinPacketTolerance <= Current &&
+            PacketTolerance * 4 < Current * 5) {
+            return;
+        }
+    } else if (PacketTolerance < Current) {
+        if (PacketTolerance != QUIC_MIN_ACK_SEND_NUMBER &&
+            PacketTolerance * 2 > Current) {
+            return;
+        }
+    } else {
+        return;
+    }
+
+    QuicConnUpdatePeerPacketTolerance(Connection, (uint8_t)PacketTolerance);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRecordTelemetry(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow
+    )
+{
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    QUIC_CONN_TELEMETRY_SAMPLE Sample;
+    CxPlatZeroMemory(&Sample, sizeof(Sample));
+
+    Sample.TimeUs = CxPlatTimeDiff64(Connection->Stats.Timing.Start, TimeNow);
+    if (Path->GotFirstRttSample) {
+        Sample.SmoothedRttUs = Path->SmoothedRtt;
+        Sample.MinRttUs = Path->MinRtt;
+    }
+    Sample.SendTotalPackets = Connection->Stats.Send.TotalPackets;
+    Sample.SendLostPackets =
+        Connection->Stats.Send.SuspectedLostPackets -
+        Connection->Stats.Send.SpuriousLostPackets;
+
+    //
+    // The congestion control algorithm fills in the window, bytes in flight,
+    // bandwidth estimate and pacing rate.
+    //
+    QuicCongestionControlGetTelemetry(&Connection->CongestionControl, &Sample);
+
+    QuicTelemetryRecord(&Connection->Telemetry, TimeNow, &Sample);
+}
+
 #define QUIC_CONN_BAD_START_STATE(CONN) (CONN->State.Started || CONN->State.ClosedLocally)
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -6488,16 +6786,16 @@ QuicConnParamSet(
             break;
         }
 
-        Connection->State.UseRoundRobinStreamScheduling =
-            Scheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        Status = QuicSendSetStreamSchedulingScheme(&Connection->Send, Scheme);
+        if (QUIC_FAILED(Status)) {
+            break;
+        }
 
         QuicTraceLogConnInfo(
             UpdateStreamSchedulingScheme,
             Connection,
             "Updated Stream Scheduling Scheme = %u",
             (uint32_t)Scheme);
-
-        Status = QUIC_STATUS_SUCCESS;
         break;
     }
 
@@ -6714,6 +7012,26 @@ QuicConnParamSet(
         break;
     }
 
+    case QUIC_PARAM_CONN_TELEMETRY_INTERVAL: {
+        if (BufferLength != sizeof(uint32_t) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Status =
+            QuicTelemetrySetInterval(
+                &Connection->Telemetry,
+                *(uint32_t*)Buffer);
+        if (QUIC_SUCCEEDED(Status)) {
+            QuicTraceLogConnInfo(
+                ConnTelemetryIntervalSet,
+                Connection,
+                "Telemetry interval set to %u ms",
+                Connection->Telemetry.IntervalMs);
+        }
+        break;
+    }
+
     //
     // Private
     //
@@ -6928,6 +7246,19 @@ QuicConnGetV2Statistics(
     if (STATISTICS_HAS_FIELD(*StatsLength, RttVariance)) {
         Stats->RttVariance = (uint32_t)Path->RttVariance;
     }
+    if (STATISTICS_HAS_FIELD(*StatsLength, MigrationCount)) {
+        Stats->MigrationCount = Connection->Stats.Misc.MigrationCount;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, MigrationCachedCcCount)) {
+        Stats->MigrationCachedCcCount = Connection->Stats.Misc.MigrationCachedCcCount;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, LastPathValidationTimeUs)) {
+        Stats->LastPathValidationTimeUs = Connection->Stats.Misc.LastPathValidationTimeUs;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, RehydrationCount)) {
+        Stats->HibernationCount = Connection->Stats.Misc.HibernationCount;
+        Stats->RehydrationCount = Connection->Stats.Misc.RehydrationCount;
+    }
 
     *StatsLength = CXPLAT_MIN(*StatsLength, sizeof(QUIC_STATISTICS_V2));
 
@@ -7224,8 +7555,7 @@ QuicConnParamGet(
 
         *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
         *(QUIC_STREAM_SCHEDULING_SCHEME*)Buffer =
-            Connection->State.UseRoundRobinStreamScheduling ?
-                QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN : QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
+            (QUIC_STREAM_SCHEDULING_SCHEME)Connection->Send.SchedulingScheme;
 
         Status = QUIC_STATUS_SUCCESS;
         break;
@@ -7352,6 +7682,71 @@ QuicConnParamGet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_CONN_TELEMETRY_INTERVAL:
+
+        if (*BufferLength < sizeof(uint32_t)) {
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            *BufferLength = sizeof(uint32_t);
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint32_t);
+        *(uint32_t*)Buffer = Connection->Telemetry.IntervalMs;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_TELEMETRY:
+        Status =
+            QuicTelemetryRead(
+                &Connection->Telemetry,
+                BufferLength,
+                Buffer);
+        break;
+
+    case QUIC_PARAM_CONN_ARENA_STATISTICS:
+
+        if (*BufferLength < sizeof(QUIC_CONN_ARENA_STATISTICS)) {
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            *BufferLength = sizeof(QUIC_CONN_ARENA_STATISTICS);
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_CONN_ARENA_STATISTICS);
+        QuicArenaGetStatistics(&Connection->Arena, (QUIC_CONN_ARENA_STATISTICS*)Buffer);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_SENT_PACKET_STORE_CAPACITY:
+
+        if (*BufferLength < sizeof(uint32_t)) {
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            *BufferLength = sizeof(uint32_t);
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint32_t);
+        *(uint32_t*)Buffer = Connection->LossDetection.SentPackets.Capacity;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -7513,6 +7908,11 @@ QuicConnApplyNewSettings(
         }
     }
 
+    if (NewSettings->IsSet.HibernateTimeoutMs && Connection->State.Started) {
+        QuicConnRehydrate(Connection);
+        QuicConnResetHibernateTimer(Connection);
+    }
+
     if (OverWrite) {
         QuicSettingsDumpNew(NewSettings);
     } else {
@@ -7618,6 +8018,12 @@ QuicConnProcessApiOperation(
             ApiCtx->STRM_SEND.Stream);
         break;
 
+    case QUIC_API_TYPE_STRM_SEND_BATCH:
+        for (uint32_t i = 0; i < ApiCtx->STRM_SEND_BATCH.StreamCount; ++i) {
+            QuicStreamSendFlush(ApiCtx->STRM_SEND_BATCH.Streams[i]);
+        }
+        break;
+
     case QUIC_API_TYPE_STRM_RECV_COMPLETE:
         QuicStreamReceiveCompletePending(
             ApiCtx->STRM_RECV_COMPLETE.Stream);
@@ -7702,6 +8108,9 @@ QuicConnProcessExpiredTimer(
     case QUIC_CONN_TIMER_KEEP_ALIVE:
         QuicConnProcessKeepAliveOperation(Connection);
         break;
+    case QUIC_CONN_TIMER_HIBERNATE:
+        QuicConnProcessHibernateTimerOperation(Connection);
+        break;
     case QUIC_CONN_TIMER_SHUTDOWN:
         QuicConnProcessShutdownTimerOperation(Connection);
         break;
@@ -7722,6 +8131,7 @@ QuicConnDrainOperations(
     const uint32_t MaxOperationCount =
         Connection->Settings.MaxOperationsPerDrain;
     uint32_t OperationCount = 0;
+    const uint64_t CompletedOperationCount = Connection->Stats.Schedule.OperationCount;
     BOOLEAN HasMoreWorkToDo = TRUE;
 
     CXPLAT_PASSIVE_CODE();
@@ -7763,10 +8173,25 @@ QuicConnDrainOperations(
 
         BOOLEAN FreeOper = Oper->FreeAfterProcess;
 
+        //
+        // Time a sample of the operations for the profiler. The type is
+        // captured up front because the operation may be freed or requeued.
+        //
+        const BOOLEAN Profile =
+            QuicProfileShouldSample(Connection->Stats.Schedule.OperationCount);
+        const QUIC_OPERATION_TYPE OperType = Oper->Type;
+        const QUIC_API_TYPE ApiType =
+            OperType == QUIC_OPER_TYPE_API_CALL ?
+                Oper->API_CALL.Context->Type : QUIC_API_TYPE_CONN_CLOSE;
+        const uint64_t ProfileStart = Profile ? CxPlatCycleCount() : 0;
+
         switch (Oper->Type) {
 
         case QUIC_OPER_TYPE_API_CALL:
             CXPLAT_DBG_ASSERT(Oper->API_CALL.Context != NULL);
+            if (Oper->API_CALL.Context->Type != QUIC_API_TYPE_GET_PARAM) {
+                QuicConnRehydrate(Connection);
+            }
             QuicConnProcessApiOperation(
                 Connection,
                 Oper->API_CALL.Context);
@@ -7847,6 +8272,14 @@ QuicConnDrainOperations(
 
         QuicConnValidate(Connection);
 
+        if (Profile) {
+            const uint64_t Cycles = CxPlatCycleCount() - ProfileStart;
+            QuicProfileRecord(&Connection->Partition->Profile.Operations[OperType], Cycles);
+            if (OperType == QUIC_OPER_TYPE_API_CALL) {
+                QuicProfileRecord(&Connection->Partition->Profile.ApiCalls[ApiType], Cycles);
+            }
+        }
+
         if (FreeOper) {
             QuicOperationFree(Oper);
         }
@@ -7855,6 +8288,11 @@ QuicConnDrainOperations(
         QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_OPER_COMPLETED);
     }
 
+    QuicPerfHistogramRecord(
+        Connection->Partition,
+        QUIC_PERF_HISTOGRAM_DRAIN_BATCH_SIZE,
+        Connection->Stats.Schedule.OperationCount - CompletedOperationCount);
+
     if (Connection->State.ProcessShutdownComplete) {
         QuicConnOnShutdownComplete(Connection);
     }
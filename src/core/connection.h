@@ -8,6 +8,10 @@
 #include "connection.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_LISTENER QUIC_LISTENER;
 
 //
@@ -133,12 +137,6 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN TestTransportParameterSet : 1;
 
-        //
-        // Indicates the connection is using the round robin stream scheduling
-        // scheme.
-        //
-        BOOLEAN UseRoundRobinStreamScheduling : 1;
-
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -194,6 +192,12 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN DelayedApplicationError : 1;
 
+        //
+        // The connection has been quiescent for HibernateTimeoutMs and has
+        // released its buffers. They are reallocated as they are next needed.
+        //
+        BOOLEAN Hibernated : 1;
+
 #ifdef CxPlatVerifierEnabledByAddr
         //
         // The calling app is being verified (app or driver verifier).
@@ -302,6 +306,11 @@ typedef struct QUIC_CONN_STATS {
     struct {
         uint32_t KeyUpdateCount;        // Count of key updates completed.
         uint32_t DestCidUpdateCount;    // Number of times the destination CID changed.
+        uint32_t MigrationCount;        // Number of times the active path changed IP address.
+        uint32_t MigrationCachedCcCount;// Migrations that resumed cached congestion control state.
+        uint64_t LastPathValidationTimeUs; // Duration of the last successful path validation.
+        uint32_t HibernationCount;      // Number of times the connection hibernated.
+        uint32_t RehydrationCount;      // Number of times the connection woke from hibernation.
     } Misc;
 
 } QUIC_CONN_STATS;
@@ -454,6 +463,13 @@ typedef struct QUIC_CONNECTION {
     //
     uint8_t PeerPacketTolerance;
 
+    //
+    // The smallest packet tolerance we will ask the peer to use, from the
+    // largest batch the send path has been scheduling limited at. Only reset on
+    // persistent congestion.
+    //
+    uint8_t MinPeerPacketTolerance;
+
     //
     // The maximum number of packets that can be out of order before an immediate
     // acknowledgment (ACK) is triggered. If no specific instructions (ACK_FREQUENCY
@@ -503,6 +519,12 @@ typedef struct QUIC_CONNECTION {
     //
     QUIC_PATH Paths[QUIC_MAX_PATH_COUNT];
 
+    //
+    // Congestion control state of previously active paths, looked up by the
+    // path's addresses.
+    //
+    QUIC_PATH_CC_CACHE PathCcCache[QUIC_MAX_PATH_COUNT];
+
     //
     // The list of connection IDs used for receiving.
     //
@@ -650,6 +672,23 @@ typedef struct QUIC_CONNECTION {
     //
     QUIC_CONN_STATS Stats;
 
+    //
+    // Periodic samples of transport state, when enabled by the app.
+    //
+    QUIC_TELEMETRY Telemetry;
+
+    //
+    // Backs small connection-lifetime allocations, such as the peer's CIDs,
+    // when enabled with QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE.
+    //
+    QUIC_ARENA Arena;
+
+    //
+    // Sum of the stream bytes sent and received when the hibernate timer was
+    // last armed, used to tell whether the connection was idle since then.
+    //
+    uint64_t HibernateCheckStreamBytes;
+
     //
     // Mostly test specific state.
     //
@@ -1605,6 +1644,25 @@ QuicConnResetIdleTimeout(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Arms (or, if hibernation is disabled, cancels) the hibernate timer.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnResetHibernateTimer(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Called on any activity on a hibernated connection. The buffers released by
+// hibernation are reallocated lazily by their owners.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRehydrate(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 //
 // Queues a received packet chain to a connection for processing.
 //
@@ -1652,6 +1710,28 @@ QuicConnUpdatePeerPacketTolerance(
     _In_ uint8_t NewPacketTolerance
     );
 
+//
+// Recalculates the packet tolerance we want the peer to use from the current
+// congestion control state, and queues up an update if it changed enough.
+// MinPacketTolerance raises the floor the tolerance is kept at from then on.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdateAckFrequency(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint8_t MinPacketTolerance
+    );
+
+//
+// Takes a sample of the connection's transport state for the telemetry ring.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRecordTelemetry(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow
+    );
+
 //
 // Sets a connection parameter.
 //
@@ -1739,3 +1819,7 @@ QuicMtuDiscoveryCheckSearchCompleteTimeout(
         }
     }
 }
+
+#if defined(__cplusplus)
+}
+#endif
@@ -257,8 +257,10 @@ QuicCryptoUninitialize(
     if (Crypto->Initialized) {
         QuicRecvBufferUninitialize(&Crypto->RecvBuffer);
         QuicRangeUninitialize(&Crypto->SparseAckRanges);
-        CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
-        Crypto->TlsState.Buffer = NULL;
+        if (Crypto->TlsState.Buffer != NULL) {
+            CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
+            Crypto->TlsState.Buffer = NULL;
+        }
         Crypto->Initialized = FALSE;
     }
 }
@@ -499,6 +501,58 @@ QuicCryptoHandshakeConfirmed(
     }
 
     QuicCryptoDiscardKeys(Crypto, QUIC_PACKET_KEY_HANDSHAKE);
+    QuicConnResetHibernateTimer(Connection);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicCryptoHibernate(
+    _In_ QUIC_CRYPTO* Crypto
+    )
+{
+    if (!Crypto->Initialized || Crypto->Hibernated ||
+        !QuicCryptoGetConnection(Crypto)->State.HandshakeConfirmed ||
+        Crypto->TlsState.BufferLength != 0 ||
+        Crypto->UnAckedOffset != Crypto->TlsState.BufferTotalLength ||
+        !QuicRecvBufferHibernate(&Crypto->RecvBuffer)) {
+        return FALSE;
+    }
+
+    CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
+    Crypto->TlsState.Buffer = NULL;
+    Crypto->Hibernated = TRUE;
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicCryptoRehydrate(
+    _In_ QUIC_CRYPTO* Crypto
+    )
+{
+    if (!Crypto->Hibernated) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    QUIC_STATUS Status = QuicRecvBufferRehydrate(&Crypto->RecvBuffer);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    Crypto->TlsState.Buffer =
+        CXPLAT_ALLOC_NONPAGED(Crypto->TlsState.BufferAllocLength, QUIC_POOL_TLS_BUFFER);
+    if (Crypto->TlsState.Buffer == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "crypto send buffer",
+            Crypto->TlsState.BufferAllocLength);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    Crypto->Hibernated = FALSE;
+    return QUIC_STATUS_SUCCESS;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1288,6 +1342,11 @@ QuicCryptoProcessDataFrame(
             EncLevelOffset = Crypto->RecvEncryptLevelStartOffset;
         }
 
+        Status = QuicCryptoRehydrate(Crypto);
+        if (QUIC_FAILED(Status)) {
+            goto Error;
+        }
+
         //
         // Write the received data (could be duplicate) to the stream buffer. The
         // stream buffer will indicate if there is data to process.
@@ -1643,6 +1702,10 @@ QuicCryptoProcessTlsCompletion(
         //
         Connection->State.Connected = TRUE;
         QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_CONNECTED);
+        QuicPerfHistogramRecord(
+            Connection->Partition,
+            QUIC_PERF_HISTOGRAM_HANDSHAKE_TIME,
+            CxPlatTimeDiff64(Connection->Stats.Timing.Start, CxPlatTimeUs64()));
 
         QuicConnGenerateNewSourceCids(Connection, FALSE);
 
@@ -1984,7 +2047,10 @@ QuicCryptoProcessAppData(
         const uint8_t* AppData
     )
 {
-    QUIC_STATUS Status;
+    QUIC_STATUS Status = QuicCryptoRehydrate(Crypto);
+    if (QUIC_FAILED(Status)) {
+        goto Error;
+    }
 
     Crypto->ResultFlags =
         CxPlatTlsProcessData(
@@ -39,6 +39,12 @@ typedef struct QUIC_CRYPTO {
     //
     BOOLEAN CertValidationPending : 1;
 
+    //
+    // Indicates the send and receive buffers were freed while the connection
+    // was idle. They are allocated again before the next use.
+    //
+    BOOLEAN Hibernated : 1;
+
     //
     // The TLS context for processing handshake messages.
     //
@@ -191,6 +197,26 @@ QuicCryptoDiscardKeys(
     _In_ QUIC_PACKET_KEY_TYPE KeyType
     );
 
+//
+// Frees the TLS send buffer and the receive buffer once the handshake is
+// confirmed and all crypto data has been acknowledged and processed. Returns
+// TRUE if they were freed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicCryptoHibernate(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
+//
+// Allocates the buffers freed by QuicCryptoHibernate again, if needed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicCryptoRehydrate(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
 //
 // Returns the next encryption level with data ready to be sent.
 //
@@ -174,6 +174,56 @@ CubicCongestionControlReset(
     QuicConnLogCubic(Connection);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CubicCongestionControlResume(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t CongestionWindow
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+
+    CubicCongestionControlReset(Cc, FALSE);
+
+    //
+    // Start slow start from half the window last used on the path. It's
+    // known to have been safe recently, and halving it leaves room for the
+    // path to have gotten worse in the meantime.
+    //
+    if (CongestionWindow / 2 > Cubic->CongestionWindow) {
+        Cubic->CongestionWindow = CongestionWindow / 2;
+        Cubic->BytesInFlightMax = Cubic->CongestionWindow / 2;
+        QuicConnLogOutFlowStats(QuicCongestionControlGetConnection(Cc));
+    }
+}
+
+//
+// Since the window grows via ACK feedback and since we defer packets when
+// pacing, using the current window to calculate the pacing interval can slow
+// the growth of the window. So instead, use the predicted window of the next
+// round trip. In slowstart, this is double the current window. In congestion
+// avoidance the growth function is more complicated, and we use a simple
+// estimate of 25% growth.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+uint64_t
+CubicCongestionControlGetPacingWindow(
+    _In_ const QUIC_CONGESTION_CONTROL_CUBIC* Cubic
+    )
+{
+    uint64_t EstimatedWnd;
+    if (Cubic->CongestionWindow < Cubic->SlowStartThreshold) {
+        EstimatedWnd = (uint64_t)Cubic->CongestionWindow << 1;
+        if (EstimatedWnd > Cubic->SlowStartThreshold) {
+            EstimatedWnd = Cubic->SlowStartThreshold;
+        }
+    } else {
+        EstimatedWnd = Cubic->CongestionWindow + (Cubic->CongestionWindow >> 2); // CongestionWindow * 1.25
+    }
+    return EstimatedWnd;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint32_t
 CubicCongestionControlGetSendAllowance(
@@ -210,23 +260,7 @@ CubicCongestionControlGetSendAllowance(
         // size) as the time since the last send times the pacing rate (CWND / RTT).
         //
 
-        //
-        // Since the window grows via ACK feedback and since we defer packets
-        // when pacing, using the current window to calculate the pacing
-        // interval can slow the growth of the window. So instead, use the
-        // predicted window of the next round trip. In slowstart, this is double
-        // the current window. In congestion avoidance the growth function is
-        // more complicated, and we use a simple estimate of 25% growth.
-        //
-        uint64_t EstimatedWnd;
-        if (Cubic->CongestionWindow < Cubic->SlowStartThreshold) {
-            EstimatedWnd = (uint64_t)Cubic->CongestionWindow << 1;
-            if (EstimatedWnd > Cubic->SlowStartThreshold) {
-                EstimatedWnd = Cubic->SlowStartThreshold;
-            }
-        } else {
-            EstimatedWnd = Cubic->CongestionWindow + (Cubic->CongestionWindow >> 2); // CongestionWindow * 1.25
-        }
+        const uint64_t EstimatedWnd = CubicCongestionControlGetPacingWindow(Cubic);
 
         SendAllowance =
             Cubic->LastSendAllowance +
@@ -851,6 +885,18 @@ CubicCongestionControlGetCongestionWindow(
     return Cc->Cubic.CongestionWindow;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CubicCongestionControlNeedsFrequentAcks(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+    return
+        Cubic->IsInRecovery ||
+        Cubic->CongestionWindow < Cubic->SlowStartThreshold;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 CubicCongestionControlIsAppLimited(
@@ -870,11 +916,41 @@ CubicCongestionControlSetAppLimited(
     UNREFERENCED_PARAMETER(Cc);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CubicCongestionControlGetTelemetry(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc,
+    _Inout_ QUIC_CONN_TELEMETRY_SAMPLE* Sample
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+
+    Sample->CongestionWindow = Cubic->CongestionWindow;
+    Sample->BytesInFlight = Cubic->BytesInFlight;
+
+    if (Path->GotFirstRttSample && Path->SmoothedRtt != 0) {
+        //
+        // Cubic has no bandwidth model of its own; a window per RTT is the
+        // rate it allows.
+        //
+        Sample->BandwidthEstimate =
+            S_TO_US((uint64_t)Cubic->CongestionWindow) / Path->SmoothedRtt;
+        if (Connection->Settings.PacingEnabled &&
+            Path->SmoothedRtt >= QUIC_MIN_PACING_RTT) {
+            Sample->PacingRate =
+                S_TO_US(CubicCongestionControlGetPacingWindow(Cubic)) / Path->SmoothedRtt;
+        }
+    }
+}
+
 static const QUIC_CONGESTION_CONTROL QuicCongestionControlCubic = {
     .Name = "Cubic",
     .QuicCongestionControlCanSend = CubicCongestionControlCanSend,
     .QuicCongestionControlSetExemption = CubicCongestionControlSetExemption,
     .QuicCongestionControlReset = CubicCongestionControlReset,
+    .QuicCongestionControlResume = CubicCongestionControlResume,
     .QuicCongestionControlGetSendAllowance = CubicCongestionControlGetSendAllowance,
     .QuicCongestionControlOnDataSent = CubicCongestionControlOnDataSent,
     .QuicCongestionControlOnDataInvalidated = CubicCongestionControlOnDataInvalidated,
@@ -889,6 +965,8 @@ static const QUIC_CONGESTION_CONTROL QuicCongestionControlCubic = {
     .QuicCongestionControlSetAppLimited = CubicCongestionControlSetAppLimited,
     .QuicCongestionControlGetCongestionWindow = CubicCongestionControlGetCongestionWindow,
     .QuicCongestionControlLogPacketSent = NULL, // Cubic doesn't need per-packet logging
+    .QuicCongestionControlNeedsFrequentAcks = CubicCongestionControlNeedsFrequentAcks,
+    .QuicCongestionControlGetTelemetry = CubicCongestionControlGetTelemetry,
 };
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -47,11 +47,19 @@ QuicDatagramValidate(
     if (!Datagram->SendEnabled) {
         CXPLAT_DBG_ASSERT(Datagram->MaxSendLength == 0);
     } else {
+        uint32_t KeyedCount = 0;
         QUIC_SEND_REQUEST* SendRequest = Datagram->SendQueue;
         while (SendRequest) {
             CXPLAT_DBG_ASSERT(SendRequest->TotalLength <= (uint64_t)Datagram->MaxSendLength);
+            CXPLAT_DBG_ASSERT(
+                SendRequest->Next == NULL ||
+                SendRequest->DatagramPriority >= SendRequest->Next->DatagramPriority);
+            if (SendRequest->DatagramKey != 0) {
+                KeyedCount++;
+            }
             SendRequest = SendRequest->Next;
         }
+        CXPLAT_DBG_ASSERT(KeyedCount == Datagram->SendQueueKeyedCount);
     }
 }
 #else
@@ -79,8 +87,8 @@ QuicDatagramInitialize(
 {
     Datagram->SendEnabled = TRUE;
     Datagram->MaxSendLength = UINT16_MAX;
-    Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
     Datagram->SendQueueTail = &Datagram->SendQueue;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockInitialize(&Datagram->ApiQueueLock);
     QuicDatagramValidate(Datagram);
 }
@@ -171,6 +179,7 @@ QuicDatagramSendShutdown(
     Datagram->MaxSendLength = 0;
     QUIC_SEND_REQUEST* ApiQueue = Datagram->ApiQueue;
     Datagram->ApiQueue = NULL;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
 
     QuicSendClearSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_DATAGRAM);
@@ -183,8 +192,8 @@ QuicDatagramSendShutdown(
         Datagram->SendQueue = SendRequest->Next;
         QuicDatagramCancelSend(Connection, SendRequest);
     }
-    Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
     Datagram->SendQueueTail = &Datagram->SendQueue;
+    Datagram->SendQueueKeyedCount = 0;
 
     while (ApiQueue != NULL) {
         QUIC_SEND_REQUEST* SendRequest = ApiQueue;
@@ -210,10 +219,10 @@ QuicDatagramOnMaxSendLengthChanged(
     while (*SendQueue != NULL) {
         if ((*SendQueue)->TotalLength > (uint64_t)Datagram->MaxSendLength) {
             QUIC_SEND_REQUEST* SendRequest = *SendQueue;
-            if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-                Datagram->PrioritySendQueueTail = SendQueue;
-            }
             *SendQueue = SendRequest->Next;
+            if (SendRequest->DatagramKey != 0) {
+                Datagram->SendQueueKeyedCount--;
+            }
             QuicDatagramCancelSend(Connection, SendRequest);
         } else {
             SendQueue = &((*SendQueue)->Next);
@@ -326,10 +335,26 @@ QuicDatagramQueueSend(
     )
 {
     QUIC_STATUS Status;
-    BOOLEAN QueueOper = TRUE;
-    const BOOLEAN IsPriority = !!(SendRequest->Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
+    BOOLEAN QueueOper = FALSE;
+    BOOLEAN IsPriority = FALSE;
+    uint64_t MaxLength = 0;
+    QUIC_SEND_REQUEST* Last = SendRequest;
     QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
 
+    //
+    // Everything about the chain that doesn't depend on the connection's state
+    // is gathered before taking the lock.
+    //
+    for (QUIC_SEND_REQUEST* Request = SendRequest; Request != NULL; Request = Request->Next) {
+        if (Request->Flags & QUIC_SEND_FLAG_PRIORITY_WORK) {
+            IsPriority = TRUE;
+        }
+        if (Request->TotalLength > MaxLength) {
+            MaxLength = Request->TotalLength;
+        }
+        Last = Request;
+    }
+
     CxPlatDispatchLockAcquire(&Datagram->ApiQueueLock);
     if (!Datagram->SendEnabled) {
         QuicTraceEvent(
@@ -339,7 +364,7 @@ QuicDatagramQueueSend(
             "Datagram send while disabled");
         Status = QUIC_STATUS_INVALID_STATE;
     } else {
-        if (SendRequest->TotalLength > (uint64_t)Datagram->MaxSendLength) {
+        if (MaxLength > (uint64_t)Datagram->MaxSendLength) {
             QuicTraceEvent(
                 ConnError,
                 "[conn][%p] ERROR, %s.",
@@ -347,19 +372,24 @@ QuicDatagramQueueSend(
                 "Datagram send request is longer than allowed");
             Status = QUIC_STATUS_INVALID_PARAMETER;
         } else {
-            QUIC_SEND_REQUEST** ApiQueueTail = &Datagram->ApiQueue;
-            while (*ApiQueueTail != NULL) {
-                ApiQueueTail = &((*ApiQueueTail)->Next);
-                QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
-            }
-            *ApiQueueTail = SendRequest;
+            //
+            // The operation is only necessary if the previous sends have
+            // already been flushed.
+            //
+            QueueOper = Datagram->ApiQueue == NULL;
+            *Datagram->ApiQueueTail = SendRequest;
+            Datagram->ApiQueueTail = &Last->Next;
             Status = QUIC_STATUS_SUCCESS;
         }
     }
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
 
     if (QUIC_FAILED(Status)) {
-        CxPlatPoolFree(SendRequest);
+        while (SendRequest != NULL) {
+            QUIC_SEND_REQUEST* Next = SendRequest->Next;
+            CxPlatPoolFree(SendRequest);
+            SendRequest = Next;
+        }
         goto Exit;
     }
 
@@ -400,6 +430,100 @@ Exit:
     return Status;
 }
 
+//
+// Inserts the request into the send queue after all the requests with the same
+// or a higher priority.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramInsertQueued(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ QUIC_SEND_REQUEST* SendRequest
+    )
+{
+    QUIC_SEND_REQUEST** Link = Datagram->SendQueueTail;
+    if (Link != &Datagram->SendQueue &&
+        CXPLAT_CONTAINING_RECORD(Link, QUIC_SEND_REQUEST, Next)->DatagramPriority <
+            SendRequest->DatagramPriority) {
+        //
+        // Usually everything has the same priority and the request goes at the
+        // tail. Otherwise, find the end of its priority level.
+        //
+        Link = &Datagram->SendQueue;
+        while ((*Link)->DatagramPriority >= SendRequest->DatagramPriority) {
+            Link = &((*Link)->Next);
+        }
+    }
+
+    SendRequest->Next = *Link;
+    *Link = SendRequest;
+    if (SendRequest->Next == NULL) {
+        Datagram->SendQueueTail = &SendRequest->Next;
+    }
+    if (SendRequest->DatagramKey != 0) {
+        Datagram->SendQueueKeyedCount++;
+    }
+}
+
+//
+// Cancels the queued request with the same key as SendRequest, if there is one.
+// Returns TRUE if SendRequest took its place in the queue, which it does when
+// they have the same priority, so the update isn't delayed behind datagrams
+// queued after the one it replaces. The search ends at the last keyed request,
+// so it costs nothing while no keyed datagrams are queued.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicDatagramReplaceQueued(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ QUIC_SEND_REQUEST* SendRequest
+    )
+{
+    uint32_t KeyedRemaining = Datagram->SendQueueKeyedCount;
+    QUIC_SEND_REQUEST** Link = &Datagram->SendQueue;
+    while (KeyedRemaining != 0) {
+        CXPLAT_DBG_ASSERT(*Link != NULL);
+        if ((*Link)->DatagramKey == SendRequest->DatagramKey) {
+            break;
+        }
+        if ((*Link)->DatagramKey != 0) {
+            KeyedRemaining--;
+        }
+        Link = &((*Link)->Next);
+    }
+    if (KeyedRemaining == 0) {
+        return FALSE;
+    }
+
+    QUIC_SEND_REQUEST* OldRequest = *Link;
+    BOOLEAN Replaced = OldRequest->DatagramPriority == SendRequest->DatagramPriority;
+    if (Replaced) {
+        SendRequest->Next = OldRequest->Next;
+        *Link = SendRequest;
+        if (Datagram->SendQueueTail == &OldRequest->Next) {
+            Datagram->SendQueueTail = &SendRequest->Next;
+        }
+    } else {
+        *Link = OldRequest->Next;
+        if (Datagram->SendQueueTail == &OldRequest->Next) {
+            Datagram->SendQueueTail = Link;
+        }
+        Datagram->SendQueueKeyedCount--;
+    }
+
+    QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+    QuicTraceLogConnVerbose(
+        DatagramSendReplaced,
+        Connection,
+        "Datagram [%p] replaced by [%p] (key %u)",
+        OldRequest,
+        SendRequest,
+        SendRequest->DatagramKey);
+    QuicDatagramCancelSend(Connection, OldRequest);
+
+    return Replaced;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicDatagramSendFlush(
@@ -409,6 +533,7 @@ QuicDatagramSendFlush(
     CxPlatDispatchLockAcquire(&Datagram->ApiQueueLock);
     QUIC_SEND_REQUEST* ApiQueue = Datagram->ApiQueue;
     Datagram->ApiQueue = NULL;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
     uint64_t TotalBytesSent = 0;
 
@@ -432,16 +557,9 @@ QuicDatagramSendFlush(
         }
         TotalBytesSent += SendRequest->TotalLength;
 
-        if (SendRequest->Flags & QUIC_SEND_FLAG_DGRAM_PRIORITY) {
-            SendRequest->Next = *Datagram->PrioritySendQueueTail;
-            *Datagram->PrioritySendQueueTail = SendRequest;
-            if (Datagram->SendQueueTail == Datagram->PrioritySendQueueTail) {
-                Datagram->SendQueueTail = &SendRequest->Next;
-            }
-            Datagram->PrioritySendQueueTail = &SendRequest->Next;
-        } else {
-            *Datagram->SendQueueTail = SendRequest;
-            Datagram->SendQueueTail = &SendRequest->Next;
+        if (SendRequest->DatagramKey == 0 ||
+            !QuicDatagramReplaceQueued(Datagram, SendRequest)) {
+            QuicDatagramInsertQueued(Datagram, SendRequest);
         }
 
         QuicTraceLogConnVerbose(
@@ -516,13 +634,13 @@ QuicDatagramWriteFrame(
             goto Exit;
         }
 
-        if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-            Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
-        }
         if (Datagram->SendQueueTail == &SendRequest->Next) {
             Datagram->SendQueueTail = &Datagram->SendQueue;
         }
         Datagram->SendQueue = SendRequest->Next;
+        if (SendRequest->DatagramKey != 0) {
+            Datagram->SendQueueKeyedCount--;
+        }
 
         Builder->Metadata->Flags.IsAckEliciting = TRUE;
         Builder->Metadata->Frames[Builder->Metadata->FrameCount].Type = QUIC_FRAME_DATAGRAM;
@@ -611,10 +729,10 @@ QuicDatagramCancelBlocked(
     do {
         if ((*SendQueue)->Flags & QUIC_SEND_FLAG_CANCEL_ON_BLOCKED) {
             QUIC_SEND_REQUEST* SendRequest = *SendQueue;
-            if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-                Datagram->PrioritySendQueueTail = SendQueue;
-            }
             *SendQueue = SendRequest->Next;
+            if (SendRequest->DatagramKey != 0) {
+                Datagram->SendQueueKeyedCount--;
+            }
             QuicDatagramCancelSend(Connection, SendRequest);
         } else {
             SendQueue = &((*SendQueue)->Next);
@@ -8,18 +8,25 @@
 typedef struct QUIC_DATAGRAM {
 
     //
-    // Datagram send queue.
+    // Datagram send queue, ordered by DatagramPriority (highest first) and
+    // then by the order they were queued.
     //
     QUIC_SEND_REQUEST* SendQueue;
-    QUIC_SEND_REQUEST** PrioritySendQueueTail;
     QUIC_SEND_REQUEST** SendQueueTail;
 
+    //
+    // The number of requests in the send queue with a replacement key. Bounds
+    // the search for the request a keyed datagram replaces.
+    //
+    uint32_t SendQueueKeyedCount;
+
     //
     // API calls to DatagramSend queue the send request here and then queue the
     // send operation. That operation moves the send request onto the
     // send queue.
     //
     QUIC_SEND_REQUEST* ApiQueue;
+    QUIC_SEND_REQUEST** ApiQueueTail;
     CXPLAT_DISPATCH_LOCK ApiQueueLock;
 
     //
@@ -40,6 +47,12 @@ typedef struct QUIC_DATAGRAM {
 
 } QUIC_DATAGRAM;
 
+//
+// The priority of datagrams sent with QUIC_SEND_FLAG_DGRAM_PRIORITY, which is
+// above every level an app can set explicitly.
+//
+#define QUIC_DATAGRAM_PRIORITY_FLAGGED  ((uint16_t)UINT8_MAX + 1)
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicDatagramInitialize(
@@ -64,6 +77,10 @@ QuicDatagramOnSendStateChanged(
     _In_ QUIC_DATAGRAM* Datagram
     );
 
+//
+// Queues SendRequest, and any requests chained to it by Next, to be sent. The
+// whole chain is queued or, on failure, freed.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QuicDatagramQueueSend(
@@ -133,6 +133,18 @@ QuicAckBlockDecode(
     _Out_ QUIC_ACK_BLOCK_EX* Block
     )
 {
+    //
+    // Fast path: with small gaps and blocks (the common case) both values are
+    // single byte varints, which can be checked and decoded together.
+    //
+    if (BufferLength >= *Offset + 2 &&
+        (Buffer[*Offset] | Buffer[*Offset + 1]) < 0x40) {
+        Block->Gap = Buffer[*Offset];
+        Block->AckBlock = Buffer[*Offset + 1];
+        *Offset += 2;
+        return TRUE;
+    }
+
     if (!QuicVarIntDecode(BufferLength, Buffer, Offset, &Block->Gap) ||
         !QuicVarIntDecode(BufferLength, Buffer, Offset, &Block->AckBlock)) {
         return FALSE;
@@ -281,6 +293,7 @@ QuicAckFrameDecode(
 {
     *InvalidFrame = FALSE;
     CXPLAT_DBG_ASSERT(AckRanges->SubRanges); // Should be pre-initialized.
+    CXPLAT_DBG_ASSERT(QuicRangeSize(AckRanges) == 0); // Should be empty.
 
     //
     // Decode the ACK frame header.
@@ -291,32 +304,31 @@ QuicAckFrameDecode(
         return FALSE;
     }
 
+    if (Frame.AdditionalAckBlockCount >= QUIC_MAX_NUMBER_ACK_BLOCKS) {
+        *InvalidFrame = TRUE;
+        return FALSE;
+    }
+
     //
-    // Insert the largest/first block into the range.
+    // The blocks are encoded from largest to smallest, and the validation
+    // below guarantees each one is strictly less than, and not adjacent to, the
+    // one before it. So they are appended as-is, without the search or memmove
+    // an ordered insert would need, and then flipped to ascending order once
+    // all of them have been decoded.
     //
 
     uint64_t Largest = Frame.LargestAcknowledged;
     uint64_t Count = Frame.FirstAckBlock + 1;
 
-    BOOLEAN DontCare;
-    if (!QuicRangeAddRange(AckRanges, Largest + 1 - Count, Count, &DontCare)) {
+    if (!QuicRangeAddDescending(AckRanges, Largest + 1 - Count, Count)) {
         return FALSE;
     }
 
-    if (Frame.AdditionalAckBlockCount >= QUIC_MAX_NUMBER_ACK_BLOCKS) {
-        *InvalidFrame = TRUE;
-        return FALSE;
-    }
-
-    //
-    // Insert all the rest of the blocks (if any) into the range.
-    //
-
     for (uint32_t i = 0; i < (uint32_t)Frame.AdditionalAckBlockCount; i++) {
 
         if (Count > Largest) {
             *InvalidFrame = TRUE;
-            return FALSE;
+            goto Error;
         }
 
         Largest -= Count;
@@ -324,29 +336,32 @@ QuicAckFrameDecode(
         QUIC_ACK_BLOCK_EX Block;
         if (!QuicAckBlockDecode(BufferLength, Buffer, Offset, &Block)) {
             *InvalidFrame = TRUE;
-            return FALSE;
+            goto Error;
         }
 
         if (Block.Gap + 1 > Largest) {
             *InvalidFrame = TRUE;
-            return FALSE;
+            goto Error;
         }
 
         Largest -= (Block.Gap + 1);
         Count = Block.AckBlock + 1;
 
-        //
-        // N.B. The efficiency here isn't great because we are always inserting
-        // values less than the current minimum, which requires a complete
-        // memmove of the current array. A circular buffer that allows both
-        // forward and backward growth would fix this.
-        //
+        if (Count > Largest + 1) {
+            //
+            // The block extends below zero.
+            //
+            *InvalidFrame = TRUE;
+            goto Error;
+        }
 
-        if (!QuicRangeAddRange(AckRanges, Largest - Count + 1, Count, &DontCare)) {
-            return FALSE;
+        if (!QuicRangeAddDescending(AckRanges, Largest - Count + 1, Count)) {
+            goto Error;
         }
     }
 
+    QuicRangeCompleteDescending(AckRanges);
+
     *AckDelay = Frame.AckDelay;
 
     if (FrameType == QUIC_FRAME_ACK_1) {
@@ -359,6 +374,14 @@ QuicAckFrameDecode(
     }
 
     return TRUE;
+
+Error:
+
+    //
+    // Don't leave a partially decoded (descending) range behind.
+    //
+    QuicRangeReset(AckRanges);
+    return FALSE;
 }
 
 _Success_(return != FALSE)
@@ -272,6 +272,56 @@ QuicLibrarySumPerfCounters(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLibrarySumPerfHistograms(
+    _Out_writes_bytes_(BufferLength) uint8_t* Buffer,
+    _In_ uint32_t BufferLength
+    )
+{
+    if (MsQuicLib.Partitions == NULL) {
+        CxPlatZeroMemory(Buffer, BufferLength);
+        return;
+    }
+
+    CXPLAT_DBG_ASSERT(BufferLength % (sizeof(int64_t) * QUIC_PERF_HISTOGRAM_BUCKET_COUNT) == 0);
+    CXPLAT_DBG_ASSERT(BufferLength <= sizeof(MsQuicLib.Partitions[0].PerfHistograms));
+    const uint32_t BucketsPerBuffer = BufferLength / sizeof(int64_t);
+    int64_t* const Buckets = (int64_t*)Buffer;
+    memcpy(Buffer, MsQuicLib.Partitions[0].PerfHistograms, BufferLength);
+
+    for (uint32_t ProcIndex = 1; ProcIndex < MsQuicLib.PartitionCount; ++ProcIndex) {
+        const int64_t* const PartitionBuckets =
+            &MsQuicLib.Partitions[ProcIndex].PerfHistograms[0][0];
+        for (uint32_t BucketIndex = 0; BucketIndex < BucketsPerBuffer; ++BucketIndex) {
+            Buckets[BucketIndex] += PartitionBuckets[BucketIndex];
+        }
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLibrarySumProfile(
+    _Out_ QUIC_PROFILE* Profile
+    )
+{
+    CxPlatZeroMemory(Profile, sizeof(*Profile));
+    if (MsQuicLib.Partitions == NULL) {
+        return;
+    }
+
+    const uint32_t CounterCount = sizeof(*Profile) / sizeof(QUIC_PROFILE_COUNTER);
+    QUIC_PROFILE_COUNTER* const Counters = (QUIC_PROFILE_COUNTER*)Profile;
+    for (uint32_t ProcIndex = 0; ProcIndex < MsQuicLib.PartitionCount; ++ProcIndex) {
+        const QUIC_PROFILE_COUNTER* const PartitionCounters =
+            (const QUIC_PROFILE_COUNTER*)&MsQuicLib.Partitions[ProcIndex].Profile;
+        for (uint32_t CounterIndex = 0; CounterIndex < CounterCount; ++CounterIndex) {
+            Counters[CounterIndex].Samples += PartitionCounters[CounterIndex].Samples;
+            Counters[CounterIndex].Cycles += PartitionCounters[CounterIndex].Cycles;
+        }
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLibrarySumPerfCountersExternal(
@@ -1205,6 +1255,28 @@ QuicLibrarySetGlobalParam(
         }
         break;
 
+    case QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE: {
+        if (BufferLength != sizeof(uint32_t) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const uint32_t SlabSize = *(uint32_t*)Buffer;
+        if (SlabSize != 0 &&
+            (SlabSize < QUIC_ARENA_MIN_SLAB_SIZE || SlabSize > QUIC_ARENA_MAX_SLAB_SIZE)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Only connections created from now on pick this up.
+        //
+        MsQuicLib.ConnArenaSlabSize = SlabSize;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -1316,6 +1388,62 @@ QuicLibraryGetGlobalParam(
         break;
     }
 
+    case QUIC_PARAM_GLOBAL_PERF_HISTOGRAMS: {
+        const uint32_t HistogramSize =
+            sizeof(int64_t) * QUIC_PERF_HISTOGRAM_BUCKET_COUNT;
+
+        if (*BufferLength < HistogramSize) {
+            *BufferLength = HistogramSize * QUIC_PERF_HISTOGRAM_MAX;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (*BufferLength < QUIC_PERF_HISTOGRAM_MAX * HistogramSize) {
+            //
+            // Copy as many histograms will fit completely in the buffer.
+            //
+            *BufferLength = (*BufferLength / HistogramSize) * HistogramSize;
+        } else {
+            *BufferLength = QUIC_PERF_HISTOGRAM_MAX * HistogramSize;
+        }
+
+        QuicLibrarySumPerfHistograms(Buffer, *BufferLength);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_PROFILE: {
+        QUIC_PROFILE Profile;
+        QuicLibrarySumProfile(&Profile);
+        Status = QuicProfileGetEntries(&Profile, BufferLength, Buffer);
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE:
+
+        if (*BufferLength < sizeof(uint32_t)) {
+            *BufferLength = sizeof(uint32_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint32_t);
+        *(uint32_t*)Buffer = MsQuicLib.ConnArenaSlabSize;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     case QUIC_PARAM_GLOBAL_SETTINGS:
 
         Status = QuicSettingsGetSettings(&MsQuicLib.Settings, BufferLength, (QUIC_SETTINGS*)Buffer);
@@ -1503,7 +1631,9 @@ QuicLibraryGetGlobalParam(
             QUIC_STATISTICS_V2_SIZE_1,
             QUIC_STATISTICS_V2_SIZE_2,
             QUIC_STATISTICS_V2_SIZE_3,
-            QUIC_STATISTICS_V2_SIZE_4
+            QUIC_STATISTICS_V2_SIZE_4,
+            QUIC_STATISTICS_V2_SIZE_5,
+            QUIC_STATISTICS_V2_SIZE_6
         };
         static const uint32_t NumStatSizes = ARRAYSIZE(StatSizes);
         uint32_t MaxSizes = *BufferLength / sizeof(uint32_t);
@@ -1884,13 +2014,16 @@ MsQuicOpenVersion(
     Api->StreamReceiveComplete = MsQuicStreamReceiveComplete;
     Api->StreamReceiveSetEnabled = MsQuicStreamReceiveSetEnabled;
     Api->StreamProvideReceiveBuffers = MsQuicStreamProvideReceiveBuffers;
+    Api->StreamSendBatch = MsQuicStreamSendBatch;
 
     Api->DatagramSend = MsQuicDatagramSend;
+    Api->DatagramSendBatch = MsQuicDatagramSendBatch;
 
 #ifndef _KERNEL_MODE
     Api->ExecutionCreate = MsQuicExecutionCreate;
     Api->ExecutionDelete = MsQuicExecutionDelete;
     Api->ExecutionPoll = MsQuicExecutionPoll;
+    Api->StreamSendFile = MsQuicStreamSendFile;
 #endif
 
     Api->ConnectionPoolCreate = MsQuicConnectionPoolCreate;
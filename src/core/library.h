@@ -167,6 +167,11 @@ typedef struct QUIC_LIBRARY {
     //
     uint64_t CurrentHandshakeMemoryUsage;
 
+    //
+    // Initial slab size for each new connection's arena. Zero disables it.
+    //
+    uint32_t ConnArenaSlabSize;
+
     //
     // Handle to global persistent storage (registry).
     //
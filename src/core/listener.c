@@ -330,6 +330,11 @@ MsQuicListenerStart(
             UdpConfig.CibirIdLength);
     }
 
+    // for CID based receive steering
+    UdpConfig.CidPartitionIdOffset = MsQuicLib.CidServerIdLength;
+    UdpConfig.CidPartitionIdMask = MsQuicLib.PartitionMask;
+    UdpConfig.CidPartitionCount = MsQuicLib.PartitionCount;
+
     if (MsQuicLib.Settings.XdpEnabled) {
         UdpConfig.Flags |= CXPLAT_SOCKET_FLAG_XDP;
     }
@@ -95,18 +95,26 @@ QuicLossValidate(
     )
 {
     uint32_t AckElicitingPackets = 0;
-    QUIC_SENT_PACKET_METADATA** Tail = &LossDetection->SentPackets;
-    while (*Tail) {
-        CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
-        if ((*Tail)->Flags.IsAckEliciting) {
+    uint32_t SentPackets = 0;
+    const QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+        const uint32_t Slot = QuicSentPacketStoreSlot(Store, i);
+        const QUIC_SENT_PACKET_METADATA* Packet = Store->Packets[Slot];
+        if (Packet == NULL) {
+            continue;
+        }
+        CXPLAT_DBG_ASSERT(!Packet->Flags.Freed);
+        CXPLAT_DBG_ASSERT(Packet->PacketNumber == QuicSentPacketStorePacketNumber(Store, i));
+        CXPLAT_DBG_ASSERT(Packet->Flags.IsAckEliciting == Store->Flags[Slot].IsAckEliciting);
+        if (Store->Flags[Slot].IsAckEliciting) {
             AckElicitingPackets++;
         }
-        Tail = &((*Tail)->Next);
+        SentPackets++;
     }
-    CXPLAT_DBG_ASSERT(Tail == LossDetection->SentPacketsTail);
+    CXPLAT_DBG_ASSERT(Store->PacketCount == SentPackets);
     CXPLAT_DBG_ASSERT(LossDetection->PacketsInFlight == AckElicitingPackets);
 
-    Tail = &LossDetection->LostPackets;
+    QUIC_SENT_PACKET_METADATA** Tail = &LossDetection->LostPackets;
     while (*Tail) {
         CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
         Tail = &((*Tail)->Next);
@@ -123,8 +131,7 @@ QuicLossDetectionInitialize(
     _Inout_ QUIC_LOSS_DETECTION* LossDetection
     )
 {
-    LossDetection->SentPackets = NULL;
-    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
+    QuicSentPacketStoreInitialize(&LossDetection->SentPackets);
     LossDetection->LostPackets = NULL;
     LossDetection->LostPacketsTail = &LossDetection->LostPackets;
     QuicLossDetectionInitializeInternalState(LossDetection);
@@ -137,10 +144,13 @@ QuicLossDetectionUninitialize(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
 
-    while (LossDetection->SentPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-        LossDetection->SentPackets = LossDetection->SentPackets->Next;
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+        if (QuicSentPacketStoreGet(Store, i) == NULL) {
+            continue;
+        }
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketStoreRemove(Store, i);
 
         if (Packet->Flags.IsAckEliciting) {
             QuicTraceLogVerbose(
@@ -153,6 +163,8 @@ QuicLossDetectionUninitialize(
 
         QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, FALSE);
     }
+    QuicSentPacketStoreUninitialize(Store);
+
     while (LossDetection->LostPackets != NULL) {
         QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
         LossDetection->LostPackets = LossDetection->LostPackets->Next;
@@ -174,6 +186,7 @@ QuicLossDetectionReset(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
 
     QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_LOSS_DETECTION);
 
@@ -186,12 +199,13 @@ QuicLossDetectionReset(
     // Throw away any outstanding packets.
     //
 
-    while (LossDetection->SentPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-        LossDetection->SentPackets = LossDetection->SentPackets->Next;
-        QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+        if (QuicSentPacketStoreGet(Store, i) != NULL) {
+            QuicLossDetectionRetransmitFrames(
+                LossDetection, QuicSentPacketStoreRemove(Store, i), TRUE);
+        }
     }
-    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
+    QuicSentPacketStoreCompact(Store);
 
     while (LossDetection->LostPackets != NULL) {
         QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
@@ -214,11 +228,14 @@ QuicLossDetectionOldestOutstandingPacket(
     _In_ QUIC_LOSS_DETECTION* LossDetection
     )
 {
-    QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-    while (Packet != NULL && !Packet->Flags.IsAckEliciting) {
-        Packet = Packet->Next;
+    const QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+        const uint32_t Slot = QuicSentPacketStoreSlot(Store, i);
+        if (Store->Packets[Slot] != NULL && Store->Flags[Slot].IsAckEliciting) {
+            return Store->Packets[Slot];
+        }
     }
-    return Packet;
+    return NULL;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -422,11 +439,17 @@ QuicLossDetectionOnPacketSent(
     LossDetection->LargestSentPacketNumber = TempSentPacket->PacketNumber;
 
     //
-    // Add to the outstanding-packet queue.
+    // Add to the outstanding-packet store.
     //
     SentPacket->Next = NULL;
-    *LossDetection->SentPacketsTail = SentPacket;
-    LossDetection->SentPacketsTail = &SentPacket->Next;
+    if (!QuicSentPacketStoreAdd(&LossDetection->SentPackets, SentPacket)) {
+        //
+        // The store couldn't grow to track this packet, so handle it the same
+        // as a failure to allocate the metadata above.
+        //
+        QuicLossDetectionRetransmitFrames(LossDetection, SentPacket, TRUE);
+        return;
+    }
 
     CXPLAT_DBG_ASSERT(
         SentPacket->Flags.KeyType != QUIC_PACKET_KEY_0_RTT ||
@@ -611,7 +634,7 @@ QuicLossDetectionOnPacketAcknowledged(
                 QUIC_CID_VALIDATE_NULL(Connection, DestCid);
                 CXPLAT_DBG_ASSERT(Connection->RetiredDestCidCount > 0);
                 Connection->RetiredDestCidCount--;
-                CXPLAT_FREE(DestCid, QUIC_POOL_CIDLIST);
+                QuicCidFreeDestination(&Connection->Arena, DestCid);
             }
             break;
         }
@@ -691,6 +714,7 @@ QuicLossDetectionRetransmitFrames(
     for (uint8_t i = 0; i < Packet->FrameCount; i++) {
         switch (Packet->Frames[i].Type) {
         case QUIC_FRAME_PING:
+        case QUIC_FRAME_IMMEDIATE_ACK:
             if (!Packet->Flags.IsMtuProbe) {
                 //
                 // Don't consider PING "new data" so that we might still find
@@ -928,6 +952,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
     uint32_t LostRetransmittableBytes = 0;
     QUIC_SENT_PACKET_METADATA* Packet;
 
@@ -959,7 +984,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
         QuicLossValidate(LossDetection);
     }
 
-    if (LossDetection->SentPackets != NULL) {
+    if (!QuicSentPacketStoreIsEmpty(Store)) {
         //
         // Remove "suspect" packets inferred lost from out-of-order ACKs.
         // The spec has:
@@ -972,52 +997,56 @@ QuicLossDetectionDetectAndHandleLostPackets(
         uint64_t Rtt = CXPLAT_MAX(Path->SmoothedRtt, Path->LatestRttSample);
         uint64_t TimeReorderThreshold = QUIC_TIME_REORDER_THRESHOLD(Rtt);
         uint64_t LargestLostPacketNumber = 0;
-        QUIC_SENT_PACKET_METADATA* PrevPacket = NULL;
-        Packet = LossDetection->SentPackets;
-        while (Packet != NULL) {
+        for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+
+            const uint32_t Slot = QuicSentPacketStoreSlot(Store, i);
+            Packet = Store->Packets[Slot];
+            if (Packet == NULL) {
+                continue;
+            }
 
+            const uint64_t PacketNumber = QuicSentPacketStorePacketNumber(Store, i);
+            const QUIC_SENT_PACKET_STORE_FLAGS Flags = Store->Flags[Slot];
             BOOLEAN NonretransmittableHandshakePacket =
-                !Packet->Flags.IsAckEliciting &&
-                Packet->Flags.KeyType < QUIC_PACKET_KEY_1_RTT;
+                !Flags.IsAckEliciting &&
+                Flags.KeyType < QUIC_PACKET_KEY_1_RTT;
             QUIC_ENCRYPT_LEVEL EncryptLevel =
-                QuicKeyTypeToEncryptLevel(Packet->Flags.KeyType);
+                QuicKeyTypeToEncryptLevel(Flags.KeyType);
 
             if (EncryptLevel > LossDetection->LargestAckEncryptLevel) {
-                PrevPacket = Packet;
-                Packet = Packet->Next;
                 continue;
             }
 
-            if (Packet->PacketNumber + QUIC_PACKET_REORDER_THRESHOLD < LossDetection->LargestAck) {
+            if (PacketNumber + QUIC_PACKET_REORDER_THRESHOLD < LossDetection->LargestAck) {
                 if (!NonretransmittableHandshakePacket) {
                     QuicTraceLogVerbose(
                         PacketTxLostFack,
                         "[%c][TX][%llu] Lost: FACK %llu packets",
                         PtkConnPre(Connection),
-                        Packet->PacketNumber,
-                        LossDetection->LargestAck - Packet->PacketNumber);
+                        PacketNumber,
+                        LossDetection->LargestAck - PacketNumber);
                     QuicTraceEvent(
                         ConnPacketLost,
                         "[conn][%p][TX][%llu] %hhu Lost: %hhu",
                         Connection,
-                        Packet->PacketNumber,
+                        PacketNumber,
                         QuicPacketTraceType(Packet),
                         QUIC_TRACE_PACKET_LOSS_FACK);
                 }
-            } else if (Packet->PacketNumber < LossDetection->LargestAck &&
-                        CxPlatTimeAtOrBefore64(Packet->SentTime + TimeReorderThreshold, TimeNow)) {
+            } else if (PacketNumber < LossDetection->LargestAck &&
+                        CxPlatTimeAtOrBefore64(Store->SentTimes[Slot] + TimeReorderThreshold, TimeNow)) {
                 if (!NonretransmittableHandshakePacket) {
                     QuicTraceLogVerbose(
                         PacketTxLostRack,
                         "[%c][TX][%llu] Lost: RACK %llu ms",
                         PtkConnPre(Connection),
-                        Packet->PacketNumber,
-                        CxPlatTimeDiff64(Packet->SentTime, TimeNow));
+                        PacketNumber,
+                        CxPlatTimeDiff64(Store->SentTimes[Slot], TimeNow));
                     QuicTraceEvent(
                         ConnPacketLost,
                         "[conn][%p][TX][%llu] %hhu Lost: %hhu",
                         Connection,
-                        Packet->PacketNumber,
+                        PacketNumber,
                         QuicPacketTraceType(Packet),
                         QUIC_TRACE_PACKET_LOSS_RACK);
                 }
@@ -1028,31 +1057,22 @@ QuicLossDetectionDetectAndHandleLostPackets(
             Connection->Stats.Send.SuspectedLostPackets++;
             QuicPerfCounterIncrement(
                 Connection->Partition, QUIC_PERF_COUNTER_PKTS_SUSPECTED_LOST);
-            if (Packet->Flags.IsAckEliciting) {
+            if (Flags.IsAckEliciting) {
                 LossDetection->PacketsInFlight--;
-                LostRetransmittableBytes += Packet->PacketLength;
+                LostRetransmittableBytes += Store->PacketLengths[Slot];
                 QuicLossDetectionRetransmitFrames(LossDetection, Packet, FALSE);
             }
 
-            LargestLostPacketNumber = Packet->PacketNumber;
-            if (PrevPacket == NULL) {
-                LossDetection->SentPackets = Packet->Next;
-                if (Packet->Next == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            } else {
-                PrevPacket->Next = Packet->Next;
-                if (Packet->Next == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            }
+            LargestLostPacketNumber = PacketNumber;
+            (void)QuicSentPacketStoreRemove(Store, i);
 
+            Packet->Next = NULL;
             *LossDetection->LostPacketsTail = Packet;
             LossDetection->LostPacketsTail = &Packet->Next;
-            Packet = Packet->Next;
-            *LossDetection->LostPacketsTail = NULL;
         }
 
+        QuicSentPacketStoreCompact(Store);
+
         QuicLossValidate(LossDetection);
 
         if (LostRetransmittableBytes > 0) {
@@ -1061,6 +1081,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 // On persistent congestion, reset the peer's packet tolerance
                 // back to the default.
                 //
+                Connection->MinPeerPacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
                 QuicConnUpdatePeerPacketTolerance(Connection, QUIC_MIN_ACK_SEND_NUMBER);
             }
 
@@ -1093,6 +1114,7 @@ QuicLossDetectionDiscardPackets(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
     QUIC_ENCRYPT_LEVEL EncryptLevel = QuicKeyTypeToEncryptLevel(KeyType);
     QUIC_SENT_PACKET_METADATA* PrevPacket;
     QUIC_SENT_PACKET_METADATA* Packet;
@@ -1149,53 +1171,38 @@ QuicLossDetectionDiscardPackets(
 
     QuicLossValidate(LossDetection);
 
-    PrevPacket = NULL;
-    Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
-
-        if (Packet->Flags.KeyType == KeyType) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->SentPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            }
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+        const uint32_t Slot = QuicSentPacketStoreSlot(Store, i);
+        if (Store->Packets[Slot] == NULL ||
+            Store->Flags[Slot].KeyType != KeyType) {
+            continue;
+        }
 
-            QuicTraceLogVerbose(
-                PacketTxAckedImplicit,
-                "[%c][TX][%llu] ACKed (implicit)",
-                PtkConnPre(Connection),
-                Packet->PacketNumber);
-            QuicTraceEvent(
-                ConnPacketACKed,
-                "[conn][%p][TX][%llu] %hhu ACKed",
-                Connection,
-                Packet->PacketNumber,
-                QuicPacketTraceType(Packet));
+        Packet = QuicSentPacketStoreRemove(Store, i);
 
-            if (Packet->Flags.IsAckEliciting) {
-                LossDetection->PacketsInFlight--;
-                AckedRetransmittableBytes += Packet->PacketLength;
-            }
-
-            QuicLossDetectionOnPacketAcknowledged(LossDetection, EncryptLevel, Packet, TRUE, TimeNow, 0);
+        QuicTraceLogVerbose(
+            PacketTxAckedImplicit,
+            "[%c][TX][%llu] ACKed (implicit)",
+            PtkConnPre(Connection),
+            Packet->PacketNumber);
+        QuicTraceEvent(
+            ConnPacketACKed,
+            "[conn][%p][TX][%llu] %hhu ACKed",
+            Connection,
+            Packet->PacketNumber,
+            QuicPacketTraceType(Packet));
 
-            QuicSentPacketPoolReturnPacketMetadata(Packet, Connection);
+        if (Packet->Flags.IsAckEliciting) {
+            LossDetection->PacketsInFlight--;
+            AckedRetransmittableBytes += Packet->PacketLength;
+        }
 
-            Packet = NextPacket;
+        QuicLossDetectionOnPacketAcknowledged(LossDetection, EncryptLevel, Packet, TRUE, TimeNow, 0);
 
-        } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
-        }
+        QuicSentPacketPoolReturnPacketMetadata(Packet, Connection);
     }
 
+    QuicSentPacketStoreCompact(Store);
     QuicLossValidate(LossDetection);
 
     if (AckedRetransmittableBytes > 0) {
@@ -1227,6 +1234,30 @@ QuicLossDetectionDiscardPackets(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicLossDetectionHibernate(
+    _In_ QUIC_LOSS_DETECTION* LossDetection
+    )
+{
+    if (LossDetection->PacketsInFlight != 0 ||
+        LossDetection->LostPackets != NULL) {
+        return FALSE;
+    }
+
+    QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+        if (QuicSentPacketStoreGet(Store, i) != NULL) {
+            QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketStoreRemove(Store, i);
+            CXPLAT_DBG_ASSERT(!Packet->Flags.IsAckEliciting);
+            QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, FALSE);
+        }
+    }
+    QuicSentPacketStoreRelease(Store);
+
+    return TRUE;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLossDetectionOnZeroRttRejected(
@@ -1234,53 +1265,37 @@ QuicLossDetectionOnZeroRttRejected(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
-    QUIC_SENT_PACKET_METADATA* PrevPacket;
-    QUIC_SENT_PACKET_METADATA* Packet;
+    QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
     uint32_t CountRetransmittableBytes = 0;
 
     //
     // Marks all the packets as lost so they can be retransmitted immediately.
     //
 
-    PrevPacket = NULL;
-    Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
-
-        if (Packet->Flags.KeyType == QUIC_PACKET_KEY_0_RTT) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->SentPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            }
-
-            QuicTraceLogVerbose(
-                PacketTx0RttRejected,
-                "[%c][TX][%llu] Rejected",
-                PtkConnPre(Connection),
-                Packet->PacketNumber);
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+        const uint32_t Slot = QuicSentPacketStoreSlot(Store, i);
+        if (Store->Packets[Slot] == NULL ||
+            Store->Flags[Slot].KeyType != QUIC_PACKET_KEY_0_RTT) {
+            continue;
+        }
 
-            CXPLAT_DBG_ASSERT(Packet->Flags.IsAckEliciting);
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketStoreRemove(Store, i);
 
-            LossDetection->PacketsInFlight--;
-            CountRetransmittableBytes += Packet->PacketLength;
+        QuicTraceLogVerbose(
+            PacketTx0RttRejected,
+            "[%c][TX][%llu] Rejected",
+            PtkConnPre(Connection),
+            Packet->PacketNumber);
 
-            QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
+        CXPLAT_DBG_ASSERT(Packet->Flags.IsAckEliciting);
 
-            Packet = NextPacket;
+        LossDetection->PacketsInFlight--;
+        CountRetransmittableBytes += Packet->PacketLength;
 
-        } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
-        }
+        QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
     }
 
+    QuicSentPacketStoreCompact(Store);
     QuicLossValidate(LossDetection);
 
     if (CountRetransmittableBytes > 0) {
@@ -1323,8 +1338,9 @@ QuicLossDetectionProcessAckBlocks(
     *InvalidAckBlock = FALSE;
 
     QUIC_SENT_PACKET_METADATA** LostPacketsStart = &LossDetection->LostPackets;
-    QUIC_SENT_PACKET_METADATA** SentPacketsStart = &LossDetection->SentPackets;
+    QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
     QUIC_SENT_PACKET_METADATA* LargestAckedPacket = NULL;
+    uint32_t StartPosition, EndPosition;
 
     uint32_t i = 0;
     QUIC_SUBRANGE* AckBlock;
@@ -1393,38 +1409,38 @@ QuicLossDetectionProcessAckBlocks(
 
 CheckSentPackets:
         //
-        // Now find all the acknowledged packets in the SentPackets list.
+        // Now find all the acknowledged packets in the SentPackets store. The
+        // store is indexed by packet number, so only the slots covered by the
+        // ACK block are visited.
         //
-        if (*SentPacketsStart != NULL) {
-            while (*SentPacketsStart && (*SentPacketsStart)->PacketNumber < AckBlock->Low) {
-                SentPacketsStart = &((*SentPacketsStart)->Next);
-            }
-
-            QUIC_SENT_PACKET_METADATA** End = SentPacketsStart;
-            while (*End && (*End)->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
+        if (QuicSentPacketStoreFindRange(
+                Store,
+                AckBlock->Low,
+                QuicRangeGetHigh(AckBlock),
+                &StartPosition,
+                &EndPosition)) {
+
+            for (uint32_t j = StartPosition; j < EndPosition; j++) {
+                const uint32_t Slot = QuicSentPacketStoreSlot(Store, j);
+                if (Store->Packets[Slot] == NULL) {
+                    continue;
+                }
 
-                if ((*End)->Flags.IsAckEliciting) {
+                if (Store->Flags[Slot].IsAckEliciting) {
                     LossDetection->PacketsInFlight--;
-                    AckedRetransmittableBytes += (*End)->PacketLength;
+                    AckedRetransmittableBytes += Store->PacketLengths[Slot];
                 }
-                LargestAckedPacket = *End;
-                End = &((*End)->Next);
-            }
 
-            if (SentPacketsStart != End) {
                 //
-                // Remove the ACKed packets from the outstanding packet list.
+                // Remove the ACKed packet from the outstanding packet store.
                 //
-                *AckedPacketsTail = *SentPacketsStart;
-                AckedPacketsTail = End;
-                *SentPacketsStart = *End;
-                *End = NULL;
-                if (End == LossDetection->SentPacketsTail) {
-                    LossDetection->SentPacketsTail = SentPacketsStart;
-                }
-
-                QuicLossValidate(LossDetection);
+                LargestAckedPacket = QuicSentPacketStoreRemove(Store, j);
+                *AckedPacketsTail = LargestAckedPacket;
+                AckedPacketsTail = &LargestAckedPacket->Next;
             }
+            *AckedPacketsTail = NULL;
+
+            QuicLossValidate(LossDetection);
         }
 
         if (LargestAckedPacket != NULL &&
@@ -1440,6 +1456,8 @@ CheckSentPackets:
         }
     }
 
+    QuicSentPacketStoreCompact(Store);
+
     if (AckedPackets == NULL) {
         //
         // Nothing was acknowledged, so we can exit now.
@@ -1621,6 +1639,12 @@ CheckSentPackets:
             //
             QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
         }
+
+        QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+
+        if (QuicTelemetryIsSampleDue(&Connection->Telemetry, TimeNow)) {
+            QuicConnRecordTelemetry(Connection, TimeNow);
+        }
     }
 
     LossDetection->ProbeCount = 0;
@@ -1768,9 +1792,11 @@ QuicLossDetectionScheduleProbe(
     // Not enough new stream data exists to fill the probing packets. Schedule
     // retransmits if possible.
     //
-    QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
-        if (Packet->Flags.IsAckEliciting) {
+    const QUIC_SENT_PACKET_STORE* Store = &LossDetection->SentPackets;
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(Store); i++) {
+        const uint32_t Slot = QuicSentPacketStoreSlot(Store, i);
+        QUIC_SENT_PACKET_METADATA* Packet = Store->Packets[Slot];
+        if (Packet != NULL && Store->Flags[Slot].IsAckEliciting) {
             QuicTraceLogVerbose(
                 PacketTxProbeRetransmit,
                 "[%c][TX][%llu] Probe Retransmit",
@@ -1788,7 +1814,6 @@ QuicLossDetectionScheduleProbe(
                 return;
             }
         }
-        Packet = Packet->Next;
     }
 
     //
@@ -1838,7 +1863,7 @@ QuicLossDetectionProcessTimerOperation(
         CxPlatTimeDiff64(OldestPacket->SentTime, TimeNow) >=
             MS_TO_US((uint64_t)Connection->Settings.DisconnectTimeoutMs)) {
         //
-        // OldestPacket has been in the SentPackets list for at least
+        // OldestPacket has been in the SentPackets store for at least
         // DisconnectTimeoutUs without an ACK for either OldestPacket or for any
         // packets sent more than the reordering threshold after it. Assume the
         // path is dead and close the connection.
@@ -129,6 +129,13 @@ QuicOperationFree(
                     QUIC_POOL_RECVBUF);
             }
             QuicStreamRelease(ApiCtx->STRM_PROVIDE_RECV_BUFFERS.Stream, QUIC_STREAM_REF_OPERATION);
+        } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_SEND_BATCH) {
+            for (uint32_t i = 0; i < ApiCtx->STRM_SEND_BATCH.StreamCount; ++i) {
+                QuicStreamRelease(ApiCtx->STRM_SEND_BATCH.Streams[i], QUIC_STREAM_REF_OPERATION);
+            }
+            if (ApiCtx->STRM_SEND_BATCH.Streams != NULL) {
+                CXPLAT_FREE(ApiCtx->STRM_SEND_BATCH.Streams, QUIC_POOL_SEND_BATCH);
+            }
         }
         CxPlatPoolFree(ApiCtx);
     } else if (Oper->Type == QUIC_OPER_TYPE_FLUSH_STREAM_RECV) {
@@ -284,6 +291,16 @@ QuicOperationQueueClear(
                         ApiCtx->STRM_START.Stream,
                         QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
                         0);
+                } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_SEND_BATCH) {
+                    for (uint32_t i = 0; i < ApiCtx->STRM_SEND_BATCH.StreamCount; ++i) {
+                        QUIC_STREAM* Stream = ApiCtx->STRM_SEND_BATCH.Streams[i];
+                        if (!Stream->Flags.Started) {
+                            QuicStreamShutdown(
+                                Stream,
+                                QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
+                                0);
+                        }
+                    }
                 }
             }
             QuicOperationFree(Oper);
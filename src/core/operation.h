@@ -64,6 +64,7 @@ typedef enum QUIC_API_TYPE {
     QUIC_API_TYPE_CONN_COMPLETE_RESUMPTION_TICKET_VALIDATION,
     QUIC_API_TYPE_CONN_COMPLETE_CERTIFICATE_VALIDATION,
     QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS,
+    QUIC_API_TYPE_STRM_SEND_BATCH,
 
 } QUIC_API_TYPE;
 
@@ -159,6 +160,10 @@ typedef struct QUIC_API_CONTEXT {
             QUIC_STREAM* Stream;
             CXPLAT_LIST_ENTRY /* QUIC_RECV_CHUNK */ Chunks;
         } STRM_PROVIDE_RECV_BUFFERS;
+        struct {
+            QUIC_STREAM** Streams;  // Each holds a QUIC_STREAM_REF_OPERATION
+            uint32_t StreamCount;
+        } STRM_SEND_BATCH;
 
         struct {
             HQUIC Handle;
@@ -183,6 +188,7 @@ typedef enum QUIC_CONN_TIMER_TYPE {
     QUIC_CONN_TIMER_LOSS_DETECTION,
     QUIC_CONN_TIMER_KEEP_ALIVE,
     QUIC_CONN_TIMER_IDLE,
+    QUIC_CONN_TIMER_HIBERNATE,
     QUIC_CONN_TIMER_SHUTDOWN,
 
     QUIC_CONN_TIMER_COUNT
@@ -99,6 +99,16 @@ typedef struct QUIC_CACHEALIGN QUIC_PARTITION {
     //
     int64_t PerfCounters[QUIC_PERF_COUNTER_MAX];
 
+    //
+    // Per-processor latency and size distributions.
+    //
+    int64_t PerfHistograms[QUIC_PERF_HISTOGRAM_MAX][QUIC_PERF_HISTOGRAM_BUCKET_COUNT];
+
+    //
+    // Per-processor sampled cycle accounting.
+    //
+    QUIC_PROFILE Profile;
+
 } QUIC_PARTITION;
 
 //
@@ -187,6 +197,50 @@ QuicPerfCounterAdd(
 #define QuicPerfCounterIncrement(Partition, Type) QuicPerfCounterAdd(Partition, Type, 1)
 #define QuicPerfCounterDecrement(Partition, Type) QuicPerfCounterAdd(Partition, Type, -1)
 
+//
+// Returns the log-linear histogram bucket for a value. See
+// QUIC_PERF_HISTOGRAM_BUCKET_LOW for the inverse.
+//
+QUIC_INLINE
+uint32_t
+QuicPerfHistogramBucket(
+    _In_ uint64_t Value
+    )
+{
+    if (Value > UINT32_MAX) {
+        Value = UINT32_MAX;
+    }
+
+    //
+    // Find the smallest shift that leaves fewer than 16 (i.e. 4 significant
+    // bits), which is one more than the largest shift that leaves at least 16.
+    //
+    uint32_t Shift = 0;
+    if (Value >= 16) {
+        for (uint32_t Step = 16; Step != 0; Step >>= 1) {
+            if ((Value >> (Shift + Step)) >= 16) {
+                Shift += Step;
+            }
+        }
+        Shift++;
+    }
+
+    return Shift * 8 + (uint32_t)(Value >> Shift);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicPerfHistogramRecord(
+    _In_ QUIC_PARTITION* Partition,
+    _In_ QUIC_PERFORMANCE_HISTOGRAMS Type,
+    _In_ uint64_t Value
+    )
+{
+    CXPLAT_DBG_ASSERT(Type >= 0 && Type < QUIC_PERF_HISTOGRAM_MAX);
+    InterlockedIncrement64(&Partition->PerfHistograms[Type][QuicPerfHistogramBucket(Value)]);
+}
+
 #if defined(__cplusplus)
 }
 #endif
@@ -258,6 +258,82 @@ QuicConnGetPathForPacket(
     return Path;
 }
 
+//
+// Returns TRUE if the cached congestion state belongs to the path, i.e. the
+// path uses the same local and remote IP addresses.
+//
+static
+BOOLEAN
+QuicPathCcCacheMatches(
+    _In_ const QUIC_PATH_CC_CACHE* Cache,
+    _In_ const QUIC_PATH* Path
+    )
+{
+    return
+        Cache->Valid &&
+        QuicAddrGetFamily(&Cache->LocalAddress) == QuicAddrGetFamily(&Path->Route.LocalAddress) &&
+        QuicAddrCompareIp(&Cache->LocalAddress, &Path->Route.LocalAddress) &&
+        QuicAddrGetFamily(&Cache->RemoteAddress) == QuicAddrGetFamily(&Path->Route.RemoteAddress) &&
+        QuicAddrCompareIp(&Cache->RemoteAddress, &Path->Route.RemoteAddress);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicPathCcCacheSave(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_PATH* Path
+    )
+{
+    //
+    // Reuse the entry already held for the path, otherwise take an empty
+    // entry, or else replace the oldest one.
+    //
+    QUIC_PATH_CC_CACHE* Cache = NULL;
+    for (uint8_t i = 0; i < ARRAYSIZE(Connection->PathCcCache); ++i) {
+        QUIC_PATH_CC_CACHE* Entry = &Connection->PathCcCache[i];
+        if (QuicPathCcCacheMatches(Entry, Path)) {
+            Cache = Entry;
+            break;
+        }
+        if (Cache == NULL ||
+            (Cache->Valid && (!Entry->Valid || Entry->TimeUs < Cache->TimeUs))) {
+            Cache = Entry;
+        }
+    }
+
+    Cache->TimeUs = CxPlatTimeUs64();
+    Cache->LocalAddress = Path->Route.LocalAddress;
+    Cache->RemoteAddress = Path->Route.RemoteAddress;
+    Cache->SmoothedRtt = Path->SmoothedRtt;
+    Cache->RttVariance = Path->RttVariance;
+    Cache->MinRtt = Path->MinRtt;
+    Cache->CongestionWindow =
+        QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl);
+    Cache->Valid = TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+_Ret_maybenull_
+QUIC_PATH_CC_CACHE*
+QuicPathCcCacheFind(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_PATH* Path
+    )
+{
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    for (uint8_t i = 0; i < ARRAYSIZE(Connection->PathCcCache); ++i) {
+        QUIC_PATH_CC_CACHE* Entry = &Connection->PathCcCache[i];
+        if (QuicPathCcCacheMatches(Entry, Path) &&
+            CxPlatTimeDiff64(Entry->TimeUs, TimeNow) <
+                MS_TO_US(QUIC_PATH_CC_CACHE_LIFETIME_MS)) {
+            return Entry;
+        }
+    }
+    return NULL;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicPathSetActive(
@@ -266,6 +342,7 @@ QuicPathSetActive(
     )
 {
     BOOLEAN UdpPortChangeOnly = FALSE;
+    BOOLEAN Migrated = FALSE;
     if (Path == &Connection->Paths[0]) {
         CXPLAT_DBG_ASSERT(!Path->IsActive);
         Path->IsActive = TRUE;
@@ -274,9 +351,19 @@ QuicPathSetActive(
         UdpPortChangeOnly =
             QuicAddrGetFamily(&Path->Route.RemoteAddress) == QuicAddrGetFamily(&Connection->Paths[0].Route.RemoteAddress) &&
             QuicAddrCompareIp(&Path->Route.RemoteAddress, &Connection->Paths[0].Route.RemoteAddress);
+        Migrated = TRUE;
 
         QUIC_PATH PrevActivePath = Connection->Paths[0];
 
+        if (!UdpPortChangeOnly && PrevActivePath.GotFirstRttSample) {
+            //
+            // Remember the congestion state of the path we're leaving, in
+            // case the connection migrates back to it (i.e. handover back and
+            // forth between networks).
+            //
+            QuicPathCcCacheSave(Connection, &PrevActivePath);
+        }
+
         PrevActivePath.IsActive = FALSE;
         Path->IsActive = TRUE;
         if (UdpPortChangeOnly) {
@@ -298,7 +385,37 @@ QuicPathSetActive(
         UdpPortChangeOnly);
 
     if (!UdpPortChangeOnly) {
-        QuicCongestionControlReset(&Connection->CongestionControl, FALSE);
+        QUIC_PATH* ActivePath = &Connection->Paths[0];
+        QUIC_PATH_CC_CACHE* Cache = NULL;
+        if (Migrated) {
+            Connection->Stats.Misc.MigrationCount++;
+            Cache = QuicPathCcCacheFind(Connection, ActivePath);
+        }
+        if (Cache != NULL) {
+            if (!ActivePath->GotFirstRttSample) {
+                //
+                // The cached window only makes sense with the RTT it was used
+                // at, so start from that RTT estimate too.
+                //
+                ActivePath->GotFirstRttSample = TRUE;
+                ActivePath->SmoothedRtt = Cache->SmoothedRtt;
+                ActivePath->RttVariance = Cache->RttVariance;
+                ActivePath->MinRtt = Cache->MinRtt;
+            }
+            QuicTraceLogConnInfo(
+                PathCcResumed,
+                Connection,
+                "Path[%hhu] Resuming congestion control (cwnd=%u)",
+                ActivePath->ID,
+                Cache->CongestionWindow);
+            QuicCongestionControlResume(
+                &Connection->CongestionControl,
+                Cache->CongestionWindow);
+            Connection->Stats.Misc.MigrationCachedCcCount++;
+            Cache->Valid = FALSE;
+        } else {
+            QuicCongestionControlReset(&Connection->CongestionControl, FALSE);
+        }
     }
     CXPLAT_DBG_ASSERT(Path->DestCid != NULL);
     CXPLAT_DBG_ASSERT(!Path->DestCid->CID.Retired);
@@ -187,6 +187,43 @@ typedef struct QUIC_PATH {
 
 } QUIC_PATH;
 
+//
+// Congestion control state remembered for a path after it stops being the
+// active path. Paths are matched by their local and remote IP addresses, since
+// a path that is migrated back to usually gets a new path ID.
+//
+typedef struct QUIC_PATH_CC_CACHE {
+
+    //
+    // The time (in microseconds) the path stopped being active.
+    //
+    uint64_t TimeUs;
+
+    //
+    // The local and remote addresses of the path. Ports are ignored.
+    //
+    QUIC_ADDR LocalAddress;
+    QUIC_ADDR RemoteAddress;
+
+    //
+    // The RTT estimate of the path when it stopped being active.
+    //
+    uint64_t SmoothedRtt;
+    uint64_t RttVariance;
+    uint64_t MinRtt;
+
+    //
+    // The congestion window in use when the path stopped being active.
+    //
+    uint32_t CongestionWindow;
+
+    //
+    // Indicates the entry holds state.
+    //
+    BOOLEAN Valid;
+
+} QUIC_PATH_CC_CACHE;
+
 #if DEBUG
 #define QuicPathValidate(Path) \
     CXPLAT_DBG_ASSERT( \
@@ -42,6 +42,7 @@
 // Internal Core Headers.
 //
 #include "quicdef.h"
+#include "arena.h"
 #include "cid.h"
 #include "mtu_discovery.h"
 #include "path.h"
@@ -50,6 +51,7 @@
 #include "timer_wheel.h"
 #include "settings.h"
 #include "sent_packet_metadata.h"
+#include "profile.h"
 #include "partition.h"
 #include "library.h"
 #include "operation.h"
@@ -67,6 +69,7 @@
 #include "packet_space.h"
 #include "congestion_control.h"
 #include "loss_detection.h"
+#include "telemetry.h"
 #include "send.h"
 #include "crypto.h"
 #include "stream.h"
@@ -0,0 +1,219 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    A low overhead, always-on profiler. A sample of connection operations
+    (broken down further by API call for API operations), stateless operations
+    and received frames are timed with the CPU cycle counter, and the cycles
+    are accumulated per partition. The totals are exposed, with names, via
+    QUIC_PARAM_GLOBAL_PROFILE, so that the relative cost of each stage can be
+    seen on a running system without tracing.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "profile.c.clog.h"
+#endif
+
+CXPLAT_STATIC_ASSERT(
+    IS_POWER_OF_TWO(QUIC_PROFILE_SAMPLE_INTERVAL),
+    "Sampling uses a mask");
+CXPLAT_STATIC_ASSERT(
+    QUIC_OPER_TYPE_RETRY + 1 == QUIC_PROFILE_OPER_TYPE_COUNT,
+    "Operation types must all be tracked");
+CXPLAT_STATIC_ASSERT(
+    QUIC_API_TYPE_STRM_SEND_BATCH + 1 == QUIC_PROFILE_API_TYPE_COUNT,
+    "API types must all be tracked");
+
+#define QUIC_PROFILE_FRAME_ACK_FREQUENCY_INDEX  (QUIC_FRAME_DATAGRAM_1 + 1)
+#define QUIC_PROFILE_FRAME_TIMESTAMP_INDEX      (QUIC_FRAME_DATAGRAM_1 + 2)
+
+CXPLAT_STATIC_ASSERT(
+    QUIC_PROFILE_FRAME_TIMESTAMP_INDEX + 1 == QUIC_PROFILE_FRAME_TYPE_COUNT,
+    "Frame types must all be tracked");
+
+//
+// Names for each slot. Slots without a name are never used.
+//
+static const char* const QuicProfileOperationNames[QUIC_PROFILE_OPER_TYPE_COUNT] = {
+    "API_CALL",
+    "FLUSH_RECV",
+    "UNREACHABLE",
+    "FLUSH_STREAM_RECV",
+    "FLUSH_SEND",
+    NULL, // DEPRECATED
+    "TIMER_EXPIRED",
+    "TRACE_RUNDOWN",
+    "ROUTE_COMPLETION",
+    "VERSION_NEGOTIATION",
+    "STATELESS_RESET",
+    "RETRY",
+};
+
+static const char* const QuicProfileApiNames[QUIC_PROFILE_API_TYPE_COUNT] = {
+    "CONN_CLOSE",
+    "CONN_SHUTDOWN",
+    "CONN_START",
+    "CONN_SET_CONFIGURATION",
+    "CONN_SEND_RESUMPTION_TICKET",
+    "STRM_CLOSE",
+    "STRM_SHUTDOWN",
+    "STRM_START",
+    "STRM_SEND",
+    "STRM_RECV_COMPLETE",
+    "STRM_RECV_SET_ENABLED",
+    "SET_PARAM",
+    "GET_PARAM",
+    "DATAGRAM_SEND",
+    "CONN_COMPLETE_RESUMPTION_TICKET_VALIDATION",
+    "CONN_COMPLETE_CERTIFICATE_VALIDATION",
+    "STRM_PROVIDE_RECV_BUFFERS",
+    "STRM_SEND_BATCH",
+};
+
+static const char* const QuicProfileFrameNames[QUIC_PROFILE_FRAME_TYPE_COUNT] = {
+    "PADDING",
+    "PING",
+    "ACK",
+    "ACK_ECN",
+    "RESET_STREAM",
+    "STOP_SENDING",
+    "CRYPTO",
+    "NEW_TOKEN",
+    "STREAM",
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, // STREAM variants
+    "MAX_DATA",
+    "MAX_STREAM_DATA",
+    "MAX_STREAMS_BIDI",
+    "MAX_STREAMS_UNI",
+    "DATA_BLOCKED",
+    "STREAM_DATA_BLOCKED",
+    "STREAMS_BLOCKED_BIDI",
+    "STREAMS_BLOCKED_UNI",
+    "NEW_CONNECTION_ID",
+    "RETIRE_CONNECTION_ID",
+    "PATH_CHALLENGE",
+    "PATH_RESPONSE",
+    "CONNECTION_CLOSE",
+    "CONNECTION_CLOSE_APP",
+    "HANDSHAKE_DONE",
+    "IMMEDIATE_ACK",
+    NULL, // 0x20
+    "RELIABLE_RESET_STREAM",
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, // 0x22 - 0x28
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, // 0x29 - 0x2f
+    "DATAGRAM",
+    "DATAGRAM_LEN",
+    "ACK_FREQUENCY",
+    "TIMESTAMP",
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicProfileFrameIndex(
+    _In_ uint64_t FrameType
+    )
+{
+    if (FrameType >= QUIC_FRAME_STREAM && FrameType <= QUIC_FRAME_STREAM_7) {
+        return QUIC_FRAME_STREAM;
+    }
+    if (FrameType <= QUIC_FRAME_DATAGRAM_1) {
+        return (uint32_t)FrameType;
+    }
+    if (FrameType == QUIC_FRAME_ACK_FREQUENCY) {
+        return QUIC_PROFILE_FRAME_ACK_FREQUENCY_INDEX;
+    }
+    CXPLAT_DBG_ASSERT(FrameType == QUIC_FRAME_TIMESTAMP);
+    return QUIC_PROFILE_FRAME_TIMESTAMP_INDEX;
+}
+
+static
+uint32_t
+QuicProfileWriteCategory(
+    _In_ QUIC_PROFILE_CATEGORY Category,
+    _In_reads_(Count) const QUIC_PROFILE_COUNTER* Counters,
+    _In_reads_(Count) const char* const* Names,
+    _In_ uint32_t Count,
+    _Out_writes_bytes_opt_(MaxEntries * sizeof(QUIC_PROFILE_ENTRY))
+        QUIC_PROFILE_ENTRY* Entries,
+    _In_ uint32_t MaxEntries
+    )
+{
+    uint32_t Written = 0;
+    for (uint32_t i = 0; i < Count; ++i) {
+        if (Names[i] == NULL) {
+            continue;
+        }
+        if (Entries != NULL && Written < MaxEntries) {
+            QUIC_PROFILE_ENTRY* Entry = &Entries[Written];
+            CxPlatZeroMemory(Entry, sizeof(*Entry));
+            Entry->Category = Category;
+            Entry->Type = i;
+            Entry->Samples = (uint64_t)Counters[i].Samples;
+            Entry->Cycles = (uint64_t)Counters[i].Cycles;
+            const size_t NameLength = strlen(Names[i]);
+            CXPLAT_DBG_ASSERT(NameLength < sizeof(Entry->Name));
+            CxPlatCopyMemory(Entry->Name, Names[i], NameLength);
+        }
+        Written++;
+    }
+    return Written;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicProfileGetEntries(
+    _In_ const QUIC_PROFILE* Profile,
+    _Inout_ uint32_t* BufferLength,
+    _Out_writes_bytes_opt_(*BufferLength)
+        void* Buffer
+    )
+{
+    const uint32_t TotalEntries =
+        QuicProfileWriteCategory(
+            QUIC_PROFILE_CATEGORY_OPERATION, Profile->Operations,
+            QuicProfileOperationNames, QUIC_PROFILE_OPER_TYPE_COUNT, NULL, 0) +
+        QuicProfileWriteCategory(
+            QUIC_PROFILE_CATEGORY_API_CALL, Profile->ApiCalls,
+            QuicProfileApiNames, QUIC_PROFILE_API_TYPE_COUNT, NULL, 0) +
+        QuicProfileWriteCategory(
+            QUIC_PROFILE_CATEGORY_FRAME, Profile->Frames,
+            QuicProfileFrameNames, QUIC_PROFILE_FRAME_TYPE_COUNT, NULL, 0);
+
+    if (*BufferLength < sizeof(QUIC_PROFILE_ENTRY)) {
+        *BufferLength = TotalEntries * sizeof(QUIC_PROFILE_ENTRY);
+        return QUIC_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    if (Buffer == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    //
+    // Copy as many entries as will fit completely in the buffer.
+    //
+    QUIC_PROFILE_ENTRY* Entries = (QUIC_PROFILE_ENTRY*)Buffer;
+    uint32_t MaxEntries = *BufferLength / sizeof(QUIC_PROFILE_ENTRY);
+    uint32_t Written =
+        QuicProfileWriteCategory(
+            QUIC_PROFILE_CATEGORY_OPERATION, Profile->Operations,
+            QuicProfileOperationNames, QUIC_PROFILE_OPER_TYPE_COUNT,
+            Entries, MaxEntries);
+    Written +=
+        QuicProfileWriteCategory(
+            QUIC_PROFILE_CATEGORY_API_CALL, Profile->ApiCalls,
+            QuicProfileApiNames, QUIC_PROFILE_API_TYPE_COUNT,
+            Entries + CXPLAT_MIN(Written, MaxEntries), MaxEntries - CXPLAT_MIN(Written, MaxEntries));
+    Written +=
+        QuicProfileWriteCategory(
+            QUIC_PROFILE_CATEGORY_FRAME, Profile->Frames,
+            QuicProfileFrameNames, QUIC_PROFILE_FRAME_TYPE_COUNT,
+            Entries + CXPLAT_MIN(Written, MaxEntries), MaxEntries - CXPLAT_MIN(Written, MaxEntries));
+
+    *BufferLength = CXPLAT_MIN(Written, MaxEntries) * sizeof(QUIC_PROFILE_ENTRY);
+    return QUIC_STATUS_SUCCESS;
+}
@@ -0,0 +1,98 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// Only one in this many connection operations and received packets is timed.
+// Must be a power of two.
+//
+#define QUIC_PROFILE_SAMPLE_INTERVAL    16
+
+//
+// The number of distinct QUIC_OPERATION_TYPE and QUIC_API_TYPE values.
+//
+#define QUIC_PROFILE_OPER_TYPE_COUNT    12
+#define QUIC_PROFILE_API_TYPE_COUNT     18
+
+//
+// Frame types up to DATAGRAM are tracked by type (with all STREAM variants
+// folded into one), followed by one slot each for ACK_FREQUENCY and TIMESTAMP.
+//
+#define QUIC_PROFILE_FRAME_TYPE_COUNT   0x34
+
+typedef struct QUIC_PROFILE_COUNTER {
+
+    int64_t Samples;
+    int64_t Cycles;
+
+} QUIC_PROFILE_COUNTER;
+
+//
+// Sampled cycle accounting, kept per partition like the perf counters.
+//
+typedef struct QUIC_PROFILE {
+
+    QUIC_PROFILE_COUNTER Operations[QUIC_PROFILE_OPER_TYPE_COUNT];
+    QUIC_PROFILE_COUNTER ApiCalls[QUIC_PROFILE_API_TYPE_COUNT];
+    QUIC_PROFILE_COUNTER Frames[QUIC_PROFILE_FRAME_TYPE_COUNT];
+
+} QUIC_PROFILE;
+
+//
+// Returns TRUE if the event with this sequence number should be timed.
+//
+QUIC_INLINE
+BOOLEAN
+QuicProfileShouldSample(
+    _In_ uint64_t Sequence
+    )
+{
+    return (Sequence & (QUIC_PROFILE_SAMPLE_INTERVAL - 1)) == 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicProfileRecord(
+    _In_ QUIC_PROFILE_COUNTER* Counter,
+    _In_ uint64_t Cycles
+    )
+{
+    InterlockedIncrement64(&Counter->Samples);
+    InterlockedExchangeAdd64(&Counter->Cycles, (int64_t)Cycles);
+}
+
+//
+// Returns the QUIC_PROFILE.Frames index for a (known) frame type.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicProfileFrameIndex(
+    _In_ uint64_t FrameType
+    );
+
+//
+// Writes one named QUIC_PROFILE_ENTRY per tracked operation, API and frame
+// type, for QUIC_PARAM_GLOBAL_PROFILE.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicProfileGetEntries(
+    _In_ const QUIC_PROFILE* Profile,
+    _Inout_ uint32_t* BufferLength,
+    _Out_writes_bytes_opt_(*BufferLength)
+        void* Buffer
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -103,6 +103,23 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MIN_ACK_SEND_NUMBER                2
 
+//
+// When the congestion controller is in steady state, the peer is asked (via
+// ACK_FREQUENCY) to acknowledge about this many times per congestion window.
+//
+#define QUIC_ACK_FREQUENCY_ACKS_PER_CWND        4
+
+//
+// The maximum packet tolerance we will ask the peer to use.
+//
+#define QUIC_MAX_ACK_FREQUENCY_PACKET_TOLERANCE 64
+
+//
+// One in this many ACK frames is timed for the ACK processing time histogram.
+// Must be a power of two.
+//
+#define QUIC_ACK_PROCESSING_SAMPLE_INTERVAL     16
+
 //
 // The value for Reordering threshold when no ACK_FREQUENCY frame is received.
 // This means that the receiver will immediately acknowledge any out-of-order packets.
@@ -335,11 +352,17 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_DEFAULT_KEEP_ALIVE_INTERVAL        0
 
 //
-// The flow control window is doubled when more than (1 / ratio) of the current
-// window is delivered to the app within 1 RTT.
+// The flow control window is updated (and auto-tuned) each time more than
+// (1 / ratio) of the current window has been delivered to the app.
 //
 #define QUIC_RECV_BUFFER_DRAIN_RATIO            4
 
+//
+// Receive window auto-tuning targets this multiple of the bandwidth-delay
+// product, estimated from the rate the app drains the stream.
+//
+#define QUIC_RECV_WINDOW_BDP_MULTIPLIER         2
+
 //
 // The default value for send buffering being enabled or not.
 //
@@ -356,6 +379,12 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_MAX_IDEAL_SEND_BUFFER_SIZE         0x8000000 // 134217728
 
+//
+// How far ahead of the data being sent (in bytes) the OS is asked to read
+// StreamSendFile data, so the reads on the worker thread hit the page cache.
+//
+#define QUIC_SEND_FILE_READ_AHEAD               0x100000 // 1048576
+
 //
 // The minimum number of bytes of send allowance we must have before we will
 // send another packet.
@@ -373,6 +402,38 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_MAX_PATH_COUNT                     4
 
+//
+// How long, in milliseconds, the congestion window of a path that is no longer
+// active is remembered for, in case the connection migrates back to it.
+//
+#define QUIC_PATH_CC_CACHE_LIFETIME_MS          10000
+
+//
+// The number of samples kept in a connection's telemetry ring, when enabled.
+// Must be a power of two.
+//
+#define QUIC_TELEMETRY_SAMPLE_COUNT             256
+
+//
+// The smallest allowed interval, in milliseconds, between telemetry samples.
+//
+#define QUIC_TELEMETRY_MIN_INTERVAL_MS          1
+
+//
+// Blocks handed out by a connection's arena are rounded up to a multiple of
+// this size, and each multiple up to QUIC_ARENA_MAX_BLOCK_SIZE has its own
+// free list. Larger requests go to the heap.
+//
+#define QUIC_ARENA_BLOCK_ALIGNMENT              16
+#define QUIC_ARENA_MAX_BLOCK_SIZE               128
+
+//
+// Bounds for the slab size given by QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE.
+// Slabs start at that size and double, up to QUIC_ARENA_MAX_SLAB_SIZE.
+//
+#define QUIC_ARENA_MIN_SLAB_SIZE                256
+#define QUIC_ARENA_MAX_SLAB_SIZE                4096
+
 //
 // Maximum number of connection IDs accepted from the peer.
 //
@@ -504,6 +565,12 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_DEST_CID_UPDATE_IDLE_TIMEOUT_MS 20000
 
+//
+// The default period a connection must be quiescent before its buffers are
+// released (hibernated). Zero disables hibernation.
+//
+#define QUIC_DEFAULT_HIBERNATE_TIMEOUT_MS           0
+
 //
 // The default value for enabling grease quic bit extension.
 //
@@ -673,6 +740,7 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_INITIAL_WINDOW_PACKETS         "InitialWindowPackets"
 #define QUIC_SETTING_SEND_IDLE_TIMEOUT_MS           "SendIdleTimeoutMs"
 #define QUIC_SETTING_DEST_CID_UPDATE_IDLE_TIMEOUT_MS "DestCidUpdateIdleTimeoutMs"
+#define QUIC_SETTING_HIBERNATE_TIMEOUT_MS           "HibernateTimeoutMs"
 
 #define QUIC_SETTING_INITIAL_RTT                    "InitialRttMs"
 #define QUIC_SETTING_MAX_ACK_DELAY                  "MaxAckDelayMs"
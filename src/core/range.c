@@ -49,6 +49,31 @@ QuicRangeReset(
     Range->UsedLength = 0;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRangeCompact(
+    _Inout_ QUIC_RANGE* Range
+    )
+{
+    if (Range->AllocLength == QUIC_RANGE_INITIAL_SUB_COUNT) {
+        return;
+    }
+
+    uint32_t DropCount = 0;
+    if (Range->UsedLength > QUIC_RANGE_INITIAL_SUB_COUNT) {
+        DropCount = Range->UsedLength - QUIC_RANGE_INITIAL_SUB_COUNT;
+        Range->UsedLength = QUIC_RANGE_INITIAL_SUB_COUNT;
+    }
+
+    CxPlatCopyMemory(
+        Range->PreAllocSubRanges,
+        Range->SubRanges + DropCount,
+        Range->UsedLength * sizeof(QUIC_SUBRANGE));
+    CXPLAT_FREE(Range->SubRanges, QUIC_POOL_RANGE);
+    Range->SubRanges = Range->PreAllocSubRanges;
+    Range->AllocLength = QUIC_RANGE_INITIAL_SUB_COUNT;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
 BOOLEAN
@@ -387,6 +412,56 @@ QuicRangeAddValue(
     return QuicRangeAddRange(Range, Value, 1, &DontCare) != NULL;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicRangeAddDescending(
+    _Inout_ QUIC_RANGE* Range,
+    _In_ uint64_t Low,
+    _In_ uint64_t Count
+    )
+{
+    CXPLAT_DBG_ASSERT(Count > 0);
+    CXPLAT_DBG_ASSERT(
+        Range->UsedLength == 0 ||
+        Low + Count < QuicRangeGet(Range, Range->UsedLength - 1)->Low);
+
+    if (Range->UsedLength == Range->AllocLength) {
+        //
+        // Unlike QuicRangeMakeSpace, never age out existing values to make
+        // room. They are all larger than the new one.
+        //
+        if (!QuicRangeGrow(Range, Range->UsedLength)) {
+            return FALSE;
+        }
+    } else {
+        Range->UsedLength++;
+    }
+
+    QUIC_SUBRANGE* Sub = QuicRangeGet(Range, Range->UsedLength - 1);
+    Sub->Low = Low;
+    Sub->Count = Count;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRangeCompleteDescending(
+    _Inout_ QUIC_RANGE* Range
+    )
+{
+    if (Range->UsedLength < 2) {
+        return;
+    }
+    QUIC_SUBRANGE* Front = Range->SubRanges;
+    QUIC_SUBRANGE* Back = Range->SubRanges + Range->UsedLength - 1;
+    while (Front < Back) {
+        QUIC_SUBRANGE Temp = *Front;
+        *Front++ = *Back;
+        *Back-- = Temp;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
 BOOLEAN
@@ -402,21 +477,14 @@ QuicRangeRemoveRange(
     // and returns TRUE).
     //
 
-    uint32_t i;
-    QUIC_SUBRANGE* Sub = NULL;
-    QUIC_SUBRANGE* Test;
-
     //
-    // Find the leftmost overlapping subrange.
+    // Find the leftmost overlapping subrange. The first subrange that ends at
+    // or after "low" is the only candidate, since the subranges are sorted and
+    // don't overlap each other.
     //
-    for (i = 0; (Test = QuicRangeGetSafe(Range, i)) != NULL; i++) {
-        if (Test->Low < Low + Count &&
-            Test->Low + Test->Count > Low) {
-            Sub = Test;
-            break;
-        }
-    }
-    if (Sub == NULL) {
+    uint32_t i = QuicRangeLowerBound(Range, Low);
+    QUIC_SUBRANGE* Sub = QuicRangeGetSafe(Range, i);
+    if (Sub == NULL || Sub->Low >= Low + Count) {
         return TRUE;
     }
 
@@ -481,20 +549,11 @@ QuicRangeSetMin(
     //
     // Drop all values less than "low".
     //
-    uint32_t i = 0;
-    QUIC_SUBRANGE* Sub = NULL;
-    while (i < QuicRangeSize(Range)) {
-        Sub = QuicRangeGet(Range, i);
-        if (Sub->Low >= Low) {
-            break;
-        }
-
-        if (QuicRangeGetHigh(Sub) >= Low) {
-            Sub->Count -= Low - Sub->Low;
-            Sub->Low = Low;
-            break;
-        }
-        i++;
+    uint32_t i = QuicRangeLowerBound(Range, Low);
+    QUIC_SUBRANGE* Sub = QuicRangeGetSafe(Range, i);
+    if (Sub != NULL && Sub->Low < Low) {
+        Sub->Count -= Low - Sub->Low;
+        Sub->Low = Low;
     }
     if (i > 0) {
         QuicRangeRemoveSubranges(Range, 0, i);
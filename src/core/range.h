@@ -228,6 +228,32 @@ QuicRangeSearch(
 
 #endif
 
+//
+// O(log(n))
+// Returns the index of the first subrange whose largest value is greater than
+// or equal to the passed in value, or the number of subranges if there is no
+// such subrange.
+//
+QUIC_INLINE
+uint32_t
+QuicRangeLowerBound(
+    _In_ const QUIC_RANGE* Range,
+    _In_ uint64_t Value
+    )
+{
+    uint32_t Lo = 0;
+    uint32_t Hi = Range->UsedLength;
+    while (Lo < Hi) {
+        const uint32_t Mid = Lo + (Hi - Lo) / 2;
+        if (QuicRangeGetHigh(QuicRangeGet(Range, Mid)) < Value) {
+            Lo = Mid + 1;
+        } else {
+            Hi = Mid;
+        }
+    }
+    return Lo;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRangeInitialize(
@@ -250,6 +276,17 @@ QuicRangeReset(
     _Inout_ QUIC_RANGE* Range
     );
 
+//
+// Frees the subrange array if it has grown past the preallocated one. If more
+// than QUIC_RANGE_INITIAL_SUB_COUNT subranges are in use, the smallest ones
+// are dropped, as when the range hits its maximum allocation size.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRangeCompact(
+    _Inout_ QUIC_RANGE* Range
+    );
+
 //
 // O(n)      when QUIC_RANGE_USE_BINARY_SEARCH == 0
 // O(log(n)) when QUIC_RANGE_USE_BINARY_SEARCH == 1
@@ -298,6 +335,34 @@ QuicRangeAddRange(
     _Out_ BOOLEAN* RangeUpdated
     );
 
+//
+// O(1) amortized
+// Appends a subrange that is less than, and not adjacent to, all the
+// subranges already added. This never moves existing subranges, which makes it
+// the cheap way to fill a range from a source ordered from largest to smallest
+// (i.e. an ACK frame). Until QuicRangeCompleteDescending is called, the
+// subranges are stored in descending order and no other range function may be
+// used. Returns FALSE if the range can't grow to hold the new subrange.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicRangeAddDescending(
+    _Inout_ QUIC_RANGE* Range,
+    _In_ uint64_t LowValue,
+    _In_ uint64_t Count
+    );
+
+//
+// O(n) Puts subranges added by QuicRangeAddDescending back into ascending
+// order.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRangeCompleteDescending(
+    _Inout_ QUIC_RANGE* Range
+    );
+
 //
 // Removes a number of subranges from the range. Returns TRUE if the list was
 // shrunk (reallocated) because of the removal operation.
@@ -311,8 +376,9 @@ QuicRangeRemoveSubranges(
     );
 
 //
-// O(n) Removes a range of values from the range object. Returns TRUE if
-// successful or FALSE on an allocation failure.
+// O(log(n) + m) Removes a range of values from the range object, where m is
+// the number of subranges it overlaps. Returns TRUE if successful or FALSE on
+// an allocation failure.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
@@ -324,7 +390,8 @@ QuicRangeRemoveRange(
     );
 
 //
-// Drops all values in the range below the input value.
+// O(log(n)) Drops all values in the range below the input value (plus the cost
+// of moving down the remaining subranges).
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
@@ -338,6 +338,68 @@ QuicRecvBufferUninitialize(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferHibernate(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    CXPLAT_DBG_ASSERT(
+        RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_SINGLE ||
+        RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_CIRCULAR);
+
+    if (CxPlatListIsEmpty(&RecvBuffer->Chunks)) {
+        return TRUE; // Already hibernated.
+    }
+
+    if (RecvBuffer->ReadPendingLength != 0 ||
+        RecvBuffer->RetiredChunk != NULL ||
+        RecvBuffer->Chunks.Flink->Flink != &RecvBuffer->Chunks ||
+        QuicRecvBufferGetTotalLength(RecvBuffer) != RecvBuffer->BaseOffset) {
+        return FALSE;
+    }
+
+    QUIC_RECV_CHUNK* Chunk =
+        CXPLAT_CONTAINING_RECORD(
+            CxPlatListRemoveHead(&RecvBuffer->Chunks),
+            QUIC_RECV_CHUNK,
+            Link);
+    CXPLAT_DBG_ASSERT(!Chunk->ExternalReference);
+    RecvBuffer->Capacity = Chunk->AllocLength;
+    RecvBuffer->ReadStart = 0;
+    RecvBuffer->ReadLength = 0;
+    QuicRecvChunkFree(Chunk);
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferRehydrate(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    if (!CxPlatListIsEmpty(&RecvBuffer->Chunks)) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    CXPLAT_DBG_ASSERT(RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_APP_OWNED);
+    QUIC_RECV_CHUNK* Chunk =
+        CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_RECV_CHUNK) + RecvBuffer->Capacity, QUIC_POOL_RECVBUF);
+    if (Chunk == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "recv_buffer",
+            sizeof(QUIC_RECV_CHUNK) + RecvBuffer->Capacity);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    QuicRecvChunkInitialize(Chunk, RecvBuffer->Capacity, (uint8_t*)(Chunk + 1), FALSE);
+    CxPlatListInsertHead(&RecvBuffer->Chunks, &Chunk->Link);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint64_t
 QuicRecvBufferGetTotalLength(
@@ -390,7 +452,7 @@ QuicRecvBufferIncreaseVirtualBufferLength(
     )
 {
     CXPLAT_DBG_ASSERT(RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_APP_OWNED);
-    CXPLAT_DBG_ASSERT(NewLength >= RecvBuffer->VirtualBufferLength); // Don't support decrease.
+    CXPLAT_DBG_ASSERT(NewLength >= RecvBuffer->VirtualBufferLength);
     RecvBuffer->VirtualBufferLength = NewLength;
 }
 
@@ -438,7 +500,8 @@ QuicRecvBufferProvideChunks(
 //
 // Allocates a new contiguous buffer of the target size. Depending on the
 // receive mode and any external references, this may copy the existing buffer,
-// or it may simply be used for new data.
+// or it may simply be used for new data. A buffer with a single chunk that
+// isn't referenced can also be shrunk, as long as the data still fits.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
@@ -457,8 +520,11 @@ QuicRecvBufferResize(
 
     QUIC_RECV_CHUNK* LastChunk =
         CXPLAT_CONTAINING_RECORD(RecvBuffer->Chunks.Blink, QUIC_RECV_CHUNK, Link);
-    CXPLAT_DBG_ASSERT(TargetBufferLength > LastChunk->AllocLength); // Should only be called when buffer needs to grow
     BOOLEAN LastChunkIsFirst = LastChunk->Link.Blink == &RecvBuffer->Chunks;
+    CXPLAT_DBG_ASSERT(
+        TargetBufferLength > LastChunk->AllocLength ||
+        (LastChunkIsFirst && !LastChunk->ExternalReference &&
+         TargetBufferLength >= QuicRecvBufferGetSpan(RecvBuffer)));
 
     QUIC_RECV_CHUNK* NewChunk =
         CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_RECV_CHUNK) + TargetBufferLength, QUIC_POOL_RECVBUF);
@@ -541,6 +607,40 @@ QuicRecvBufferResize(
     return TRUE;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferDecreaseVirtualBufferLength(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t NewLength
+    )
+{
+    CXPLAT_DBG_ASSERT(RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_APP_OWNED);
+    CXPLAT_DBG_ASSERT(NewLength <= RecvBuffer->VirtualBufferLength);
+    CXPLAT_DBG_ASSERT(
+        RecvBuffer->BaseOffset + NewLength >= QuicRecvBufferGetTotalLength(RecvBuffer));
+    RecvBuffer->VirtualBufferLength = NewLength;
+
+    //
+    // Give back the memory the smaller window no longer needs. This is only
+    // done while the buffer is a single chunk that isn't being read, so the
+    // data can simply be copied over; otherwise the chunk is kept.
+    //
+    if (CxPlatListIsEmpty(&RecvBuffer->Chunks) ||
+        RecvBuffer->ReadPendingLength != 0 ||
+        RecvBuffer->Chunks.Flink->Flink != &RecvBuffer->Chunks) {
+        return;
+    }
+    QUIC_RECV_CHUNK* Chunk =
+        CXPLAT_CONTAINING_RECORD(RecvBuffer->Chunks.Flink, QUIC_RECV_CHUNK, Link);
+    uint32_t TargetLength = Chunk->AllocLength;
+    while (TargetLength / 2 >= NewLength) {
+        TargetLength /= 2;
+    }
+    if (TargetLength < Chunk->AllocLength && !Chunk->ExternalReference) {
+        (void)QuicRecvBufferResize(RecvBuffer, TargetLength);
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint32_t
 QuicRecvBufferGetTotalAllocLength(
@@ -124,6 +124,27 @@ QuicRecvBufferUninitialize(
     _In_ QUIC_RECV_BUFFER* RecvBuffer
     );
 
+//
+// Frees the chunk of an empty buffer, keeping its offsets, so an idle owner
+// doesn't hold on to memory. Returns FALSE (and frees nothing) if the buffer
+// holds any data or is being read. Only valid for SINGLE and CIRCULAR modes.
+// QuicRecvBufferRehydrate must be called before the buffer is used again.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferHibernate(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer
+    );
+
+//
+// Allocates a new chunk, of the size freed by QuicRecvBufferHibernate.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferRehydrate(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer
+    );
+
 //
 // Get the buffer's total length from offset 0. This does not necessarily mean
 // all of this buffer is available to be read, as some of it may have already
@@ -154,6 +175,18 @@ QuicRecvBufferIncreaseVirtualBufferLength(
     _In_ uint32_t NewLength
     );
 
+//
+// Shrinks the buffer's virtual buffer length, and the chunk backing it if it
+// is no longer needed and isn't being read. The caller must not have allowed
+// the peer to write beyond BaseOffset + NewLength.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferDecreaseVirtualBufferLength(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t NewLength
+    );
+
 //
 // Provide app-owned buffers. At least one chunk must be provided.
 // Only valid for QUIC_RECV_BUF_MODE_APP_OWNED mode.
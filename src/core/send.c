@@ -33,6 +33,8 @@ QuicSendInitialize(
     )
 {
     CxPlatListInitializeHead(&Send->SendStreams);
+    CxPlatListInitializeHead(&Send->ParkedStreams);
+    Send->SchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
     Send->MaxData = Settings->ConnFlowControlWindow;
 }
 
@@ -64,9 +66,19 @@ QuicSendUninitialize(
         Entry = Entry->Flink;
         Stream->SendFlags = 0;
         Stream->SendLink.Flink = NULL;
+        Stream->SendParkedLink.Flink = NULL;
 
         QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
     }
+
+    CxPlatListInitializeHead(&Send->ParkedStreams);
+    Send->ParkedStreamCount = 0;
+    Send->StreamHeapCount = 0;
+    if (Send->StreamHeap != NULL) {
+        CXPLAT_FREE(Send->StreamHeap, QUIC_POOL_STREAM_HEAP);
+        Send->StreamHeap = NULL;
+        Send->StreamHeapCapacity = 0;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -139,6 +151,400 @@ QuicSendQueueFlush(
     }
 }
 
+#define QUIC_STREAM_HEAP_INITIAL_CAPACITY 8
+
+//
+// Returns TRUE if the scheduling scheme keeps the queued streams in the heap.
+//
+#define QUIC_SEND_SCHEME_USES_HEAP(Scheme) \
+    ((Scheme) == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR || \
+     (Scheme) == QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE)
+
+//
+// The weighted fair queuing virtual time advanced by one byte at the lowest
+// priority. A stream's weight is its priority plus one.
+//
+#define QUIC_WFQ_VIRTUAL_TIME_SCALE 0x10000ULL
+
+//
+// Returns TRUE if stream A should be sent before stream B. Ties are broken by
+// priority and then by stream ID.
+//
+QUIC_INLINE
+BOOLEAN
+QuicSendStreamHeapLess(
+    _In_ const QUIC_SEND* Send,
+    _In_ const QUIC_STREAM* A,
+    _In_ const QUIC_STREAM* B
+    )
+{
+    if (Send->SchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR) {
+        if (A->SendVirtualFinish != B->SendVirtualFinish) {
+            return A->SendVirtualFinish < B->SendVirtualFinish;
+        }
+    } else {
+        if (A->SendDeadline != B->SendDeadline) {
+            return A->SendDeadline < B->SendDeadline;
+        }
+    }
+    if (A->SendPriority != B->SendPriority) {
+        return A->SendPriority > B->SendPriority;
+    }
+    return A->ID < B->ID;
+}
+
+QUIC_INLINE
+void
+QuicSendStreamHeapSet(
+    _In_ QUIC_SEND* Send,
+    _In_ uint32_t Index,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    Send->StreamHeap[Index] = Stream;
+    Stream->SendHeapIndex = Index;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamHeapFix(
+    _In_ QUIC_SEND* Send,
+    _In_ uint32_t Index
+    )
+{
+    QUIC_STREAM* Stream = Send->StreamHeap[Index];
+
+    //
+    // Sift up.
+    //
+    while (Index > 0) {
+        const uint32_t Parent = (Index - 1) / 2;
+        if (!QuicSendStreamHeapLess(Send, Stream, Send->StreamHeap[Parent])) {
+            break;
+        }
+        QuicSendStreamHeapSet(Send, Index, Send->StreamHeap[Parent]);
+        Index = Parent;
+    }
+
+    //
+    // Sift down.
+    //
+    while (TRUE) {
+        const uint32_t Left = 2 * Index + 1;
+        if (Left >= Send->StreamHeapCount) {
+            break;
+        }
+        uint32_t Child = Left;
+        if (Left + 1 < Send->StreamHeapCount &&
+            QuicSendStreamHeapLess(Send, Send->StreamHeap[Left + 1], Send->StreamHeap[Left])) {
+            Child = Left + 1;
+        }
+        if (!QuicSendStreamHeapLess(Send, Send->StreamHeap[Child], Stream)) {
+            break;
+        }
+        QuicSendStreamHeapSet(Send, Index, Send->StreamHeap[Child]);
+        Index = Child;
+    }
+
+    QuicSendStreamHeapSet(Send, Index, Stream);
+}
+
+//
+// Makes sure the heap has room for at least Count streams.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSendStreamHeapReserve(
+    _In_ QUIC_SEND* Send,
+    _In_ uint32_t Count
+    )
+{
+    if (Count > Send->StreamHeapCapacity) {
+        uint32_t NewCapacity =
+            Send->StreamHeapCapacity == 0 ?
+                QUIC_STREAM_HEAP_INITIAL_CAPACITY : Send->StreamHeapCapacity * 2;
+        if (NewCapacity < Count) {
+            NewCapacity = Count;
+        }
+        QUIC_STREAM** NewHeap =
+            CXPLAT_ALLOC_NONPAGED(NewCapacity * sizeof(QUIC_STREAM*), QUIC_POOL_STREAM_HEAP);
+        if (NewHeap == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "stream heap",
+                NewCapacity * sizeof(QUIC_STREAM*));
+            return FALSE;
+        }
+        if (Send->StreamHeap != NULL) {
+            CxPlatCopyMemory(
+                NewHeap, Send->StreamHeap, Send->StreamHeapCount * sizeof(QUIC_STREAM*));
+            CXPLAT_FREE(Send->StreamHeap, QUIC_POOL_STREAM_HEAP);
+        }
+        Send->StreamHeap = NewHeap;
+        Send->StreamHeapCapacity = NewCapacity;
+    }
+    return TRUE;
+}
+
+//
+// Adds a stream to the heap. Room must have been reserved already.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamHeapInsert(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    CXPLAT_DBG_ASSERT(Send->StreamHeapCount < Send->StreamHeapCapacity);
+    QuicSendStreamHeapSet(Send, Send->StreamHeapCount++, Stream);
+    QuicSendStreamHeapFix(Send, Stream->SendHeapIndex);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamHeapRemove(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    const uint32_t Index = Stream->SendHeapIndex;
+    CXPLAT_DBG_ASSERT(Index < Send->StreamHeapCount);
+    CXPLAT_DBG_ASSERT(Send->StreamHeap[Index] == Stream);
+
+    QUIC_STREAM* Last = Send->StreamHeap[--Send->StreamHeapCount];
+    if (Last != Stream) {
+        QuicSendStreamHeapSet(Send, Index, Last);
+        QuicSendStreamHeapFix(Send, Index);
+    }
+}
+
+//
+// Starts the scheduling state of a stream that was just queued. The clock is
+// only read for the schemes that use the heap.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamStartScheduling(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint64_t Now
+    )
+{
+    Stream->Scheduling.QueuedTimeUs = Now;
+
+    Stream->SendDeadline =
+        Stream->SchedulingDeadlineUs != 0 ?
+            Now + Stream->SchedulingDeadlineUs : UINT64_MAX;
+
+    //
+    // A stream that was idle doesn't get credit for the time it wasn't
+    // sending. It starts from the current virtual time.
+    //
+    if (Stream->SendVirtualFinish < Send->VirtualTime) {
+        Stream->SendVirtualFinish = Send->VirtualTime;
+    }
+}
+
+//
+// Rebuilds the heap from the send list after a scheme change. Room for all the
+// queued streams must have been reserved already.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamHeapRebuild(
+    _In_ QUIC_SEND* Send
+    )
+{
+    Send->StreamHeapCount = 0;
+    while (!CxPlatListIsEmpty(&Send->ParkedStreams)) {
+        CxPlatListRemoveHead(&Send->ParkedStreams)->Flink = NULL;
+    }
+    Send->ParkedStreamCount = 0;
+    if (!QUIC_SEND_SCHEME_USES_HEAP(Send->SchedulingScheme)) {
+        return;
+    }
+
+    const uint64_t Now = CxPlatTimeUs64();
+    for (CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
+         Entry != &Send->SendStreams;
+         Entry = Entry->Flink) {
+        QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+        if (Stream->Scheduling.QueuedTimeUs == 0) {
+            QuicSendStreamStartScheduling(Send, Stream, Now);
+        }
+        QuicSendStreamHeapInsert(Send, Stream);
+    }
+}
+
+//
+// Called when a stream is added to the send list.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamQueued(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (QUIC_SEND_SCHEME_USES_HEAP(Send->SchedulingScheme)) {
+        QuicSendStreamStartScheduling(Send, Stream, CxPlatTimeUs64());
+        QuicSendStreamHeapInsert(Send, Stream);
+    }
+}
+
+//
+// Removes a stream that has nothing left to send from the send list.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendDequeueStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->SendParkedLink.Flink != NULL) {
+        CxPlatListEntryRemove(&Stream->SendParkedLink);
+        Stream->SendParkedLink.Flink = NULL;
+        Send->ParkedStreamCount--;
+    } else if (QUIC_SEND_SCHEME_USES_HEAP(Send->SchedulingScheme)) {
+        QuicSendStreamHeapRemove(Send, Stream);
+    }
+    CxPlatListEntryRemove(&Stream->SendLink);
+    Stream->SendLink.Flink = NULL;
+    Stream->Scheduling.QueuedTimeUs = 0;
+    QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
+}
+
+//
+// Updates the scheduling statistics for a stream that was just picked to
+// send.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamPicked(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->Scheduling.QueuedTimeUs != 0) {
+        const uint64_t Now = CxPlatTimeUs64();
+        const uint64_t Delay = CxPlatTimeDiff64(Stream->Scheduling.QueuedTimeUs, Now);
+        Stream->Scheduling.DelayUs += Delay;
+        if (Delay > Stream->Scheduling.MaxDelayUs) {
+            Stream->Scheduling.MaxDelayUs = Delay;
+        }
+        if (Now > Stream->SendDeadline) {
+            Stream->Scheduling.DeadlineMissCount++;
+        }
+        Stream->Scheduling.QueuedTimeUs = 0;
+    }
+}
+
+//
+// Charges a stream for bytes it just framed, under weighted fair queuing.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamCharge(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint32_t Bytes
+    )
+{
+    CXPLAT_DBG_ASSERT(Send->SchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR);
+    if (Stream->SendVirtualFinish > Send->VirtualTime) {
+        Send->VirtualTime = Stream->SendVirtualFinish;
+    }
+    Stream->SendVirtualFinish +=
+        (Bytes * QUIC_WFQ_VIRTUAL_TIME_SCALE) / ((uint64_t)Stream->SendPriority + 1);
+    if (Stream->SendLink.Flink != NULL && Stream->SendParkedLink.Flink == NULL) {
+        QuicSendStreamHeapFix(Send, Stream->SendHeapIndex);
+    }
+}
+
+//
+// Returns the key streams can currently be sent with: 1-RTT, 0-RTT, or
+// QUIC_PACKET_KEY_COUNT if neither is available.
+//
+QUIC_INLINE
+QUIC_PACKET_KEY_TYPE
+QuicSendStreamWriteKey(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    if (Connection->Crypto.TlsState.WriteKey == QUIC_PACKET_KEY_1_RTT) {
+        return QUIC_PACKET_KEY_1_RTT;
+    }
+    if (Connection->Crypto.TlsState.WriteKeys[QUIC_PACKET_KEY_0_RTT] != NULL) {
+        return QUIC_PACKET_KEY_0_RTT;
+    }
+    return QUIC_PACKET_KEY_COUNT;
+}
+
+//
+// Takes a stream that can't send out of the heap, so that picking the next
+// stream doesn't keep running into it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamPark(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    CXPLAT_DBG_ASSERT(Stream->SendParkedLink.Flink == NULL);
+    QuicSendStreamHeapRemove(Send, Stream);
+    CxPlatListInsertTail(&Send->ParkedStreams, &Stream->SendParkedLink);
+    Send->ParkedStreamCount++;
+    Send->ParkedPeerMaxData = Send->PeerMaxData;
+    Send->ParkedWriteKey =
+        (uint8_t)QuicSendStreamWriteKey(QuicSendGetConnection(Send));
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUnparkStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->SendParkedLink.Flink != NULL) {
+        CxPlatListEntryRemove(&Stream->SendParkedLink);
+        Stream->SendParkedLink.Flink = NULL;
+        Send->ParkedStreamCount--;
+        QuicSendStreamHeapInsert(Send, Stream);
+    }
+}
+
+//
+// Puts all the parked streams back in the heap if the connection wide send
+// state they might have been blocked on changed since.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUnparkStreamsIfUnblocked(
+    _In_ QUIC_SEND* Send
+    )
+{
+    if (CxPlatListIsEmpty(&Send->ParkedStreams) ||
+        (Send->ParkedPeerMaxData == Send->PeerMaxData &&
+         Send->ParkedWriteKey ==
+            (uint8_t)QuicSendStreamWriteKey(QuicSendGetConnection(Send)))) {
+        return;
+    }
+
+    while (!CxPlatListIsEmpty(&Send->ParkedStreams)) {
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Send->ParkedStreams), QUIC_STREAM, SendParkedLink);
+        Stream->SendParkedLink.Flink = NULL;
+        QuicSendStreamHeapInsert(Send, Stream);
+    }
+    Send->ParkedStreamCount = 0;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendQueueFlushForStream(
@@ -148,6 +554,13 @@ QuicSendQueueFlushForStream(
     )
 {
     if (Stream->SendLink.Flink == NULL) {
+        if (QUIC_SEND_SCHEME_USES_HEAP(Send->SchedulingScheme) &&
+            !QuicSendStreamHeapReserve(
+                Send, Send->StreamHeapCount + Send->ParkedStreamCount + 1)) {
+            QuicConnFatalError(Stream->Connection, QUIC_STATUS_OUT_OF_MEMORY, "Stream heap OOM");
+            return;
+        }
+
         //
         // Not previously queued, so add the stream to the end of the queue.
         //
@@ -165,6 +578,13 @@ QuicSendQueueFlushForStream(
         }
         CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
         QuicStreamAddRef(Stream, QUIC_STREAM_REF_SEND);
+        QuicSendStreamQueued(Send, Stream);
+
+    } else {
+        //
+        // New frames might unblock the stream.
+        //
+        QuicSendUnparkStream(Send, Stream);
     }
 
     //
@@ -208,6 +628,40 @@ QuicSendUpdateStreamPriority(
         Entry = Entry->Blink;
     }
     CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+
+    if (QUIC_SEND_SCHEME_USES_HEAP(Send->SchedulingScheme) &&
+        Stream->SendParkedLink.Flink == NULL) {
+        QuicSendStreamHeapFix(Send, Stream->SendHeapIndex);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicSendSetStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM_SCHEDULING_SCHEME Scheme
+    )
+{
+    CXPLAT_DBG_ASSERT(Scheme < QUIC_STREAM_SCHEDULING_SCHEME_COUNT);
+    if (Send->SchedulingScheme == (uint8_t)Scheme) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (QUIC_SEND_SCHEME_USES_HEAP(Scheme)) {
+        uint32_t QueuedCount = 0;
+        for (CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
+             Entry != &Send->SendStreams;
+             Entry = Entry->Flink) {
+            QueuedCount++;
+        }
+        if (!QuicSendStreamHeapReserve(Send, QueuedCount)) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    Send->SchedulingScheme = (uint8_t)Scheme;
+    QuicSendStreamHeapRebuild(Send);
+    return QUIC_STATUS_SUCCESS;
 }
 
 #if DEBUG
@@ -270,9 +724,15 @@ QuicSendClear(
         CXPLAT_DBG_ASSERT(Stream->SendFlags != 0);
         Stream->SendFlags = 0;
         Stream->SendLink.Flink = NULL;
+        Stream->SendParkedLink.Flink = NULL;
+        Stream->Scheduling.QueuedTimeUs = 0;
 
         QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
     }
+
+    CxPlatListInitializeHead(&Send->ParkedStreams);
+    Send->ParkedStreamCount = 0;
+    Send->StreamHeapCount = 0;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -424,6 +884,13 @@ QuicSendSetStreamSendFlag(
             QuicSendQueueFlushForStream(Send, Stream, DelaySend);
         }
         Stream->SendFlags |= SendFlags;
+
+    } else if (SendFlags != 0) {
+        //
+        // The flags are already set, but whatever is setting them again (e.g.
+        // lost data to retransmit) might have unblocked a parked stream.
+        //
+        QuicSendUnparkStream(Send, Stream);
     }
 
     return SendFlags != 0;
@@ -437,8 +904,6 @@ QuicSendClearStreamSendFlag(
     _In_ uint32_t SendFlags
     )
 {
-    UNREFERENCED_PARAMETER(Send);
-
     if (Stream->SendFlags & SendFlags) {
 
         QuicTraceLogStreamVerbose(
@@ -456,9 +921,7 @@ QuicSendClearStreamSendFlag(
             //
             // Since there are no flags left, remove the stream from the queue.
             //
-            CxPlatListEntryRemove(&Stream->SendLink);
-            Stream->SendLink.Flink = NULL;
-            QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
+            QuicSendDequeueStream(Send, Stream);
         }
     }
 }
@@ -929,7 +1392,16 @@ QuicSendWriteFrames(
     if (Send->SendFlags & QUIC_CONN_SEND_FLAG_PING) {
 
         if (Builder->DatagramLength < AvailableBufferLength) {
-            Builder->Datagram->Buffer[Builder->DatagramLength++] = QUIC_FRAME_PING;
+            //
+            // If the peer has been asked to acknowledge less often, use an
+            // IMMEDIATE_ACK frame instead, so that probes and keep alives
+            // still get a prompt response.
+            //
+            const QUIC_FRAME_TYPE PingType =
+                (Builder->EncryptLevel == QUIC_ENCRYPT_LEVEL_1_RTT &&
+                 Connection->PeerPacketTolerance > QUIC_MIN_ACK_SEND_NUMBER) ?
+                    QUIC_FRAME_IMMEDIATE_ACK : QUIC_FRAME_PING;
+            Builder->Datagram->Buffer[Builder->DatagramLength++] = (uint8_t)PingType;
             Send->SendFlags &= ~QUIC_CONN_SEND_FLAG_PING;
             if (Connection->KeepAlivePadding) {
                 Builder->MinimumDatagramLength =
@@ -940,7 +1412,7 @@ QuicSendWriteFrames(
             } else {
                 Builder->MinimumDatagramLength = (uint16_t)Builder->Datagram->Length;
             }
-            if (QuicPacketBuilderAddFrame(Builder, QUIC_FRAME_PING, TRUE)) {
+            if (QuicPacketBuilderAddFrame(Builder, PingType, TRUE)) {
                 return TRUE;
             }
         } else {
@@ -968,17 +1440,14 @@ QuicSendCanSendStreamNow(
 {
     CXPLAT_DBG_ASSERT(Stream->SendFlags != 0);
 
-    QUIC_CONNECTION* Connection = Stream->Connection;
-
-    if (Connection->Crypto.TlsState.WriteKey == QUIC_PACKET_KEY_1_RTT) {
+    switch (QuicSendStreamWriteKey(Stream->Connection)) {
+    case QUIC_PACKET_KEY_1_RTT:
         return QuicStreamCanSendNow(Stream, FALSE);
-    }
-
-    if (Connection->Crypto.TlsState.WriteKeys[QUIC_PACKET_KEY_0_RTT] != NULL) {
+    case QUIC_PACKET_KEY_0_RTT:
         return QuicStreamCanSendNow(Stream, TRUE);
+    default:
+        return FALSE;
     }
-
-    return FALSE;
 }
 
 _Success_(return != NULL)
@@ -988,8 +1457,41 @@ QuicSendGetNextStream(
     _Out_ uint32_t* PacketCount
     )
 {
-    QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
-    CXPLAT_DBG_ASSERT(!QuicConnIsClosed(Connection) || CxPlatListIsEmpty(&Send->SendStreams));
+    CXPLAT_DBG_ASSERT(
+        !QuicConnIsClosed(QuicSendGetConnection(Send)) ||
+        CxPlatListIsEmpty(&Send->SendStreams));
+
+    if (QUIC_SEND_SCHEME_USES_HEAP(Send->SchedulingScheme)) {
+        QuicSendUnparkStreamsIfUnblocked(Send);
+
+        //
+        // Streams that can't send are parked until something that might
+        // unblock them changes, so each one is only passed over once.
+        //
+        QUIC_STREAM* Stream;
+        while (TRUE) {
+            if (Send->StreamHeapCount == 0) {
+                return NULL;
+            }
+            Stream = Send->StreamHeap[0];
+            if (QuicSendCanSendStreamNow(Stream)) {
+                break;
+            }
+            QuicSendStreamPark(Send, Stream);
+        }
+
+        QuicSendStreamPicked(Stream);
+
+        //
+        // Weighted fair queuing re-evaluates the order after every packet
+        // since each one changes the stream's virtual finish time. Deadlines
+        // don't change while sending, so just stick with the stream.
+        //
+        *PacketCount =
+            Send->SchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR ?
+                1 : UINT32_MAX;
+        return Stream;
+    }
 
     CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
     while (Entry != &Send->SendStreams) {
@@ -1007,7 +1509,9 @@ QuicSendGetNextStream(
         //
         if (QuicSendCanSendStreamNow(Stream)) {
 
-            if (Connection->State.UseRoundRobinStreamScheduling) {
+            QuicSendStreamPicked(Stream);
+
+            if (Send->SchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN) {
                 //
                 // Move the stream after any streams of the same priority. Start
                 // with the "next" entry in the list and keep going until the
@@ -1401,16 +1905,21 @@ QuicSendFlush(
             //
             // Write the stream frames.
             //
-            WrotePacketFrames |= QuicStreamSendWrite(Stream, &Builder);
+            const uint16_t PrevDatagramLength = Builder.DatagramLength;
+            if (QuicStreamSendWrite(Stream, &Builder)) {
+                WrotePacketFrames = TRUE;
+                if (Send->SchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR) {
+                    QuicSendStreamCharge(
+                        Send, Stream, Builder.DatagramLength - PrevDatagramLength);
+                }
+            }
 
             if (Stream->SendFlags == 0 && Stream->SendLink.Flink != NULL) {
                 //
                 // If the stream no longer has anything to send, remove it from the
                 // list and release Send's reference on it.
                 //
-                CxPlatListEntryRemove(&Stream->SendLink);
-                Stream->SendLink.Flink = NULL;
-                QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
+                QuicSendDequeueStream(Send, Stream);
                 Stream = NULL;
 
             } else if ((WrotePacketFrames && --StreamPacketCount == 0) ||
@@ -1492,7 +2001,7 @@ QuicSendFlush(
             // should expect more than a single batch before needing to send an
             // acknowledgment back.
             //
-            QuicConnUpdatePeerPacketTolerance(Connection, Builder.TotalCountDatagrams + 1);
+            QuicConnUpdateAckFrequency(Connection, (uint8_t)(Builder.TotalCountDatagrams + 1));
         }
 
     } else if (Builder.TotalCountDatagrams > Connection->PeerPacketTolerance) {
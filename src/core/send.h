@@ -317,6 +317,40 @@ typedef struct QUIC_SEND {
     //
     CXPLAT_LIST_ENTRY SendStreams;
 
+    //
+    // The stream scheduling scheme (QUIC_STREAM_SCHEDULING_SCHEME) in use.
+    //
+    uint8_t SchedulingScheme;
+
+    //
+    // Binary min-heap of the streams in SendStreams, ordered by their virtual
+    // finish time or deadline. Only maintained for the weighted fair and
+    // deadline scheduling schemes.
+    //
+    QUIC_STREAM** StreamHeap;
+    uint32_t StreamHeapCount;
+    uint32_t StreamHeapCapacity;
+
+    //
+    // Streams in SendStreams taken out of the heap because they couldn't send
+    // when picked. They go back in the heap when they might be unblocked.
+    //
+    CXPLAT_LIST_ENTRY ParkedStreams;
+    uint32_t ParkedStreamCount;
+
+    //
+    // The connection wide send state when the last stream was parked. If it
+    // changes, all the parked streams might be unblocked.
+    //
+    uint64_t ParkedPeerMaxData;
+    uint8_t ParkedWriteKey;
+
+    //
+    // The weighted fair queuing virtual time; the virtual finish time of the
+    // last stream picked to send.
+    //
+    uint64_t VirtualTime;
+
     //
     // The current token to send with an Initial packet.
     //
@@ -411,6 +445,17 @@ QuicSendQueueFlushForStream(
     _In_ BOOLEAN DelaySend
     );
 
+//
+// Puts a stream that was parked because it couldn't send back in the
+// scheduling heap, after something that might have unblocked it changed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUnparkStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    );
+
 //
 // Updates the stream's order in response to a priority change.
 //
@@ -421,6 +466,17 @@ QuicSendUpdateStreamPriority(
     _In_ QUIC_STREAM* Stream
     );
 
+//
+// Changes the stream scheduling scheme, reordering any queued streams. Fails
+// if the heap used by the new scheme can't be allocated.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicSendSetStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM_SCHEDULING_SCHEME Scheme
+    );
+
 //
 // Tries to drain all queued data that needs to be sent. Returns TRUE if all the
 // data was drained.
@@ -17,6 +17,12 @@ Abstract:
     We copy requests into fixed-sized blocks when possible, and fall back on
     CXPLAT_ALLOC for large send requests.
 
+    Requests queued with QUIC_SEND_FLAG_NO_COPY are not copied. Their bytes
+    count toward BufferedBytes just the same, but the send buffer references
+    the app's buffers, and the request is completed once all of its bytes
+    have been acknowledged (possibly before earlier bytes on the stream are).
+    This keeps large sends zero-copy while preserving the IdealBytes limit.
+
     We buffer send requests until we've buffered AT LEAST the desired number
     of bytes, rather than using the ideal buffer size as a hard limit. This
     covers several corner cases (such as an app that posts sends larger than
@@ -112,6 +118,27 @@ QuicSendBufferFree(
     SendBuffer->BufferedBytes -= Size;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendBufferReference(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ uint64_t Size
+    )
+{
+    SendBuffer->BufferedBytes += Size;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendBufferRelease(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ uint64_t Size
+    )
+{
+    CXPLAT_DBG_ASSERT(SendBuffer->BufferedBytes >= Size);
+    SendBuffer->BufferedBytes -= Size;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicSendBufferHasSpace(
@@ -162,12 +189,12 @@ QuicSendBufferFill(
         // should happen in order).
         //
         Req = Stream->SendRequests;
-        while (Req != NULL && !!(Req->Flags & QUIC_SEND_FLAG_BUFFERED)) {
+        while (Req != NULL && !!(Req->Flags & QUIC_SEND_FLAGS_IN_SEND_BUFFER)) {
             Req = Req->Next;
         }
         CXPLAT_DBG_ASSERT(Req == Stream->SendBufferBookmark);
         while (Req != NULL) {
-            CXPLAT_DBG_ASSERT(!(Req->Flags & QUIC_SEND_FLAG_BUFFERED));
+            CXPLAT_DBG_ASSERT(!(Req->Flags & QUIC_SEND_FLAGS_IN_SEND_BUFFER));
             Req = Req->Next;
         }
 #endif
@@ -60,6 +60,24 @@ QuicSendBufferFree(
     _In_ uint32_t Size
     );
 
+//
+// Accounts for app-owned bytes the send buffer holds a reference on instead
+// of a copy. Released once the bytes are acknowledged or canceled.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendBufferReference(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ uint64_t Size
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendBufferRelease(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ uint64_t Size
+    );
+
 //
 // Buffers pending send requests until the send buffer is full.
 // Should be called when the send buffer is adjusted or bytes are ACKed.
@@ -14,6 +14,12 @@ Abstract:
     contained in the packet. The allocator uses a different pool for each
     possible size.
 
+    Outstanding packets are tracked by a QUIC_SENT_PACKET_STORE, a ring buffer
+    indexed by packet number. The store keeps the fields needed to scan for
+    acknowledged and lost packets in parallel arrays, separate from the
+    metadata, so that those scans stay cache friendly even with very large
+    numbers of packets in flight.
+
 --*/
 
 #include "precomp.h"
@@ -134,3 +140,170 @@ QuicSentPacketPoolReturnPacketMetadata(
     QuicSentPacketMetadataReleaseFrames(Metadata, Connection);
     CxPlatPoolFree(Metadata);
 }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketStoreInitialize(
+    _Out_ QUIC_SENT_PACKET_STORE* Store
+    )
+{
+    CxPlatZeroMemory(Store, sizeof(*Store));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketStoreUninitialize(
+    _In_ QUIC_SENT_PACKET_STORE* Store
+    )
+{
+    CXPLAT_DBG_ASSERT(Store->PacketCount == 0);
+    if (Store->Packets != NULL) {
+        CXPLAT_FREE(Store->Packets, QUIC_POOL_META);
+    }
+    CxPlatZeroMemory(Store, sizeof(*Store));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketStoreCompact(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store
+    )
+{
+    if (Store->PacketCount == 0) {
+        Store->BasePacketNumber += Store->Span;
+        Store->Head = 0;
+        Store->Span = 0;
+        return;
+    }
+
+    while (Store->Packets[Store->Head] == NULL) {
+        CXPLAT_DBG_ASSERT(Store->Span > 1);
+        Store->Head = (Store->Head + 1) & (Store->Capacity - 1);
+        Store->BasePacketNumber++;
+        Store->Span--;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketStoreRelease(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store
+    )
+{
+    CXPLAT_DBG_ASSERT(Store->PacketCount == 0);
+    QuicSentPacketStoreCompact(Store);
+    if (Store->Packets != NULL) {
+        CXPLAT_FREE(Store->Packets, QUIC_POOL_META);
+        Store->Packets = NULL;
+        Store->SentTimes = NULL;
+        Store->PacketLengths = NULL;
+        Store->Flags = NULL;
+        Store->Capacity = 0;
+    }
+}
+
+//
+// Reallocates the slot arrays so that at least MinCapacity slots are available.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicSentPacketStoreGrow(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _In_ uint32_t MinCapacity
+    )
+{
+    uint32_t NewCapacity =
+        Store->Capacity == 0 ?
+            QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY : Store->Capacity;
+    while (NewCapacity < MinCapacity) {
+        NewCapacity <<= 1;
+    }
+
+    const uint64_t SlotSize =
+        sizeof(QUIC_SENT_PACKET_METADATA*) +
+        sizeof(uint64_t) +
+        sizeof(uint16_t) +
+        sizeof(QUIC_SENT_PACKET_STORE_FLAGS);
+    const uint64_t AllocSize = SlotSize * NewCapacity;
+    if (AllocSize > SIZE_MAX) {
+        return FALSE;
+    }
+
+    uint8_t* Buffer = CXPLAT_ALLOC_NONPAGED((size_t)AllocSize, QUIC_POOL_META);
+    if (Buffer == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Sent packet store",
+            AllocSize);
+        return FALSE;
+    }
+
+    QUIC_SENT_PACKET_METADATA** Packets = (QUIC_SENT_PACKET_METADATA**)Buffer;
+    uint64_t* SentTimes = (uint64_t*)(Packets + NewCapacity);
+    uint16_t* PacketLengths = (uint16_t*)(SentTimes + NewCapacity);
+    QUIC_SENT_PACKET_STORE_FLAGS* Flags = (QUIC_SENT_PACKET_STORE_FLAGS*)(PacketLengths + NewCapacity);
+
+    CxPlatZeroMemory(Packets, sizeof(QUIC_SENT_PACKET_METADATA*) * NewCapacity);
+
+    for (uint32_t i = 0; i < Store->Span; i++) {
+        const uint32_t Slot = QuicSentPacketStoreSlot(Store, i);
+        Packets[i] = Store->Packets[Slot];
+        SentTimes[i] = Store->SentTimes[Slot];
+        PacketLengths[i] = Store->PacketLengths[Slot];
+        Flags[i] = Store->Flags[Slot];
+    }
+
+    if (Store->Packets != NULL) {
+        CXPLAT_FREE(Store->Packets, QUIC_POOL_META);
+    }
+
+    Store->Packets = Packets;
+    Store->SentTimes = SentTimes;
+    Store->PacketLengths = PacketLengths;
+    Store->Flags = Flags;
+    Store->Capacity = NewCapacity;
+    Store->Head = 0;
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketStoreAdd(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+    QuicSentPacketStoreCompact(Store);
+
+    if (Store->Span == 0) {
+        Store->BasePacketNumber = Packet->PacketNumber;
+    }
+
+    CXPLAT_DBG_ASSERT(Packet->PacketNumber >= Store->BasePacketNumber + Store->Span);
+    const uint64_t Offset = Packet->PacketNumber - Store->BasePacketNumber;
+    if (Offset >= QUIC_SENT_PACKET_STORE_MAX_CAPACITY) {
+        return FALSE;
+    }
+
+    const uint32_t Position = (uint32_t)Offset;
+    if (Position >= Store->Capacity &&
+        !QuicSentPacketStoreGrow(Store, Position + 1)) {
+        return FALSE;
+    }
+
+    Store->Span = Position + 1;
+    Store->PacketCount++;
+
+    const uint32_t Slot = QuicSentPacketStoreSlot(Store, Position);
+    CXPLAT_DBG_ASSERT(Store->Packets[Slot] == NULL);
+    Store->Packets[Slot] = Packet;
+    Store->SentTimes[Slot] = Packet->SentTime;
+    Store->PacketLengths[Slot] = Packet->PacketLength;
+    Store->Flags[Slot].KeyType = Packet->Flags.KeyType;
+    Store->Flags[Slot].IsAckEliciting = Packet->Flags.IsAckEliciting;
+
+    return TRUE;
+}
@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 //
 // The maximum number of frames we will write to a single packet.
 //
@@ -243,3 +247,243 @@ QuicSentPacketPoolReturnPacketMetadata(
     _In_ QUIC_SENT_PACKET_METADATA* Metadata,
     _In_ QUIC_CONNECTION* Connection
     );
+
+//
+// Initial number of slots allocated for a sent packet store the first time a
+// packet is added to it.
+//
+#define QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY 64
+
+//
+// The store is never allowed to grow past this many slots.
+//
+#define QUIC_SENT_PACKET_STORE_MAX_CAPACITY     0x80000000u
+
+//
+// The flags of a sent packet that the store keeps a copy of. Only flags that
+// are final when the packet is added, and never change afterwards, belong here.
+//
+typedef struct QUIC_SENT_PACKET_STORE_FLAGS {
+
+    uint8_t KeyType                 : 2;
+    BOOLEAN IsAckEliciting          : 1;
+
+} QUIC_SENT_PACKET_STORE_FLAGS;
+
+//
+// A packet number indexed ring buffer of outstanding sent packets.
+//
+// Slot 'i' (relative to Head) tracks packet number 'BasePacketNumber + i'. The
+// fields that are read while scanning for acknowledged or lost packets are
+// kept in parallel arrays so that those scans walk contiguous memory instead
+// of chasing pointers to individually allocated metadata. The full metadata
+// (including the frames) is only touched once a packet is actually acked,
+// lost or discarded.
+//
+// Packet numbers must be added in strictly increasing order. Packet numbers
+// that were never tracked, or that have already been removed, leave empty
+// (NULL) slots. Empty slots at the front are reclaimed by
+// QuicSentPacketStoreCompact, which is the only operation (other than Add)
+// that changes the position of a packet in the store.
+//
+typedef struct QUIC_SENT_PACKET_STORE {
+
+    //
+    // The packet number tracked by the slot at Head.
+    //
+    uint64_t BasePacketNumber;
+
+    //
+    // Index of the first slot in use.
+    //
+    uint32_t Head;
+
+    //
+    // Number of slots from Head up to and including the last packet added.
+    //
+    uint32_t Span;
+
+    //
+    // Number of allocated slots. Always zero or a power of two.
+    //
+    uint32_t Capacity;
+
+    //
+    // Number of non-empty slots.
+    //
+    uint32_t PacketCount;
+
+    //
+    // Parallel arrays, each with Capacity entries.
+    //
+    QUIC_SENT_PACKET_METADATA** Packets;
+    uint64_t* SentTimes;
+    uint16_t* PacketLengths;
+    QUIC_SENT_PACKET_STORE_FLAGS* Flags;
+
+} QUIC_SENT_PACKET_STORE;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketStoreInitialize(
+    _Out_ QUIC_SENT_PACKET_STORE* Store
+    );
+
+//
+// Frees the slot arrays. The store must be empty.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketStoreUninitialize(
+    _In_ QUIC_SENT_PACKET_STORE* Store
+    );
+
+//
+// Adds a packet to the end of the store. Its packet number must be larger than
+// any other packet ever added since the store was last empty. Returns FALSE if
+// the store could not be grown to hold the packet.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketStoreAdd(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    );
+
+//
+// Reclaims the empty slots at the front of the store. This invalidates any
+// previously calculated positions.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketStoreCompact(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store
+    );
+
+//
+// Frees the slot arrays of an empty store. The next Add allocates them again.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketStoreRelease(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store
+    );
+
+//
+// Returns the number of positions to iterate over, some of which may be empty.
+//
+QUIC_INLINE
+uint32_t
+QuicSentPacketStoreSpan(
+    _In_ const QUIC_SENT_PACKET_STORE* Store
+    )
+{
+    return Store->Span;
+}
+
+//
+// Returns TRUE if no packets are tracked.
+//
+QUIC_INLINE
+BOOLEAN
+QuicSentPacketStoreIsEmpty(
+    _In_ const QUIC_SENT_PACKET_STORE* Store
+    )
+{
+    return Store->PacketCount == 0;
+}
+
+//
+// Converts a position (relative to the first slot in use) to an index into the
+// slot arrays.
+//
+QUIC_INLINE
+uint32_t
+QuicSentPacketStoreSlot(
+    _In_ const QUIC_SENT_PACKET_STORE* Store,
+    _In_ uint32_t Position
+    )
+{
+    CXPLAT_DBG_ASSERT(Position < Store->Span);
+    return (Store->Head + Position) & (Store->Capacity - 1);
+}
+
+//
+// Returns the packet number tracked at the given position.
+//
+QUIC_INLINE
+uint64_t
+QuicSentPacketStorePacketNumber(
+    _In_ const QUIC_SENT_PACKET_STORE* Store,
+    _In_ uint32_t Position
+    )
+{
+    return Store->BasePacketNumber + Position;
+}
+
+//
+// Returns the packet at the given position, or NULL if the slot is empty.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketStoreGet(
+    _In_ const QUIC_SENT_PACKET_STORE* Store,
+    _In_ uint32_t Position
+    )
+{
+    return Store->Packets[QuicSentPacketStoreSlot(Store, Position)];
+}
+
+//
+// Removes and returns the packet at the given position. The slot is left
+// empty; positions of the other packets are not changed.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketStoreRemove(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _In_ uint32_t Position
+    )
+{
+    const uint32_t Slot = QuicSentPacketStoreSlot(Store, Position);
+    QUIC_SENT_PACKET_METADATA* Packet = Store->Packets[Slot];
+    CXPLAT_DBG_ASSERT(Packet != NULL);
+    CXPLAT_DBG_ASSERT(Store->PacketCount > 0);
+    Store->Packets[Slot] = NULL;
+    Store->PacketCount--;
+    return Packet;
+}
+
+//
+// Calculates the positions covering the packet numbers [Low, High]. Returns
+// FALSE if none of the packet numbers fall within the store.
+//
+QUIC_INLINE
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketStoreFindRange(
+    _In_ const QUIC_SENT_PACKET_STORE* Store,
+    _In_ uint64_t Low,
+    _In_ uint64_t High,
+    _Out_ uint32_t* Start,
+    _Out_ uint32_t* End // Exclusive
+    )
+{
+    if (Store->Span == 0 ||
+        High < Store->BasePacketNumber ||
+        Low >= Store->BasePacketNumber + Store->Span) {
+        return FALSE;
+    }
+    *Start =
+        Low <= Store->BasePacketNumber ?
+            0 : (uint32_t)(Low - Store->BasePacketNumber);
+    *End =
+        High - Store->BasePacketNumber >= Store->Span ?
+            Store->Span : (uint32_t)(High - Store->BasePacketNumber + 1);
+    return TRUE;
+}
+
+#if defined(__cplusplus)
+}
+#endif
@@ -144,6 +144,9 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.DestCidUpdateIdleTimeoutMs) {
         Settings->DestCidUpdateIdleTimeoutMs = QUIC_DEFAULT_DEST_CID_UPDATE_IDLE_TIMEOUT_MS;
     }
+    if (!Settings->IsSet.HibernateTimeoutMs) {
+        Settings->HibernateTimeoutMs = QUIC_DEFAULT_HIBERNATE_TIMEOUT_MS;
+    }
     if (!Settings->IsSet.GreaseQuicBitEnabled) {
         Settings->GreaseQuicBitEnabled = QUIC_DEFAULT_GREASE_QUIC_BIT_ENABLED;
     }
@@ -321,6 +324,9 @@ QuicSettingsCopy(
     if (!Destination->IsSet.DestCidUpdateIdleTimeoutMs) {
         Destination->DestCidUpdateIdleTimeoutMs = Source->DestCidUpdateIdleTimeoutMs;
     }
+    if (!Destination->IsSet.HibernateTimeoutMs) {
+        Destination->HibernateTimeoutMs = Source->HibernateTimeoutMs;
+    }
     if (!Destination->IsSet.GreaseQuicBitEnabled) {
         Destination->GreaseQuicBitEnabled = Source->GreaseQuicBitEnabled;
     }
@@ -694,6 +700,11 @@ QuicSettingApply(
         Destination->IsSet.DestCidUpdateIdleTimeoutMs = TRUE;
     }
 
+    if (Source->IsSet.HibernateTimeoutMs && (!Destination->IsSet.HibernateTimeoutMs || OverWrite)) {
+        Destination->HibernateTimeoutMs = Source->HibernateTimeoutMs;
+        Destination->IsSet.HibernateTimeoutMs = TRUE;
+    }
+
     if (Source->IsSet.GreaseQuicBitEnabled && (!Destination->IsSet.GreaseQuicBitEnabled || OverWrite)) {
         Destination->GreaseQuicBitEnabled = Source->GreaseQuicBitEnabled;
         Destination->IsSet.GreaseQuicBitEnabled = TRUE;
@@ -1335,6 +1346,16 @@ VersionSettingsFail:
             &ValueLen);
         Settings->DestCidUpdateIdleTimeoutMs = Value;
     }
+    if (!Settings->IsSet.HibernateTimeoutMs) {
+        Value = QUIC_DEFAULT_HIBERNATE_TIMEOUT_MS;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_HIBERNATE_TIMEOUT_MS,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->HibernateTimeoutMs = Value;
+    }
     if (!Settings->IsSet.GreaseQuicBitEnabled) {
         Value = QUIC_DEFAULT_GREASE_QUIC_BIT_ENABLED;
         ValueLen = sizeof(Value);
@@ -1506,6 +1527,7 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingDumpStatelessOperExpirMs,    "[sett] StatelessOperExpirMs   = %hu", Settings->StatelessOperationExpirationMs);
     QuicTraceLogVerbose(SettingCongestionControlAlgorithm,  "[sett] CongestionControlAlgorithm = %hu", Settings->CongestionControlAlgorithm);
     QuicTraceLogVerbose(SettingDestCidUpdateIdleTimeoutMs,  "[sett] DestCidUpdateIdleTimeoutMs = %u", Settings->DestCidUpdateIdleTimeoutMs);
+    QuicTraceLogVerbose(SettingDumpHibernateTimeoutMs,      "[sett] HibernateTimeoutMs     = %u", Settings->HibernateTimeoutMs);
     QuicTraceLogVerbose(SettingGreaseQuicBitEnabled,        "[sett] GreaseQuicBitEnabled   = %hhu", Settings->GreaseQuicBitEnabled);
     QuicTraceLogVerbose(SettingEcnEnabled,                  "[sett] EcnEnabled             = %hhu", Settings->EcnEnabled);
     QuicTraceLogVerbose(SettingHyStartEnabled,              "[sett] HyStartEnabled         = %hhu", Settings->HyStartEnabled);
@@ -1657,6 +1679,9 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.DestCidUpdateIdleTimeoutMs) {
         QuicTraceLogVerbose(SettingDestCidUpdateIdleTimeoutMs,      "[sett] DestCidUpdateIdleTimeoutMs = %u", Settings->DestCidUpdateIdleTimeoutMs);
     }
+    if (Settings->IsSet.HibernateTimeoutMs) {
+        QuicTraceLogVerbose(SettingDumpHibernateTimeoutMs,          "[sett] HibernateTimeoutMs     = %u", Settings->HibernateTimeoutMs);
+    }
     if (Settings->IsSet.GreaseQuicBitEnabled) {
         QuicTraceLogVerbose(SettingGreaseQuicBitEnabled,            "[sett] GreaseQuicBitEnabled   = %hhu", Settings->GreaseQuicBitEnabled);
     }
@@ -1972,6 +1997,13 @@ QuicSettingsSettingsToInternal(
         SettingsSize,
         InternalSettings);
 
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        HibernateTimeoutMs,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -2165,6 +2197,13 @@ QuicSettingsGetSettings(
         *SettingsLength,
         InternalSettings);
 
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        HibernateTimeoutMs,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     *SettingsLength = CXPLAT_MIN(*SettingsLength, sizeof(QUIC_SETTINGS));
 
     return QUIC_STATUS_SUCCESS;
@@ -65,7 +65,8 @@ typedef struct QUIC_SETTINGS_INTERNAL {
             uint64_t XdpEnabled                             : 1;
             uint64_t QTIPEnabled                            : 1;
             uint64_t RioEnabled                             : 1;
-            uint64_t RESERVED                               : 13;
+            uint64_t HibernateTimeoutMs                     : 1;
+            uint64_t RESERVED                               : 12;
         } IsSet;
     };
 
@@ -91,6 +92,7 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint32_t DisconnectTimeoutMs;
     uint32_t KeepAliveIntervalMs;
     uint32_t DestCidUpdateIdleTimeoutMs;
+    uint32_t HibernateTimeoutMs;
     uint32_t FixedServerID;                 // Global only
     uint16_t PeerBidiStreamCount;
     uint16_t PeerUnidiStreamCount;
@@ -161,6 +161,7 @@ QuicStreamInitialize(
 
     Stream->MaxAllowedRecvOffset = Stream->RecvBuffer.VirtualBufferLength;
     Stream->RecvWindowLastUpdate = CxPlatTimeUs64();
+    Stream->RecvWindowMin = FlowControlWindowSize;
 
     QuicConnAddRef(Connection, QUIC_CONN_REF_STREAM);
 
@@ -689,6 +690,48 @@ QuicStreamParamSet(
         break;
     }
 
+    case QUIC_PARAM_STREAM_SCHEDULING_DEADLINE:
+
+        if (BufferLength != sizeof(uint64_t) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Takes effect the next time the stream is queued to send.
+        //
+        Stream->SchedulingDeadlineUs = *(uint64_t*)Buffer;
+
+        QuicTraceLogStreamInfo(
+            UpdateSchedulingDeadline,
+            Stream,
+            "New scheduling deadline = %llu us",
+            Stream->SchedulingDeadlineUs);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_STREAM_SEND_EXPIRY:
+
+        if (BufferLength != sizeof(uint64_t) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Only applies to sends with QUIC_SEND_FLAG_EXPIRES queued from now on.
+        //
+        Stream->SendExpiryUs = *(uint64_t*)Buffer;
+
+        QuicTraceLogStreamInfo(
+            UpdateSendExpiry,
+            Stream,
+            "New send expiry = %llu us",
+            Stream->SendExpiryUs);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
    case QUIC_PARAM_STREAM_RELIABLE_OFFSET:
 
         if (BufferLength != sizeof(uint64_t) || Buffer == NULL) {
@@ -851,7 +894,7 @@ QuicStreamParamGet(
 
     case QUIC_PARAM_STREAM_STATISTICS: {
 
-        if (*BufferLength < sizeof(QUIC_STREAM_STATISTICS)) {
+        if (*BufferLength < QUIC_STREAM_STATISTICS_SIZE_1) {
             *BufferLength = sizeof(QUIC_STREAM_STATISTICS);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
@@ -916,11 +959,64 @@ QuicStreamParamGet(
         }
         Stats->ConnBlockedByFlowControlUs -= Stream->BlockedTimings.CachedConnFlowControlUs;
 
-        *BufferLength = sizeof(QUIC_STREAM_STATISTICS);
+        if (CXPLAT_STRUCT_HAS_FIELD(QUIC_STREAM_STATISTICS, *BufferLength, SchedulingDeadlineMissCount)) {
+            Stats->SchedulingDelayUs = Stream->Scheduling.DelayUs;
+            Stats->SchedulingMaxDelayUs = Stream->Scheduling.MaxDelayUs;
+            if (Stream->Scheduling.QueuedTimeUs != 0) {
+                //
+                // Include the time spent waiting so far.
+                //
+                const uint64_t Delay =
+                    CxPlatTimeDiff64(Stream->Scheduling.QueuedTimeUs, Now);
+                Stats->SchedulingDelayUs += Delay;
+                if (Delay > Stats->SchedulingMaxDelayUs) {
+                    Stats->SchedulingMaxDelayUs = Delay;
+                }
+            }
+            Stats->SchedulingDeadlineMissCount = Stream->Scheduling.DeadlineMissCount;
+        }
+
+        *BufferLength = CXPLAT_MIN(*BufferLength, sizeof(QUIC_STREAM_STATISTICS));
         Status = QUIC_STATUS_SUCCESS;
         break;
     }
 
+    case QUIC_PARAM_STREAM_SCHEDULING_DEADLINE:
+
+        if (*BufferLength < sizeof(uint64_t)) {
+            *BufferLength = sizeof(uint64_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint64_t);
+        *(uint64_t*)Buffer = Stream->SchedulingDeadlineUs;
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_STREAM_SEND_EXPIRY:
+
+        if (*BufferLength < sizeof(uint64_t)) {
+            *BufferLength = sizeof(uint64_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint64_t);
+        *(uint64_t*)Buffer = Stream->SendExpiryUs;
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     case QUIC_PARAM_STREAM_RELIABLE_OFFSET:
         if (*BufferLength < sizeof(uint64_t)) {
             *BufferLength = sizeof(uint64_t);
@@ -9,6 +9,10 @@
 #include "stream.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 
 //
@@ -45,10 +49,28 @@ typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 // Internal send flags. The public ones are defined in msquic.h.
 //
 #define QUIC_SEND_FLAG_BUFFERED     ((QUIC_SEND_FLAGS)0x80000000)
+#define QUIC_SEND_FLAG_REFERENCED   ((QUIC_SEND_FLAGS)0x40000000)
+#define QUIC_SEND_FLAG_COMPLETED    ((QUIC_SEND_FLAGS)0x20000000)
+#define QUIC_SEND_FLAG_FILE         ((QUIC_SEND_FLAGS)0x10000000)
+#define QUIC_SEND_FLAG_SACKED       ((QUIC_SEND_FLAGS)0x08000000)
 
 #define QUIC_SEND_FLAGS_INTERNAL \
 ( \
-    QUIC_SEND_FLAG_BUFFERED \
+    QUIC_SEND_FLAG_BUFFERED | \
+    QUIC_SEND_FLAG_REFERENCED | \
+    QUIC_SEND_FLAG_COMPLETED | \
+    QUIC_SEND_FLAG_FILE | \
+    QUIC_SEND_FLAG_SACKED \
+)
+
+//
+// Requests the send buffer has taken, either by copying (BUFFERED) or by
+// referencing the app's buffers until the data is acknowledged (REFERENCED).
+//
+#define QUIC_SEND_FLAGS_IN_SEND_BUFFER \
+( \
+    QUIC_SEND_FLAG_BUFFERED | \
+    QUIC_SEND_FLAG_REFERENCED \
 )
 
 #define QUIC_STREAM_PRIORITY_DEFAULT 0x7FFF // Medium priority by default
@@ -90,10 +112,37 @@ typedef struct QUIC_SEND_REQUEST {
     uint64_t TotalLength;
 
     //
-    // Data descriptor for buffered requests.
+    // The absolute time (in microseconds) after which lost data from this
+    // request is no longer retransmitted, or zero if it never expires.
+    //
+    uint64_t ExpiryTime;
+
+    //
+    // For datagrams, the send priority (higher is sent first) and the key of
+    // the older queued datagram this one replaces, or zero.
+    //
+    uint16_t DatagramPriority;
+    uint32_t DatagramKey;
+
+    //
+    // Data descriptor for buffered and file requests.
     //
     QUIC_BUFFER InternalBuffer;
 
+#ifndef _KERNEL_MODE
+    //
+    // The file, and the file offset of the first byte, for requests queued
+    // with StreamSendFile (QUIC_SEND_FLAG_FILE). Their data is read from the
+    // file when frames are written. ReadAheadLength is how much of the range
+    // the OS has been asked to read ahead, and ReadStatus the reason the
+    // send failed, if a read did.
+    //
+    QUIC_FILE File;
+    uint64_t FileOffset;
+    uint32_t ReadAheadLength;
+    QUIC_STATUS ReadStatus;
+#endif
+
     //
     // API Client completion context.
     //
@@ -147,6 +196,9 @@ typedef union QUIC_STREAM_FLAGS {
         BOOLEAN SendDelayed             : 1;    // A delayed send is currently queued.
         BOOLEAN CancelOnLoss            : 1;    // Indicates that the stream is to be canceled
                                                 // if loss is detected.
+        BOOLEAN SendExpiring            : 1;    // Sends with an expiry time have been queued.
+        BOOLEAN SendExpired             : 1;    // The send path was reset because a send expired.
+        BOOLEAN SendFileReadFailed      : 1;    // The send path is being reset because a file read failed.
 
         BOOLEAN HandleSendShutdown      : 1;    // Send shutdown complete callback delivered.
         BOOLEAN HandleShutdown          : 1;    // Shutdown callback delivered.
@@ -306,6 +358,12 @@ typedef struct QUIC_STREAM {
     QUIC_SEND_REQUEST* SendRequests;
     QUIC_SEND_REQUEST** SendRequestsTail;
 
+    //
+    // The number of queued referenced requests that haven't been SACKed yet.
+    // SACK updates only look for requests to release while this is non-zero.
+    //
+    uint32_t UnsackedReferencedRequestCount;
+
     //
     // Shortcut pointer: NULL, or the request containing the next byte to send.
     //
@@ -370,6 +428,13 @@ typedef struct QUIC_STREAM {
     //
     uint64_t ReliableOffsetSend;
 
+    //
+    // The app configured time (in microseconds) after data is queued with
+    // QUIC_SEND_FLAG_EXPIRES that it is no longer retransmitted. Zero if not
+    // set.
+    //
+    uint64_t SendExpiryUs;
+
     #define RECOV_WINDOW_OPEN(S) ((S)->RecoveryNextOffset < (S)->RecoveryEndOffset)
 
     //
@@ -388,6 +453,36 @@ typedef struct QUIC_STREAM {
     //
     uint16_t SendPriority;
 
+    //
+    // The index of the stream in the send module's scheduling heap, if queued
+    // there.
+    //
+    uint32_t SendHeapIndex;
+
+    //
+    // The list entry in the send module's parked list, while the stream is
+    // out of the scheduling heap because it can't send. NULL Flink otherwise.
+    //
+    CXPLAT_LIST_ENTRY SendParkedLink;
+
+    //
+    // The virtual time at which the stream's data sent so far would finish
+    // under weighted fair queuing.
+    //
+    uint64_t SendVirtualFinish;
+
+    //
+    // The absolute time (in microseconds) the stream should be picked to send
+    // by under the deadline scheduling scheme, or UINT64_MAX if none.
+    //
+    uint64_t SendDeadline;
+
+    //
+    // The app configured time (in microseconds) after data is queued that the
+    // stream should be picked to send by. Zero if not set.
+    //
+    uint64_t SchedulingDeadlineUs;
+
     //
     // Recv State
     //
@@ -406,10 +501,21 @@ typedef struct QUIC_STREAM {
     uint64_t RecvWindowBytesDelivered;
 
     //
-    // Timestamp of the last recv window update.
+    // The number of bytes delivered to the app since RecvWindowLastUpdate,
+    // used to estimate the delivery rate for receive window auto-tuning.
+    //
+    uint64_t RecvWindowSampleBytes;
+
+    //
+    // Timestamp of the last recv window auto-tuning sample.
     //
     uint64_t RecvWindowLastUpdate;
 
+    //
+    // The initial recv window. Auto-tuning never shrinks the window below it.
+    //
+    uint32_t RecvWindowMin;
+
     //
     // The structure for tracking received buffers.
     //
@@ -470,6 +576,16 @@ typedef struct QUIC_STREAM {
         uint64_t CachedConnCongestionControlUs;
         uint64_t CachedConnFlowControlUs;
     } BlockedTimings;
+
+    //
+    // Stream scheduling statistics.
+    //
+    struct {
+        uint64_t QueuedTimeUs; // Non-zero while waiting to be picked to send.
+        uint64_t DelayUs;
+        uint64_t MaxDelayUs;
+        uint64_t DeadlineMissCount;
+    } Scheduling;
 } QUIC_STREAM;
 
 //
@@ -1018,6 +1134,16 @@ QuicStreamRecv(
     _Inout_ BOOLEAN* UpdatedFlowControl
     );
 
+//
+// Re-evaluates the stream's receive window from the rate the app has drained
+// it over at least one RTT.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamTuneRecvWindow(
+    _In_ QUIC_STREAM* Stream
+    );
+
 //
 // Processes queued events and delivers them to the API client.
 //
@@ -1056,3 +1182,7 @@ QuicStreamProvideRecvBuffers(
     _In_ QUIC_STREAM* Stream,
     _Inout_ CXPLAT_LIST_ENTRY* /* QUIC_RECV_CHUNK */ Chunks
     );
+
+#if defined(__cplusplus)
+}
+#endif
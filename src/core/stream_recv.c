@@ -526,6 +526,16 @@ QuicStreamProcessStreamFrame(
         }
 
         Stream->Connection->Stats.Recv.TotalStreamBytes += Frame->Length;
+
+        //
+        // The window is normally tuned as the app drains the stream, but it
+        // is also re-evaluated here so that it still shrinks if the app
+        // stops draining.
+        //
+        if (Stream->RecvBuffer.VirtualBufferLength != 0 &&
+            !Stream->Flags.UseAppOwnedRecvBuffers) {
+            QuicStreamTuneRecvWindow(Stream);
+        }
     }
 
     if (Frame->Fin) {
@@ -655,6 +665,7 @@ QuicStreamRecv(
             //
             QuicStreamRemoveOutFlowBlockedReason(
                 Stream, QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL);
+            QuicSendUnparkStream(&Stream->Connection->Send, Stream);
             QuicSendClearStreamSendFlag(
                 &Stream->Connection->Send,
                 Stream,
@@ -727,6 +738,89 @@ QuicStreamRecv(
     return Status;
 }
 
+//
+// Receive window auto-tuning:
+//
+// The stream's window must cover the bandwidth-delay product (BDP) of the path
+// for the peer not to be flow control limited, but any more than that only
+// lets data pile up in the buffer. As Linux does for TCP receive buffers, the
+// BDP is estimated from the rate the app drained the stream over at least one
+// RTT, and the window is set to QUIC_RECV_WINDOW_BDP_MULTIPLIER times that, so
+// the peer's congestion window still has room to grow. While the window is the
+// limit, the estimate is the window itself and the window doubles every RTT.
+// Once it isn't, the window settles at 2x BDP rather than the next power of
+// two. If the app drains at less than half the rate the window allows, the
+// window is halved, down to its initial size, each RTT.
+//
+// The window is always kept between the initial stream window and the
+// connection's flow control window, and never shrunk below what has already
+// been advertised to the peer. Shrinking the window also shrinks the buffer's
+// chunk when it can.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamTuneRecvWindow(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    const uint64_t Elapsed = CxPlatTimeDiff64(Stream->RecvWindowLastUpdate, TimeNow);
+    const uint64_t Rtt = Stream->Connection->Paths[0].SmoothedRtt;
+    if (Elapsed < Rtt || Elapsed == 0) {
+        return; // Keep sampling for at least one RTT.
+    }
+
+    const uint32_t CurrentWindow = Stream->RecvBuffer.VirtualBufferLength;
+    const uint32_t MaxWindow =
+        CXPLAT_MAX(Stream->Connection->Settings.ConnFlowControlWindow, Stream->RecvWindowMin);
+    uint64_t TargetWindow =
+        (QUIC_RECV_WINDOW_BDP_MULTIPLIER * Stream->RecvWindowSampleBytes * Rtt) / Elapsed;
+    if (TargetWindow > MaxWindow) {
+        TargetWindow = MaxWindow;
+    }
+
+    if (TargetWindow > CurrentWindow) {
+        QuicRecvBufferIncreaseVirtualBufferLength(
+            &Stream->RecvBuffer,
+            (uint32_t)TargetWindow);
+
+        QuicTraceLogStreamVerbose(
+            IncreaseRxBuffer,
+            Stream,
+            "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
+            (uint32_t)TargetWindow,
+            Stream->Connection->Paths[0].MinRtt,
+            TimeNow,
+            Stream->RecvWindowLastUpdate);
+
+    } else if (TargetWindow < CurrentWindow / 2) {
+        //
+        // Credit already given to the peer can't be taken back.
+        //
+        const uint64_t Advertised =
+            Stream->MaxAllowedRecvOffset - Stream->RecvBuffer.BaseOffset;
+        uint64_t NewWindow = CXPLAT_MAX(CurrentWindow / 2, Stream->RecvWindowMin);
+        NewWindow = CXPLAT_MAX(NewWindow, Advertised);
+        if (NewWindow < CurrentWindow) {
+            QuicRecvBufferDecreaseVirtualBufferLength(
+                &Stream->RecvBuffer,
+                (uint32_t)NewWindow);
+
+            QuicTraceLogStreamVerbose(
+                DecreaseRxBuffer,
+                Stream,
+                "Decreasing max RX buffer size to %u (SmoothedRtt=%llu; Delivered=%llu; Elapsed=%llu)",
+                (uint32_t)NewWindow,
+                Rtt,
+                Stream->RecvWindowSampleBytes,
+                Elapsed);
+        }
+    }
+
+    Stream->RecvWindowLastUpdate = TimeNow;
+    Stream->RecvWindowSampleBytes = 0;
+}
+
 //
 // Criteria for sending MAX_DATA/MAX_STREAM_DATA frames:
 //
@@ -749,6 +843,7 @@ QuicStreamOnBytesDelivered(
         Stream->RecvBuffer.VirtualBufferLength / QUIC_RECV_BUFFER_DRAIN_RATIO;
 
     Stream->RecvWindowBytesDelivered += BytesDelivered;
+    Stream->RecvWindowSampleBytes += BytesDelivered;
     Stream->Connection->Send.MaxData += BytesDelivered;
 
     Stream->Connection->Send.OrderedStreamBytesDeliveredAccumulator += BytesDelivered;
@@ -762,56 +857,15 @@ QuicStreamOnBytesDelivered(
 
     if (Stream->RecvWindowBytesDelivered >= RecvBufferDrainThreshold) {
 
-        uint64_t TimeNow = CxPlatTimeUs64();
-
         //
-        // Limit stream FC window growth by the connection FC window size.
-        // When using app-owned buffers, skip this: the virtual buffer length is entirely based
-        // on the amount of buffer space provided by the app.
+        // When using app-owned buffers, skip tuning: the virtual buffer length
+        // is entirely based on the amount of buffer space provided by the app.
         //
         if (Stream->RecvBuffer.VirtualBufferLength != 0 &&
-            Stream->RecvBuffer.VirtualBufferLength < Stream->Connection->Settings.ConnFlowControlWindow &&
             !Stream->Flags.UseAppOwnedRecvBuffers) {
-
-            uint64_t TimeThreshold =
-                ((Stream->RecvWindowBytesDelivered * Stream->Connection->Paths[0].SmoothedRtt) / RecvBufferDrainThreshold);
-            if (CxPlatTimeDiff64(Stream->RecvWindowLastUpdate, TimeNow) <= TimeThreshold) {
-
-                //
-                // Buffer tuning:
-                //
-                // VirtualBufferLength limits the connection's throughput to:
-                //   R = VirtualBufferLength / RTT
-                //
-                // We've delivered data at an average rate of at least:
-                //   R / QUIC_RECV_BUFFER_DRAIN_RATIO
-                //
-                // Double VirtualBufferLength to make sure it doesn't limit
-                // throughput.
-                //
-                // Mainly people complain about flow control when it limits
-                // throughput. But if we grow the buffer limit and then the app
-                // stops receiving data, bytes will pile up in the buffer. We could
-                // add logic to shrink the buffer when the app absorb rate is too
-                // low.
-                //
-
-                QuicRecvBufferIncreaseVirtualBufferLength(
-                    &Stream->RecvBuffer,
-                    Stream->RecvBuffer.VirtualBufferLength * 2);
-
-                QuicTraceLogStreamVerbose(
-                    IncreaseRxBuffer,
-                    Stream,
-                    "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
-                    Stream->RecvBuffer.VirtualBufferLength * 2,
-                    Stream->Connection->Paths[0].MinRtt,
-                    TimeNow,
-                    Stream->RecvWindowLastUpdate);
-            }
+            QuicStreamTuneRecvWindow(Stream);
         }
 
-        Stream->RecvWindowLastUpdate = TimeNow;
         Stream->RecvWindowBytesDelivered = 0;
 
     } else if (!(Stream->Connection->Send.SendFlags & QUIC_CONN_SEND_FLAG_ACK)) {
@@ -1131,11 +1185,13 @@ QuicStreamReceiveComplete(
         return !Stream->Flags.ReceiveMultiple;
     }
 
-    if (Stream->RecvBuffer.BaseOffset == Stream->RecvMaxLength) {
+    if (Stream->RecvBuffer.BaseOffset == Stream->RecvMaxLength &&
+        !Stream->Flags.RemoteCloseResetReliable) {
         CXPLAT_DBG_ASSERT(!Stream->Flags.ReceiveDataPending);
         //
         // We have delivered all the payload that needs to be delivered. Deliver
-        // the graceful close event now.
+        // the graceful close event now. A reliable reset that arrived before
+        // the data is handled below instead.
         //
         Stream->Flags.RemoteCloseFin = TRUE;
         Stream->Flags.RemoteCloseAcked = TRUE;
@@ -269,6 +269,18 @@ QuicStreamSendShutdown(
             QuicStreamSendDumpState(Stream);
         }
 
+        //
+        // Nothing past the reliable offset of an expired send is delivered, so
+        // don't send the FIN.
+        //
+        if (Stream->Flags.SendExpired &&
+            Stream->ReliableOffsetSend < Stream->QueuedSendOffset) {
+            QuicSendClearStreamSendFlag(
+                &Stream->Connection->Send,
+                Stream,
+                QUIC_STREAM_SEND_FLAG_FIN);
+        }
+
         //
         // Queue up a RESET RELIABLE STREAM frame to be sent. We will clear up any flags later.
         //
@@ -306,6 +318,25 @@ QuicStreamAllowedByPeer(
     return Info->MaxTotalStreamCount >= StreamCount;
 }
 
+//
+// Returns the offset past which stream data is no longer (re)transmitted. Once
+// the send path has been reliably reset because a send expired, only the bytes
+// up to the reliable offset still need to be delivered. App initiated reliable
+// resets keep sending everything that was queued.
+//
+QUIC_INLINE
+uint64_t
+QuicStreamSendLimit(
+    _In_ const QUIC_STREAM* Stream
+    )
+{
+    if (Stream->Flags.SendExpired &&
+        Stream->ReliableOffsetSend < Stream->QueuedSendOffset) {
+        return Stream->ReliableOffsetSend;
+    }
+    return Stream->QueuedSendOffset;
+}
+
 //
 // Returns TRUE if the stream has any data queued to be sent.
 //
@@ -316,7 +347,7 @@ QuicStreamHasPendingStreamData(
 {
     return
         RECOV_WINDOW_OPEN(Stream) ||
-        (Stream->NextSendOffset < Stream->QueuedSendOffset);
+        (Stream->NextSendOffset < QuicStreamSendLimit(Stream));
 }
 
 //
@@ -361,11 +392,14 @@ QuicStreamSendCanWriteDataFrames(
         return TRUE;
     }
 
-    if (Stream->NextSendOffset == Stream->QueuedSendOffset) {
+    const uint64_t SendLimit = QuicStreamSendLimit(Stream);
+    if (Stream->NextSendOffset >= SendLimit) {
         //
         // No unsent data. Can send only if a FIN is needed.
         //
-        return !!(Stream->SendFlags & QUIC_STREAM_SEND_FLAG_FIN);
+        return
+            SendLimit == Stream->QueuedSendOffset &&
+            !!(Stream->SendFlags & QUIC_STREAM_SEND_FLAG_FIN);
     }
 
     //
@@ -408,6 +442,46 @@ QuicStreamCanSendNow(
     return FALSE;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamIndicateSendComplete(
+    _In_ QUIC_STREAM* Stream,
+    _In_ QUIC_SEND_REQUEST* SendRequest,
+    _In_ BOOLEAN Canceled
+    )
+{
+    QUIC_STREAM_EVENT Event;
+    Event.Type = QUIC_STREAM_EVENT_SEND_COMPLETE;
+    Event.SEND_COMPLETE.Canceled = Canceled;
+    Event.SEND_COMPLETE.ClientContext = SendRequest->ClientContext;
+    Event.SEND_COMPLETE.Status = QUIC_STATUS_SUCCESS;
+    if (Canceled) {
+        Event.SEND_COMPLETE.Status = QUIC_STATUS_ABORTED;
+#ifndef _KERNEL_MODE
+        if (SendRequest->Flags & QUIC_SEND_FLAG_FILE &&
+            QUIC_FAILED(SendRequest->ReadStatus)) {
+            Event.SEND_COMPLETE.Status = SendRequest->ReadStatus;
+        }
+#endif
+    }
+
+    if (Canceled) {
+        QuicTraceLogStreamVerbose(
+            IndicateSendCanceled,
+            Stream,
+            "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
+            SendRequest);
+    } else {
+        QuicTraceLogStreamVerbose(
+            IndicateSendComplete,
+            Stream,
+            "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
+            SendRequest);
+    }
+
+    (void)QuicStreamIndicateEvent(Stream, &Event);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamCompleteSendRequest(
@@ -426,34 +500,31 @@ QuicStreamCompleteSendRequest(
         Stream->SendBufferBookmark = SendRequest->Next;
         CXPLAT_DBG_ASSERT(
             Stream->SendBufferBookmark == NULL ||
-            !(Stream->SendBufferBookmark->Flags & QUIC_SEND_FLAG_BUFFERED));
+            !(Stream->SendBufferBookmark->Flags & QUIC_SEND_FLAGS_IN_SEND_BUFFER));
     }
 
     if (SendRequest->Flags & QUIC_SEND_FLAG_START && !Stream->Flags.Started) {
         QuicStreamIndicateStartComplete(Stream, QUIC_STATUS_ABORTED);
     }
 
-    if (!(SendRequest->Flags & QUIC_SEND_FLAG_BUFFERED)) {
-        QUIC_STREAM_EVENT Event;
-        Event.Type = QUIC_STREAM_EVENT_SEND_COMPLETE;
-        Event.SEND_COMPLETE.Canceled = Canceled;
-        Event.SEND_COMPLETE.ClientContext = SendRequest->ClientContext;
-
-        if (Canceled) {
-            QuicTraceLogStreamVerbose(
-                IndicateSendCanceled,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
-                SendRequest);
-        } else {
-            QuicTraceLogStreamVerbose(
-                IndicateSendComplete,
+    if (SendRequest->Flags & QUIC_SEND_FLAG_REFERENCED) {
+        //
+        // A referenced request may already have been released when all of its
+        // bytes were SACKed, and indicated complete after that ACK was done.
+        //
+        if (!(SendRequest->Flags & QUIC_SEND_FLAG_SACKED)) {
+            QuicSendBufferRelease(&Connection->SendBuffer, SendRequest->TotalLength);
+            CXPLAT_DBG_ASSERT(Stream->UnsackedReferencedRequestCount > 0);
+            Stream->UnsackedReferencedRequestCount--;
+        }
+        if (!(SendRequest->Flags & QUIC_SEND_FLAG_COMPLETED)) {
+            QuicStreamIndicateSendComplete(
                 Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
-                SendRequest);
+                SendRequest,
+                Canceled && !(SendRequest->Flags & QUIC_SEND_FLAG_SACKED));
         }
-
-        (void)QuicStreamIndicateEvent(Stream, &Event);
+    } else if (!(SendRequest->Flags & QUIC_SEND_FLAG_BUFFERED)) {
+        QuicStreamIndicateSendComplete(Stream, SendRequest, Canceled);
     } else if (SendRequest->InternalBuffer.Length != 0) {
         QuicSendBufferFree(
             &Connection->SendBuffer,
@@ -473,6 +544,80 @@ QuicStreamCompleteSendRequest(
     CxPlatPoolFree(SendRequest);
 }
 
+//
+// Releases any referenced (QUIC_SEND_FLAG_NO_COPY) requests that lie entirely
+// inside a newly updated SACK block. Their bytes are never read again (the
+// send and loss paths skip SACKed ranges), so the app can have its buffers
+// back without waiting for UnAckedOffset to pass them. This only marks the
+// requests; QuicStreamIndicateSackedRequests completes them to the app once
+// the ACK has been processed. The requests themselves stay queued, so offsets
+// still resolve, until in-order completion frees them.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamReleaseSackedRequests(
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint64_t SackLow,
+    _In_ uint64_t SackHigh
+    )
+{
+    QUIC_CONNECTION* Connection = Stream->Connection;
+    BOOLEAN Released = FALSE;
+
+    for (QUIC_SEND_REQUEST* Req = Stream->SendRequests;
+        Stream->UnsackedReferencedRequestCount != 0 &&
+        Req != NULL && Req->StreamOffset < SackHigh;
+        Req = Req->Next) {
+        if ((Req->Flags & (QUIC_SEND_FLAG_REFERENCED | QUIC_SEND_FLAG_SACKED)) ==
+                QUIC_SEND_FLAG_REFERENCED &&
+            Req->StreamOffset >= SackLow &&
+            Req->StreamOffset + Req->TotalLength <= SackHigh) {
+            Req->Flags |= QUIC_SEND_FLAG_SACKED;
+            QuicSendBufferRelease(&Connection->SendBuffer, Req->TotalLength);
+            Stream->UnsackedReferencedRequestCount--;
+            Released = TRUE;
+        }
+    }
+
+    return Released;
+}
+
+//
+// Indicates SEND_COMPLETE for the requests QuicStreamReleaseSackedRequests
+// marked, in a single pass over the queue.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamIndicateSackedRequests(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    QUIC_SEND_REQUEST* Req = Stream->SendRequests;
+    while (Req != NULL) {
+        if ((Req->Flags & (QUIC_SEND_FLAG_SACKED | QUIC_SEND_FLAG_COMPLETED)) ==
+                QUIC_SEND_FLAG_SACKED) {
+            Req->Flags |= QUIC_SEND_FLAG_COMPLETED;
+            QuicStreamIndicateSendComplete(Stream, Req, FALSE);
+            Req->ClientContext = NULL;
+
+            //
+            // Requests are only freed from the head of the queue, and only
+            // all at once from a callback (when the app aborts the send
+            // direction inline). That completes the rest of the marked
+            // requests too.
+            //
+            if (Stream->SendRequests == NULL) {
+                break;
+            }
+        }
+        Req = Req->Next;
+    }
+
+    if (Stream->Connection->Settings.SendBufferingEnabled) {
+        QuicSendBufferFill(Stream->Connection);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamSendBufferRequest(
@@ -482,6 +627,21 @@ QuicStreamSendBufferRequest(
 {
     QUIC_CONNECTION* Connection = Stream->Connection;
 
+    if (Req->Flags & (QUIC_SEND_FLAG_NO_COPY | QUIC_SEND_FLAG_FILE)) {
+        //
+        // Leave the app's buffers (or file) in place. The bytes count toward the send
+        // buffer until the request completes, once they are all acknowledged.
+        //
+        QuicSendBufferReference(&Connection->SendBuffer, Req->TotalLength);
+        Req->Flags |= QUIC_SEND_FLAG_REFERENCED;
+        Stream->UnsackedReferencedRequestCount++;
+        Stream->SendBufferBookmark = Req->Next;
+        CXPLAT_DBG_ASSERT(
+            Stream->SendBufferBookmark == NULL ||
+            !(Stream->SendBufferBookmark->Flags & QUIC_SEND_FLAGS_IN_SEND_BUFFER));
+        return QUIC_STATUS_SUCCESS;
+    }
+
     CXPLAT_DBG_ASSERT(Req->TotalLength <= UINT32_MAX);
 
     if (Req->TotalLength != 0) {
@@ -513,21 +673,12 @@ QuicStreamSendBufferRequest(
     Stream->SendBufferBookmark = Req->Next;
     CXPLAT_DBG_ASSERT(
         Stream->SendBufferBookmark == NULL ||
-        !(Stream->SendBufferBookmark->Flags & QUIC_SEND_FLAG_BUFFERED));
+        !(Stream->SendBufferBookmark->Flags & QUIC_SEND_FLAGS_IN_SEND_BUFFER));
 
     //
     // Complete the request.
     //
-    QUIC_STREAM_EVENT Event;
-    Event.Type = QUIC_STREAM_EVENT_SEND_COMPLETE;
-    Event.SEND_COMPLETE.Canceled = FALSE;
-    Event.SEND_COMPLETE.ClientContext = Req->ClientContext;
-    QuicTraceLogStreamVerbose(
-        IndicateSendComplete,
-        Stream,
-        "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
-        Req);
-    (void)QuicStreamIndicateEvent(Stream, &Event);
+    QuicStreamIndicateSendComplete(Stream, Req, FALSE);
 
     Req->ClientContext = NULL;
 
@@ -552,6 +703,13 @@ QuicStreamEnqueueSendRequest(
     SendRequest->StreamOffset = Stream->QueuedSendOffset;
     Stream->QueuedSendOffset += SendRequest->TotalLength;
 
+    if ((SendRequest->Flags & QUIC_SEND_FLAG_EXPIRES) && Stream->SendExpiryUs != 0) {
+        SendRequest->ExpiryTime = CxPlatTimeUs64() + Stream->SendExpiryUs;
+        Stream->Flags.SendExpiring = TRUE;
+    } else {
+        SendRequest->ExpiryTime = 0;
+    }
+
     if (SendRequest->Flags & QUIC_SEND_FLAG_ALLOW_0_RTT &&
         Stream->Queued0Rtt == SendRequest->StreamOffset) {
         Stream->Queued0Rtt = Stream->QueuedSendOffset;
@@ -574,7 +732,7 @@ QuicStreamEnqueueSendRequest(
         //
         CXPLAT_DBG_ASSERT(
             Stream->SendRequests == NULL ||
-            !!(Stream->SendRequests->Flags & QUIC_SEND_FLAG_BUFFERED));
+            !!(Stream->SendRequests->Flags & QUIC_SEND_FLAGS_IN_SEND_BUFFER));
         Stream->SendBufferBookmark = SendRequest;
     }
 
@@ -680,8 +838,33 @@ QuicStreamSendFlush(
         TotalBytesSent);
 }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
+#ifndef _KERNEL_MODE
+//
+// Keeps the OS reading file data at least half of QUIC_SEND_FILE_READ_AHEAD
+// ahead of Offset (relative to the start of the request), so the synchronous
+// reads on the worker thread normally hit the page cache.
+//
+QUIC_INLINE
 void
+QuicSendRequestFileReadAhead(
+    _Inout_ QUIC_SEND_REQUEST* Req,
+    _In_ uint64_t Offset
+    )
+{
+    if (Req->ReadAheadLength < Req->TotalLength &&
+        Offset + QUIC_SEND_FILE_READ_AHEAD / 2 > Req->ReadAheadLength) {
+        const uint32_t Length =
+            (uint32_t)CXPLAT_MIN(
+                QUIC_SEND_FILE_READ_AHEAD,
+                Req->TotalLength - Req->ReadAheadLength);
+        CxPlatFileReadAhead(Req->File, Req->FileOffset + Req->ReadAheadLength, Length);
+        Req->ReadAheadLength += Length;
+    }
+}
+#endif
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
 QuicStreamCopyFromSendRequests(
     _In_ QUIC_STREAM* Stream,
     _In_ uint64_t Offset,
@@ -691,7 +874,8 @@ QuicStreamCopyFromSendRequests(
 {
     //
     // Copies up to Len stream bytes starting at Offset from the noncontiguous
-    // send request queue into a contiguous frame buffer.
+    // send request queue into a contiguous frame buffer. Only fails if the
+    // data of a file request can't be read.
     //
 
     CXPLAT_DBG_ASSERT(Len > 0);
@@ -743,7 +927,21 @@ QuicStreamCopyFromSendRequests(
         uint32_t BufferLeft = Req->Buffers[CurIndex].Length - (uint32_t)CurOffset;
         uint16_t CopyLength = Len < BufferLeft ? Len : (uint16_t)BufferLeft;
         CXPLAT_DBG_ASSERT(CopyLength > 0);
-        CxPlatCopyMemory(Buf, Req->Buffers[CurIndex].Buffer + CurOffset, CopyLength);
+#ifndef _KERNEL_MODE
+        if (Req->Flags & QUIC_SEND_FLAG_FILE) {
+            QuicSendRequestFileReadAhead(Req, CurOffset + CopyLength);
+            Req->ReadStatus =
+                CxPlatFileRead(
+                    Req->File, Req->FileOffset + CurOffset, CopyLength, Buf);
+            if (QUIC_FAILED(Req->ReadStatus)) {
+                Stream->SendBookmark = Req;
+                return FALSE;
+            }
+        } else
+#endif
+        {
+            CxPlatCopyMemory(Buf, Req->Buffers[CurIndex].Buffer + CurOffset, CopyLength);
+        }
         Len -= CopyLength;
         Buf += CopyLength;
 
@@ -768,7 +966,55 @@ QuicStreamCopyFromSendRequests(
     // Save the bookmark for later.
     //
     Stream->SendBookmark = Req;
+    return TRUE;
+}
+
+#ifndef _KERNEL_MODE
+//
+// The data of a file request couldn't be read while writing a frame. The send
+// path can't shut the stream down from underneath itself, so stop writing
+// data on the stream and queue an abort of the send direction instead, once.
+// The failed request completes with the read's status.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamOnSendFileReadFailure(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    QUIC_CONNECTION* Connection = Stream->Connection;
+
+    Stream->SendFlags &= ~QUIC_STREAM_SEND_FLAG_DATA;
+
+    if (Stream->Flags.SendFileReadFailed) {
+        return; // The abort is already queued.
+    }
+
+    QuicTraceEvent(
+        StreamError,
+        "[strm][%p] ERROR, %s.",
+        Stream,
+        "Send file read failed");
+
+    QUIC_OPERATION* Oper =
+        QuicConnAllocOperation(Connection, QUIC_OPER_TYPE_API_CALL);
+    if (Oper == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "STRM_SHUTDOWN operation",
+            0);
+        return;
+    }
+    Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_SHUTDOWN;
+    Oper->API_CALL.Context->STRM_SHUTDOWN.Stream = Stream;
+    Oper->API_CALL.Context->STRM_SHUTDOWN.Flags = QUIC_STREAM_SHUTDOWN_FLAG_ABORT_SEND;
+    Oper->API_CALL.Context->STRM_SHUTDOWN.ErrorCode = 0;
+    QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+    QuicConnQueueOper(Connection, Oper);
+    Stream->Flags.SendFileReadFailed = TRUE;
 }
+#endif
 
 //
 // Writes data at the requested stream offset to a stream frame.
@@ -819,8 +1065,15 @@ QuicStreamWriteOneFrame(
             CXPLAT_DBG_ASSERT(Frame.Length > 0);
         }
         Frame.Data = Buffer + HeaderLength;
-        QuicStreamCopyFromSendRequests(
-            Stream, Offset, (uint8_t*)Frame.Data, (uint16_t)Frame.Length);
+        if (!QuicStreamCopyFromSendRequests(
+                Stream, Offset, (uint8_t*)Frame.Data, (uint16_t)Frame.Length)) {
+#ifndef _KERNEL_MODE
+            QuicStreamOnSendFileReadFailure(Stream);
+#endif
+            *FramePayloadBytes = 0;
+            *FrameBytes = 0;
+            return;
+        }
         Stream->Connection->Stats.Send.TotalStreamBytes += Frame.Length;
     }
 
@@ -898,6 +1151,7 @@ QuicStreamWriteStreamFrames(
     )
 {
     QUIC_SEND* Send = &Stream->Connection->Send;
+    const uint64_t SendLimit = QuicStreamSendLimit(Stream);
     uint16_t BytesWritten = 0;
 
     //
@@ -957,10 +1211,14 @@ QuicStreamWriteStreamFrames(
             if (Right > Sack->Low) {
                 Right = Sack->Low;
             }
-        } else {
-            if (Right > Stream->QueuedSendOffset) {
-                Right = Stream->QueuedSendOffset;
-            }
+        }
+
+        //
+        // Nothing past the send limit is sent, though a reliably reset stream
+        // may still need an empty frame to open it.
+        //
+        if (Right > SendLimit) {
+            Right = CXPLAT_MAX(Left, SendLimit);
         }
 
         //
@@ -1014,8 +1272,8 @@ QuicStreamWriteStreamFrames(
         //
         Right = Left + FramePayloadBytes;
 
-        CXPLAT_DBG_ASSERT(Right <= Stream->QueuedSendOffset);
-        if (Right == Stream->QueuedSendOffset) {
+        CXPLAT_DBG_ASSERT(Right <= SendLimit || Right == Left);
+        if (Right >= SendLimit) {
             if (Stream->Flags.SendEnabled) {
                 QuicStreamAddOutFlowBlockedReason(Stream, QUIC_FLOW_BLOCKED_APP);
             }
@@ -1243,6 +1501,69 @@ QuicStreamSendWrite(
     return Builder->Metadata->FrameCount > PrevFrameCount;
 }
 
+//
+// Checks if any lost data in [Start, End) belongs to a send request that has
+// expired. If so, everything from that request on is dropped by resetting the
+// send path, reliably up to the expired request's offset if negotiated. An app
+// provided reliable offset is never lowered.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamSendExpireLostData(
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint64_t Start,
+    _In_ uint64_t End
+    )
+{
+    if (Stream->Flags.LocalCloseResetReliable) {
+        //
+        // The reliable offset can't be lowered once it has been sent.
+        //
+        return FALSE;
+    }
+
+    //
+    // Requests starting before an app provided reliable offset must still be
+    // delivered, so they never expire.
+    //
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    QUIC_SEND_REQUEST* SendRequest = Stream->SendRequests;
+    while (SendRequest != NULL && SendRequest->StreamOffset < End) {
+        if (SendRequest->StreamOffset + SendRequest->TotalLength > Start &&
+            SendRequest->StreamOffset >= Stream->ReliableOffsetSend &&
+            SendRequest->ExpiryTime != 0 &&
+            CxPlatTimeAtOrBefore64(SendRequest->ExpiryTime, TimeNow)) {
+            break;
+        }
+        SendRequest = SendRequest->Next;
+    }
+
+    if (SendRequest == NULL || SendRequest->StreamOffset >= End) {
+        return FALSE;
+    }
+
+    QuicTraceLogStreamInfo(
+        SendExpired,
+        Stream,
+        "Dropping expired data from offset %llu",
+        SendRequest->StreamOffset);
+
+    if (Stream->Connection->State.ReliableResetStreamNegotiated &&
+        Stream->ReliableOffsetSend == 0) {
+        //
+        // Everything before the expired request is still delivered. A zero
+        // offset results in a normal reset.
+        //
+        Stream->ReliableOffsetSend = SendRequest->StreamOffset;
+    }
+
+    Stream->Flags.SendExpired = TRUE;
+
+    QuicStreamShutdown(Stream, QUIC_STREAM_SHUTDOWN_FLAG_ABORT_SEND, 0);
+
+    return TRUE;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicStreamOnLoss(
@@ -1289,6 +1610,19 @@ QuicStreamOnLoss(
             "Recovering fin STREAM frame");
     }
 
+    const uint64_t SendLimit = QuicStreamSendLimit(Stream);
+    if (End > SendLimit) {
+        //
+        // Nothing past the reliable offset of a reliably reset stream is
+        // retransmitted.
+        //
+        AddSendFlags &= ~QUIC_STREAM_SEND_FLAG_FIN;
+        End = SendLimit;
+        if (Start >= End) {
+            goto Done;
+        }
+    }
+
     //
     // First check to make sure this data wasn't already acknowledged in a
     // different packet.
@@ -1375,6 +1709,18 @@ QuicStreamOnLoss(
 
 Done:
 
+    if ((AddSendFlags & QUIC_STREAM_SEND_FLAG_DATA) &&
+        Stream->Flags.SendExpiring &&
+        QuicStreamSendExpireLostData(Stream, Start, End)) {
+        if (Stream->Flags.LocalCloseReset) {
+            return FALSE; // Don't resend any data.
+        }
+        AddSendFlags &= ~QUIC_STREAM_SEND_FLAG_FIN;
+        if (!QuicStreamHasPendingStreamData(Stream)) {
+            AddSendFlags &= ~QUIC_STREAM_SEND_FLAG_DATA;
+        }
+    }
+
     if (AddSendFlags != 0) {
         //
         // Check stream's 'cancel on loss' flag to determine how to handle
@@ -1435,6 +1781,7 @@ QuicStreamOnAck(
     uint64_t FollowingOffset = Offset + Length;
 
     uint32_t RemoveSendFlags = 0;
+    BOOLEAN SackedRequests = FALSE;
 
     CXPLAT_DBG_ASSERT(FollowingOffset <= Stream->QueuedSendOffset);
 
@@ -1584,6 +1931,12 @@ QuicStreamOnAck(
                 Stream->RecoveryNextOffset < Sack->Low + Sack->Count) {
                 Stream->RecoveryNextOffset = Sack->Low + Sack->Count;
             }
+
+            if (Stream->UnsackedReferencedRequestCount != 0) {
+                SackedRequests =
+                    QuicStreamReleaseSackedRequests(
+                        Stream, Sack->Low, Sack->Low + Sack->Count);
+            }
         }
     }
 
@@ -1613,6 +1966,10 @@ QuicStreamOnAck(
         QuicStreamTryCompleteShutdown(Stream);
     }
 
+    if (SackedRequests) {
+        QuicStreamIndicateSackedRequests(Stream);
+    }
+
     if (!QuicStreamHasPendingStreamData(Stream)) {
         //
         // Make sure the stream isn't queued to send any stream data.
@@ -297,6 +297,30 @@ QuicStreamSetDrainClosedStreams(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicStreamSetHasOpenStreams(
+    _In_ const QUIC_STREAM_SET* StreamSet
+    )
+{
+    return
+        (StreamSet->StreamTable != NULL && StreamSet->StreamTable->NumEntries != 0) ||
+        !CxPlatListIsEmpty(&StreamSet->WaitingStreams);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSetCompact(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    )
+{
+    QuicStreamSetDrainClosedStreams(StreamSet);
+    if (StreamSet->StreamTable != NULL && StreamSet->StreamTable->NumEntries == 0) {
+        CxPlatHashtableUninitialize(StreamSet->StreamTable);
+        StreamSet->StreamTable = NULL;
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamSetIndicateStreamsAvailable(
@@ -418,6 +442,7 @@ QuicStreamSetInitializeTransportParameters(
         if (FlowBlockedFlagsToRemove) {
             QuicStreamRemoveOutFlowBlockedReason(
                 Stream, FlowBlockedFlagsToRemove);
+            QuicSendUnparkStream(&Connection->Send, Stream);
             QuicStreamSendDumpState(Stream);
             MightBeUnblocked = TRUE;
         }
@@ -503,6 +528,7 @@ QuicStreamSetUpdateMaxStreams(
                     Stream, QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL)) {
                 CXPLAT_DBG_ASSERTMSG(FALSE, "Stream should be blocked by id flow control");
             }
+            QuicSendUnparkStream(&Connection->Send, Stream);
             CxPlatListEntryRemove(&Stream->WaitingLink);
             Stream->Flags.InWaitingList = FALSE;
             //
@@ -122,6 +122,25 @@ QuicStreamSetDrainClosedStreams(
     _Inout_ QUIC_STREAM_SET* StreamSet
     );
 
+//
+// Returns TRUE if any stream is open or waiting for stream ID flow control.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicStreamSetHasOpenStreams(
+    _In_ const QUIC_STREAM_SET* StreamSet
+    );
+
+//
+// Frees the stream table if no streams are left in it. It is allocated again
+// when the next stream is opened.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSetCompact(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    );
+
 //
 // Invoked when the the transport parameters have been received from the peer.
 //
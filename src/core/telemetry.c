@@ -0,0 +1,158 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Per-connection telemetry keeps a fixed size ring of samples of the
+    connection's transport state (congestion window, RTT, bandwidth estimate,
+    bytes in flight, pacing rate and loss), taken from the ACK processing path
+    no more often than a configured interval. The app reads the ring in bulk
+    with a cursor, so it can poll at any rate and learn how many samples it
+    missed if it falls behind.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "telemetry.c.clog.h"
+#endif
+
+CXPLAT_STATIC_ASSERT(
+    IS_POWER_OF_TWO(QUIC_TELEMETRY_SAMPLE_COUNT),
+    "Telemetry ring slots are found by masking");
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTelemetryUninitialize(
+    _In_ QUIC_TELEMETRY* Telemetry
+    )
+{
+    if (Telemetry->Samples != NULL) {
+        CXPLAT_FREE(Telemetry->Samples, QUIC_POOL_TELEMETRY);
+        Telemetry->Samples = NULL;
+    }
+    Telemetry->IntervalMs = 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicTelemetrySetInterval(
+    _In_ QUIC_TELEMETRY* Telemetry,
+    _In_ uint32_t IntervalMs
+    )
+{
+    if (IntervalMs == 0) {
+        QuicTelemetryUninitialize(Telemetry);
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (IntervalMs < QUIC_TELEMETRY_MIN_INTERVAL_MS) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (Telemetry->Samples == NULL) {
+        const size_t AllocSize =
+            sizeof(QUIC_CONN_TELEMETRY_SAMPLE) * QUIC_TELEMETRY_SAMPLE_COUNT;
+        Telemetry->Samples =
+            CXPLAT_ALLOC_NONPAGED(AllocSize, QUIC_POOL_TELEMETRY);
+        if (Telemetry->Samples == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Telemetry ring",
+                AllocSize);
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        Telemetry->FirstSequence = Telemetry->NextSequence;
+        Telemetry->NextSampleTime = 0;
+    }
+
+    Telemetry->IntervalMs = IntervalMs;
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTelemetryRecord(
+    _In_ QUIC_TELEMETRY* Telemetry,
+    _In_ uint64_t TimeNow,
+    _In_ const QUIC_CONN_TELEMETRY_SAMPLE* Sample
+    )
+{
+    CXPLAT_DBG_ASSERT(Telemetry->Samples != NULL);
+    const uint32_t Slot =
+        (uint32_t)(Telemetry->NextSequence & (QUIC_TELEMETRY_SAMPLE_COUNT - 1));
+    Telemetry->Samples[Slot] = *Sample;
+    Telemetry->NextSequence++;
+    Telemetry->NextSampleTime = TimeNow + MS_TO_US(Telemetry->IntervalMs);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicTelemetryRead(
+    _In_ const QUIC_TELEMETRY* Telemetry,
+    _Inout_ uint32_t* BufferLength,
+    _Inout_updates_bytes_opt_(*BufferLength)
+        void* Buffer
+    )
+{
+    if (Telemetry->Samples == NULL) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    uint64_t Oldest = Telemetry->FirstSequence;
+    if (Telemetry->NextSequence - Oldest > QUIC_TELEMETRY_SAMPLE_COUNT) {
+        Oldest = Telemetry->NextSequence - QUIC_TELEMETRY_SAMPLE_COUNT;
+    }
+
+    if (*BufferLength < sizeof(QUIC_CONN_TELEMETRY)) {
+        *BufferLength =
+            sizeof(QUIC_CONN_TELEMETRY) +
+            (uint32_t)(Telemetry->NextSequence - Oldest) * sizeof(QUIC_CONN_TELEMETRY_SAMPLE);
+        return QUIC_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    if (Buffer == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    QUIC_CONN_TELEMETRY* Header = (QUIC_CONN_TELEMETRY*)Buffer;
+    if (Header->Cursor > Telemetry->NextSequence) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    const uint64_t Start = CXPLAT_MAX(Header->Cursor, Oldest);
+    const uint64_t Dropped = Start - Header->Cursor;
+
+    uint32_t Count =
+        (*BufferLength - sizeof(QUIC_CONN_TELEMETRY)) / sizeof(QUIC_CONN_TELEMETRY_SAMPLE);
+    if (Count > Telemetry->NextSequence - Start) {
+        Count = (uint32_t)(Telemetry->NextSequence - Start);
+    }
+
+    //
+    // The requested samples may wrap around the end of the ring, in which case
+    // they are copied out in two pieces.
+    //
+    QUIC_CONN_TELEMETRY_SAMPLE* Samples = (QUIC_CONN_TELEMETRY_SAMPLE*)(Header + 1);
+    const uint32_t Slot = (uint32_t)(Start & (QUIC_TELEMETRY_SAMPLE_COUNT - 1));
+    const uint32_t FirstCount = CXPLAT_MIN(Count, QUIC_TELEMETRY_SAMPLE_COUNT - Slot);
+    CxPlatCopyMemory(
+        Samples,
+        Telemetry->Samples + Slot,
+        FirstCount * sizeof(QUIC_CONN_TELEMETRY_SAMPLE));
+    CxPlatCopyMemory(
+        Samples + FirstCount,
+        Telemetry->Samples,
+        (Count - FirstCount) * sizeof(QUIC_CONN_TELEMETRY_SAMPLE));
+
+    Header->Cursor = Start + Count;
+    Header->SampleCount = Count;
+    Header->DroppedCount = Dropped > UINT32_MAX ? UINT32_MAX : (uint32_t)Dropped;
+
+    *BufferLength =
+        sizeof(QUIC_CONN_TELEMETRY) + Count * sizeof(QUIC_CONN_TELEMETRY_SAMPLE);
+    return QUIC_STATUS_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// A fixed size ring of periodic connection samples, exposed to the app via
+// QUIC_PARAM_CONN_TELEMETRY. Sample N (counting from zero since the
+// connection was created) lives at slot N % QUIC_TELEMETRY_SAMPLE_COUNT.
+//
+typedef struct QUIC_TELEMETRY {
+
+    //
+    // The sample ring. NULL while telemetry is disabled.
+    //
+    QUIC_CONN_TELEMETRY_SAMPLE* Samples;
+
+    //
+    // The sequence number of the next sample to be recorded.
+    //
+    uint64_t NextSequence;
+
+    //
+    // The sequence number of the first sample recorded since telemetry was
+    // last enabled. Samples before this are not in the ring.
+    //
+    uint64_t FirstSequence;
+
+    //
+    // The earliest time (us) the next sample may be taken.
+    //
+    uint64_t NextSampleTime;
+
+    //
+    // The minimum interval (ms) between samples. Zero while disabled.
+    //
+    uint32_t IntervalMs;
+
+} QUIC_TELEMETRY;
+
+//
+// Frees the sample ring, if any.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTelemetryUninitialize(
+    _In_ QUIC_TELEMETRY* Telemetry
+    );
+
+//
+// Sets the sampling interval. Zero disables telemetry and frees the ring; any
+// other value allocates the ring if it isn't already.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicTelemetrySetInterval(
+    _In_ QUIC_TELEMETRY* Telemetry,
+    _In_ uint32_t IntervalMs
+    );
+
+//
+// Returns TRUE if telemetry is enabled and the sampling interval has elapsed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+BOOLEAN
+QuicTelemetryIsSampleDue(
+    _In_ const QUIC_TELEMETRY* Telemetry,
+    _In_ uint64_t TimeNow
+    )
+{
+    return
+        Telemetry->Samples != NULL &&
+        CxPlatTimeAtOrBefore64(Telemetry->NextSampleTime, TimeNow);
+}
+
+//
+// Appends a sample to the ring, overwriting the oldest one if it is full.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTelemetryRecord(
+    _In_ QUIC_TELEMETRY* Telemetry,
+    _In_ uint64_t TimeNow,
+    _In_ const QUIC_CONN_TELEMETRY_SAMPLE* Sample
+    );
+
+//
+// Copies samples out, starting at the QUIC_CONN_TELEMETRY cursor passed in the
+// buffer, for QUIC_PARAM_CONN_TELEMETRY.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicTelemetryRead(
+    _In_ const QUIC_TELEMETRY* Telemetry,
+    _Inout_ uint32_t* BufferLength,
+    _Inout_updates_bytes_opt_(*BufferLength)
+        void* Buffer
+    );
+
+#if defined(__cplusplus)
+}
+#endif
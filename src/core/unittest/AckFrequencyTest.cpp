@@ -0,0 +1,154 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for picking the packet tolerance requested from the peer.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "AckFrequencyTest.cpp.clog.h"
+#endif
+
+struct AckFrequencyTest : public ::testing::Test
+{
+    QUIC_CONNECTION* Connection;
+    uint32_t DatagramPayloadSize;
+
+    void SetUp() override {
+        Connection = new(std::nothrow) QUIC_CONNECTION {};
+        ASSERT_NE(nullptr, Connection);
+        Connection->PeerTransportParams.Flags = QUIC_TP_FLAG_MIN_ACK_DELAY;
+        Connection->PeerPacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
+        Connection->MinPeerPacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
+        Connection->Paths[0].Mtu = 1500;
+        //
+        // Keep setting send flags from trying to queue a flush operation.
+        //
+        Connection->Send.FlushOperationPending = TRUE;
+
+        QUIC_SETTINGS_INTERNAL Settings;
+        CxPlatZeroMemory(&Settings, sizeof(Settings));
+        QuicSettingsSetDefault(&Settings);
+        Settings.CongestionControlAlgorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
+        QuicCongestionControlInitialize(&Connection->CongestionControl, &Settings);
+
+        DatagramPayloadSize = QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    }
+
+    void TearDown() override {
+        delete Connection;
+    }
+
+    //
+    // Leaves slow start with a congestion window that asks for the given
+    // packet tolerance.
+    //
+    void SetSteadyStateTolerance(uint32_t PacketTolerance) {
+        QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Connection->CongestionControl.Cubic;
+        Cubic->CongestionWindow =
+            PacketTolerance * DatagramPayloadSize * QUIC_ACK_FREQUENCY_ACKS_PER_CWND;
+        Cubic->SlowStartThreshold = Cubic->CongestionWindow;
+        Cubic->IsInRecovery = FALSE;
+    }
+
+    void EnterRecovery() {
+        Connection->CongestionControl.Cubic.IsInRecovery = TRUE;
+    }
+};
+
+TEST_F(AckFrequencyTest, NotNegotiated)
+{
+    Connection->PeerTransportParams.Flags = 0;
+    SetSteadyStateTolerance(20);
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(QUIC_MIN_ACK_SEND_NUMBER, Connection->PeerPacketTolerance);
+    ASSERT_FALSE(Connection->Send.SendFlags & QUIC_CONN_SEND_FLAG_ACK_FREQUENCY);
+}
+
+TEST_F(AckFrequencyTest, SlowStartKeepsDefault)
+{
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(QUIC_MIN_ACK_SEND_NUMBER, Connection->PeerPacketTolerance);
+    ASSERT_EQ(0ull, Connection->SendAckFreqSeqNum);
+}
+
+TEST_F(AckFrequencyTest, SteadyStateFollowsCongestionWindow)
+{
+    SetSteadyStateTolerance(20);
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(20, Connection->PeerPacketTolerance);
+    ASSERT_EQ(1ull, Connection->SendAckFreqSeqNum);
+    ASSERT_TRUE(Connection->Send.SendFlags & QUIC_CONN_SEND_FLAG_ACK_FREQUENCY);
+
+    SetSteadyStateTolerance(1000);
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(QUIC_MAX_ACK_FREQUENCY_PACKET_TOLERANCE, Connection->PeerPacketTolerance);
+
+    EnterRecovery();
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(QUIC_MIN_ACK_SEND_NUMBER, Connection->PeerPacketTolerance);
+}
+
+TEST_F(AckFrequencyTest, SmallChangesIgnored)
+{
+    SetSteadyStateTolerance(20);
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(20, Connection->PeerPacketTolerance);
+    const uint64_t SeqNum = Connection->SendAckFreqSeqNum;
+
+    SetSteadyStateTolerance(24); // Less than a quarter more.
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(20, Connection->PeerPacketTolerance);
+
+    SetSteadyStateTolerance(11); // More than half.
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(20, Connection->PeerPacketTolerance);
+    ASSERT_EQ(SeqNum, Connection->SendAckFreqSeqNum);
+
+    SetSteadyStateTolerance(25);
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(25, Connection->PeerPacketTolerance);
+
+    SetSteadyStateTolerance(12);
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(12, Connection->PeerPacketTolerance);
+    ASSERT_EQ(SeqNum + 2, Connection->SendAckFreqSeqNum);
+}
+
+TEST_F(AckFrequencyTest, SchedulingHintIsKept)
+{
+    //
+    // A scheduling limited send raises the tolerance even in slow start.
+    //
+    QuicConnUpdateAckFrequency(Connection, 10);
+    ASSERT_EQ(10, Connection->PeerPacketTolerance);
+
+    //
+    // The next ACK doesn't drop it back to the default.
+    //
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(10, Connection->PeerPacketTolerance);
+
+    //
+    // A larger congestion control value wins over the hint, and the hint is
+    // still the floor when congestion control wants frequent ACKs again.
+    //
+    SetSteadyStateTolerance(40);
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(40, Connection->PeerPacketTolerance);
+
+    EnterRecovery();
+    QuicConnUpdateAckFrequency(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+    ASSERT_EQ(10, Connection->PeerPacketTolerance);
+
+    //
+    // Small hint increases are applied right away.
+    //
+    QuicConnUpdateAckFrequency(Connection, 11);
+    ASSERT_EQ(11, Connection->PeerPacketTolerance);
+}
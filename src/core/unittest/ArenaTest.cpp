@@ -0,0 +1,100 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the connection arena.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "ArenaTest.cpp.clog.h"
+#endif
+
+struct ArenaTest : public ::testing::Test
+{
+    QUIC_ARENA Arena;
+
+    void TearDown() override {
+        QuicArenaUninitialize(&Arena);
+    }
+
+    QUIC_CONN_ARENA_STATISTICS Stats() {
+        QUIC_CONN_ARENA_STATISTICS Stats;
+        QuicArenaGetStatistics(&Arena, &Stats);
+        return Stats;
+    }
+};
+
+TEST_F(ArenaTest, Disabled)
+{
+    QuicArenaInitialize(&Arena, 0);
+    void* Memory = QuicArenaAlloc(&Arena, 40, QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, Memory);
+    ASSERT_EQ(0u, Stats().SlabCount);
+    ASSERT_EQ(40u, Stats().HeapBytes);
+    QuicArenaFree(&Arena, Memory, 40, QUIC_POOL_TEST);
+    ASSERT_EQ(0u, Stats().HeapBytes);
+}
+
+TEST_F(ArenaTest, CarveAndReuse)
+{
+    QuicArenaInitialize(&Arena, QUIC_ARENA_MIN_SLAB_SIZE);
+
+    uint8_t* First = (uint8_t*)QuicArenaAlloc(&Arena, 20, QUIC_POOL_TEST);
+    uint8_t* Second = (uint8_t*)QuicArenaAlloc(&Arena, 20, QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, First);
+    ASSERT_NE(nullptr, Second);
+    ASSERT_EQ(0u, (size_t)First % QUIC_ARENA_BLOCK_ALIGNMENT);
+    ASSERT_EQ(First + 32, Second); // Both rounded up and carved back to back.
+    ASSERT_EQ(1u, Stats().SlabCount);
+    ASSERT_EQ(64u, Stats().UsedBytes);
+    ASSERT_EQ(0u, Stats().HeapBytes);
+
+    //
+    // A freed block is reused for the next allocation of the same class.
+    //
+    QuicArenaFree(&Arena, First, 20, QUIC_POOL_TEST);
+    ASSERT_EQ(32u, Stats().UsedBytes);
+    ASSERT_EQ(First, QuicArenaAlloc(&Arena, 30, QUIC_POOL_TEST));
+    ASSERT_EQ(64u, Stats().PeakUsedBytes);
+
+    //
+    // Requests larger than the biggest class go to the heap.
+    //
+    void* Large = QuicArenaAlloc(&Arena, QUIC_ARENA_MAX_BLOCK_SIZE + 1, QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, Large);
+    ASSERT_EQ(QUIC_ARENA_MAX_BLOCK_SIZE + 1u, Stats().HeapBytes);
+    QuicArenaFree(&Arena, Large, QUIC_ARENA_MAX_BLOCK_SIZE + 1, QUIC_POOL_TEST);
+    ASSERT_EQ(0u, Stats().HeapBytes);
+}
+
+TEST_F(ArenaTest, SlabsGrow)
+{
+    QuicArenaInitialize(&Arena, QUIC_ARENA_MIN_SLAB_SIZE);
+
+    //
+    // Fill the first slab exactly, then spill into a second, twice the size.
+    //
+    for (uint32_t i = 0; i < QUIC_ARENA_MIN_SLAB_SIZE / QUIC_ARENA_MAX_BLOCK_SIZE; ++i) {
+        ASSERT_NE(nullptr, QuicArenaAlloc(&Arena, QUIC_ARENA_MAX_BLOCK_SIZE, QUIC_POOL_TEST));
+    }
+    ASSERT_EQ(1u, Stats().SlabCount);
+    ASSERT_NE(nullptr, QuicArenaAlloc(&Arena, 16, QUIC_POOL_TEST));
+    ASSERT_EQ(2u, Stats().SlabCount);
+    ASSERT_LE(3u * QUIC_ARENA_MIN_SLAB_SIZE, Stats().SlabBytes);
+
+    //
+    // Growth stops at the maximum slab size.
+    //
+    uint32_t Allocated = 0;
+    while (Stats().SlabCount < 8) {
+        ASSERT_NE(nullptr, QuicArenaAlloc(&Arena, QUIC_ARENA_MAX_BLOCK_SIZE, QUIC_POOL_TEST));
+        Allocated += QUIC_ARENA_MAX_BLOCK_SIZE;
+    }
+    ASSERT_EQ((uint32_t)QUIC_ARENA_MAX_SLAB_SIZE, Arena.NextSlabSize);
+    ASSERT_GE(Stats().UsedBytes, Allocated);
+}
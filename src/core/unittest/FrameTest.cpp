@@ -206,6 +206,131 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Values(QUIC_FRAME_ACK, QUIC_FRAME_ACK_1),
     ::testing::PrintToStringParamName());
 
+//
+// Round trips the encode/decode of ACK frames with a given number of ACK
+// ranges. The gaps and block lengths alternate between 1, 2 and 4 byte varints
+// to exercise both the fast and the general ACK block decode paths.
+//
+struct AckFrameRangeTest : ::testing::TestWithParam<uint32_t> {
+    QUIC_RANGE AckRange;
+    QUIC_RANGE DecodedAckRange;
+    uint8_t Buffer[4096];
+    uint16_t FrameLength;
+
+    void SetUp() override {
+        const uint32_t RangeCount = GetParam();
+        BOOLEAN Unused;
+
+        QuicRangeInitialize(QUIC_MAX_RANGE_DECODE_ACKS, &AckRange);
+        QuicRangeInitialize(QUIC_MAX_RANGE_DECODE_ACKS, &DecodedAckRange);
+
+        uint64_t Low = 1;
+        for (uint32_t i = 0; i < RangeCount; i++) {
+            const uint64_t Count = (i % 3 == 0) ? 1 : ((i % 3 == 1) ? 100 : 20000);
+            ASSERT_TRUE(QuicRangeAddRange(&AckRange, Low, Count, &Unused) != nullptr);
+            Low += Count + ((i % 2 == 0) ? 1 : 5000);
+        }
+        ASSERT_EQ(RangeCount, QuicRangeSize(&AckRange));
+
+        FrameLength = 0;
+        ASSERT_TRUE(QuicAckFrameEncode(&AckRange, 0, nullptr, &FrameLength, sizeof(Buffer), Buffer));
+    }
+
+    void TearDown() override {
+        QuicRangeUninitialize(&AckRange);
+        QuicRangeUninitialize(&DecodedAckRange);
+    }
+
+    void Decode() {
+        uint16_t Offset = 1;
+        uint64_t AckDelay = 0;
+        BOOLEAN InvalidFrame = FALSE;
+        ASSERT_TRUE(QuicAckFrameDecode(QUIC_FRAME_ACK, FrameLength, Buffer, &Offset, &InvalidFrame, &DecodedAckRange, nullptr, &AckDelay));
+        ASSERT_FALSE(InvalidFrame);
+        ASSERT_EQ(FrameLength, Offset);
+    }
+
+    void Encode() {
+        uint16_t Offset = 0;
+        ASSERT_TRUE(QuicAckFrameEncode(&DecodedAckRange, 0, nullptr, &Offset, sizeof(Buffer), Buffer));
+        ASSERT_EQ(FrameLength, Offset);
+    }
+};
+
+TEST_P(AckFrameRangeTest, EncodeDecode)
+{
+    //
+    // Decode more than once to make sure a reset range can be reused.
+    //
+    for (uint32_t i = 0; i < 3; i++) {
+        if (i != 0) {
+            QuicRangeReset(&DecodedAckRange);
+        }
+        Decode();
+    }
+
+    ASSERT_EQ(QuicRangeSize(&AckRange), QuicRangeSize(&DecodedAckRange));
+    for (uint32_t i = 0; i < GetParam(); i++) {
+        ASSERT_EQ(QuicRangeGet(&AckRange, i)->Low, QuicRangeGet(&DecodedAckRange, i)->Low);
+        ASSERT_EQ(QuicRangeGet(&AckRange, i)->Count, QuicRangeGet(&DecodedAckRange, i)->Count);
+    }
+
+    Encode();
+}
+
+//
+// Times the ACK frame decode and encode. Not run by default; use
+// --gtest_also_run_disabled_tests to run it.
+//
+TEST_P(AckFrameRangeTest, DISABLED_EncodeDecodePerf)
+{
+    const uint32_t Iterations = 10000;
+
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; i++) {
+        QuicRangeReset(&DecodedAckRange);
+        Decode();
+    }
+    uint64_t Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+    std::cout << "Decode " << GetParam() << " ranges: " <<
+        Elapsed * 1000 / Iterations << " ns/frame" << std::endl;
+
+    Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; i++) {
+        Encode();
+    }
+    Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+    std::cout << "Encode " << GetParam() << " ranges: " <<
+        Elapsed * 1000 / Iterations << " ns/frame" << std::endl;
+}
+
+TEST(FrameTest, AckFrameDecodeBlockBelowZero)
+{
+    QUIC_RANGE DecodedAckBlocks;
+    uint16_t Offset = 1;
+    BOOLEAN InvalidFrame = FALSE;
+    uint64_t AckDelay;
+    const uint8_t Buffer[] = {
+        QUIC_FRAME_ACK,
+        10, // Largest Acknowledged
+        0,  // ACK Delay
+        1,  // ACK Range Count
+        2,  // First ACK Range (8-10)
+        1,  // Gap (skips 5-7)
+        6   // ACK Range (would cover -1 to 5)
+    };
+    QuicRangeInitialize(QUIC_MAX_RANGE_DECODE_ACKS, &DecodedAckBlocks);
+    ASSERT_FALSE(QuicAckFrameDecode(QUIC_FRAME_ACK, sizeof(Buffer), Buffer, &Offset, &InvalidFrame, &DecodedAckBlocks, nullptr, &AckDelay));
+    ASSERT_TRUE(InvalidFrame);
+    ASSERT_EQ(0u, QuicRangeSize(&DecodedAckBlocks));
+    QuicRangeUninitialize(&DecodedAckBlocks);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FrameTest,
+    AckFrameRangeTest,
+    ::testing::Values(1u, 32u, 256u));
+
 TEST(FrameTest, ResetStreamFrameEncodeDecode)
 {
     QUIC_RESET_STREAM_EX Frame = {127, 4294967297, 65536};
@@ -48,3 +48,27 @@ TEST(PartitionTest, RandomPartitionId)
 
     MsQuicLib.PartitionCount = OldPartitionCount;
 }
+
+TEST(PartitionTest, PerfHistogramBuckets)
+{
+    //
+    // Small values get a bucket each.
+    //
+    for (uint64_t i = 0; i < 16; ++i) {
+        ASSERT_EQ((uint32_t)i, QuicPerfHistogramBucket(i));
+    }
+
+    //
+    // Every bucket's lower bound maps back to that bucket, and the value just
+    // below it maps to the previous one.
+    //
+    for (uint32_t i = 1; i < QUIC_PERF_HISTOGRAM_BUCKET_COUNT; ++i) {
+        const uint64_t Low = QUIC_PERF_HISTOGRAM_BUCKET_LOW(i);
+        ASSERT_LT(QUIC_PERF_HISTOGRAM_BUCKET_LOW(i - 1), Low);
+        ASSERT_EQ(i, QuicPerfHistogramBucket(Low));
+        ASSERT_EQ(i - 1, QuicPerfHistogramBucket(Low - 1));
+    }
+
+    ASSERT_EQ(QUIC_PERF_HISTOGRAM_BUCKET_COUNT - 1u, QuicPerfHistogramBucket(UINT32_MAX));
+    ASSERT_EQ(QUIC_PERF_HISTOGRAM_BUCKET_COUNT - 1u, QuicPerfHistogramBucket(UINT64_MAX));
+}
@@ -0,0 +1,82 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the sampling profiler.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "ProfileTest.cpp.clog.h"
+#endif
+
+TEST(ProfileTest, FrameIndex)
+{
+    ASSERT_EQ((uint32_t)QUIC_FRAME_PADDING, QuicProfileFrameIndex(QUIC_FRAME_PADDING));
+    ASSERT_EQ((uint32_t)QUIC_FRAME_ACK_1, QuicProfileFrameIndex(QUIC_FRAME_ACK_1));
+    for (uint64_t Type = QUIC_FRAME_STREAM; Type <= QUIC_FRAME_STREAM_7; ++Type) {
+        ASSERT_EQ((uint32_t)QUIC_FRAME_STREAM, QuicProfileFrameIndex(Type));
+    }
+    ASSERT_EQ((uint32_t)QUIC_FRAME_DATAGRAM_1, QuicProfileFrameIndex(QUIC_FRAME_DATAGRAM_1));
+    ASSERT_LT(QuicProfileFrameIndex(QUIC_FRAME_ACK_FREQUENCY), (uint32_t)QUIC_PROFILE_FRAME_TYPE_COUNT);
+    ASSERT_LT(QuicProfileFrameIndex(QUIC_FRAME_TIMESTAMP), (uint32_t)QUIC_PROFILE_FRAME_TYPE_COUNT);
+    ASSERT_NE(
+        QuicProfileFrameIndex(QUIC_FRAME_ACK_FREQUENCY),
+        QuicProfileFrameIndex(QUIC_FRAME_TIMESTAMP));
+}
+
+TEST(ProfileTest, GetEntries)
+{
+    QUIC_PROFILE Profile;
+    CxPlatZeroMemory(&Profile, sizeof(Profile));
+    QuicProfileRecord(&Profile.Operations[QUIC_OPER_TYPE_FLUSH_SEND], 100);
+    QuicProfileRecord(&Profile.Operations[QUIC_OPER_TYPE_FLUSH_SEND], 50);
+    QuicProfileRecord(&Profile.ApiCalls[QUIC_API_TYPE_STRM_SEND], 7);
+    QuicProfileRecord(&Profile.Frames[QuicProfileFrameIndex(QUIC_FRAME_STREAM_3)], 9);
+
+    uint32_t BufferLength = 0;
+    ASSERT_EQ(QUIC_STATUS_BUFFER_TOO_SMALL, QuicProfileGetEntries(&Profile, &BufferLength, nullptr));
+    ASSERT_NE(0u, BufferLength);
+    ASSERT_EQ(0u, BufferLength % sizeof(QUIC_PROFILE_ENTRY));
+
+    std::vector<QUIC_PROFILE_ENTRY> Entries(BufferLength / sizeof(QUIC_PROFILE_ENTRY));
+    const uint32_t FullLength = BufferLength;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicProfileGetEntries(&Profile, &BufferLength, Entries.data()));
+    ASSERT_EQ(FullLength, BufferLength);
+
+    uint32_t Found = 0;
+    for (const auto& Entry : Entries) {
+        ASSERT_NE('\0', Entry.Name[0]);
+        if (Entry.Category == QUIC_PROFILE_CATEGORY_OPERATION &&
+            Entry.Type == QUIC_OPER_TYPE_FLUSH_SEND) {
+            ASSERT_STREQ("FLUSH_SEND", Entry.Name);
+            ASSERT_EQ(2u, Entry.Samples);
+            ASSERT_EQ(150u, Entry.Cycles);
+            Found++;
+        } else if (Entry.Category == QUIC_PROFILE_CATEGORY_API_CALL &&
+            Entry.Type == QUIC_API_TYPE_STRM_SEND) {
+            ASSERT_STREQ("STRM_SEND", Entry.Name);
+            ASSERT_EQ(1u, Entry.Samples);
+            Found++;
+        } else if (Entry.Category == QUIC_PROFILE_CATEGORY_FRAME &&
+            Entry.Type == QUIC_FRAME_STREAM) {
+            ASSERT_STREQ("STREAM", Entry.Name);
+            ASSERT_EQ(9u, Entry.Cycles);
+            Found++;
+        } else {
+            ASSERT_EQ(0u, Entry.Samples);
+        }
+    }
+    ASSERT_EQ(3u, Found);
+
+    //
+    // A short buffer gets as many whole entries as fit.
+    //
+    BufferLength = 2 * sizeof(QUIC_PROFILE_ENTRY) + 4;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicProfileGetEntries(&Profile, &BufferLength, Entries.data()));
+    ASSERT_EQ(2 * sizeof(QUIC_PROFILE_ENTRY), BufferLength);
+}
@@ -478,6 +478,68 @@ TEST(RangeTest, HitMax)
     ASSERT_EQ(range.Max(), MaxCount*2);
 }
 
+TEST(RangeTest, SetMin)
+{
+    SmartRange range;
+    for (uint32_t i = 0; i < 256; i++) {
+        range.Add(i * 10, 5);
+    }
+    QuicRangeSetMin(&range.range, 0);
+    ASSERT_EQ(range.ValidCount(), (uint32_t)256);
+    QuicRangeSetMin(&range.range, 7); // In a gap.
+    ASSERT_EQ(range.ValidCount(), (uint32_t)255);
+    ASSERT_EQ(range.Min(), 10ull);
+    QuicRangeSetMin(&range.range, 1002); // In a subrange.
+    ASSERT_EQ(range.ValidCount(), (uint32_t)156);
+    ASSERT_EQ(range.Min(), 1002ull);
+    QuicRangeSetMin(&range.range, 2554); // Last value.
+    ASSERT_EQ(range.ValidCount(), (uint32_t)1);
+    ASSERT_EQ(range.Min(), 2554ull);
+    ASSERT_EQ(range.Max(), 2554ull);
+    QuicRangeSetMin(&range.range, 2555);
+    ASSERT_EQ(range.ValidCount(), (uint32_t)0);
+}
+
+TEST(RangeTest, RemoveRangeMany)
+{
+    SmartRange range;
+    for (uint32_t i = 0; i < 256; i++) {
+        range.Add(i * 10, 5);
+    }
+    range.Remove(5, 5); // Only a gap.
+    ASSERT_EQ(range.ValidCount(), (uint32_t)256);
+    range.Remove(1003, 1); // Middle of a subrange.
+    ASSERT_EQ(range.ValidCount(), (uint32_t)257);
+    range.Remove(1012, 21); // Spans several subranges.
+    ASSERT_EQ(range.ValidCount(), (uint32_t)256);
+    uint64_t Count;
+    BOOLEAN IsLastRange;
+    ASSERT_TRUE(QuicRangeGetRange(&range.range, 1010, &Count, &IsLastRange));
+    ASSERT_EQ(Count, 2ull);
+    ASSERT_FALSE(QuicRangeGetRange(&range.range, 1020, &Count, &IsLastRange));
+    ASSERT_TRUE(QuicRangeGetRange(&range.range, 1033, &Count, &IsLastRange));
+    ASSERT_EQ(Count, 2ull);
+    range.Remove(2550, 100); // Tail.
+    ASSERT_EQ(range.ValidCount(), (uint32_t)255);
+    ASSERT_EQ(range.Max(), 2544ull);
+}
+
+TEST(RangeTest, AddDescending)
+{
+    SmartRange range;
+    for (uint32_t i = 256; i > 0; i--) {
+        ASSERT_TRUE(QuicRangeAddDescending(&range.range, i * 10, 5));
+    }
+    QuicRangeCompleteDescending(&range.range);
+    ASSERT_EQ(range.ValidCount(), (uint32_t)256);
+    for (uint32_t i = 0; i < 256; i++) {
+        ASSERT_EQ(QuicRangeGet(&range.range, i)->Low, (i + 1) * 10ull);
+    }
+    range.Add(2565); // Ordered operations work afterwards.
+    ASSERT_EQ(range.ValidCount(), (uint32_t)256);
+    ASSERT_EQ(range.Max(), 2565ull);
+}
+
 TEST(RangeTest, SearchZero)
 {
     SmartRange range;
@@ -787,3 +849,28 @@ TEST(RangeTest, SearchRangeThree)
     ASSERT_EQ(index, 2);
 #endif
 }
+
+TEST(RangeTest, Compact)
+{
+    SmartRange range;
+    for (uint32_t i = 0; i < 2 * QUIC_RANGE_INITIAL_SUB_COUNT; i++) {
+        range.Add(i * 2);
+    }
+    ASSERT_NE(range.range.SubRanges, range.range.PreAllocSubRanges);
+
+    //
+    // Only the largest subranges are kept, in the preallocated array.
+    //
+    QuicRangeCompact(&range.range);
+    ASSERT_EQ(range.range.SubRanges, range.range.PreAllocSubRanges);
+    ASSERT_EQ(range.ValidCount(), (uint32_t)QUIC_RANGE_INITIAL_SUB_COUNT);
+    ASSERT_EQ(range.Max(), 2 * (2 * QUIC_RANGE_INITIAL_SUB_COUNT - 1));
+    ASSERT_EQ(range.Min(), 2 * QUIC_RANGE_INITIAL_SUB_COUNT);
+
+    //
+    // The range can grow again afterwards.
+    //
+    range.Add(1000);
+    range.Add(1002);
+    ASSERT_EQ(range.ValidCount(), (uint32_t)QUIC_RANGE_INITIAL_SUB_COUNT + 2);
+}
@@ -1152,6 +1152,31 @@ TEST_P(WithMode, IncreaseVirtualLength)
     }
 }
 
+TEST_P(WithMode, DecreaseVirtualLength)
+{
+    auto Mode = GetParam();
+    if (Mode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        return; // The app's buffers define the length.
+    }
+
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(Mode, false, 8, LARGE_TEST_BUFFER_LENGTH));
+    uint64_t InOutWriteLength = LARGE_TEST_BUFFER_LENGTH;
+    BOOLEAN NewDataReady = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 16, &InOutWriteLength, &NewDataReady));
+
+    //
+    // The length can shrink down to the data already written.
+    //
+    QuicRecvBufferDecreaseVirtualBufferLength(&RecvBuf.RecvBuf, 32);
+    ASSERT_EQ(32u, RecvBuf.RecvBuf.VirtualBufferLength);
+    InOutWriteLength = LARGE_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(QUIC_STATUS_BUFFER_TOO_SMALL, RecvBuf.Write(16, 20, &InOutWriteLength, &NewDataReady));
+    InOutWriteLength = LARGE_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(16, 16, &InOutWriteLength, &NewDataReady));
+    ASSERT_EQ(32ull, RecvBuf.GetTotalLength());
+}
+
 // Validate the gap can span the edge of a chunk
 // |0, 1, 2, 3, x, x, x, x| ReadStart:0, ReadLength:4, Ext:0
 // |R, R, R, R, x, x, x, x| ReadStart:0, ReadLength:4, Ext:1
@@ -1874,6 +1899,47 @@ TEST(AppOwnedBuffersTest, ProvideChunks)
     ASSERT_TRUE(CxPlatListIsEmpty(&ChunkList));
 }
 
+TEST(RecvBufferTest, HibernateAndRehydrate)
+{
+    for (auto Mode : {QUIC_RECV_BUF_MODE_SINGLE, QUIC_RECV_BUF_MODE_CIRCULAR}) {
+        RecvBuffer RecvBuf;
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(Mode));
+        uint64_t InOutWriteLength = DEF_TEST_BUFFER_LENGTH;
+        BOOLEAN NewDataReady = FALSE;
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 20, &InOutWriteLength, &NewDataReady));
+
+        //
+        // Unread data keeps the chunk.
+        //
+        ASSERT_FALSE(QuicRecvBufferHibernate(&RecvBuf.RecvBuf));
+        uint64_t ReadOffset;
+        QUIC_BUFFER ReadBuffers[3];
+        uint32_t BufferCount = ARRAYSIZE(ReadBuffers);
+        RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+        ASSERT_FALSE(QuicRecvBufferHibernate(&RecvBuf.RecvBuf)); // Read pending
+        ASSERT_TRUE(RecvBuf.Drain(20));
+
+        ASSERT_TRUE(QuicRecvBufferHibernate(&RecvBuf.RecvBuf));
+        ASSERT_TRUE(CxPlatListIsEmpty(&RecvBuf.RecvBuf.Chunks));
+        ASSERT_TRUE(QuicRecvBufferHibernate(&RecvBuf.RecvBuf));
+        ASSERT_EQ(20ull, RecvBuf.GetTotalLength());
+
+        //
+        // The offsets are kept across hibernation.
+        //
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicRecvBufferRehydrate(&RecvBuf.RecvBuf));
+        ASSERT_FALSE(CxPlatListIsEmpty(&RecvBuf.RecvBuf.Chunks));
+        InOutWriteLength = DEF_TEST_BUFFER_LENGTH + 20;
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(20, 10, &InOutWriteLength, &NewDataReady));
+        ASSERT_TRUE(NewDataReady);
+        BufferCount = ARRAYSIZE(ReadBuffers);
+        RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+        ASSERT_EQ(20ull, ReadOffset);
+        ASSERT_EQ(10u, ReadBuffers[0].Length);
+        ASSERT_TRUE(RecvBuf.Drain(10));
+    }
+}
+
 TEST(AppOwnedBuffersTest, ProvideChunksOverflow)
 {
     RecvBuffer RecvBuf;
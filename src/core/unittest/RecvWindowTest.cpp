@@ -0,0 +1,172 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the stream receive window auto-tuning.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "RecvWindowTest.cpp.clog.h"
+#endif
+
+#define TEST_RTT_US             10000
+#define TEST_INITIAL_WINDOW     0x10000     // 64 KB
+#define TEST_CONN_WINDOW        0x1000000   // 16 MB
+
+struct RecvWindowTest : public ::testing::Test
+{
+    QUIC_CONNECTION* Connection;
+    QUIC_STREAM* Stream;
+
+    void SetUp() override {
+        Connection = new(std::nothrow) QUIC_CONNECTION {};
+        ASSERT_NE(nullptr, Connection);
+        Connection->Paths[0].SmoothedRtt = TEST_RTT_US;
+        Connection->Paths[0].MinRtt = TEST_RTT_US;
+        Connection->Settings.ConnFlowControlWindow = TEST_CONN_WINDOW;
+
+        Stream = new(std::nothrow) QUIC_STREAM {};
+        ASSERT_NE(nullptr, Stream);
+        Stream->Connection = Connection;
+        Stream->RecvWindowMin = TEST_INITIAL_WINDOW;
+    }
+
+    void TearDown() override {
+        QuicRecvBufferUninitialize(&Stream->RecvBuffer);
+        delete Stream;
+        delete Connection;
+    }
+
+    void InitializeBuffer(uint32_t AllocLength, uint32_t Window) {
+        ASSERT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicRecvBufferInitialize(
+                &Stream->RecvBuffer,
+                AllocLength,
+                Window,
+                QUIC_RECV_BUF_MODE_SINGLE,
+                NULL));
+        Stream->MaxAllowedRecvOffset = TEST_INITIAL_WINDOW;
+    }
+
+    //
+    // Reports Delivered bytes drained by the app over the last RTT.
+    //
+    void Tune(uint64_t Delivered) {
+        Stream->RecvWindowSampleBytes = Delivered;
+        Stream->RecvWindowLastUpdate = CxPlatTimeUs64() - TEST_RTT_US;
+        QuicStreamTuneRecvWindow(Stream);
+    }
+
+    uint32_t Window() const {
+        return Stream->RecvBuffer.VirtualBufferLength;
+    }
+
+    uint32_t ChunkLength() const {
+        return
+            CXPLAT_CONTAINING_RECORD(
+                Stream->RecvBuffer.Chunks.Flink, QUIC_RECV_CHUNK, Link)->AllocLength;
+    }
+};
+
+TEST_F(RecvWindowTest, Grow)
+{
+    InitializeBuffer(0x1000, TEST_INITIAL_WINDOW);
+
+    //
+    // An app that drains the whole window every RTT is flow control limited,
+    // so the window (about) doubles.
+    //
+    Tune(TEST_INITIAL_WINDOW);
+    ASSERT_GT(Window(), (uint32_t)TEST_INITIAL_WINDOW);
+    ASSERT_LE(Window(), (uint32_t)(2 * TEST_INITIAL_WINDOW));
+    ASSERT_EQ(0ull, Stream->RecvWindowSampleBytes);
+
+    //
+    // But never past the connection's window.
+    //
+    Connection->Settings.ConnFlowControlWindow = 3 * TEST_INITIAL_WINDOW;
+    Tune(4 * TEST_INITIAL_WINDOW);
+    ASSERT_EQ((uint32_t)(3 * TEST_INITIAL_WINDOW), Window());
+}
+
+TEST_F(RecvWindowTest, Settle)
+{
+    InitializeBuffer(0x1000, 0x100000);
+
+    //
+    // Nothing changes until an RTT has passed.
+    //
+    Stream->RecvWindowSampleBytes = 0;
+    Stream->RecvWindowLastUpdate = CxPlatTimeUs64();
+    QuicStreamTuneRecvWindow(Stream);
+    ASSERT_EQ(0x100000u, Window());
+
+    //
+    // Draining between a quarter and a half of the window per RTT means the
+    // window is between 2x and 4x the BDP, so it is left as is.
+    //
+    Tune(0x50000);
+    ASSERT_EQ(0x100000u, Window());
+    Tune(0x7F000);
+    ASSERT_EQ(0x100000u, Window());
+}
+
+TEST_F(RecvWindowTest, Shrink)
+{
+    InitializeBuffer(0x100000, 0x100000);
+
+    uint8_t Data[1000];
+    for (uint32_t i = 0; i < sizeof(Data); ++i) {
+        Data[i] = (uint8_t)i;
+    }
+    uint64_t WriteLimit = sizeof(Data);
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicRecvBufferWrite(
+            &Stream->RecvBuffer, 0, sizeof(Data), Data, &WriteLimit, &ReadyToRead));
+
+    //
+    // An app that stops draining halves the window every RTT, and the chunk
+    // behind it with it, keeping the data already buffered.
+    //
+    Tune(0);
+    ASSERT_EQ(0x80000u, Window());
+    ASSERT_EQ(0x80000u, ChunkLength());
+    ASSERT_EQ(0x80000u, Stream->RecvBuffer.Capacity);
+    ASSERT_EQ(sizeof(Data), QuicRecvBufferGetTotalLength(&Stream->RecvBuffer));
+    QUIC_RECV_CHUNK* Chunk =
+        CXPLAT_CONTAINING_RECORD(Stream->RecvBuffer.Chunks.Flink, QUIC_RECV_CHUNK, Link);
+    ASSERT_EQ(0, memcmp(Data, Chunk->Buffer, sizeof(Data)));
+
+    //
+    // Down to the initial window, and no further.
+    //
+    Tune(0);
+    Tune(0);
+    Tune(0);
+    ASSERT_EQ((uint32_t)TEST_INITIAL_WINDOW, Window());
+    ASSERT_EQ((uint32_t)TEST_INITIAL_WINDOW, ChunkLength());
+    Tune(0);
+    ASSERT_EQ((uint32_t)TEST_INITIAL_WINDOW, Window());
+}
+
+TEST_F(RecvWindowTest, ShrinkKeepsAdvertisedCredit)
+{
+    InitializeBuffer(0x100000, 0x100000);
+    Stream->MaxAllowedRecvOffset = 0xC0000;
+
+    //
+    // The peer may already send up to the advertised offset, so the window
+    // only shrinks that far, and the chunk needs to stay big enough for it.
+    //
+    Tune(0);
+    ASSERT_EQ(0xC0000u, Window());
+    ASSERT_EQ(0x100000u, ChunkLength());
+}
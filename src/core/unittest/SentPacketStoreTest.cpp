@@ -0,0 +1,249 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the sent packet store.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "SentPacketStoreTest.cpp.clog.h"
+#endif
+
+struct SentPacketStoreTest : public ::testing::Test
+{
+    QUIC_SENT_PACKET_STORE Store;
+    QUIC_SENT_PACKET_METADATA* Packets;
+    uint32_t PacketCount;
+
+    void SetUp() override {
+        QuicSentPacketStoreInitialize(&Store);
+        PacketCount = 4096;
+        Packets = new QUIC_SENT_PACKET_METADATA[PacketCount];
+        CxPlatZeroMemory(Packets, sizeof(QUIC_SENT_PACKET_METADATA) * PacketCount);
+        for (uint32_t i = 0; i < PacketCount; i++) {
+            Packets[i].PacketNumber = i;
+            Packets[i].SentTime = 1000 + i;
+            Packets[i].PacketLength = (uint16_t)(1200 + (i % 100));
+            Packets[i].Flags.IsAckEliciting = (i % 3) != 0;
+        }
+    }
+
+    void TearDown() override {
+        for (uint32_t i = 0; i < QuicSentPacketStoreSpan(&Store); i++) {
+            if (QuicSentPacketStoreGet(&Store, i) != NULL) {
+                (void)QuicSentPacketStoreRemove(&Store, i);
+            }
+        }
+        QuicSentPacketStoreUninitialize(&Store);
+        delete [] Packets;
+    }
+
+    void Add(uint64_t PacketNumber) {
+        ASSERT_TRUE(QuicSentPacketStoreAdd(&Store, &Packets[PacketNumber]));
+    }
+
+    void AddRange(uint64_t Low, uint64_t Count) {
+        for (uint64_t i = Low; i < Low + Count; i++) {
+            Add(i);
+        }
+    }
+
+    QUIC_SENT_PACKET_METADATA* Find(uint64_t PacketNumber) {
+        uint32_t Start, End;
+        if (!QuicSentPacketStoreFindRange(&Store, PacketNumber, PacketNumber, &Start, &End)) {
+            return NULL;
+        }
+        EXPECT_EQ(Start + 1, End);
+        return QuicSentPacketStoreGet(&Store, Start);
+    }
+
+    void Remove(uint64_t PacketNumber) {
+        uint32_t Start, End;
+        ASSERT_TRUE(QuicSentPacketStoreFindRange(&Store, PacketNumber, PacketNumber, &Start, &End));
+        ASSERT_EQ(&Packets[PacketNumber], QuicSentPacketStoreRemove(&Store, Start));
+    }
+
+    void ValidateHotFields() {
+        for (uint32_t i = 0; i < QuicSentPacketStoreSpan(&Store); i++) {
+            const uint32_t Slot = QuicSentPacketStoreSlot(&Store, i);
+            const QUIC_SENT_PACKET_METADATA* Packet = Store.Packets[Slot];
+            if (Packet != NULL) {
+                ASSERT_EQ(Packet->PacketNumber, QuicSentPacketStorePacketNumber(&Store, i));
+                ASSERT_EQ(Packet->SentTime, Store.SentTimes[Slot]);
+                ASSERT_EQ(Packet->PacketLength, Store.PacketLengths[Slot]);
+                ASSERT_EQ(Packet->Flags.IsAckEliciting, Store.Flags[Slot].IsAckEliciting);
+            }
+        }
+    }
+};
+
+TEST_F(SentPacketStoreTest, Empty)
+{
+    ASSERT_TRUE(QuicSentPacketStoreIsEmpty(&Store));
+    ASSERT_EQ(0u, QuicSentPacketStoreSpan(&Store));
+    uint32_t Start, End;
+    ASSERT_FALSE(QuicSentPacketStoreFindRange(&Store, 0, UINT64_MAX, &Start, &End));
+    QuicSentPacketStoreCompact(&Store);
+    ASSERT_TRUE(QuicSentPacketStoreIsEmpty(&Store));
+}
+
+TEST_F(SentPacketStoreTest, AddAndFind)
+{
+    AddRange(10, 20);
+    ASSERT_FALSE(QuicSentPacketStoreIsEmpty(&Store));
+    ASSERT_EQ(20u, QuicSentPacketStoreSpan(&Store));
+    ASSERT_EQ(NULL, Find(9));
+    ASSERT_EQ(NULL, Find(30));
+    for (uint64_t i = 10; i < 30; i++) {
+        ASSERT_EQ(&Packets[i], Find(i));
+    }
+    ValidateHotFields();
+}
+
+TEST_F(SentPacketStoreTest, FindRangeClamps)
+{
+    AddRange(100, 50);
+    uint32_t Start, End;
+    ASSERT_FALSE(QuicSentPacketStoreFindRange(&Store, 0, 99, &Start, &End));
+    ASSERT_FALSE(QuicSentPacketStoreFindRange(&Store, 150, 200, &Start, &End));
+    ASSERT_TRUE(QuicSentPacketStoreFindRange(&Store, 0, 100, &Start, &End));
+    ASSERT_EQ(0u, Start);
+    ASSERT_EQ(1u, End);
+    ASSERT_TRUE(QuicSentPacketStoreFindRange(&Store, 120, 129, &Start, &End));
+    ASSERT_EQ(20u, Start);
+    ASSERT_EQ(30u, End);
+    ASSERT_TRUE(QuicSentPacketStoreFindRange(&Store, 149, UINT64_MAX, &Start, &End));
+    ASSERT_EQ(49u, Start);
+    ASSERT_EQ(50u, End);
+    ASSERT_TRUE(QuicSentPacketStoreFindRange(&Store, 0, UINT64_MAX, &Start, &End));
+    ASSERT_EQ(0u, Start);
+    ASSERT_EQ(50u, End);
+}
+
+TEST_F(SentPacketStoreTest, Gaps)
+{
+    Add(1);
+    Add(5);
+    Add(6);
+    Add(40);
+    ASSERT_EQ(40u, QuicSentPacketStoreSpan(&Store));
+    ASSERT_EQ(4u, Store.PacketCount);
+    ASSERT_EQ(&Packets[1], Find(1));
+    ASSERT_EQ(NULL, Find(2));
+    ASSERT_EQ(&Packets[5], Find(5));
+    ASSERT_EQ(&Packets[40], Find(40));
+    ValidateHotFields();
+}
+
+TEST_F(SentPacketStoreTest, RemoveAndCompact)
+{
+    AddRange(0, 10);
+    Remove(0);
+    Remove(1);
+    Remove(3);
+    ASSERT_EQ(10u, QuicSentPacketStoreSpan(&Store));
+    QuicSentPacketStoreCompact(&Store);
+    ASSERT_EQ(8u, QuicSentPacketStoreSpan(&Store));
+    ASSERT_EQ(2u, QuicSentPacketStorePacketNumber(&Store, 0));
+    ASSERT_EQ(NULL, Find(3));
+    ASSERT_EQ(&Packets[4], Find(4));
+
+    for (uint64_t i = 4; i < 10; i++) {
+        Remove(i);
+    }
+    Remove(2);
+    ASSERT_TRUE(QuicSentPacketStoreIsEmpty(&Store));
+    QuicSentPacketStoreCompact(&Store);
+    ASSERT_EQ(0u, QuicSentPacketStoreSpan(&Store));
+
+    //
+    // The store can continue with a larger packet number after being emptied.
+    //
+    Add(1000);
+    ASSERT_EQ(1u, QuicSentPacketStoreSpan(&Store));
+    ASSERT_EQ(&Packets[1000], Find(1000));
+}
+
+TEST_F(SentPacketStoreTest, Release)
+{
+    AddRange(0, 10);
+    for (uint64_t i = 0; i < 10; i++) {
+        Remove(i);
+    }
+    QuicSentPacketStoreRelease(&Store);
+    ASSERT_EQ(NULL, Store.Packets);
+    ASSERT_EQ(0u, Store.Capacity);
+    ASSERT_TRUE(QuicSentPacketStoreIsEmpty(&Store));
+    ASSERT_EQ(NULL, Find(5));
+
+    //
+    // The slot arrays are allocated again by the next add.
+    //
+    AddRange(100, 5);
+    ASSERT_EQ((uint32_t)QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY, Store.Capacity);
+    ASSERT_EQ(&Packets[102], Find(102));
+    ValidateHotFields();
+}
+
+TEST_F(SentPacketStoreTest, GrowWhileWrapped)
+{
+    //
+    // Slide the window forward so that the used slots wrap around the end of
+    // the slot arrays, then force a reallocation.
+    //
+    AddRange(0, QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY);
+    ASSERT_EQ((uint32_t)QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY, Store.Capacity);
+    for (uint64_t i = 0; i < QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY / 2; i++) {
+        Remove(i);
+    }
+    AddRange(QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY, QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY / 2);
+    ASSERT_EQ((uint32_t)QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY, Store.Capacity);
+    ASSERT_NE(0u, Store.Head);
+
+    AddRange(QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY * 3 / 2, 1000);
+    ASSERT_LT((uint32_t)QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY, Store.Capacity);
+    ASSERT_TRUE(IS_POWER_OF_TWO(Store.Capacity));
+
+    const uint64_t Low = QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY / 2;
+    const uint64_t High = QUIC_SENT_PACKET_STORE_INITIAL_CAPACITY * 3 / 2 + 1000;
+    ASSERT_EQ(High - Low, Store.PacketCount);
+    ASSERT_EQ(NULL, Find(Low - 1));
+    for (uint64_t i = Low; i < High; i++) {
+        ASSERT_EQ(&Packets[i], Find(i));
+    }
+    ValidateHotFields();
+}
+
+TEST_F(SentPacketStoreTest, AckBlockScan)
+{
+    //
+    // Mimic ACK processing: acknowledge every other block of 10 packets and
+    // verify only the unacknowledged packets remain, in order.
+    //
+    AddRange(0, 1000);
+    for (uint64_t Low = 0; Low < 1000; Low += 20) {
+        uint32_t Start, End;
+        ASSERT_TRUE(QuicSentPacketStoreFindRange(&Store, Low, Low + 9, &Start, &End));
+        for (uint32_t i = Start; i < End; i++) {
+            ASSERT_EQ(&Packets[QuicSentPacketStorePacketNumber(&Store, i)], QuicSentPacketStoreRemove(&Store, i));
+        }
+    }
+    QuicSentPacketStoreCompact(&Store);
+    ASSERT_EQ(500u, Store.PacketCount);
+    ASSERT_EQ(10u, QuicSentPacketStorePacketNumber(&Store, 0));
+
+    uint64_t Expected = 10;
+    for (uint32_t i = 0; i < QuicSentPacketStoreSpan(&Store); i++) {
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketStoreGet(&Store, i);
+        if (Packet != NULL) {
+            ASSERT_EQ(Expected, Packet->PacketNumber);
+            Expected += (Expected % 20 == 19) ? 11 : 1;
+        }
+    }
+    ValidateHotFields();
+}
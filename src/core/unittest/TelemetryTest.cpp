@@ -0,0 +1,153 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the connection telemetry ring.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "TelemetryTest.cpp.clog.h"
+#endif
+
+struct TelemetryTest : public ::testing::Test
+{
+    QUIC_TELEMETRY Telemetry;
+    uint64_t TimeNow;
+
+    void SetUp() override {
+        CxPlatZeroMemory(&Telemetry, sizeof(Telemetry));
+        TimeNow = 1000000;
+    }
+
+    void TearDown() override {
+        QuicTelemetryUninitialize(&Telemetry);
+    }
+
+    //
+    // Records Count samples, one per interval, each tagged with its sequence
+    // number in the TimeUs field.
+    //
+    void Record(uint64_t Count) {
+        for (uint64_t i = 0; i < Count; i++) {
+            ASSERT_TRUE(QuicTelemetryIsSampleDue(&Telemetry, TimeNow));
+            QUIC_CONN_TELEMETRY_SAMPLE Sample;
+            CxPlatZeroMemory(&Sample, sizeof(Sample));
+            Sample.TimeUs = Telemetry.NextSequence;
+            QuicTelemetryRecord(&Telemetry, TimeNow, &Sample);
+            ASSERT_FALSE(QuicTelemetryIsSampleDue(&Telemetry, TimeNow));
+            TimeNow += MS_TO_US(Telemetry.IntervalMs);
+        }
+    }
+
+    //
+    // Reads up to MaxCount samples from Cursor, validates them and returns
+    // the header.
+    //
+    QUIC_CONN_TELEMETRY Read(uint64_t Cursor, uint32_t MaxCount) {
+        std::vector<uint8_t> Buffer(
+            sizeof(QUIC_CONN_TELEMETRY) + MaxCount * sizeof(QUIC_CONN_TELEMETRY_SAMPLE));
+        QUIC_CONN_TELEMETRY* Header = (QUIC_CONN_TELEMETRY*)Buffer.data();
+        Header->Cursor = Cursor;
+        uint32_t BufferLength = (uint32_t)Buffer.size();
+        EXPECT_EQ(QUIC_STATUS_SUCCESS, QuicTelemetryRead(&Telemetry, &BufferLength, Buffer.data()));
+        EXPECT_EQ(
+            sizeof(QUIC_CONN_TELEMETRY) + Header->SampleCount * sizeof(QUIC_CONN_TELEMETRY_SAMPLE),
+            BufferLength);
+        const QUIC_CONN_TELEMETRY_SAMPLE* Samples = (QUIC_CONN_TELEMETRY_SAMPLE*)(Header + 1);
+        const uint64_t First = Header->Cursor - Header->SampleCount;
+        for (uint32_t i = 0; i < Header->SampleCount; i++) {
+            EXPECT_EQ(First + i, Samples[i].TimeUs);
+        }
+        return *Header;
+    }
+};
+
+TEST_F(TelemetryTest, Disabled)
+{
+    ASSERT_FALSE(QuicTelemetryIsSampleDue(&Telemetry, TimeNow));
+    QUIC_CONN_TELEMETRY Header = {};
+    uint32_t BufferLength = sizeof(Header);
+    ASSERT_EQ(QUIC_STATUS_INVALID_STATE, QuicTelemetryRead(&Telemetry, &BufferLength, &Header));
+}
+
+TEST_F(TelemetryTest, EnableDisable)
+{
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicTelemetrySetInterval(&Telemetry, 10));
+    ASSERT_NE(nullptr, Telemetry.Samples);
+    ASSERT_EQ(10u, Telemetry.IntervalMs);
+    Record(5);
+
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicTelemetrySetInterval(&Telemetry, 0));
+    ASSERT_EQ(nullptr, Telemetry.Samples);
+    ASSERT_FALSE(QuicTelemetryIsSampleDue(&Telemetry, TimeNow));
+
+    //
+    // Sequence numbers carry on after re-enabling, but earlier samples are
+    // reported as dropped.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicTelemetrySetInterval(&Telemetry, 10));
+    Record(3);
+    QUIC_CONN_TELEMETRY Header = Read(0, 16);
+    ASSERT_EQ(3u, Header.SampleCount);
+    ASSERT_EQ(5u, Header.DroppedCount);
+    ASSERT_EQ(8u, Header.Cursor);
+}
+
+TEST_F(TelemetryTest, BufferSizing)
+{
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicTelemetrySetInterval(&Telemetry, 1));
+    Record(7);
+    uint32_t BufferLength = 0;
+    ASSERT_EQ(QUIC_STATUS_BUFFER_TOO_SMALL, QuicTelemetryRead(&Telemetry, &BufferLength, nullptr));
+    ASSERT_EQ(sizeof(QUIC_CONN_TELEMETRY) + 7 * sizeof(QUIC_CONN_TELEMETRY_SAMPLE), BufferLength);
+
+    QUIC_CONN_TELEMETRY Header = {};
+    Header.Cursor = 8;
+    BufferLength = sizeof(Header);
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER, QuicTelemetryRead(&Telemetry, &BufferLength, &Header));
+}
+
+TEST_F(TelemetryTest, CursorReads)
+{
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicTelemetrySetInterval(&Telemetry, 1));
+    Record(20);
+
+    uint64_t Cursor = 0;
+    uint32_t Total = 0;
+    while (Cursor < 20) {
+        QUIC_CONN_TELEMETRY Header = Read(Cursor, 6);
+        ASSERT_EQ(0u, Header.DroppedCount);
+        ASSERT_NE(0u, Header.SampleCount);
+        Total += Header.SampleCount;
+        Cursor = Header.Cursor;
+    }
+    ASSERT_EQ(20u, Total);
+
+    QUIC_CONN_TELEMETRY Header = Read(Cursor, 6);
+    ASSERT_EQ(0u, Header.SampleCount);
+    ASSERT_EQ(20u, Header.Cursor);
+}
+
+TEST_F(TelemetryTest, Wraparound)
+{
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicTelemetrySetInterval(&Telemetry, 1));
+    Record(QUIC_TELEMETRY_SAMPLE_COUNT + 10);
+
+    //
+    // A reader that started at zero has missed the overwritten samples and
+    // gets the remaining ones, in order, across the end of the ring.
+    //
+    QUIC_CONN_TELEMETRY Header = Read(0, QUIC_TELEMETRY_SAMPLE_COUNT * 2);
+    ASSERT_EQ(10u, Header.DroppedCount);
+    ASSERT_EQ((uint32_t)QUIC_TELEMETRY_SAMPLE_COUNT, Header.SampleCount);
+    ASSERT_EQ((uint64_t)QUIC_TELEMETRY_SAMPLE_COUNT + 10, Header.Cursor);
+
+    Header = Read(QUIC_TELEMETRY_SAMPLE_COUNT - 5, 10);
+    ASSERT_EQ(0u, Header.DroppedCount);
+    ASSERT_EQ(10u, Header.SampleCount);
+}
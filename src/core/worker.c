@@ -397,6 +397,8 @@ QuicWorkerUpdateQueueDelay(
     )
 {
     Worker->AverageQueueDelay = (7 * Worker->AverageQueueDelay + TimeInQueueUs) / 8;
+    QuicPerfHistogramRecord(
+        Worker->Partition, QUIC_PERF_HISTOGRAM_WORK_QUEUE_DELAY, TimeInQueueUs);
     QuicTraceEvent(
         WorkerQueueDelayUpdated,
         "[wrkr][%p] QueueDelay = %u",
@@ -744,9 +746,18 @@ QuicWorkerLoop(
 
     QUIC_OPERATION* Operation = QuicWorkerGetNextOperation(Worker);
     if (Operation != NULL) {
+        //
+        // Stateless operations are rare and relatively expensive, so each one
+        // is timed for the profiler rather than a sample.
+        //
+        const QUIC_OPERATION_TYPE OperType = Operation->Type;
+        const uint64_t ProfileStart = CxPlatCycleCount();
         QuicBindingProcessStatelessOperation(
             Operation->Type,
             Operation->STATELESS.Context);
+        QuicProfileRecord(
+            &Worker->Partition->Profile.Operations[OperType],
+            CxPlatCycleCount() - ProfileStart);
         QuicOperationFree(Operation);
         QuicPerfCounterIncrement(Worker->Partition, QUIC_PERF_COUNTER_WORK_OPER_COMPLETED);
         Worker->ExecutionContext.Ready = TRUE;
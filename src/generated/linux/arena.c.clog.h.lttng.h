@@ -0,0 +1,23 @@
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "arena slab",
+                QUIC_ARENA_SLAB_HEADER_SIZE + SlabSize);
+// arg2 = arg2 = "arena slab" = arg2
+// arg3 = arg3 = QUIC_ARENA_SLAB_HEADER_SIZE + SlabSize = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_ARENA_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
@@ -772,6 +772,44 @@ tracepoint(CLOG_CONNECTION_C, FailedRouteResolution , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ConnHibernated
+// [conn][%p] Hibernated after %u ms idle
+// QuicTraceLogConnInfo(
+        ConnHibernated,
+        Connection,
+        "Hibernated after %u ms idle",
+        Connection->Settings.HibernateTimeoutMs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->Settings.HibernateTimeoutMs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ConnHibernated
+#define _clog_4_ARGS_TRACE_ConnHibernated(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, ConnHibernated , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnRehydrated
+// [conn][%p] Rehydrated
+// QuicTraceLogConnInfo(
+        ConnRehydrated,
+        Connection,
+        "Rehydrated");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_ConnRehydrated
+#define _clog_3_ARGS_TRACE_ConnRehydrated(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CONNECTION_C, ConnRehydrated , arg1);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for UpdatePeerPacketTolerance
 // [conn][%p] Updating peer packet tolerance to %hhu
@@ -894,6 +932,26 @@ tracepoint(CLOG_CONNECTION_C, ConnDscpSet , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ConnTelemetryIntervalSet
+// [conn][%p] Telemetry interval set to %u ms
+// QuicTraceLogConnInfo(
+                ConnTelemetryIntervalSet,
+                Connection,
+                "Telemetry interval set to %u ms",
+                Connection->Telemetry.IntervalMs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->Telemetry.IntervalMs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ConnTelemetryIntervalSet
+#define _clog_4_ARGS_TRACE_ConnTelemetryIntervalSet(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, ConnTelemetryIntervalSet , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ApplySettings
 // [conn][%p] Applying new settings
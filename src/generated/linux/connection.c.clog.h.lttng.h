@@ -819,6 +819,48 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, FailedRouteResolution,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ConnHibernated
+// [conn][%p] Hibernated after %u ms idle
+// QuicTraceLogConnInfo(
+        ConnHibernated,
+        Connection,
+        "Hibernated after %u ms idle",
+        Connection->Settings.HibernateTimeoutMs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->Settings.HibernateTimeoutMs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnHibernated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnRehydrated
+// [conn][%p] Rehydrated
+// QuicTraceLogConnInfo(
+        ConnRehydrated,
+        Connection,
+        "Rehydrated");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnRehydrated,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for UpdatePeerPacketTolerance
 // [conn][%p] Updating peer packet tolerance to %hhu
@@ -961,6 +1003,29 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnDscpSet,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ConnTelemetryIntervalSet
+// [conn][%p] Telemetry interval set to %u ms
+// QuicTraceLogConnInfo(
+                ConnTelemetryIntervalSet,
+                Connection,
+                "Telemetry interval set to %u ms",
+                Connection->Telemetry.IntervalMs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->Telemetry.IntervalMs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnTelemetryIntervalSet,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ApplySettings
 // [conn][%p] Applying new settings
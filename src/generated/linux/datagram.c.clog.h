@@ -85,6 +85,30 @@ tracepoint(CLOG_DATAGRAM_C, IndicateDatagramStateChanged , arg1, arg3, arg4);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendReplaced
+// [conn][%p] Datagram [%p] replaced by [%p] (key %u)
+// QuicTraceLogConnVerbose(
+        DatagramSendReplaced,
+        Connection,
+        "Datagram [%p] replaced by [%p] (key %u)",
+        OldRequest,
+        SendRequest,
+        SendRequest->DatagramKey);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = OldRequest = arg3
+// arg4 = arg4 = SendRequest = arg4
+// arg5 = arg5 = SendRequest->DatagramKey = arg5
+----------------------------------------------------------*/
+#ifndef _clog_6_ARGS_TRACE_DatagramSendReplaced
+#define _clog_6_ARGS_TRACE_DatagramSendReplaced(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5)\
+tracepoint(CLOG_DATAGRAM_C, DatagramSendReplaced , arg1, arg3, arg4, arg5);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DatagramSendQueued
 // [conn][%p] Datagram [%p] queued with %llu bytes (flags 0x%x)
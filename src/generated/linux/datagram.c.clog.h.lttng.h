@@ -70,6 +70,37 @@ TRACEPOINT_EVENT(CLOG_DATAGRAM_C, IndicateDatagramStateChanged,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendReplaced
+// [conn][%p] Datagram [%p] replaced by [%p] (key %u)
+// QuicTraceLogConnVerbose(
+        DatagramSendReplaced,
+        Connection,
+        "Datagram [%p] replaced by [%p] (key %u)",
+        OldRequest,
+        SendRequest,
+        SendRequest->DatagramKey);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = OldRequest = arg3
+// arg4 = arg4 = SendRequest = arg4
+// arg5 = arg5 = SendRequest->DatagramKey = arg5
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramSendReplaced,
+    TP_ARGS(
+        const void *, arg1,
+        const void *, arg3,
+        const void *, arg4,
+        unsigned int, arg5), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer_hex(uint64_t, arg3, (uint64_t)arg3)
+        ctf_integer_hex(uint64_t, arg4, (uint64_t)arg4)
+        ctf_integer(unsigned int, arg5, arg5)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DatagramSendQueued
 // [conn][%p] Datagram [%p] queued with %llu bytes (flags 0x%x)
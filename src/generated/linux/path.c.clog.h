@@ -105,6 +105,28 @@ tracepoint(CLOG_PATH_C, PathActive , arg1, arg3, arg4);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for PathCcResumed
+// [conn][%p] Path[%hhu] Resuming congestion control (cwnd=%u)
+// QuicTraceLogConnInfo(
+                PathCcResumed,
+                Connection,
+                "Path[%hhu] Resuming congestion control (cwnd=%u)",
+                ActivePath->ID,
+                Cache->CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = ActivePath->ID = arg3
+// arg4 = arg4 = Cache->CongestionWindow = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_PathCcResumed
+#define _clog_5_ARGS_TRACE_PathCcResumed(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_PATH_C, PathCcResumed , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PathQeoEnabled
 // [conn][%p] Path[%hhu] QEO enabled
@@ -101,6 +101,33 @@ TRACEPOINT_EVENT(CLOG_PATH_C, PathActive,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for PathCcResumed
+// [conn][%p] Path[%hhu] Resuming congestion control (cwnd=%u)
+// QuicTraceLogConnInfo(
+                PathCcResumed,
+                Connection,
+                "Path[%hhu] Resuming congestion control (cwnd=%u)",
+                ActivePath->ID,
+                Cache->CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = ActivePath->ID = arg3
+// arg4 = arg4 = Cache->CongestionWindow = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_PATH_C, PathCcResumed,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3,
+        unsigned int, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PathQeoEnabled
 // [conn][%p] Path[%hhu] QEO enabled
@@ -213,6 +213,26 @@ tracepoint(CLOG_SEND_C, ConnQueueSendFlush , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "stream heap",
+                NewCapacity * sizeof(QUIC_STREAM*));
+// arg2 = arg2 = "stream heap" = arg2
+// arg3 = arg3 = NewCapacity * sizeof(QUIC_STREAM*) = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AllocFailure
+#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_SEND_C, AllocFailure , arg2, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnFlushSend
 // [conn][%p] Flushing Send. Allowance=%u bytes
@@ -208,6 +208,29 @@ TRACEPOINT_EVENT(CLOG_SEND_C, ConnQueueSendFlush,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "stream heap",
+                NewCapacity * sizeof(QUIC_STREAM*));
+// arg2 = arg2 = "stream heap" = arg2
+// arg3 = arg3 = NewCapacity * sizeof(QUIC_STREAM*) = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SEND_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnFlushSend
 // [conn][%p] Flushing Send. Allowance=%u bytes
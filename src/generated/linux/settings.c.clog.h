@@ -677,6 +677,21 @@ tracepoint(CLOG_SETTINGS_C, SettingDestCidUpdateIdleTimeoutMs , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpHibernateTimeoutMs
+// [sett] HibernateTimeoutMs     = %u
+// QuicTraceLogVerbose(SettingDumpHibernateTimeoutMs,      "[sett] HibernateTimeoutMs     = %u", Settings->HibernateTimeoutMs);
+// arg2 = arg2 = Settings->HibernateTimeoutMs = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpHibernateTimeoutMs
+#define _clog_3_ARGS_TRACE_SettingDumpHibernateTimeoutMs(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpHibernateTimeoutMs , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingGreaseQuicBitEnabled
 // [sett] GreaseQuicBitEnabled   = %hhu
@@ -107,6 +107,46 @@ tracepoint(CLOG_STREAM_C, UpdatePriority , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for UpdateSchedulingDeadline
+// [strm][%p] New scheduling deadline = %llu us
+// QuicTraceLogStreamInfo(
+            UpdateSchedulingDeadline,
+            Stream,
+            "New scheduling deadline = %llu us",
+            Stream->SchedulingDeadlineUs);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = Stream->SchedulingDeadlineUs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_UpdateSchedulingDeadline
+#define _clog_4_ARGS_TRACE_UpdateSchedulingDeadline(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_STREAM_C, UpdateSchedulingDeadline , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for UpdateSendExpiry
+// [strm][%p] New send expiry = %llu us
+// QuicTraceLogStreamInfo(
+            UpdateSendExpiry,
+            Stream,
+            "New send expiry = %llu us",
+            Stream->SendExpiryUs);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = Stream->SendExpiryUs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_UpdateSendExpiry
+#define _clog_4_ARGS_TRACE_UpdateSendExpiry(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_STREAM_C, UpdateSendExpiry , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for MultipleReliableResetSendNotSupported
 // [strm][%p] Multiple RELIABLE_RESET frames sending not supported.
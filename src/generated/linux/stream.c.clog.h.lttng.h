@@ -81,6 +81,52 @@ TRACEPOINT_EVENT(CLOG_STREAM_C, UpdatePriority,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for UpdateSchedulingDeadline
+// [strm][%p] New scheduling deadline = %llu us
+// QuicTraceLogStreamInfo(
+            UpdateSchedulingDeadline,
+            Stream,
+            "New scheduling deadline = %llu us",
+            Stream->SchedulingDeadlineUs);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = Stream->SchedulingDeadlineUs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_C, UpdateSchedulingDeadline,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for UpdateSendExpiry
+// [strm][%p] New send expiry = %llu us
+// QuicTraceLogStreamInfo(
+            UpdateSendExpiry,
+            Stream,
+            "New send expiry = %llu us",
+            Stream->SendExpiryUs);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = Stream->SendExpiryUs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_C, UpdateSendExpiry,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for MultipleReliableResetSendNotSupported
 // [strm][%p] Multiple RELIABLE_RESET frames sending not supported.
@@ -357,15 +357,15 @@ tracepoint(CLOG_STREAM_RECV_C, RemoteBlocked , arg1, arg3);\
 // Decoder Ring for IncreaseRxBuffer
 // [strm][%p] Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)
 // QuicTraceLogStreamVerbose(
-                    IncreaseRxBuffer,
-                    Stream,
-                    "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
-                    Stream->RecvBuffer.VirtualBufferLength * 2,
-                    Stream->Connection->Paths[0].MinRtt,
-                    TimeNow,
-                    Stream->RecvWindowLastUpdate);
+            IncreaseRxBuffer,
+            Stream,
+            "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
+            (uint32_t)TargetWindow,
+            Stream->Connection->Paths[0].MinRtt,
+            TimeNow,
+            Stream->RecvWindowLastUpdate);
 // arg1 = arg1 = Stream = arg1
-// arg3 = arg3 = Stream->RecvBuffer.VirtualBufferLength * 2 = arg3
+// arg3 = arg3 = (uint32_t)TargetWindow = arg3
 // arg4 = arg4 = Stream->Connection->Paths[0].MinRtt = arg4
 // arg5 = arg5 = TimeNow = arg5
 // arg6 = arg6 = Stream->RecvWindowLastUpdate = arg6
@@ -379,6 +379,32 @@ tracepoint(CLOG_STREAM_RECV_C, IncreaseRxBuffer , arg1, arg3, arg4, arg5, arg6);
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DecreaseRxBuffer
+// [strm][%p] Decreasing max RX buffer size to %u (SmoothedRtt=%llu; Delivered=%llu; Elapsed=%llu)
+// QuicTraceLogStreamVerbose(
+                DecreaseRxBuffer,
+                Stream,
+                "Decreasing max RX buffer size to %u (SmoothedRtt=%llu; Delivered=%llu; Elapsed=%llu)",
+                (uint32_t)NewWindow,
+                Rtt,
+                Stream->RecvWindowSampleBytes,
+                Elapsed);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = (uint32_t)NewWindow = arg3
+// arg4 = arg4 = Rtt = arg4
+// arg5 = arg5 = Stream->RecvWindowSampleBytes = arg5
+// arg6 = arg6 = Elapsed = arg6
+----------------------------------------------------------*/
+#ifndef _clog_7_ARGS_TRACE_DecreaseRxBuffer
+#define _clog_7_ARGS_TRACE_DecreaseRxBuffer(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5, arg6)\
+tracepoint(CLOG_STREAM_RECV_C, DecreaseRxBuffer , arg1, arg3, arg4, arg5, arg6);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for UpdateFlowControl
 // [strm][%p] Updating flow control window
@@ -356,15 +356,15 @@ TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, RemoteBlocked,
 // Decoder Ring for IncreaseRxBuffer
 // [strm][%p] Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)
 // QuicTraceLogStreamVerbose(
-                    IncreaseRxBuffer,
-                    Stream,
-                    "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
-                    Stream->RecvBuffer.VirtualBufferLength * 2,
-                    Stream->Connection->Paths[0].MinRtt,
-                    TimeNow,
-                    Stream->RecvWindowLastUpdate);
+            IncreaseRxBuffer,
+            Stream,
+            "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
+            (uint32_t)TargetWindow,
+            Stream->Connection->Paths[0].MinRtt,
+            TimeNow,
+            Stream->RecvWindowLastUpdate);
 // arg1 = arg1 = Stream = arg1
-// arg3 = arg3 = Stream->RecvBuffer.VirtualBufferLength * 2 = arg3
+// arg3 = arg3 = (uint32_t)TargetWindow = arg3
 // arg4 = arg4 = Stream->Connection->Paths[0].MinRtt = arg4
 // arg5 = arg5 = TimeNow = arg5
 // arg6 = arg6 = Stream->RecvWindowLastUpdate = arg6
@@ -387,6 +387,41 @@ TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, IncreaseRxBuffer,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DecreaseRxBuffer
+// [strm][%p] Decreasing max RX buffer size to %u (SmoothedRtt=%llu; Delivered=%llu; Elapsed=%llu)
+// QuicTraceLogStreamVerbose(
+                DecreaseRxBuffer,
+                Stream,
+                "Decreasing max RX buffer size to %u (SmoothedRtt=%llu; Delivered=%llu; Elapsed=%llu)",
+                (uint32_t)NewWindow,
+                Rtt,
+                Stream->RecvWindowSampleBytes,
+                Elapsed);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = (uint32_t)NewWindow = arg3
+// arg4 = arg4 = Rtt = arg4
+// arg5 = arg5 = Stream->RecvWindowSampleBytes = arg5
+// arg6 = arg6 = Elapsed = arg6
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, DecreaseRxBuffer,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3,
+        unsigned long long, arg4,
+        unsigned long long, arg5,
+        unsigned long long, arg6), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+        ctf_integer(uint64_t, arg5, arg5)
+        ctf_integer(uint64_t, arg6, arg6)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for UpdateFlowControl
 // [strm][%p] Updating flow control window
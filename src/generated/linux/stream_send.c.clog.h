@@ -14,6 +14,10 @@
 #include "stream_send.c.clog.h.lttng.h"
 #endif
 #include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogStreamInfo
+#define _clog_MACRO_QuicTraceLogStreamInfo  1
+#define QuicTraceLogStreamInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifndef _clog_MACRO_QuicTraceLogStreamVerbose
 #define _clog_MACRO_QuicTraceLogStreamVerbose  1
 #define QuicTraceLogStreamVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
@@ -25,6 +29,26 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/*----------------------------------------------------------
+// Decoder Ring for SendExpired
+// [strm][%p] Dropping expired data from offset %llu
+// QuicTraceLogStreamInfo(
+        SendExpired,
+        Stream,
+        "Dropping expired data from offset %llu",
+        SendRequest->StreamOffset);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = SendRequest->StreamOffset = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_SendExpired
+#define _clog_4_ARGS_TRACE_SendExpired(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_STREAM_SEND_C, SendExpired , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IndicateSendShutdownComplete
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_SHUTDOWN_COMPLETE
@@ -47,10 +71,10 @@ tracepoint(CLOG_STREAM_SEND_C, IndicateSendShutdownComplete , arg1);\
 // Decoder Ring for IndicateSendCanceled
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)
 // QuicTraceLogStreamVerbose(
-                IndicateSendCanceled,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
-                SendRequest);
+            IndicateSendCanceled,
+            Stream,
+            "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
+            SendRequest);
 // arg1 = arg1 = Stream = arg1
 // arg3 = arg3 = SendRequest = arg3
 ----------------------------------------------------------*/
@@ -67,10 +91,10 @@ tracepoint(CLOG_STREAM_SEND_C, IndicateSendCanceled , arg1, arg3);\
 // Decoder Ring for IndicateSendComplete
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]
 // QuicTraceLogStreamVerbose(
-                IndicateSendComplete,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
-                SendRequest);
+            IndicateSendComplete,
+            Stream,
+            "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
+            SendRequest);
 // arg1 = arg1 = Stream = arg1
 // arg3 = arg3 = SendRequest = arg3
 ----------------------------------------------------------*/
@@ -367,6 +391,46 @@ tracepoint(CLOG_STREAM_SEND_C, StreamSendState , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for StreamError
+// [strm][%p] ERROR, %s.
+// QuicTraceEvent(
+        StreamError,
+        "[strm][%p] ERROR, %s.",
+        Stream,
+        "Send file read failed");
+// arg2 = arg2 = Stream = arg2
+// arg3 = arg3 = "Send file read failed" = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_StreamError
+#define _clog_4_ARGS_TRACE_StreamError(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_STREAM_SEND_C, StreamError , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "STRM_SHUTDOWN operation",
+            0);
+// arg2 = arg2 = "STRM_SHUTDOWN operation" = arg2
+// arg3 = arg3 = 0 = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AllocFailure
+#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_STREAM_SEND_C, AllocFailure , arg2, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for StreamWriteFrames
 // [strm][%p] Writing frames to packet %llu
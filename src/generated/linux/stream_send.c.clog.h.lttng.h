@@ -1,6 +1,29 @@
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SendExpired
+// [strm][%p] Dropping expired data from offset %llu
+// QuicTraceLogStreamInfo(
+        SendExpired,
+        Stream,
+        "Dropping expired data from offset %llu",
+        SendRequest->StreamOffset);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = SendRequest->StreamOffset = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, SendExpired,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IndicateSendShutdownComplete
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_SHUTDOWN_COMPLETE
@@ -24,10 +47,10 @@ TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, IndicateSendShutdownComplete,
 // Decoder Ring for IndicateSendCanceled
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)
 // QuicTraceLogStreamVerbose(
-                IndicateSendCanceled,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
-                SendRequest);
+            IndicateSendCanceled,
+            Stream,
+            "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
+            SendRequest);
 // arg1 = arg1 = Stream = arg1
 // arg3 = arg3 = SendRequest = arg3
 ----------------------------------------------------------*/
@@ -47,10 +70,10 @@ TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, IndicateSendCanceled,
 // Decoder Ring for IndicateSendComplete
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]
 // QuicTraceLogStreamVerbose(
-                IndicateSendComplete,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
-                SendRequest);
+            IndicateSendComplete,
+            Stream,
+            "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
+            SendRequest);
 // arg1 = arg1 = Stream = arg1
 // arg3 = arg3 = SendRequest = arg3
 ----------------------------------------------------------*/
@@ -413,6 +436,52 @@ TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, StreamSendState,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for StreamError
+// [strm][%p] ERROR, %s.
+// QuicTraceEvent(
+        StreamError,
+        "[strm][%p] ERROR, %s.",
+        Stream,
+        "Send file read failed");
+// arg2 = arg2 = Stream = arg2
+// arg3 = arg3 = "Send file read failed" = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, StreamError,
+    TP_ARGS(
+        const void *, arg2,
+        const char *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_string(arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "STRM_SHUTDOWN operation",
+            0);
+// arg2 = arg2 = "STRM_SHUTDOWN operation" = arg2
+// arg3 = arg3 = 0 = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for StreamWriteFrames
 // [strm][%p] Writing frames to packet %llu
@@ -190,6 +190,10 @@ DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_RESUMPTION_FLAGS)
 typedef enum QUIC_STREAM_SCHEDULING_SCHEME {
     QUIC_STREAM_SCHEDULING_SCHEME_FIFO          = 0x0000,   // Sends stream data first come, first served. (Default)
     QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN   = 0x0001,   // Sends stream data evenly multiplexed.
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR = 0x0002,   // Shares bandwidth in proportion to stream priority.
+    QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE      = 0x0003,   // Sends the stream with the earliest deadline first.
+#endif
     QUIC_STREAM_SCHEDULING_SCHEME_COUNT,                    // The number of stream scheduling schemes.
 } QUIC_STREAM_SCHEDULING_SCHEME;
 
@@ -249,6 +253,10 @@ typedef enum QUIC_SEND_FLAGS {
     QUIC_SEND_FLAG_CANCEL_ON_LOSS           = 0x0020,   // Indicates that a stream is to be cancelled when packet loss is detected.
     QUIC_SEND_FLAG_PRIORITY_WORK            = 0x0040,   // Higher priority than other connection work.
     QUIC_SEND_FLAG_CANCEL_ON_BLOCKED        = 0x0080,   // Indicates that a frame should be dropped when it can't be sent immediately.
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    QUIC_SEND_FLAG_EXPIRES                  = 0x0100,   // Indicates the data may be dropped if it is lost after the stream's send expiry.
+    QUIC_SEND_FLAG_NO_COPY                  = 0x0200,   // Indicates send buffering should reference the data instead of copying it.
+#endif
 } QUIC_SEND_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_FLAGS)
@@ -637,6 +645,13 @@ typedef struct QUIC_STATISTICS_V2 {
 
     uint32_t RttVariance;                   // In microseconds
 
+    uint32_t MigrationCount;                // Active path IP changes (NAT port rebinds are not counted).
+    uint32_t MigrationCachedCcCount;        // Migrations that resumed the path's cached congestion control state.
+    uint64_t LastPathValidationTimeUs;      // Duration of the last successful path validation.
+
+    uint32_t HibernationCount;              // Number of times the connection released its idle buffers.
+    uint32_t RehydrationCount;              // Number of times the connection woke from hibernation.
+
     // N.B. New fields must be appended to end
 
 } QUIC_STATISTICS_V2;
@@ -648,6 +663,53 @@ typedef struct QUIC_STATISTICS_V2 {
 #define QUIC_STATISTICS_V2_SIZE_2   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, DestCidUpdateCount)     // MsQuic v2.1 final size
 #define QUIC_STATISTICS_V2_SIZE_3   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, SendEcnCongestionCount) // MsQuic v2.2 final size
 #define QUIC_STATISTICS_V2_SIZE_4   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, RttVariance)            // MsQuic v2.5 final size
+#define QUIC_STATISTICS_V2_SIZE_5   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, LastPathValidationTimeUs)
+#define QUIC_STATISTICS_V2_SIZE_6   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, RehydrationCount)
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+typedef struct QUIC_CONN_TELEMETRY_SAMPLE {
+
+    uint64_t TimeUs;                        // Time since the connection started.
+    uint64_t SmoothedRttUs;
+    uint64_t MinRttUs;
+    uint64_t BandwidthEstimate;             // In bytes per second
+    uint64_t PacingRate;                    // In bytes per second; zero if not pacing.
+    uint64_t SendTotalPackets;
+    uint64_t SendLostPackets;               // SuspectedLostPackets - SpuriousLostPackets
+    uint32_t CongestionWindow;
+    uint32_t BytesInFlight;
+
+} QUIC_CONN_TELEMETRY_SAMPLE;
+
+//
+// Header for reading QUIC_PARAM_CONN_TELEMETRY. The caller sets Cursor to the
+// sequence number of the first sample it wants (zero initially) and gets back
+// as many QUIC_CONN_TELEMETRY_SAMPLE as fit in the buffer, immediately after
+// the header, along with the cursor to pass in on the next read.
+//
+typedef struct QUIC_CONN_TELEMETRY {
+
+    uint64_t Cursor;                        // In: first sample wanted; Out: next sample to read.
+    uint32_t SampleCount;                   // Out: samples following this header.
+    uint32_t DroppedCount;                  // Out: samples overwritten before they were read.
+
+} QUIC_CONN_TELEMETRY;
+
+//
+// Memory used by a connection's arena (see
+// QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE). All values are in bytes except
+// SlabCount.
+//
+typedef struct QUIC_CONN_ARENA_STATISTICS {
+
+    uint32_t SlabCount;
+    uint32_t SlabBytes;                     // Taken from the heap for slabs, headers included.
+    uint32_t UsedBytes;                     // Handed out from the slabs right now.
+    uint32_t PeakUsedBytes;
+    uint32_t HeapBytes;                     // Requests too large for the arena (or all, if disabled).
+
+} QUIC_CONN_ARENA_STATISTICS;
+#endif
 
 typedef struct QUIC_LISTENER_STATISTICS {
 
@@ -694,6 +756,49 @@ typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_MAX,
 } QUIC_PERFORMANCE_COUNTERS;
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+typedef enum QUIC_PERFORMANCE_HISTOGRAMS {
+    QUIC_PERF_HISTOGRAM_WORK_QUEUE_DELAY,       // Microseconds a connection waited in a worker queue.
+    QUIC_PERF_HISTOGRAM_HANDSHAKE_TIME,         // Microseconds from connection start to handshake completion.
+    QUIC_PERF_HISTOGRAM_RTT,                    // Microseconds, one per RTT sample.
+    QUIC_PERF_HISTOGRAM_ACK_PROCESSING_TIME,    // Microseconds spent processing an ACK frame (sampled).
+    QUIC_PERF_HISTOGRAM_DRAIN_BATCH_SIZE,       // Operations processed per connection drain.
+    QUIC_PERF_HISTOGRAM_MAX,
+} QUIC_PERFORMANCE_HISTOGRAMS;
+
+//
+// Each histogram has log-linear buckets: values below 16 get a bucket each and
+// every power of two above that is split into 8 equal buckets, up to
+// UINT32_MAX (larger values land in the last bucket). Bucket i holds values
+// from QUIC_PERF_HISTOGRAM_BUCKET_LOW(i) up to, but not including, the next
+// bucket's low value.
+//
+#define QUIC_PERF_HISTOGRAM_BUCKET_COUNT 240
+#define QUIC_PERF_HISTOGRAM_BUCKET_LOW(i) \
+    ((i) < 16 ? (uint64_t)(i) : ((uint64_t)((i) % 8 + 8) << ((i) / 8 - 1)))
+#endif
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+typedef enum QUIC_PROFILE_CATEGORY {
+    QUIC_PROFILE_CATEGORY_OPERATION,        // Connection or stateless operations, by operation type.
+    QUIC_PROFILE_CATEGORY_API_CALL,         // API call operations, by API type.
+    QUIC_PROFILE_CATEGORY_FRAME,            // Received frames, by frame type.
+} QUIC_PROFILE_CATEGORY;
+
+//
+// Sampled cost of one kind of work. Cycles are CPU timestamp counter ticks
+// where available (platform clock ticks otherwise), so are only meaningful
+// relative to each other.
+//
+typedef struct QUIC_PROFILE_ENTRY {
+    QUIC_PROFILE_CATEGORY Category;
+    uint32_t Type;
+    uint64_t Samples;
+    uint64_t Cycles;
+    char Name[48];
+} QUIC_PROFILE_ENTRY;
+#endif
+
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 typedef struct QUIC_VERSION_SETTINGS {
 
@@ -774,7 +879,8 @@ typedef struct QUIC_SETTINGS {
             uint64_t XdpEnabled                             : 1;
             uint64_t QTIPEnabled                            : 1;
             uint64_t RioEnabled                             : 1;
-            uint64_t RESERVED                               : 18;
+            uint64_t HibernateTimeoutMs                     : 1;
+            uint64_t RESERVED                               : 17;
 #else
             uint64_t RESERVED                               : 26;
 #endif
@@ -837,6 +943,9 @@ typedef struct QUIC_SETTINGS {
     uint32_t StreamRecvWindowBidiLocalDefault;
     uint32_t StreamRecvWindowBidiRemoteDefault;
     uint32_t StreamRecvWindowUnidiDefault;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    uint32_t HibernateTimeoutMs;
+#endif
 
 } QUIC_SETTINGS;
 
@@ -873,8 +982,17 @@ typedef struct QUIC_STREAM_STATISTICS {
     uint64_t StreamBlockedByIdFlowControlUs;
     uint64_t StreamBlockedByFlowControlUs;
     uint64_t StreamBlockedByAppUs;
+    //
+    // The scheduling fields are only tracked under the WEIGHTED_FAIR and
+    // DEADLINE stream scheduling schemes.
+    //
+    uint64_t SchedulingDelayUs;             // Total time spent queued before being picked to send.
+    uint64_t SchedulingMaxDelayUs;          // Longest single wait before being picked to send.
+    uint64_t SchedulingDeadlineMissCount;   // Times picked after the scheduling deadline passed.
 } QUIC_STREAM_STATISTICS;
 
+#define QUIC_STREAM_STATISTICS_SIZE_1   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STREAM_STATISTICS, StreamBlockedByAppUs)
+
 //
 // Functions for associating application contexts with QUIC handles. MsQuic
 // provides no explicit synchronization between parallel calls to these
@@ -947,6 +1065,15 @@ void
 #define QUIC_PARAM_GLOBAL_TLS_PROVIDER                  0x0100000A  // QUIC_TLS_PROVIDER
 #define QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY           0x0100000B  // uint8_t[] - Array size is QUIC_STATELESS_RESET_KEY_LENGTH
 #define QUIC_PARAM_GLOBAL_STATISTICS_V2_SIZES           0x0100000C  // uint32_t[] - Array of sizes for each QUIC_STATISTICS_V2 version. Get-only. Pass a buffer of uint32_t, output count is variable. See documentation for details.
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#define QUIC_PARAM_GLOBAL_PERF_HISTOGRAMS               0x0100000D  // int64_t[][] - Array size is QUIC_PERF_HISTOGRAM_MAX * QUIC_PERF_HISTOGRAM_BUCKET_COUNT
+#endif
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#define QUIC_PARAM_GLOBAL_PROFILE                       0x0100000E  // QUIC_PROFILE_ENTRY[]
+#endif
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#define QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE          0x0100000F  // uint32_t - bytes, 0 to disable
+#endif
 
 //
 // Parameters for Registration.
@@ -1011,6 +1138,11 @@ typedef struct QUIC_SCHANNEL_CREDENTIAL_ATTRIBUTE_W {
 #define QUIC_PARAM_CONN_STATISTICS_V2_PLAT              0x05000017  // QUIC_STATISTICS_V2
 #define QUIC_PARAM_CONN_ORIG_DEST_CID                   0x05000018  // uint8_t[]
 #define QUIC_PARAM_CONN_SEND_DSCP                       0x05000019  // uint8_t
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#define QUIC_PARAM_CONN_TELEMETRY_INTERVAL              0x0500001A  // uint32_t - milliseconds
+#define QUIC_PARAM_CONN_TELEMETRY                       0x0500001B  // QUIC_CONN_TELEMETRY + QUIC_CONN_TELEMETRY_SAMPLE[]
+#define QUIC_PARAM_CONN_ARENA_STATISTICS                0x0500001C  // QUIC_CONN_ARENA_STATISTICS
+#endif
 
 //
 // Parameters for TLS.
@@ -1043,6 +1175,8 @@ typedef struct QUIC_SCHANNEL_CONTEXT_ATTRIBUTE_EX_W {
 #define QUIC_PARAM_STREAM_STATISTICS                    0X08000004  // QUIC_STREAM_STATISTICS
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_PARAM_STREAM_RELIABLE_OFFSET               0x08000005  // uint64_t
+#define QUIC_PARAM_STREAM_SCHEDULING_DEADLINE           0x08000006  // uint64_t - microseconds after data is queued, 0 for none
+#define QUIC_PARAM_STREAM_SEND_EXPIRY                   0x08000007  // uint64_t - microseconds after data is queued, 0 for none
 #endif
 
 typedef
@@ -1547,6 +1681,9 @@ typedef struct QUIC_STREAM_EVENT {
         struct {
             BOOLEAN Canceled;
             void* ClientContext;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+            QUIC_STATUS Status;
+#endif
         } SEND_COMPLETE;
         struct {
             QUIC_UINT62 ErrorCode;
@@ -1689,6 +1826,55 @@ QUIC_STATUS
     _In_reads_(BufferCount) const QUIC_BUFFER* Buffers
     );
 
+#ifndef _KERNEL_MODE
+//
+// Queues Length bytes of File, starting at Offset, to be sent on the stream.
+// The data is read from the file as packets are built instead of up front, so
+// the app doesn't need to hold it in memory. The file must stay open and the
+// range unmodified until the QUIC_STREAM_EVENT_SEND_COMPLETE event.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_SEND_FILE_FN)(
+    _In_ _Pre_defensive_ HQUIC Stream,
+    _In_ QUIC_FILE File,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    );
+#endif
+
+//
+// One send in a StreamSendBatch call. Stream, Buffers, BufferCount, Flags and
+// ClientSendContext mean the same as for StreamSend. Status is set by the call
+// to the result of queuing this send.
+//
+typedef struct QUIC_STREAM_SEND_BATCH_ENTRY {
+    HQUIC Stream;
+    const QUIC_BUFFER* Buffers;
+    uint32_t BufferCount;
+    QUIC_SEND_FLAGS Flags;
+    void* ClientSendContext;
+    QUIC_STATUS Status;
+} QUIC_STREAM_SEND_BATCH_ENTRY;
+
+//
+// Queues a send on each entry's stream, all of which must belong to the same
+// connection, and flushes them with a single connection operation. Returns
+// QUIC_STATUS_PENDING if every send was queued, otherwise the first failure;
+// each entry's Status says whether its own send was queued.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_SEND_BATCH_FN)(
+    _In_ _Pre_defensive_ HQUIC Connection,
+    _Inout_updates_(EntryCount) QUIC_STREAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount
+    );
+
 #endif
 
 //
@@ -1711,6 +1897,40 @@ QUIC_STATUS
     _In_opt_ void* ClientSendContext
     );
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+//
+// One datagram in a DatagramSendBatch call. Buffers, BufferCount, Flags and
+// ClientSendContext mean the same as the parameters of DatagramSend.
+//
+// Datagrams with a higher Priority are sent first; QUIC_SEND_FLAG_DGRAM_PRIORITY
+// ranks above every Priority. If ReplaceKey is non-zero, a queued datagram
+// that hasn't been sent yet and has the same key is canceled in favor of this
+// one, so only the latest update for a key is sent.
+//
+typedef struct QUIC_DATAGRAM_SEND_BATCH_ENTRY {
+    const QUIC_BUFFER* Buffers;
+    uint32_t BufferCount;
+    QUIC_SEND_FLAGS Flags;
+    void* ClientSendContext;
+    uint8_t Priority;
+    uint32_t ReplaceKey;
+} QUIC_DATAGRAM_SEND_BATCH_ENTRY;
+
+//
+// Sends several unreliable datagrams on the connection with a single call.
+// Either all of them are queued or, if the call fails, none are.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_DATAGRAM_SEND_BATCH_FN)(
+    _In_ _Pre_defensive_ HQUIC Connection,
+    _In_reads_(EntryCount) _Pre_defensive_
+        const QUIC_DATAGRAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount
+    );
+#endif
+
 //
 // Connection Pool API
 //
@@ -1821,7 +2041,11 @@ typedef struct QUIC_API_TABLE {
     QUIC_EXECUTION_CREATE_FN            ExecutionCreate;    // Available from v2.5
     QUIC_EXECUTION_DELETE_FN            ExecutionDelete;    // Available from v2.5
     QUIC_EXECUTION_POLL_FN              ExecutionPoll;      // Available from v2.5
+    QUIC_STREAM_SEND_FILE_FN            StreamSendFile;     // Available from v2.6
 #endif // _KERNEL_MODE
+
+    QUIC_STREAM_SEND_BATCH_FN           StreamSendBatch;    // Available from v2.6
+    QUIC_DATAGRAM_SEND_BATCH_FN         DatagramSendBatch;  // Available from v2.6
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
 
 } QUIC_API_TABLE;
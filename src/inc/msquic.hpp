@@ -690,6 +690,7 @@ public:
     MsQuicSettings& SetInitialRttMs(uint32_t Value) { InitialRttMs = Value; IsSet.InitialRttMs = TRUE; return *this; }
     MsQuicSettings& SetIdleTimeoutMs(uint64_t Value) { IdleTimeoutMs = Value; IsSet.IdleTimeoutMs = TRUE; return *this; }
     MsQuicSettings& SetHandshakeIdleTimeoutMs(uint64_t Value) { HandshakeIdleTimeoutMs = Value; IsSet.HandshakeIdleTimeoutMs = TRUE; return *this; }
+    MsQuicSettings& SetMaxStatelessOperations(uint32_t Value) { MaxStatelessOperations = Value; IsSet.MaxStatelessOperations = TRUE; return *this; }
     MsQuicSettings& SetDisconnectTimeoutMs(uint32_t Value) { DisconnectTimeoutMs = Value; IsSet.DisconnectTimeoutMs = TRUE; return *this; }
     MsQuicSettings& SetPeerBidiStreamCount(uint16_t Value) { PeerBidiStreamCount = Value; IsSet.PeerBidiStreamCount = TRUE; return *this; }
     MsQuicSettings& SetPeerUnidiStreamCount(uint16_t Value) { PeerUnidiStreamCount = Value; IsSet.PeerUnidiStreamCount = TRUE; return *this; }
@@ -715,6 +716,7 @@ public:
     MsQuicSettings& SetOneWayDelayEnabled(bool value) { OneWayDelayEnabled = value; IsSet.OneWayDelayEnabled = TRUE; return *this; }
     MsQuicSettings& SetNetStatsEventEnabled(bool value) { NetStatsEventEnabled = value; IsSet.NetStatsEventEnabled = TRUE; return *this; }
     MsQuicSettings& SetStreamMultiReceiveEnabled(bool value) { StreamMultiReceiveEnabled = value; IsSet.StreamMultiReceiveEnabled = TRUE; return *this; }
+    MsQuicSettings& SetHibernateTimeoutMs(uint32_t Value) { HibernateTimeoutMs = Value; IsSet.HibernateTimeoutMs = TRUE; return *this; }
 #endif
 
     QUIC_STATUS
@@ -1381,6 +1383,22 @@ struct MsQuicConnection {
                 Length,
                 Value);
     }
+
+    QUIC_STATUS
+    SendBatch(
+        _Inout_updates_(EntryCount) QUIC_STREAM_SEND_BATCH_ENTRY* Entries,
+        _In_ uint32_t EntryCount
+        ) noexcept {
+        return MsQuic->StreamSendBatch(Handle, Entries, EntryCount);
+    }
+
+    QUIC_STATUS
+    SendDatagrams(
+        _In_reads_(EntryCount) const QUIC_DATAGRAM_SEND_BATCH_ENTRY* Entries,
+        _In_ uint32_t EntryCount
+        ) noexcept {
+        return MsQuic->DatagramSendBatch(Handle, Entries, EntryCount);
+    }
 #endif
 
     QUIC_STATUS GetInitStatus() const noexcept { return InitStatus; }
@@ -1759,6 +1777,19 @@ struct MsQuicStream {
         return MsQuic->StreamProvideReceiveBuffers(Handle, BufferCount, Buffers);
     }
 
+#ifndef _KERNEL_MODE
+    QUIC_STATUS
+    SendFile(
+        _In_ QUIC_FILE File,
+        _In_ uint64_t Offset,
+        _In_ uint32_t Length,
+        _In_ QUIC_SEND_FLAGS Flags = QUIC_SEND_FLAG_NONE,
+        _In_opt_ void* ClientSendContext = nullptr
+        ) noexcept {
+        return MsQuic->StreamSendFile(Handle, File, Offset, Length, Flags, ClientSendContext);
+    }
+#endif
+
     QUIC_STATUS
     GetReliableOffsetRecv(_Out_ uint64_t* Offset) const noexcept {
         uint32_t Size = sizeof(*Offset);
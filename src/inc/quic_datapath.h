@@ -602,6 +602,11 @@ typedef struct CXPLAT_UDP_CONFIG {
     uint8_t CibirIdOffsetSrc;           // CIBIR ID offset in source CID
     uint8_t CibirIdOffsetDst;           // CIBIR ID offset in destination CID
     uint8_t CibirId[6];                 // CIBIR ID data
+
+    // used for CID based receive steering of server sockets
+    uint8_t CidPartitionIdOffset;       // Partition ID offset in destination CID
+    uint16_t CidPartitionIdMask;        // Value of 0 indicates CID steering isn't used
+    uint16_t CidPartitionCount;         // Steering only applies if this equals the socket count
 } CXPLAT_UDP_CONFIG;
 
 //
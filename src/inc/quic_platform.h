@@ -159,6 +159,11 @@ typedef struct CXPLAT_SLIST_ENTRY {
 #define QUIC_POOL_DATAPATH_RSS_CONFIG       'F4cQ' // Qc4F - QUIC Datapath RSS configuration
 #define QUIC_POOL_TLS_AUX_DATA              '05cQ' // Qc50 - QUIC TLS Backing Aux data
 #define QUIC_POOL_TLS_RECORD_ENTRY          '15cQ' // Qc51 - QUIC TLS Backing Record storage 
+#define QUIC_POOL_STREAM_HEAP               '25cQ' // Qc52 - QUIC Stream scheduling heap
+#define QUIC_POOL_TELEMETRY                 '35cQ' // Qc53 - QUIC connection telemetry ring
+#define QUIC_POOL_POOL_MAGAZINES            '45cQ' // Qc54 - QUIC pool per-processor magazines
+#define QUIC_POOL_CONN_ARENA                '55cQ' // Qc55 - QUIC connection arena slab
+#define QUIC_POOL_SEND_BATCH                '65cQ' // Qc56 - QUIC stream send batch
 
 typedef enum CXPLAT_THREAD_FLAGS {
     CXPLAT_THREAD_FLAG_NONE               = 0x0000,
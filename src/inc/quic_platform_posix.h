@@ -50,6 +50,7 @@ Environment:
 #include <stdbool.h>
 #include <pthread.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/syscall.h>
 #include <sys/time.h>
 #include "quic_sal_stub.h"
@@ -226,6 +227,17 @@ InterlockedExchangePointer(
     return __sync_lock_test_and_set(Target, Value);
 }
 
+QUIC_INLINE
+void*
+InterlockedCompareExchangePointer(
+    _Inout_ _Interlocked_operand_ void* volatile *Destination,
+    _In_opt_ void* ExChange,
+    _In_opt_ void* Comperand
+    )
+{
+    return __sync_val_compare_and_swap(Destination, Comperand, ExChange);
+}
+
 QUIC_INLINE
 void*
 InterlockedFetchAndClearPointer(
@@ -463,26 +475,95 @@ CxPlatListPopEntry(
     _Inout_ CXPLAT_SLIST_ENTRY* ListHead
     );
 
+//
+// Processor Count and Index.
+//
+
+extern uint32_t CxPlatProcessorCount;
+#define CxPlatProcCount() CxPlatProcessorCount
+
+uint32_t
+CxPlatProcCurrentNumber(
+    void
+    );
+
+#define CXPLAT_POOL_CACHE_LINE_SIZE 64
+
+//
+// A magazine is a small per-processor cache of free pool entries. It is only
+// ever try-acquired: a thread that finds its processor's magazine in use (it
+// was preempted, or the processor number was stale) goes straight to the
+// shared depot instead of waiting, so allocations and frees never block.
+//
+typedef union CXPLAT_POOL_MAGAZINE {
+    struct {
+
+        //
+        // List of free entries.
+        //
+
+        CXPLAT_SLIST_ENTRY ListHead;
+
+        //
+        // The last entry in the list, valid while Depth is non-zero. Lets a
+        // full magazine be handed to the depot in one operation.
+        //
+
+        CXPLAT_SLIST_ENTRY* Tail;
+
+        //
+        // Non-zero while a thread owns the magazine.
+        //
+
+        long Busy;
+
+        //
+        // Number of free entries in the list.
+        //
+
+        uint16_t Depth;
+    };
+
+    //
+    // Keeps each processor's magazine on its own cache line.
+    //
+
+    uint8_t CacheLine[CXPLAT_POOL_CACHE_LINE_SIZE];
+
+} CXPLAT_POOL_MAGAZINE;
+
 typedef struct CXPLAT_POOL {
 
     //
-    // List of free entries.
+    // Lock-free stack of free entries shared by all processors. Entries (or
+    // chains of entries) are only ever pushed individually and only ever
+    // removed by swapping out the whole stack, so it is not subject to ABA.
     //
 
-    CXPLAT_SLIST_ENTRY ListHead;
+    void* volatile DepotHead;
 
     //
-    // Number of free entries in the list.
+    // Approximate number of free entries in the depot.
     //
 
-    uint16_t ListDepth;
+    long DepotDepth;
 
     //
-    // Lock to synchronize access to the List.
-    // LINUX_TODO: Check how to make this lock free?
+    // Per-processor magazines in front of the depot. NULL if they couldn't be
+    // allocated (or the pool was created before the platform was initialized),
+    // in which case only the depot is used.
     //
 
-    CXPLAT_LOCK Lock;
+    CXPLAT_POOL_MAGAZINE* Magazines;
+
+    //
+    // The allocation Magazines was carved out of, so that the magazines can
+    // start on a cache line boundary.
+    //
+
+    void* MagazinesAllocation;
+
+    uint32_t MagazineCount;
 
     //
     // Size of entries.
@@ -513,8 +594,10 @@ typedef struct __attribute__((aligned(16))) CXPLAT_POOL_HEADER {
 
 #ifndef DISABLE_CXPLAT_POOL
 #define CXPLAT_POOL_MAXIMUM_DEPTH   256 // Copied from EX_MAXIMUM_LOOKASIDE_DEPTH_BASE
+#define CXPLAT_POOL_MAGAZINE_DEPTH  32
 #else
 #define CXPLAT_POOL_MAXIMUM_DEPTH   0   // TODO - Optimize this scenario better
+#define CXPLAT_POOL_MAGAZINE_DEPTH  0
 #endif
 
 #if DEBUG
@@ -534,24 +617,204 @@ CxPlatPoolInitialize(
 {
     Pool->Size = Size + sizeof(CXPLAT_POOL_HEADER); // Add space for the pool header
     Pool->Tag = Tag;
-    CxPlatLockInitialize(&Pool->Lock);
-    Pool->ListDepth = 0;
-    CxPlatZeroMemory(&Pool->ListHead, sizeof(Pool->ListHead));
+    Pool->DepotHead = NULL;
+    Pool->DepotDepth = 0;
+    Pool->Magazines = NULL;
+    Pool->MagazinesAllocation = NULL;
+    Pool->MagazineCount = 0;
+    if (CXPLAT_POOL_MAGAZINE_DEPTH != 0 && CxPlatProcessorCount != 0) {
+        Pool->MagazinesAllocation =
+            CxPlatAlloc(
+                CxPlatProcessorCount * sizeof(CXPLAT_POOL_MAGAZINE) +
+                    CXPLAT_POOL_CACHE_LINE_SIZE - 1,
+                QUIC_POOL_POOL_MAGAZINES);
+        if (Pool->MagazinesAllocation != NULL) {
+            Pool->Magazines =
+                (CXPLAT_POOL_MAGAZINE*)
+                    (((uintptr_t)Pool->MagazinesAllocation + CXPLAT_POOL_CACHE_LINE_SIZE - 1) &
+                     ~(uintptr_t)(CXPLAT_POOL_CACHE_LINE_SIZE - 1));
+            CxPlatZeroMemory(
+                Pool->Magazines,
+                CxPlatProcessorCount * sizeof(CXPLAT_POOL_MAGAZINE));
+            Pool->MagazineCount = CxPlatProcessorCount;
+        }
+    }
     UNREFERENCED_PARAMETER(IsPaged);
 }
 
+QUIC_INLINE
+void
+CxPlatPoolFreeChain(
+    _In_ CXPLAT_POOL* Pool,
+    _In_opt_ CXPLAT_SLIST_ENTRY* Entry
+    )
+{
+    while (Entry != NULL) {
+        CXPLAT_SLIST_ENTRY* Next = Entry->Next;
+        CXPLAT_DBG_ASSERT(((CXPLAT_POOL_HEADER*)Entry)->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
+        CxPlatFree(Entry, Pool->Tag);
+        Entry = Next;
+    }
+}
+
 QUIC_INLINE
 void
 CxPlatPoolUninitialize(
     _Inout_ CXPLAT_POOL* Pool
     )
 {
-    CXPLAT_POOL_HEADER* Entry;
-    while ((Entry = (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Pool->ListHead)) != NULL) {
-        CXPLAT_DBG_ASSERT(Entry->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
-        CxPlatFree(Entry, Pool->Tag);
+    CxPlatPoolFreeChain(
+        Pool, (CXPLAT_SLIST_ENTRY*)InterlockedExchangePointer(&Pool->DepotHead, NULL));
+    for (uint32_t i = 0; i < Pool->MagazineCount; ++i) {
+        CXPLAT_DBG_ASSERT(Pool->Magazines[i].Busy == 0);
+        CxPlatPoolFreeChain(Pool, Pool->Magazines[i].ListHead.Next);
+    }
+    if (Pool->MagazinesAllocation != NULL) {
+        CxPlatFree(Pool->MagazinesAllocation, QUIC_POOL_POOL_MAGAZINES);
+        Pool->MagazinesAllocation = NULL;
+        Pool->Magazines = NULL;
+        Pool->MagazineCount = 0;
     }
-    CxPlatLockUninitialize(&Pool->Lock);
+}
+
+//
+// Tries to take ownership of the current processor's magazine. Returns NULL
+// if there are no magazines or if it's already in use.
+//
+QUIC_INLINE
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolAcquireMagazine(
+    _In_ CXPLAT_POOL* Pool
+    )
+{
+    if (Pool->MagazineCount == 0) {
+        return NULL;
+    }
+    CXPLAT_POOL_MAGAZINE* Magazine =
+        &Pool->Magazines[CxPlatProcCurrentNumber() % Pool->MagazineCount];
+    if (Magazine->Busy != 0 || !__sync_bool_compare_and_swap(&Magazine->Busy, 0, 1)) {
+        return NULL;
+    }
+    return Magazine;
+}
+
+QUIC_INLINE
+void
+CxPlatPoolReleaseMagazine(
+    _In_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    __sync_lock_release(&Magazine->Busy);
+}
+
+QUIC_INLINE
+void
+CxPlatPoolMagazinePush(
+    _Inout_ CXPLAT_POOL_MAGAZINE* Magazine,
+    _Inout_ CXPLAT_SLIST_ENTRY* Entry
+    )
+{
+    if (Magazine->Depth == 0) {
+        Magazine->Tail = Entry;
+    }
+    CxPlatListPushEntry(&Magazine->ListHead, Entry);
+    Magazine->Depth++;
+}
+
+//
+// Pushes the chain First..Last (Count entries) onto the depot.
+//
+QUIC_INLINE
+void
+CxPlatPoolDepotPush(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ CXPLAT_SLIST_ENTRY* First,
+    _In_ CXPLAT_SLIST_ENTRY* Last,
+    _In_ long Count
+    )
+{
+    void* Head;
+    do {
+        Head = Pool->DepotHead;
+        Last->Next = (CXPLAT_SLIST_ENTRY*)Head;
+    } while (InterlockedCompareExchangePointer(&Pool->DepotHead, First, Head) != Head);
+    if (Count != 0) {
+        __sync_fetch_and_add(&Pool->DepotDepth, Count);
+    }
+}
+
+//
+// Returns a chain that was taken off the depot (and is already accounted for
+// in DepotDepth). The depot is usually still empty at this point, in which
+// case the chain goes back as is; only if something was pushed in the
+// meantime does the chain need to be walked to link it in front.
+//
+QUIC_INLINE
+void
+CxPlatPoolDepotPutBack(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_opt_ CXPLAT_SLIST_ENTRY* Chain
+    )
+{
+    if (Chain == NULL ||
+        InterlockedCompareExchangePointer(&Pool->DepotHead, Chain, NULL) == NULL) {
+        return;
+    }
+    CXPLAT_SLIST_ENTRY* Last = Chain;
+    while (Last->Next != NULL) {
+        Last = Last->Next;
+    }
+    CxPlatPoolDepotPush(Pool, Chain, Last, 0);
+}
+
+//
+// Takes one entry from the depot, moving as many of the rest as fit into
+// Magazine (if any) and putting back whatever is left.
+//
+QUIC_INLINE
+CXPLAT_SLIST_ENTRY*
+CxPlatPoolDepotPop(
+    _Inout_ CXPLAT_POOL* Pool,
+    _Inout_opt_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    CXPLAT_SLIST_ENTRY* Entry =
+        (CXPLAT_SLIST_ENTRY*)InterlockedExchangePointer(&Pool->DepotHead, NULL);
+    if (Entry == NULL) {
+        return NULL;
+    }
+    long Taken = 1;
+    CXPLAT_SLIST_ENTRY* Rest = Entry->Next;
+    if (Magazine != NULL) {
+        while (Rest != NULL && Magazine->Depth < CXPLAT_POOL_MAGAZINE_DEPTH) {
+            CXPLAT_SLIST_ENTRY* Next = Rest->Next;
+            CxPlatPoolMagazinePush(Magazine, Rest);
+            Rest = Next;
+            Taken++;
+        }
+    }
+    __sync_fetch_and_sub(&Pool->DepotDepth, Taken);
+    CxPlatPoolDepotPutBack(Pool, Rest);
+    return Entry;
+}
+
+//
+// Takes a single entry from the depot.
+//
+QUIC_INLINE
+CXPLAT_SLIST_ENTRY*
+CxPlatPoolDepotPopOne(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    CXPLAT_SLIST_ENTRY* Entry =
+        (CXPLAT_SLIST_ENTRY*)InterlockedExchangePointer(&Pool->DepotHead, NULL);
+    if (Entry == NULL) {
+        return NULL;
+    }
+    __sync_fetch_and_sub(&Pool->DepotDepth, 1);
+    CxPlatPoolDepotPutBack(Pool, Entry->Next);
+    return Entry;
 }
 
 QUIC_INLINE
@@ -560,18 +823,27 @@ CxPlatPoolAlloc(
     _Inout_ CXPLAT_POOL* Pool
     )
 {
-    CxPlatLockAcquire(&Pool->Lock);
-    CXPLAT_POOL_HEADER* Header =
-    #if DEBUG
-        CxPlatGetAllocFailDenominator() ? NULL : // No pool when using simulated alloc failures
-    #endif
-        (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Pool->ListHead);
-    if (Header != NULL) {
-        CXPLAT_DBG_ASSERT(Pool->ListDepth > 0);
-        CXPLAT_DBG_ASSERT(Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
-        Pool->ListDepth--;
+    CXPLAT_POOL_HEADER* Header = NULL;
+#if DEBUG
+    if (!CxPlatGetAllocFailDenominator()) // No pool when using simulated alloc failures
+#endif
+    {
+        CXPLAT_POOL_MAGAZINE* Magazine = CxPlatPoolAcquireMagazine(Pool);
+        if (Magazine != NULL) {
+            Header = (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Magazine->ListHead);
+            if (Header != NULL) {
+                CXPLAT_DBG_ASSERT(Magazine->Depth > 0);
+                Magazine->Depth--;
+            }
+        }
+        if (Header == NULL) {
+            Header = (CXPLAT_POOL_HEADER*)CxPlatPoolDepotPop(Pool, Magazine);
+        }
+        if (Magazine != NULL) {
+            CxPlatPoolReleaseMagazine(Magazine);
+        }
+        CXPLAT_DBG_ASSERT(Header == NULL || Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
     }
-    CxPlatLockRelease(&Pool->Lock);
     if (Header == NULL) {
         Header = (CXPLAT_POOL_HEADER*)CxPlatAlloc(Pool->Size, Pool->Tag);
         if (Header == NULL) {
@@ -601,29 +873,58 @@ CxPlatPoolFree(
     }
     Header->SpecialFlag = CXPLAT_POOL_FREE_FLAG;
 #endif
-    if (Pool->ListDepth >= CXPLAT_POOL_MAXIMUM_DEPTH) {
+    CXPLAT_POOL_MAGAZINE* Magazine = CxPlatPoolAcquireMagazine(Pool);
+    if (Magazine != NULL) {
+        if (Magazine->Depth < CXPLAT_POOL_MAGAZINE_DEPTH) {
+            CxPlatPoolMagazinePush(Magazine, &Header->Entry);
+            CxPlatPoolReleaseMagazine(Magazine);
+            return;
+        }
+        if (Pool->DepotDepth + Magazine->Depth <= CXPLAT_POOL_MAXIMUM_DEPTH) {
+            //
+            // The magazine is full. Hand all of it to the depot in one go and
+            // start over with just this entry.
+            //
+            CxPlatPoolDepotPush(
+                Pool, Magazine->ListHead.Next, Magazine->Tail, Magazine->Depth);
+            Magazine->ListHead.Next = NULL;
+            Magazine->Depth = 0;
+            CxPlatPoolMagazinePush(Magazine, &Header->Entry);
+            CxPlatPoolReleaseMagazine(Magazine);
+            return;
+        }
+        CxPlatPoolReleaseMagazine(Magazine);
+    }
+    if (Pool->DepotDepth >= CXPLAT_POOL_MAXIMUM_DEPTH) {
         CxPlatFree(Header, Pool->Tag);
     } else {
-        CxPlatLockAcquire(&Pool->Lock);
-        CxPlatListPushEntry(&Pool->ListHead, &Header->Entry);
-        Pool->ListDepth++;
-        CxPlatLockRelease(&Pool->Lock);
+        CxPlatPoolDepotPush(Pool, &Header->Entry, &Header->Entry, 1);
     }
 }
 
+//
+// Frees one cached entry, from the depot first and then from the magazines.
+// Returns FALSE if there was nothing (that wasn't in use) to free.
+//
 QUIC_INLINE
 BOOLEAN
 CxPlatPoolPrune(
     _Inout_ CXPLAT_POOL* Pool
     )
 {
-    CxPlatLockAcquire(&Pool->Lock);
-    void* Entry = CxPlatListPopEntry(&Pool->ListHead);
-    if (Entry != NULL) {
-        CXPLAT_FRE_ASSERT(Pool->ListDepth > 0);
-        Pool->ListDepth--;
+    CXPLAT_SLIST_ENTRY* Entry = CxPlatPoolDepotPopOne(Pool);
+    for (uint32_t i = 0; Entry == NULL && i < Pool->MagazineCount; ++i) {
+        CXPLAT_POOL_MAGAZINE* Magazine = &Pool->Magazines[i];
+        if (Magazine->Depth == 0 ||
+            !__sync_bool_compare_and_swap(&Magazine->Busy, 0, 1)) {
+            continue;
+        }
+        Entry = CxPlatListPopEntry(&Magazine->ListHead);
+        if (Entry != NULL) {
+            Magazine->Depth--;
+        }
+        CxPlatPoolReleaseMagazine(Magazine);
     }
-    CxPlatLockRelease(&Pool->Lock);
     if (Entry == NULL) {
         return FALSE;
     }
@@ -698,6 +999,27 @@ CxPlatGetAbsoluteTime(
 #define CxPlatTimeMs32() (uint32_t)CxPlatTimeMs64()
 #define CxPlatTimeUs64ToPlat(x) (x)
 
+//
+// Returns a cheap, per-CPU cycle (or tick) count. Only differences between
+// values read on the same thread are meaningful, for relative cost accounting.
+//
+QUIC_INLINE
+uint64_t
+CxPlatCycleCount(
+    void
+    )
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t Count;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r" (Count));
+    return Count;
+#else
+    return CxPlatTimeUs64();
+#endif
+}
+
 QUIC_INLINE
 int64_t
 CxPlatTimeEpochMs64(
@@ -1351,6 +1673,61 @@ CxPlatCqeGetSqe(
 
 #endif
 
+//
+// File Interfaces
+//
+
+//
+// Reads Length bytes at Offset without moving the file position. Fails with
+// the read's error, or QUIC_STATUS_INVALID_STATE if the file ends first.
+//
+QUIC_INLINE
+QUIC_STATUS
+CxPlatFileRead(
+    _In_ QUIC_FILE File,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _Out_writes_bytes_(Length) uint8_t* Buffer
+    )
+{
+    while (Length != 0) {
+        ssize_t Result = pread(File, Buffer, Length, (off_t)Offset);
+        if (Result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (QUIC_STATUS)errno;
+        }
+        if (Result == 0) {
+            return QUIC_STATUS_INVALID_STATE;
+        }
+        Buffer += Result;
+        Offset += (uint64_t)Result;
+        Length -= (uint32_t)Result;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Asks the OS to start reading Length bytes at Offset into the page cache,
+// without waiting for it, so a later CxPlatFileRead doesn't block on disk.
+//
+QUIC_INLINE
+void
+CxPlatFileReadAhead(
+    _In_ QUIC_FILE File,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length
+    )
+{
+#if defined(__APPLE__)
+    struct radvisory Advisory = { (off_t)Offset, (int)Length };
+    (void)fcntl(File, F_RDADVISE, &Advisory);
+#else
+    (void)posix_fadvise(File, (off_t)Offset, (off_t)Length, POSIX_FADV_WILLNEED);
+#endif
+}
+
 //
 // Thread Interfaces.
 //
@@ -1422,18 +1799,6 @@ CxPlatCurThreadID(
     void
     );
 
-//
-// Processor Count and Index.
-//
-
-extern uint32_t CxPlatProcessorCount;
-#define CxPlatProcCount() CxPlatProcessorCount
-
-uint32_t
-CxPlatProcCurrentNumber(
-    void
-    );
-
 //
 // Rundown Protection Interfaces.
 //
@@ -643,6 +643,16 @@ CxPlatTimeUs64ToPlat(
 #define CxPlatTimeMs64() US_TO_MS(CxPlatTimeUs64())
 #define CxPlatTimeMs32() (uint32_t)CxPlatTimeMs64()
 
+//
+// Returns a cheap, per-CPU cycle (or tick) count. Only differences between
+// values read on the same thread are meaningful, for relative cost accounting.
+//
+#ifdef _M_X64
+#define CxPlatCycleCount() __rdtsc()
+#else
+#define CxPlatCycleCount() QuicTimePlat()
+#endif
+
 #define UNIX_EPOCH_AS_FILE_TIME 0x19db1ded53e8000ll
 
 QUIC_INLINE
@@ -963,6 +963,16 @@ CxPlatTimeUs64ToPlat(
 #define CxPlatTimeMs64() US_TO_MS(CxPlatTimeUs64())
 #define CxPlatTimeMs32() (uint32_t)CxPlatTimeMs64()
 
+//
+// Returns a cheap, per-CPU cycle (or tick) count. Only differences between
+// values read on the same thread are meaningful, for relative cost accounting.
+//
+#ifdef _M_X64
+#define CxPlatCycleCount() __rdtsc()
+#else
+#define CxPlatCycleCount() QuicTimePlat()
+#endif
+
 #define UNIX_EPOCH_AS_FILE_TIME 0x19db1ded53e8000ll
 
 QUIC_INLINE
@@ -1087,6 +1097,61 @@ CxPlatProcCurrentNumber(
     return CxPlatProcNumberToIndex(&ProcNumber);
 }
 
+//
+// File Interfaces
+//
+
+//
+// Reads Length bytes at Offset. The file must have been opened for
+// synchronous I/O. Fails with the read's error, or QUIC_STATUS_INVALID_STATE
+// if the file ends first.
+//
+QUIC_INLINE
+QUIC_STATUS
+CxPlatFileRead(
+    _In_ QUIC_FILE File,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _Out_writes_bytes_(Length) uint8_t* Buffer
+    )
+{
+    while (Length != 0) {
+        OVERLAPPED Overlapped = {0};
+        Overlapped.Offset = (DWORD)Offset;
+        Overlapped.OffsetHigh = (DWORD)(Offset >> 32);
+        DWORD Read = 0;
+        if (!ReadFile(File, Buffer, Length, &Read, &Overlapped)) {
+            DWORD Error = GetLastError();
+            return
+                Error == ERROR_HANDLE_EOF ?
+                    QUIC_STATUS_INVALID_STATE : HRESULT_FROM_WIN32(Error);
+        }
+        if (Read == 0) {
+            return QUIC_STATUS_INVALID_STATE;
+        }
+        Buffer += Read;
+        Offset += Read;
+        Length -= Read;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// There is no read-ahead hint for a synchronous handle. The cache manager
+// already reads ahead of sequential reads, which is how send data is read.
+//
+QUIC_INLINE
+void
+CxPlatFileReadAhead(
+    _In_ QUIC_FILE File,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length
+    )
+{
+    UNREFERENCED_PARAMETER(File);
+    UNREFERENCED_PARAMETER(Offset);
+    UNREFERENCED_PARAMETER(Length);
+}
 
 //
 // Create Thread Interfaces
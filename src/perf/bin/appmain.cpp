@@ -31,18 +31,17 @@ QuicHandleExtraData(
     )
 {
     uint64_t RunTime;
-    uint64_t CachedCompletedRequests;
-    CXPLAT_FRE_ASSERT(Length >= sizeof(RunTime) + sizeof(CachedCompletedRequests));
+    uint64_t CompletedRequests;
+    CXPLAT_FRE_ASSERT(Length >= sizeof(RunTime) + sizeof(CompletedRequests) + sizeof(PerfLatencyHistogram));
     CxPlatCopyMemory(&RunTime, ExtraData, sizeof(RunTime));
     ExtraData += sizeof(RunTime);
-    CxPlatCopyMemory(&CachedCompletedRequests, ExtraData, sizeof(CachedCompletedRequests));
-    ExtraData += sizeof(CachedCompletedRequests);
-    CXPLAT_FRE_ASSERT(CachedCompletedRequests <= UINT32_MAX);
-    uint32_t RestOfBufferLength = Length - sizeof(RunTime) - sizeof(CachedCompletedRequests);
-    RestOfBufferLength &= 0xFFFFFFFC; // Round down to nearest multiple of 4
-    uint32_t MaxCount = CXPLAT_MIN((uint32_t)CachedCompletedRequests, RestOfBufferLength);
-
-    uint32_t RPS = (uint32_t)((CachedCompletedRequests * 1000ull * 1000ull) / RunTime);
+    CxPlatCopyMemory(&CompletedRequests, ExtraData, sizeof(CompletedRequests));
+    ExtraData += sizeof(CompletedRequests);
+    auto Histogram = UniquePtr<PerfLatencyHistogram>(new (std::nothrow) PerfLatencyHistogram);
+    CXPLAT_FRE_ASSERT(Histogram.get() != nullptr);
+    CxPlatCopyMemory(Histogram.get(), ExtraData, sizeof(PerfLatencyHistogram));
+
+    uint32_t RPS = (uint32_t)((CompletedRequests * 1000ull * 1000ull) / RunTime);
     if (RPS == 0) {
         printf("Error: No requests were completed\n");
         return;
@@ -50,7 +49,7 @@ QuicHandleExtraData(
 
     Statistics LatencyStats;
     Percentiles PercentileStats;
-    GetStatistics((uint32_t*)ExtraData, MaxCount, &LatencyStats, &PercentileStats);
+    GetHistogramStatistics(Histogram.get(), &LatencyStats, &PercentileStats);
     WriteOutput(
         "Result: %u RPS, Latency,us 0th: %d, 50th: %.0f, 90th: %.0f, 99th: %.0f, 99.9th: %.0f, 99.99th: %.0f, 99.999th: %.0f, 99.9999th: %.0f, Max: %d\n",
         RPS,
@@ -80,8 +79,13 @@ QuicHandleExtraData(
         if (hdr_init(1, LatencyStats.Max, 3, &histogram)) {
             printf("Failed to create histogram\n");
         } else {
-            for (size_t i = 0; i < MaxCount; i++) {
-                hdr_record_value(histogram, ((uint32_t*)ExtraData)[i]);
+            for (uint32_t i = 0; i < PERF_LATENCY_BUCKET_COUNT; i++) {
+                if (Histogram->Counts[i] != 0) {
+                    hdr_record_values(
+                        histogram,
+                        PerfLatencyHistogram::ValueOf(i),
+                        (int64_t)Histogram->Counts[i]);
+                }
             }
             hdr_percentiles_print(histogram, FilePtr, 5, 1.0, CLASSIC);
             hdr_close(histogram);
@@ -11,6 +11,8 @@ Abstract:
 
 #pragma once
 
+#include "LatencyHistogram.h"
+
 //
 // Forward declaration because of include issues with math.h
 //
@@ -37,111 +39,56 @@ struct Percentiles {
     double P99p9999 {0};
 };
 
-#ifdef _KERNEL_MODE
-__declspec(noinline)
-#endif
-static
-double
-ComputeVariance(
-    _In_reads_(Length) uint32_t* Measurements,
-    _In_ size_t Length,
-    _In_ double Mean
-    )
-{
-    if (Length <= 1) {
-        return 0;
-    }
-    double Variance = 0;
-    for (size_t i = 0; i < Length; i++) {
-        uint32_t Value = Measurements[i];
-        Variance += (Value - Mean) * (Value - Mean) / (Length - 1);
-    }
-    return Variance;
-}
-
+//
+// Computes the statistics of the values recorded in a histogram. Each value
+// is taken to be the largest one in its bucket.
+//
 #ifdef _KERNEL_MODE
 __declspec(noinline)
 #endif
 static
 void
-GetStatistics(
-    _In_reads_(DataLength) uint32_t* Data,
-    _In_ size_t DataLength,
+GetHistogramStatistics(
+    _In_ const PerfLatencyHistogram* Histogram,
     _Out_ Statistics* AllStatistics,
     _Out_ Percentiles* PercentileStats
     )
 {
-    if (DataLength == 0) {
+    const uint64_t Count = Histogram->TotalCount();
+    if (Count == 0) {
         return;
     }
 
-    uint64_t Sum = 0;
-    uint32_t Min = 0xFFFFFFFF;
-    uint32_t Max = 0;
-    for (size_t i = 0; i < DataLength; i++) {
-        uint32_t Value = Data[i];
-        Sum += Value;
-        if (Value > Max) {
-            Max = Value;
-        }
-        if (Value < Min) {
-            Min = Value;
+    double Sum = 0;
+    for (uint32_t i = 0; i < PERF_LATENCY_BUCKET_COUNT; i++) {
+        Sum += (double)Histogram->Counts[i] * PerfLatencyHistogram::ValueOf(i);
+    }
+    double Mean = Sum / (double)Count;
+    double Variance = 0;
+    if (Count > 1) {
+        for (uint32_t i = 0; i < PERF_LATENCY_BUCKET_COUNT; i++) {
+            if (Histogram->Counts[i] != 0) {
+                double Delta = PerfLatencyHistogram::ValueOf(i) - Mean;
+                Variance += Delta * Delta * (double)Histogram->Counts[i] / (double)(Count - 1);
+            }
         }
     }
-    double Mean = Sum / (double)DataLength;
-    double Variance =
-        ComputeVariance(
-            Data,
-            DataLength,
-            Mean);
     double StandardDeviation = sqrt(Variance);
-    double StandardError = StandardDeviation / sqrt((double)DataLength);
+    double StandardError = StandardDeviation / sqrt((double)Count);
     *AllStatistics = Statistics {
         Mean,
         Variance,
         StandardDeviation,
         StandardError,
-        Min,
-        Max
+        Histogram->MinValue(),
+        Histogram->MaxValue()
     };
 
-#ifdef _WIN32
-    qsort_s(
-        Data,
-        DataLength,
-        sizeof(uint32_t),
-        [](void*, const void* Left, const void* Right) -> int {
-            return *(const uint32_t*)Left - *(const uint32_t*)Right;
-        },
-        nullptr);
-#else
-    qsort(
-        Data,
-        DataLength,
-        sizeof(uint32_t),
-        [](const void* Left, const void* Right) -> int {
-            return *(const uint32_t*)Left - *(const uint32_t*)Right;
-        });
-#endif
-
-    uint32_t PercentileIndex = (uint32_t)(DataLength * 0.5);
-    PercentileStats->P50 = Data[PercentileIndex];
-
-    PercentileIndex = (uint32_t)(DataLength * 0.9);
-    PercentileStats->P90 = Data[PercentileIndex];
-
-    PercentileIndex = (uint32_t)(DataLength * 0.99);
-    PercentileStats->P99 = Data[PercentileIndex];
-
-    PercentileIndex = (uint32_t)(DataLength * 0.999);
-    PercentileStats->P99p9 = Data[PercentileIndex];
-
-    PercentileIndex = (uint32_t)(DataLength * 0.9999);
-    PercentileStats->P99p99 = Data[PercentileIndex];
-
-    PercentileIndex = (uint32_t)(DataLength * 0.99999);
-    PercentileStats->P99p999 = Data[PercentileIndex];
-
-    PercentileIndex = (uint32_t)(DataLength * 0.999999);
-    PercentileStats->P99p9999 = Data[PercentileIndex];
+    PercentileStats->P50 = Histogram->ValueAtPercentile(PERF_LATENCY_PPM(50), Count);
+    PercentileStats->P90 = Histogram->ValueAtPercentile(PERF_LATENCY_PPM(90), Count);
+    PercentileStats->P99 = Histogram->ValueAtPercentile(PERF_LATENCY_PPM(99), Count);
+    PercentileStats->P99p9 = Histogram->ValueAtPercentile(PERF_LATENCY_PPM(99.9), Count);
+    PercentileStats->P99p99 = Histogram->ValueAtPercentile(PERF_LATENCY_PPM(99.99), Count);
+    PercentileStats->P99p999 = Histogram->ValueAtPercentile(PERF_LATENCY_PPM(99.999), Count);
+    PercentileStats->P99p9999 = Histogram->ValueAtPercentile(PERF_LATENCY_PPM(99.9999), Count);
 }
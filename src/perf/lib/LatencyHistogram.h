@@ -0,0 +1,144 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    A fixed size, HDR style latency histogram. Values (in microseconds) below
+    PERF_LATENCY_SUB_BUCKET_COUNT are counted exactly; above that, each power
+    of two is split into PERF_LATENCY_SUB_BUCKET_HALF linear buckets, so every
+    value up to UINT32_MAX is kept to within 0.1% (three significant digits)
+    with a constant amount of memory, no matter how many are recorded. Counts
+    are exact, so any percentile (P99.9999 included) lands in the right bucket.
+
+--*/
+
+#pragma once
+
+#define PERF_LATENCY_SUB_BUCKET_BITS    11
+#define PERF_LATENCY_SUB_BUCKET_COUNT   (1u << PERF_LATENCY_SUB_BUCKET_BITS)
+#define PERF_LATENCY_SUB_BUCKET_HALF    (PERF_LATENCY_SUB_BUCKET_COUNT / 2)
+#define PERF_LATENCY_BUCKET_COUNT \
+    (PERF_LATENCY_SUB_BUCKET_COUNT + \
+     (32 - PERF_LATENCY_SUB_BUCKET_BITS) * PERF_LATENCY_SUB_BUCKET_HALF)
+
+//
+// Percentiles are given in parts per million so they can be computed without
+// floating point (the client also runs in kernel mode).
+//
+#define PERF_LATENCY_PPM(Percent)       ((uint32_t)((Percent) * 10000))
+
+struct PerfLatencyHistogram {
+    uint64_t Counts[PERF_LATENCY_BUCKET_COUNT];
+
+    static uint32_t IndexOf(uint32_t Value) {
+        if (Value < PERF_LATENCY_SUB_BUCKET_COUNT) {
+            return Value;
+        }
+#ifdef _MSC_VER
+        unsigned long Msb;
+        _BitScanReverse(&Msb, Value);
+#else
+        const uint32_t Msb = 31 - (uint32_t)__builtin_clz(Value);
+#endif
+        const uint32_t Shift = (uint32_t)Msb - (PERF_LATENCY_SUB_BUCKET_BITS - 1);
+        return
+            PERF_LATENCY_SUB_BUCKET_COUNT +
+            (Shift - 1) * PERF_LATENCY_SUB_BUCKET_HALF +
+            ((Value >> Shift) - PERF_LATENCY_SUB_BUCKET_HALF);
+    }
+
+    //
+    // The largest value that falls in the bucket at Index.
+    //
+    static uint32_t ValueOf(uint32_t Index) {
+        if (Index < PERF_LATENCY_SUB_BUCKET_COUNT) {
+            return Index;
+        }
+        const uint32_t Offset = Index - PERF_LATENCY_SUB_BUCKET_COUNT;
+        const uint32_t Shift = Offset / PERF_LATENCY_SUB_BUCKET_HALF + 1;
+        const uint64_t SubBucket =
+            Offset % PERF_LATENCY_SUB_BUCKET_HALF + PERF_LATENCY_SUB_BUCKET_HALF;
+        const uint64_t Value = ((SubBucket + 1) << Shift) - 1;
+        return Value > UINT32_MAX ? UINT32_MAX : (uint32_t)Value;
+    }
+
+    void Reset() {
+        CxPlatZeroMemory(Counts, sizeof(Counts));
+    }
+
+    //
+    // Safe to call concurrently with other Record calls and with readers.
+    //
+    void Record(uint64_t Value) {
+        InterlockedIncrement64(
+            (int64_t*)&Counts[IndexOf(Value > UINT32_MAX ? UINT32_MAX : (uint32_t)Value)]);
+    }
+
+    void Add(const PerfLatencyHistogram& Other) {
+        for (uint32_t i = 0; i < PERF_LATENCY_BUCKET_COUNT; ++i) {
+            Counts[i] += Other.Counts[i];
+        }
+    }
+
+    //
+    // Turns this (cumulative) histogram into the change since Previous, and
+    // saves the cumulative counts in Previous for the next interval.
+    //
+    void TakeDelta(PerfLatencyHistogram& Previous) {
+        for (uint32_t i = 0; i < PERF_LATENCY_BUCKET_COUNT; ++i) {
+            const uint64_t Total = Counts[i];
+            Counts[i] = Total - Previous.Counts[i];
+            Previous.Counts[i] = Total;
+        }
+    }
+
+    uint64_t TotalCount() const {
+        uint64_t Total = 0;
+        for (uint32_t i = 0; i < PERF_LATENCY_BUCKET_COUNT; ++i) {
+            Total += Counts[i];
+        }
+        return Total;
+    }
+
+    uint32_t MinValue() const {
+        for (uint32_t i = 0; i < PERF_LATENCY_BUCKET_COUNT; ++i) {
+            if (Counts[i] != 0) {
+                return ValueOf(i);
+            }
+        }
+        return 0;
+    }
+
+    uint32_t MaxValue() const {
+        for (uint32_t i = PERF_LATENCY_BUCKET_COUNT; i > 0; --i) {
+            if (Counts[i - 1] != 0) {
+                return ValueOf(i - 1);
+            }
+        }
+        return 0;
+    }
+
+    //
+    // The smallest recorded value (to bucket precision) that at least
+    // PartsPerMillion / 1000000 of all values are less than or equal to.
+    //
+    uint32_t ValueAtPercentile(uint32_t PartsPerMillion, uint64_t Total) const {
+        if (Total == 0) {
+            return 0;
+        }
+        uint64_t Target = (Total * PartsPerMillion + 999999) / 1000000;
+        if (Target == 0) {
+            Target = 1;
+        }
+        uint64_t Seen = 0;
+        for (uint32_t i = 0; i < PERF_LATENCY_BUCKET_COUNT; ++i) {
+            Seen += Counts[i];
+            if (Seen >= Target) {
+                return ValueOf(i);
+            }
+        }
+        return MaxValue();
+    }
+};
@@ -10,6 +10,7 @@ Abstract:
 --*/
 
 #include "PerfClient.h"
+#include "PerfCompare.h"
 
 #ifdef QUIC_CLOG
 #include "PerfClient.cpp.clog.h"
@@ -46,6 +47,15 @@ PerfClient::Init(
             RunTime = S_TO_US(12); // 12 seconds
             RepeatConnections = TRUE;
             PrintIoRate = TRUE;
+        } else if (IsValue(ScenarioStr, "storm")) {
+            ConnectRate = 1000 * CxPlatProcCount();
+            RampTime = S_TO_US(5); // 5 seconds
+            RunTime = S_TO_US(15); // 15 seconds
+            ResumePercent = 50;
+        } else if (IsValue(ScenarioStr, "idle")) {
+            ConnectionCount = 10000;
+            RunTime = S_TO_US(20); // 20 seconds
+            HoldConnections = TRUE;
         } else if (IsValue(ScenarioStr, "rps-multi")) {
             Upload = 512;
             Download = 4000;
@@ -61,6 +71,13 @@ PerfClient::Init(
             RunTime = S_TO_US(20); // 20 seconds
             RepeatStreams = TRUE;
             PrintLatency = TRUE;
+        } else if (IsValue(ScenarioStr, "datagram")) {
+            Upload = 64;
+            RequestRate = 100000;
+            DatagramMode = TRUE;
+            DatagramBatch = 16;
+            RunTime = S_TO_US(20); // 20 seconds
+            PrintLatency = TRUE;
         } else if (IsValue(ScenarioStr, "latency")) {
             Upload = 512;
             Download = 4000;
@@ -148,6 +165,7 @@ PerfClient::Init(
     TryGetValue(argc, argv, "encrypt", &UseEncryption);
     TryGetValue(argc, argv, "pacing", &UsePacing);
     TryGetValue(argc, argv, "sendbuf", &UseSendBuffering);
+    TryGetValue(argc, argv, "sendbatch", &UseSendBatch);
     TryGetValue(argc, argv, "ptput", &PrintThroughput);
     TryGetValue(argc, argv, "pctput", &PrintConnThroughput);
     TryGetValue(argc, argv, "prate", &PrintIoRate);
@@ -156,6 +174,7 @@ PerfClient::Init(
     TryGetValue(argc, argv, "pstream", &PrintStreams);
     TryGetValue(argc, argv, "platency", &PrintLatency);
     TryGetValue(argc, argv, "plat", &PrintLatency);
+    TryGetValue(argc, argv, "platinterval", &PrintLatencyIntervalMs);
 
     //
     // Scenario options
@@ -188,12 +207,140 @@ PerfClient::Init(
     TryGetValue(argc, argv, "rc", &RepeatConnections);
     TryGetValue(argc, argv, "rstream", &RepeatStreams);
     TryGetValue(argc, argv, "rs", &RepeatStreams);
+    TryGetValue(argc, argv, "hold", &HoldConnections);
 
     if ((RepeatConnections || RepeatStreams) && !RunTime) {
         WriteOutput("Must specify a 'runtime' if using a repeat parameter!\n");
         return QUIC_STATUS_INVALID_PARAMETER;
     }
 
+    if (HoldConnections) {
+        //
+        // Idle mode: every connection stays open (kept alive, with no
+        // streams) until the run ends, so the server's per-connection
+        // footprint can be measured.
+        //
+        if (!RunTime) {
+            WriteOutput("Must specify a 'runtime' if using 'hold'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (StreamCount || RepeatConnections) {
+            WriteOutput("'hold' can't be used with 'streams' or 'rconn'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    TryGetValue(argc, argv, "rate", &RequestRate);
+    const char* ArrivalStr = nullptr;
+    if (TryGetValue(argc, argv, "arrival", &ArrivalStr)) {
+#ifndef _KERNEL_MODE
+        if (IsValue(ArrivalStr, "poisson")) {
+            PoissonArrivals = TRUE;
+        } else if (!IsValue(ArrivalStr, "fixed")) {
+            WriteOutput("Failed to parse arrival[%s] parameter!\n", ArrivalStr);
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+#else
+        WriteOutput("Kernel mode supports only fixed arrivals\n");
+#endif // !_KERNEL_MODE
+    }
+    const char* SizeDistStr = nullptr;
+    if (TryGetValue(argc, argv, "sizedist", &SizeDistStr)) {
+#ifndef _KERNEL_MODE
+        if (IsValue(SizeDistStr, "uniform")) {
+            SizeDistribution = PERF_SIZE_DISTRIBUTION_UNIFORM;
+        } else if (IsValue(SizeDistStr, "exp")) {
+            SizeDistribution = PERF_SIZE_DISTRIBUTION_EXPONENTIAL;
+        } else if (!IsValue(SizeDistStr, "fixed")) {
+            WriteOutput("Failed to parse sizedist[%s] parameter!\n", SizeDistStr);
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+#else
+        WriteOutput("Kernel mode supports only fixed request sizes\n");
+#endif // !_KERNEL_MODE
+    }
+
+    TryGetValue(argc, argv, "datagram", &DatagramMode);
+    TryGetValue(argc, argv, "dgbatch", &DatagramBatch);
+
+    if (RequestRate) {
+        //
+        // Open-loop mode: requests are issued on a schedule, independent of
+        // how quickly earlier ones complete, and their latency is measured
+        // from when they were scheduled to be sent.
+        //
+        if (!RunTime) {
+            WriteOutput("Must specify a 'runtime' if using 'rate'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (UseTCP) {
+            WriteOutput("TCP mode doesn't support 'rate'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (Timed) {
+            WriteOutput("'rate' requires upload and download lengths, not times!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (DatagramMode) {
+            //
+            // Each request is a datagram carrying the time it was due, which
+            // the server echoes back. It must at least hold that time.
+            //
+            if (DatagramBatch == 0 || DatagramBatch > PERF_SEND_BATCH_SIZE) {
+                WriteOutput("'dgbatch' must be between 1 and %u!\n", PERF_SEND_BATCH_SIZE);
+                return QUIC_STATUS_INVALID_PARAMETER;
+            }
+            Upload = CXPLAT_MAX(Upload, (uint64_t)sizeof(uint64_t));
+            Download = 0;
+        }
+        RepeatStreams = FALSE;
+        StreamCount = 0;
+    } else if (PoissonArrivals || SizeDistribution != PERF_SIZE_DISTRIBUTION_FIXED) {
+        WriteOutput("'arrival' and 'sizedist' require 'rate'!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    } else if (DatagramMode) {
+        WriteOutput("'datagram' requires 'rate'!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    TryGetValue(argc, argv, "connrate", &ConnectRate);
+    const char* RampVarNames[] = {"ramp", nullptr};
+    TryGetVariableUnitValue(argc, argv, RampVarNames, &RampTime, &IsTimeUnit);
+    TryGetValue(argc, argv, "resume", &ResumePercent);
+
+    if (HoldConnections && (RequestRate || ConnectRate)) {
+        WriteOutput("'hold' can't be used with 'rate' or 'connrate'!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (ConnectRate) {
+        //
+        // Handshake storm mode: new connections are started on a schedule
+        // that ramps up to ConnectRate, and each is closed as soon as its
+        // handshake completes.
+        //
+        if (!RunTime) {
+            WriteOutput("Must specify a 'runtime' if using 'connrate'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (UseTCP) {
+            WriteOutput("TCP mode doesn't support 'connrate'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (RequestRate) {
+            WriteOutput("'connrate' and 'rate' can't be used together!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (ResumePercent > 100) {
+            WriteOutput("'resume' must be a percentage!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        ConnectionCount = 0;
+        StreamCount = 0;
+        RepeatConnections = FALSE;
+        PrintIoRate = FALSE;
+    }
+
     if (UseTCP) {
         if (!UseEncryption) {
             WriteOutput("TCP mode doesn't support disabling encryption!\n");
@@ -203,9 +350,13 @@ PerfClient::Init(
             WriteOutput("TCP mode doesn't support CIBIR!\n");
             return QUIC_STATUS_INVALID_PARAMETER;
         }
+        if (UseSendBatch) {
+            WriteOutput("TCP mode doesn't support 'sendbatch'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
     }
 
-    if ((Upload || Download) && !StreamCount) {
+    if ((Upload || Download) && !StreamCount && !RequestRate && !ConnectRate) {
         StreamCount = 1; // Just up/down args imply they want a stream
     }
 
@@ -242,6 +393,12 @@ PerfClient::Init(
         if (IoMode && IsValue(IoMode, "rio")) {
             Settings.SetRioEnabled(true);
         }
+        if (HoldConnections) {
+            Settings.SetKeepAlive(PERF_HOLD_KEEP_ALIVE_MS);
+        }
+        if (DatagramMode) {
+            Settings.SetDatagramReceiveEnabled(true);
+        }
         Configuration.SetSettings(Settings);
     }
 
@@ -256,23 +413,34 @@ PerfClient::Init(
     }
 
     RequestBuffer.Init(IoSize, Timed ? UINT64_MAX : Download);
-    if (PrintLatency) {
-        if (RunTime) {
-            MaxLatencyIndex = ((uint64_t)RunTime / (1000 * 1000)) * PERF_MAX_REQUESTS_PER_SECOND;
-            if (MaxLatencyIndex > (UINT32_MAX / sizeof(uint32_t))) {
-                MaxLatencyIndex = UINT32_MAX / sizeof(uint32_t);
-                WriteOutput("Warning! Limiting request latency tracking to %llu requests\n",
-                    (unsigned long long)MaxLatencyIndex);
+    if (ConnectRate) {
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            Workers[i].HandshakeLatency.reset(new(std::nothrow) PerfLatencyHistogram);
+            if (!Workers[i].HandshakeLatency) {
+                return QUIC_STATUS_OUT_OF_MEMORY;
             }
-        } else {
-            MaxLatencyIndex = ConnectionCount * StreamCount;
+            Workers[i].HandshakeLatency->Reset();
         }
-
-        LatencyValues = UniquePtr<uint32_t[]>(new(std::nothrow) uint32_t[(size_t)MaxLatencyIndex]);
-        if (LatencyValues == nullptr) {
+    }
+    if (PrintLatency) {
+        //
+        // Each worker records into its own histogram; they are merged when
+        // reporting.
+        //
+        LatencyTotal.reset(new(std::nothrow) PerfLatencyHistogram);
+        LatencyPrevious.reset(new(std::nothrow) PerfLatencyHistogram);
+        if (!LatencyTotal || !LatencyPrevious) {
             return QUIC_STATUS_OUT_OF_MEMORY;
         }
-        CxPlatZeroMemory(LatencyValues.get(), (size_t)(sizeof(uint32_t) * MaxLatencyIndex));
+        LatencyTotal->Reset();
+        LatencyPrevious->Reset();
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            Workers[i].Latency.reset(new(std::nothrow) PerfLatencyHistogram);
+            if (!Workers[i].Latency) {
+                return QUIC_STATUS_OUT_OF_MEMORY;
+            }
+            Workers[i].Latency->Reset();
+        }
     }
 
     return QUIC_STATUS_SUCCESS;
@@ -309,6 +477,7 @@ PerfClient::Start(
         nullptr
     };
     const size_t TargetLen = strlen(Target.get());
+    uint64_t ConnectionsAssigned = 0;
     for (uint32_t i = 0; i < WorkerCount; ++i) {
         auto Worker = &Workers[i];
         Worker->Processor = (uint16_t)i;
@@ -321,6 +490,19 @@ PerfClient::Start(
             Worker->ConnectionsQueued++;
         }
 
+        if (RequestRate) {
+            // Split the request rate in proportion to the connections.
+            const uint64_t RateBefore = RequestRate * ConnectionsAssigned / ConnectionCount;
+            ConnectionsAssigned += Worker->ConnectionsQueued;
+            Worker->RequestRate = RequestRate * ConnectionsAssigned / ConnectionCount - RateBefore;
+#ifndef _KERNEL_MODE
+            Worker->Random.seed(CxPlatTimeUs64() + i);
+#endif
+        }
+        if (ConnectRate) {
+            Worker->ConnectRate = ConnectRate * (i + 1) / WorkerCount - ConnectRate * i / WorkerCount;
+        }
+
         // Build up target hostname.
         Worker->Target.reset(new(std::nothrow) char[TargetLen + 10]);
         CxPlatCopyMemory(Worker->Target.get(), Target.get(), TargetLen);
@@ -352,7 +534,26 @@ PerfClient::Wait(
         Timeout = RunTime < 1000 ? 1 : (int)US_TO_MS(RunTime);
     }
 
-    if (Timeout) {
+    if (PrintLatency && PrintLatencyIntervalMs) {
+        const uint64_t StartTime = CxPlatTimeMs64();
+        LatencyIntervalStart = CxPlatTimeUs64();
+        for (;;) {
+            uint32_t WaitTime = PrintLatencyIntervalMs;
+            if (Timeout) {
+                const uint64_t Elapsed = CxPlatTimeDiff64(StartTime, CxPlatTimeMs64());
+                if (Elapsed >= (uint64_t)Timeout) {
+                    break;
+                }
+                if ((uint64_t)Timeout - Elapsed < WaitTime) {
+                    WaitTime = (uint32_t)((uint64_t)Timeout - Elapsed);
+                }
+            }
+            if (CxPlatEventWaitWithTimeout(*CompletionEvent, WaitTime)) {
+                break;
+            }
+            PrintLatencyInterval();
+        }
+    } else if (Timeout) {
         CxPlatEventWaitWithTimeout(*CompletionEvent, Timeout);
     } else {
         CxPlatEventWaitForever(*CompletionEvent);
@@ -365,6 +566,30 @@ PerfClient::Wait(
         Workers[i].Uninitialize();
     }
 
+    const uint64_t RequestsSkipped = GetRequestsSkipped();
+    if (RequestsSkipped) {
+        WriteOutput(
+            "Warning: %llu requests came due with no connection ready and weren't sent!\n",
+            (unsigned long long)RequestsSkipped);
+    }
+
+    if (ConnectRate) {
+        PrintHandshakeStormResults();
+    }
+
+    if (DatagramMode) {
+        const uint64_t Sent = GetDatagramsSent();
+        const uint64_t Echoed = GetStreamsCompleted();
+        const uint64_t LostPermille = Sent ? (Sent - CXPLAT_MIN(Echoed, Sent)) * 1000 / Sent : 0;
+        WriteOutput(
+            "Result: %llu datagrams sent, %llu echoed (%llu.%llu%% lost), %llu echoed per second\n",
+            (unsigned long long)Sent,
+            (unsigned long long)Echoed,
+            (unsigned long long)(LostPermille / 10),
+            (unsigned long long)(LostPermille % 10),
+            (unsigned long long)(Echoed * 1000 * 1000 / RunTime));
+    }
+
     if (GetConnectedConnections() == 0) {
         WriteOutput("Error: No Successful Connections!\n");
         return QUIC_STATUS_CONNECTION_REFUSED;
@@ -409,18 +634,91 @@ PerfClient::Wait(
     return QUIC_STATUS_SUCCESS;
 }
 
+void
+PerfClient::PrintLatencyInterval(
+    )
+{
+    //
+    // Reads the workers' histograms while they are still being updated, so
+    // a request completing right now may land in this interval or the next.
+    //
+    LatencyTotal->Reset();
+    for (uint32_t i = 0; i < WorkerCount; ++i) {
+        LatencyTotal->Add(*Workers[i].Latency);
+    }
+    LatencyTotal->TakeDelta(*LatencyPrevious);
+
+    const uint64_t Now = CxPlatTimeUs64();
+    const uint64_t Elapsed = CxPlatTimeDiff64(LatencyIntervalStart, Now);
+    LatencyIntervalStart = Now;
+
+    const uint64_t Count = LatencyTotal->TotalCount();
+    WriteOutput(
+        "Interval: %llu RPS, Latency,us 50th: %u, 99th: %u, 99.9th: %u, 99.99th: %u, Max: %u\n",
+        (unsigned long long)(Elapsed ? Count * 1000 * 1000 / Elapsed : 0),
+        LatencyTotal->ValueAtPercentile(PERF_LATENCY_PPM(50), Count),
+        LatencyTotal->ValueAtPercentile(PERF_LATENCY_PPM(99), Count),
+        LatencyTotal->ValueAtPercentile(PERF_LATENCY_PPM(99.9), Count),
+        LatencyTotal->ValueAtPercentile(PERF_LATENCY_PPM(99.99), Count),
+        LatencyTotal->MaxValue());
+}
+
+void
+PerfClient::PrintHandshakeStormResults(
+    )
+{
+    uint64_t Attempts = 0, Connected = 0, Resumed = 0, Retried = 0, Refused = 0, Failed = 0;
+    UniquePtr<PerfLatencyHistogram> Latency(new(std::nothrow) PerfLatencyHistogram);
+    if (!Latency) {
+        return;
+    }
+    Latency->Reset();
+    for (uint32_t i = 0; i < WorkerCount; ++i) {
+        Attempts += Workers[i].ConnectionsCreated;
+        Connected += Workers[i].ConnectionsConnected;
+        Resumed += Workers[i].HandshakesResumed;
+        Retried += Workers[i].HandshakesRetried;
+        Refused += Workers[i].HandshakesRefused;
+        Failed += Workers[i].HandshakesFailed;
+        Latency->Add(*Workers[i].HandshakeLatency);
+    }
+
+    WriteOutput(
+        "Result: %llu connection attempts, %llu connected (%llu resumed, %llu after a retry), "
+        "%llu refused for load, %llu failed\n",
+        (unsigned long long)Attempts,
+        (unsigned long long)Connected,
+        (unsigned long long)Resumed,
+        (unsigned long long)Retried,
+        (unsigned long long)Refused,
+        (unsigned long long)Failed);
+
+    const uint64_t Count = Latency->TotalCount();
+    WriteOutput(
+        "Result: Handshake latency,us 50th: %u, 90th: %u, 99th: %u, 99.9th: %u, Max: %u\n",
+        Latency->ValueAtPercentile(PERF_LATENCY_PPM(50), Count),
+        Latency->ValueAtPercentile(PERF_LATENCY_PPM(90), Count),
+        Latency->ValueAtPercentile(PERF_LATENCY_PPM(99), Count),
+        Latency->ValueAtPercentile(PERF_LATENCY_PPM(99.9), Count),
+        Latency->MaxValue());
+
+    if (ResumePercent && !Resumed) {
+        WriteOutput("Warning: No handshakes were resumed; start the server with -tickets:1.\n");
+    }
+}
+
 uint32_t
 PerfClient::GetExtraDataLength(
     )
 {
-    if (!MaxLatencyIndex) {
+    if (!LatencyTotal) {
        return 0; // Not capturing this extra data
     }
     return
         (uint32_t)(
         sizeof(RunTime) +
-        sizeof(CurLatencyIndex) +
-        (LatencyCount * sizeof(uint32_t)));
+        sizeof(uint64_t) +
+        sizeof(PerfLatencyHistogram));
 }
 
 void
@@ -429,14 +727,18 @@ PerfClient::GetExtraData(
     _In_ uint32_t Length
     )
 {
-    CXPLAT_FRE_ASSERT(MaxLatencyIndex); // Shouldn't be called if we're not tracking latency
-    CXPLAT_FRE_ASSERT(Length >= sizeof(RunTime) + sizeof(CurLatencyIndex));
+    CXPLAT_FRE_ASSERT(LatencyTotal); // Shouldn't be called if we're not tracking latency
+    CXPLAT_FRE_ASSERT(Length >= GetExtraDataLength());
+    LatencyTotal->Reset();
+    for (uint32_t i = 0; i < WorkerCount; ++i) {
+        LatencyTotal->Add(*Workers[i].Latency);
+    }
+    const uint64_t Count = LatencyTotal->TotalCount();
     CxPlatCopyMemory(Data, &RunTime, sizeof(RunTime));
     Data += sizeof(RunTime);
-    uint64_t Count = (Length - sizeof(RunTime) - sizeof(Count)) / sizeof(uint32_t);
     CxPlatCopyMemory(Data, &Count, sizeof(Count));
-    Data += sizeof(CurLatencyIndex);
-    CxPlatCopyMemory(Data, LatencyValues.get(), (size_t)(Count * sizeof(uint32_t)));
+    Data += sizeof(Count);
+    CxPlatCopyMemory(Data, LatencyTotal.get(), sizeof(PerfLatencyHistogram));
 }
 
 void
@@ -455,15 +757,235 @@ PerfClientWorker::WorkerThread() {
         while (Client->Running && ConnectionsCreated < ConnectionsQueued) {
             StartNewConnection();
         }
-        WakeEvent.WaitForever();
+        uint64_t WaitUs;
+        if (ConnectRate) {
+            WaitUs = StartDueConnections();
+        } else if (RequestRate) {
+            WaitUs = SendDueRequests();
+        } else {
+            WakeEvent.WaitForever();
+            continue;
+        }
+
+        //
+        // Open-loop pacing. Sleep until the next connection or request is
+        // due, but only in whole milliseconds (the timer resolution),
+        // yielding for the rest.
+        //
+        if (WaitUs == UINT64_MAX) {
+            WakeEvent.WaitForever(); // No connection is ready yet
+        } else if (WaitUs >= 1000) {
+            WakeEvent.WaitTimeout((uint32_t)(WaitUs / 1000));
+        } else {
+            CxPlatSchedulerYield();
+        }
+    }
+}
+
+uint64_t
+PerfClientWorker::SendDueRequests() {
+    const uint64_t NowNs = CxPlatTimeUs64() * 1000;
+    Lock.Acquire();
+    if (!ScheduleStartNs) {
+        if (CxPlatListIsEmpty(&ReadyConnections)) {
+            Lock.Release();
+            return UINT64_MAX;
+        }
+        ScheduleStartNs = NextRequestNs = NowNs; // First connection is ready
     }
+
+    //
+    // Send every request that has come due, even if the pacer is running
+    // late, so a stall on the client shows up as latency rather than as a
+    // lower request rate.
+    //
+    while (Client->Running && NextRequestNs <= NowNs) {
+        if (CxPlatListIsEmpty(&ReadyConnections)) {
+            RequestsSkipped++;
+        } else {
+            auto Entry = CxPlatListRemoveHead(&ReadyConnections);
+            CxPlatListInsertTail(&ReadyConnections, Entry); // Round robin
+            auto Connection = ((PerfClientConnection::ReadyListEntry*)Entry)->Connection;
+            if (Client->DatagramMode) {
+                //
+                // Up to 'dgbatch' due datagrams go to the same connection in
+                // one call.
+                //
+                uint64_t IntendedStartTimes[PERF_SEND_BATCH_SIZE];
+                uint32_t Count = 0;
+                for (;;) {
+                    IntendedStartTimes[Count++] = NextRequestNs / 1000;
+                    if (Count == Client->DatagramBatch) {
+                        break;
+                    }
+                    ScheduleNextRequest();
+                    if (NextRequestNs > NowNs) {
+                        break;
+                    }
+                }
+                Connection->SendDatagrams(IntendedStartTimes, Count);
+                if (Count < Client->DatagramBatch) {
+                    continue; // Already scheduled the next one
+                }
+            } else {
+                Connection->StartNewStream(NextRequestNs / 1000);
+            }
+        }
+        ScheduleNextRequest();
+    }
+    Lock.Release();
+    return NextRequestNs > NowNs ? (NextRequestNs - NowNs) / 1000 : 0;
 }
 
 void
-PerfClientWorker::StartNewConnection() {
+PerfClientWorker::ScheduleNextRequest() {
+    RequestsScheduled++;
+#ifndef _KERNEL_MODE
+    if (Client->PoissonArrivals) {
+        std::exponential_distribution<double> Interarrival((double)RequestRate / 1e9);
+        NextRequestNs += (uint64_t)Interarrival(Random);
+        return;
+    }
+#endif
+    //
+    // Computed from the start, rather than by adding the interval, so the
+    // rounding doesn't accumulate.
+    //
+    NextRequestNs = ScheduleStartNs + RequestsScheduled * 1000000000ull / RequestRate;
+}
+
+uint64_t
+PerfClientWorker::NextRequestSize(
+    _In_ uint64_t Mean
+    ) {
+#ifndef _KERNEL_MODE
+    //
+    // Only called on the worker thread, which owns Random.
+    //
+    if (Mean != 0) {
+        switch (Client->SizeDistribution) {
+        case PERF_SIZE_DISTRIBUTION_UNIFORM:
+            return std::uniform_int_distribution<uint64_t>(1, 2 * Mean)(Random);
+        case PERF_SIZE_DISTRIBUTION_EXPONENTIAL: {
+            std::exponential_distribution<double> Size(1.0 / (double)Mean);
+            return CXPLAT_MAX((uint64_t)Size(Random), (uint64_t)1);
+        }
+        default:
+            break;
+        }
+    }
+#endif
+    return Mean;
+}
+
+void
+PerfClientWorker::OnConnectionReady(
+    _In_ PerfClientConnection* Connection
+    ) {
+    Lock.Acquire();
+    CxPlatListInsertTail(&ReadyConnections, &Connection->ReadyEntry.Link);
+    Connection->Ready = true;
+    Lock.Release();
+    WakeEvent.Set();
+}
+
+//
+// Integer square root (rounded down), so the ramp also works in kernel mode.
+//
+static
+uint64_t
+PerfSqrt(
+    _In_ uint64_t Value
+    )
+{
+    uint64_t Root = 0;
+    uint64_t Bit = 1ull << 62;
+    while (Bit > Value) {
+        Bit >>= 2;
+    }
+    while (Bit != 0) {
+        if (Value >= Root + Bit) {
+            Value -= Root + Bit;
+            Root = (Root >> 1) + Bit;
+        } else {
+            Root >>= 1;
+        }
+        Bit >>= 2;
+    }
+    return Root;
+}
+
+uint64_t
+PerfClientWorker::ConnectOffset(
+    _In_ uint64_t Index
+    ) const {
+    //
+    // The attempt rate ramps up linearly from zero to ConnectRate over
+    // RampTime, so the first N attempts take sqrt(2 * RampTime * N / Rate).
+    //
+    const uint64_t RampTime = Client->RampTime;
+    const uint64_t RampCount = ConnectRate * RampTime / S_TO_US(1) / 2;
+    if (Index < RampCount) {
+        return PerfSqrt(2 * RampTime * S_TO_US(1) / ConnectRate * Index);
+    }
+    return RampTime + (Index - RampCount) * S_TO_US(1) / ConnectRate;
+}
+
+uint64_t
+PerfClientWorker::StartDueConnections() {
+    const uint64_t Now = CxPlatTimeUs64();
+    if (!ConnectStartTime) {
+        ConnectStartTime = Now;
+    }
+
+    //
+    // As with requests, every attempt keeps the time it was due, even if the
+    // worker starts it late, and its handshake latency is measured from then.
+    //
+    uint64_t Next = Now;
+    while (Client->Running &&
+           (Next = ConnectStartTime + ConnectOffset(ConnectsScheduled)) <= Now) {
+        ConnectsScheduled++;
+        StartNewConnection(Next);
+    }
+    return Next > Now ? Next - Now : 0;
+}
+
+void
+PerfClientWorker::StartNewConnection(
+    _In_ uint64_t IntendedStartTime
+    ) {
     InterlockedIncrement64((int64_t*)&ConnectionsCreated);
     InterlockedIncrement64((int64_t*)&ConnectionsActive);
-    ConnectionPool.Alloc(*Client, *this)->Initialize();
+    auto Connection = ConnectionPool.Alloc(*Client, *this);
+    if (IntendedStartTime) {
+        Connection->StartTime = IntendedStartTime;
+        //
+        // Spread the resumed attempts evenly through the schedule.
+        //
+        const uint64_t Percent = Client->ResumePercent;
+        Connection->Resume =
+            ConnectsScheduled * Percent / 100 != (ConnectsScheduled - 1) * Percent / 100;
+    }
+    Connection->Initialize();
+}
+
+void
+PerfClientWorker::SaveResumptionTicket(
+    _In_reads_(Length) const uint8_t* Ticket,
+    _In_ uint32_t Length
+    ) {
+    uint8_t* Copy = new(std::nothrow) uint8_t[Length];
+    if (!Copy) {
+        return;
+    }
+    CxPlatCopyMemory(Copy, Ticket, Length);
+    UniquePtr<uint8_t[]> Previous; // Freed outside the lock
+    Lock.Acquire();
+    Previous.reset(ResumptionTicket.release());
+    ResumptionTicket.reset(Copy);
+    ResumptionTicketLength = Length;
+    Lock.Release();
 }
 
 void
@@ -519,6 +1041,23 @@ PerfClientConnection::Initialize() {
         }
 
         QUIC_STATUS Status;
+        if (Client.Trace) {
+            TraceId = Client.Trace->NewConnection();
+            OpenTime = CxPlatTimeUs64();
+            uint32_t IntervalMs = US_TO_MS(Client.Trace->SampleIntervalUs);
+            Status =
+                MsQuic->SetParam(
+                    Handle,
+                    QUIC_PARAM_CONN_TELEMETRY_INTERVAL,
+                    sizeof(IntervalMs),
+                    &IntervalMs);
+            if (QUIC_FAILED(Status)) {
+                WriteOutput("Setting telemetry interval failed, 0x%x\n", Status);
+                Worker.ConnectionPool.Free(this);
+                return;
+            }
+        }
+
         BOOLEAN Value;
         if (!Client.UseEncryption) {
             Value = TRUE;
@@ -590,6 +1129,27 @@ PerfClientConnection::Initialize() {
             return;
         }
 
+        if (Resume) {
+            Worker.Lock.Acquire();
+            if (Worker.ResumptionTicket) {
+                Status =
+                    MsQuic->SetParam(
+                        Handle,
+                        QUIC_PARAM_CONN_RESUMPTION_TICKET,
+                        Worker.ResumptionTicketLength,
+                        Worker.ResumptionTicket.get());
+            } else {
+                Status = QUIC_STATUS_SUCCESS;
+                Resume = false; // No ticket yet, so this is a full handshake
+            }
+            Worker.Lock.Release();
+            if (QUIC_FAILED(Status)) {
+                WriteOutput("SetResumptionTicket failed, 0x%x\n", Status);
+                Worker.ConnectionPool.Free(this);
+                return;
+            }
+        }
+
         Status =
             MsQuic->ConnectionStart(
                 Handle,
@@ -619,22 +1179,118 @@ PerfClientConnection::Initialize() {
     }
 }
 
+void
+PerfClientConnection::ReadTelemetry(bool Final) {
+    //
+    // Drain the connection's telemetry ring into the comparison trace. The
+    // ring holds many seconds of samples, so it only needs reading
+    // occasionally, and once more just before the connection goes away.
+    //
+    const uint64_t Now = CxPlatTimeUs64();
+    if (!Final && CxPlatTimeDiff64(TelemetryReadTime, Now) < PERF_COMPARE_READ_INTERVAL_US) {
+        return;
+    }
+    TelemetryReadTime = Now;
+
+    const uint32_t MaxSamples = 64;
+    uint8_t Buffer[sizeof(QUIC_CONN_TELEMETRY) + MaxSamples * sizeof(QUIC_CONN_TELEMETRY_SAMPLE)];
+    auto Header = (QUIC_CONN_TELEMETRY*)Buffer;
+    do {
+        Header->Cursor = TelemetryCursor;
+        uint32_t BufferLength = sizeof(Buffer);
+        if (QUIC_FAILED(
+            MsQuic->GetParam(
+                Handle,
+                QUIC_PARAM_CONN_TELEMETRY,
+                &BufferLength,
+                Buffer))) {
+            return;
+        }
+        Client.Trace->AddQuicSamples(
+            TraceId,
+            OpenTime,
+            (QUIC_CONN_TELEMETRY_SAMPLE*)(Header + 1),
+            Header->SampleCount);
+        TelemetryCursor = Header->Cursor;
+    } while (Header->SampleCount == MaxSamples);
+}
+
 void
 PerfClientConnection::OnHandshakeComplete() {
     InterlockedIncrement64((int64_t*)&Worker.ConnectionsConnected);
-    if (!Client.StreamCount) {
+    Connected = true;
+    if (Client.RequestRate) {
+        Worker.OnConnectionReady(this); // The worker's pacer starts the streams
+    } else if (Client.HoldConnections) {
+        // Left open until the registration is shut down at the end of the run
+    } else if (!Client.StreamCount) {
         WorkerConnComplete = true;
         Worker.OnConnectionComplete();
-        Shutdown();
+        if (!AwaitingTicket) {
+            Shutdown();
+        }
     } else {
-        for (uint32_t i = 0; i < Client.StreamCount; ++i) {
-            StartNewStream();
+        StartNewStreams(Client.StreamCount);
+    }
+}
+
+void
+PerfClientConnection::OnStormHandshakeComplete(
+    _In_ bool SessionResumed
+    ) {
+    if (!Client.Running) {
+        return;
+    }
+    Worker.HandshakeLatency->Record(CxPlatTimeDiff64(StartTime, CxPlatTimeUs64()));
+    if (SessionResumed) {
+        InterlockedIncrement64((int64_t*)&Worker.HandshakesResumed);
+    }
+
+    QUIC_STATISTICS_V2 Stats;
+    uint32_t StatsLength = sizeof(Stats);
+    if (QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            Handle,
+            QUIC_PARAM_CONN_STATISTICS_V2,
+            &StatsLength,
+            &Stats)) &&
+        Stats.StatelessRetry) {
+        InterlockedIncrement64((int64_t*)&Worker.HandshakesRetried);
+    }
+
+    if (Client.ResumePercent) {
+        //
+        // The server sends its ticket after the handshake, so until the
+        // worker has one, keep a single connection open to receive it.
+        //
+        Worker.Lock.Acquire();
+        if (!Worker.ResumptionTicket && !Worker.TicketRequested) {
+            Worker.TicketRequested = true;
+            AwaitingTicket = true;
+        }
+        Worker.Lock.Release();
+    }
+}
+
+void
+PerfClientConnection::RemoveFromReadyList() {
+    if (Client.RequestRate) {
+        Worker.Lock.Acquire();
+        if (Ready) {
+            CxPlatListEntryRemove(&ReadyEntry.Link);
+            Ready = false;
         }
+        Worker.Lock.Release();
     }
 }
 
 void
 PerfClientConnection::OnShutdownComplete() {
+    RemoveFromReadyList();
+    if (Client.ConnectRate && !Connected && Client.Running) {
+        InterlockedIncrement64(
+            (int64_t*)(Refused ? &Worker.HandshakesRefused : &Worker.HandshakesFailed));
+    }
     if (Client.UseTCP) {
         // Clean up leftover TCP streams
         CXPLAT_HASHTABLE_ENUMERATOR Enum;
@@ -657,10 +1313,30 @@ PerfClientConnection::OnShutdownComplete() {
 }
 
 void
-PerfClientConnection::StartNewStream() {
-    StreamsCreated++;
-    StreamsActive++;
+PerfClientConnection::StartNewStream(
+    _In_ uint64_t IntendedStartTime
+    ) {
+    //
+    // In open-loop mode this runs on the worker thread, concurrently with
+    // stream completions on the connection's callbacks.
+    //
+    InterlockedIncrement64((int64_t*)&StreamsCreated);
+    InterlockedIncrement64((int64_t*)&StreamsActive);
     auto Stream = Worker.StreamPool.Alloc(*this);
+    if (IntendedStartTime) {
+        //
+        // Measure latency from when the request was due, not from when the
+        // pacer got around to it.
+        //
+        Stream->StartTime = IntendedStartTime;
+    }
+    if (Client.SizeDistribution != PERF_SIZE_DISTRIBUTION_FIXED) {
+        if (Client.Upload) { // Must at least hold the response size
+            Stream->UploadLength =
+                CXPLAT_MAX(Worker.NextRequestSize(Client.Upload), (uint64_t)sizeof(uint64_t));
+        }
+        Stream->DownloadLength = Worker.NextRequestSize(Client.Download);
+    }
     if (Client.UseTCP) {
         Stream->Entry.Signature = (uint32_t)Worker.StreamsStarted;
         StreamTable.Insert(&Stream->Entry);
@@ -681,8 +1357,118 @@ PerfClientConnection::StartNewStream() {
     Stream->Send();
 }
 
+void
+PerfClientConnection::StartNewStreams(
+    _In_ uint32_t Count
+    ) {
+    //
+    // With 'sendbatch', the first sends of all the new streams are submitted
+    // together with StreamSendBatch instead of one StreamSend call each.
+    //
+    Batching = Client.UseSendBatch != FALSE;
+    for (uint32_t i = 0; i < Count; ++i) {
+        StartNewStream();
+    }
+    Batching = false;
+    FlushSendBatch();
+}
+
+void
+PerfClientConnection::SendDatagrams(
+    _In_reads_(Count) const uint64_t* IntendedStartTimes,
+    _In_ uint32_t Count
+    ) {
+    //
+    // Each datagram starts with the time it was due, which comes back in the
+    // server's echo. It is freed when its send reaches a final state.
+    //
+    QUIC_DATAGRAM_SEND_BATCH_ENTRY Entries[PERF_SEND_BATCH_SIZE];
+    uint32_t EntryCount = 0;
+    for (uint32_t i = 0; i < Count; ++i) {
+        const uint32_t Length =
+            (uint32_t)CXPLAT_MAX(Worker.NextRequestSize(Client.Upload), (uint64_t)sizeof(uint64_t));
+        auto Buffer =
+            (QUIC_BUFFER*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_BUFFER) + Length, QUIC_POOL_PERF);
+        if (!Buffer) {
+            break;
+        }
+        Buffer->Length = Length;
+        Buffer->Buffer = (uint8_t*)(Buffer + 1);
+        CxPlatCopyMemory(Buffer->Buffer, &IntendedStartTimes[i], sizeof(uint64_t));
+        CxPlatZeroMemory(Buffer->Buffer + sizeof(uint64_t), Buffer->Length - sizeof(uint64_t));
+        Entries[EntryCount].Buffers = Buffer;
+        Entries[EntryCount].BufferCount = 1;
+        Entries[EntryCount].Flags = QUIC_SEND_FLAG_NONE;
+        Entries[EntryCount].ClientSendContext = Buffer;
+        Entries[EntryCount].Priority = 0;
+        Entries[EntryCount].ReplaceKey = 0;
+        EntryCount++;
+    }
+    if (EntryCount == 0) {
+        return;
+    }
+    if (QUIC_FAILED(MsQuic->DatagramSendBatch(Handle, Entries, EntryCount))) {
+        for (uint32_t i = 0; i < EntryCount; ++i) {
+            CXPLAT_FREE(Entries[i].ClientSendContext, QUIC_POOL_PERF);
+        }
+        return;
+    }
+    InterlockedExchangeAdd64((int64_t*)&Worker.DatagramsSent, (int64_t)EntryCount);
+}
+
+void
+PerfClientConnection::OnDatagramReceived(
+    _In_ const QUIC_BUFFER* Buffer
+    ) {
+    if (!Client.Running || Buffer->Length < sizeof(uint64_t)) {
+        return;
+    }
+    uint64_t IntendedStartTime;
+    CxPlatCopyMemory(&IntendedStartTime, Buffer->Buffer, sizeof(IntendedStartTime));
+    if (Worker.Latency) {
+        Worker.Latency->Record(CxPlatTimeDiff64(IntendedStartTime, CxPlatTimeUs64()));
+    }
+    InterlockedIncrement64((int64_t*)&Worker.StreamsCompleted);
+}
+
+void
+PerfClientConnection::QueueSend(
+    _In_ HQUIC Stream,
+    _In_ QUIC_BUFFER* Buffer,
+    _In_ QUIC_SEND_FLAGS Flags
+    ) {
+    if (!Batching) {
+        MsQuic->StreamSend(Stream, Buffer, 1, Flags, Buffer);
+        return;
+    }
+    if (SendBatchCount == PERF_SEND_BATCH_SIZE) {
+        FlushSendBatch();
+    }
+    auto Entry = &SendBatch[SendBatchCount++];
+    Entry->Stream = Stream;
+    Entry->Buffers = Buffer;
+    Entry->BufferCount = 1;
+    Entry->Flags = Flags;
+    Entry->ClientSendContext = Buffer;
+}
+
+void
+PerfClientConnection::FlushSendBatch() {
+    if (SendBatchCount) {
+        //
+        // Reset the count first, in case the batch is flushed inline and a
+        // stream callback starts new streams.
+        //
+        const uint32_t Count = SendBatchCount;
+        SendBatchCount = 0;
+        MsQuic->StreamSendBatch(Handle, SendBatch, Count);
+    }
+}
+
 PerfClientStream::PerfClientStream(_In_ PerfClientConnection& Connection)
-    : Connection{Connection} {
+    : Connection{Connection},
+      UploadLength{Connection.Client.Upload},
+      DownloadLength{Connection.Client.Download} {
     if (Connection.Client.UseSendBuffering) {
         IdealSendBuffer = 1; // Hack to only keep 1 outstanding send at a time
     }
@@ -695,14 +1481,16 @@ PerfClientConnection::GetTcpStream(uint32_t ID) {
 
 void
 PerfClientConnection::OnStreamShutdown() {
-    StreamsActive--;
+    const auto Active = InterlockedDecrement64((int64_t*)&StreamsActive);
     if (!Client.Running) {
-        if (!StreamsActive) {
+        if (!Active) {
             Shutdown();
         }
+    } else if (Client.RequestRate) {
+        // The worker's pacer starts new streams.
     } else if (Client.RepeatStreams) {
-        while (StreamsActive < Client.StreamCount) {
-            StartNewStream();
+        if (StreamsActive < Client.StreamCount) {
+            StartNewStreams(Client.StreamCount - (uint32_t)StreamsActive);
         }
     } else {
         if (!StreamsActive && StreamsCreated == Client.StreamCount) {
@@ -729,10 +1517,44 @@ QUIC_STATUS
 PerfClientConnection::ConnectionCallback(
     _Inout_ QUIC_CONNECTION_EVENT* Event
     ) {
+    if (Client.Trace) {
+        ReadTelemetry(Event->Type == QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE);
+    }
     switch (Event->Type) {
     case QUIC_CONNECTION_EVENT_CONNECTED:
+        if (Client.ConnectRate) {
+            OnStormHandshakeComplete(Event->CONNECTED.SessionResumed);
+        }
         OnHandshakeComplete();
         break;
+    case QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_TRANSPORT:
+        if (Event->SHUTDOWN_INITIATED_BY_TRANSPORT.Status == QUIC_STATUS_CONNECTION_REFUSED) {
+            Refused = true; // The server is overloaded
+        }
+        RemoveFromReadyList();
+        break;
+    case QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_PEER:
+        RemoveFromReadyList();
+        break;
+    case QUIC_CONNECTION_EVENT_RESUMPTION_TICKET_RECEIVED:
+        if (Client.ResumePercent) {
+            Worker.SaveResumptionTicket(
+                Event->RESUMPTION_TICKET_RECEIVED.ResumptionTicket,
+                Event->RESUMPTION_TICKET_RECEIVED.ResumptionTicketLength);
+            if (AwaitingTicket) {
+                AwaitingTicket = false;
+                Shutdown();
+            }
+        }
+        break;
+    case QUIC_CONNECTION_EVENT_DATAGRAM_RECEIVED:
+        OnDatagramReceived(Event->DATAGRAM_RECEIVED.Buffer);
+        break;
+    case QUIC_CONNECTION_EVENT_DATAGRAM_SEND_STATE_CHANGED:
+        if (QUIC_DATAGRAM_SEND_STATE_IS_FINAL(Event->DATAGRAM_SEND_STATE_CHANGED.State)) {
+            CXPLAT_FREE(Event->DATAGRAM_SEND_STATE_CHANGED.ClientContext, QUIC_POOL_PERF);
+        }
+        break;
     case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
         if (Client.PrintConnections) {
             QuicPrintConnectionStatistics(MsQuic, Handle);
@@ -808,6 +1630,9 @@ PerfClientStream::QuicStreamCallback(
         OnReceive(Event->RECEIVE.TotalBufferLength, Event->RECEIVE.Flags & QUIC_RECEIVE_FLAG_FIN);
         break;
     case QUIC_STREAM_EVENT_SEND_COMPLETE:
+        if (Connection.Client.Trace) {
+            Connection.ReadTelemetry(false);
+        }
         OnSendComplete(((QUIC_BUFFER*)Event->SEND_COMPLETE.ClientContext)->Length, Event->SEND_COMPLETE.Canceled);
         break;
     case QUIC_STREAM_EVENT_PEER_SEND_ABORTED:
@@ -846,11 +1671,23 @@ PerfClientStream::Send() {
         const uint64_t BytesLeftToSend =
             Client.Timed ?
                 UINT64_MAX : // Timed sends forever
-                (Client.Upload ? (Client.Upload - BytesSent) : sizeof(uint64_t));
+                (UploadLength ? (UploadLength - BytesSent) : sizeof(uint64_t));
         uint32_t DataLength = Client.IoSize;
         QUIC_BUFFER* Buffer = Client.RequestBuffer;
         QUIC_SEND_FLAGS Flags = QUIC_SEND_FLAG_START;
 
+        if (BytesSent == 0 && DownloadLength != Client.Download) {
+            //
+            // The shared request buffer asks for the default response size,
+            // so send this request's own size in front of it.
+            //
+            ResponseSize = CxPlatByteSwapUint64(DownloadLength);
+            ResponseSizeBuffer.Buffer = (uint8_t*)&ResponseSize;
+            ResponseSizeBuffer.Length = sizeof(ResponseSize);
+            DataLength = sizeof(ResponseSize);
+            Buffer = &ResponseSizeBuffer;
+        }
+
         if ((uint64_t)DataLength >= BytesLeftToSend) {
             DataLength = (uint32_t)BytesLeftToSend;
             LastBuffer.Buffer = Buffer->Buffer;
@@ -877,7 +1714,7 @@ PerfClientStream::Send() {
             SendData->Fin = (Flags & QUIC_SEND_FLAG_FIN) ? TRUE : FALSE;
             Connection.TcpConn->Send(SendData);
         } else {
-            MsQuic->StreamSend(Handle, Buffer, 1, Flags, Buffer);
+            Connection.QueueSend(Handle, Buffer, Flags);
         }
     }
 }
@@ -959,7 +1796,7 @@ PerfClientStream::OnShutdown() {
     auto SendSuccess = SendEndTime != 0;
     if (Client.Upload) {
         const auto TotalBytes = BytesAcked;
-        if (TotalBytes < sizeof(uint64_t) || (!Client.Timed && TotalBytes < Client.Upload)) {
+        if (TotalBytes < sizeof(uint64_t) || (!Client.Timed && TotalBytes < UploadLength)) {
             SendSuccess = false;
         }
 
@@ -983,7 +1820,7 @@ PerfClientStream::OnShutdown() {
     auto RecvSuccess = RecvStartTime != 0 && RecvEndTime != 0;
     if (Client.Download) {
         const auto TotalBytes = BytesReceived;
-        if (TotalBytes == 0 || (!Client.Timed && TotalBytes < Client.Download)) {
+        if (TotalBytes == 0 || (!Client.Timed && TotalBytes < DownloadLength)) {
             RecvSuccess = false;
         }
 
@@ -1006,13 +1843,8 @@ PerfClientStream::OnShutdown() {
     }
 
     if (SendSuccess && RecvSuccess) {
-        if (Client.Running) {
-            const auto Index = (uint64_t)InterlockedIncrement64((int64_t*)&Connection.Client.CurLatencyIndex) - 1;
-            if (Index < Client.MaxLatencyIndex) {
-                const auto Latency = CxPlatTimeDiff64(StartTime, RecvEndTime);
-                Client.LatencyValues[(size_t)Index] = Latency > UINT32_MAX ? UINT32_MAX : (uint32_t)Latency;
-                InterlockedIncrement64((int64_t*)&Connection.Client.LatencyCount);
-            }
+        if (Client.Running && Connection.Worker.Latency) {
+            Connection.Worker.Latency->Record(CxPlatTimeDiff64(StartTime, RecvEndTime));
         }
         InterlockedIncrement64((int64_t*)&Connection.Worker.StreamsCompleted);
     }
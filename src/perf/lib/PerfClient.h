@@ -13,6 +13,19 @@ Abstract:
 
 #include "SecNetPerf.h"
 #include "Tcp.h"
+#include "LatencyHistogram.h"
+
+#ifndef _KERNEL_MODE
+#include <random>
+#endif
+
+struct PerfCompareTrace;
+
+typedef enum PERF_SIZE_DISTRIBUTION {
+    PERF_SIZE_DISTRIBUTION_FIXED,
+    PERF_SIZE_DISTRIBUTION_UNIFORM,     // [1, 2 * mean]
+    PERF_SIZE_DISTRIBUTION_EXPONENTIAL
+} PERF_SIZE_DISTRIBUTION;
 
 struct PerfClientConnection {
     struct PerfClient& Client;
@@ -25,14 +38,39 @@ struct PerfClientConnection {
     uint64_t StreamsCreated {0};
     uint64_t StreamsActive {0};
     bool WorkerConnComplete {false}; // Indicated completion to worker
+    bool Ready {false}; // In the worker's open-loop ready list
+    struct ReadyListEntry {
+        CXPLAT_LIST_ENTRY Link; // Must be first
+        PerfClientConnection* Connection;
+    } ReadyEntry {{nullptr, nullptr}, this};
+    uint32_t TraceId {0};
+    uint64_t OpenTime {0};
+    uint64_t TelemetryCursor {0};
+    uint64_t TelemetryReadTime {0};
+    uint64_t StartTime {0}; // When the attempt was due, in handshake storm mode
+    bool Resume {false}; // Attempt a resumed handshake
+    bool Connected {false};
+    bool Refused {false}; // Rejected by the server because of load
+    bool AwaitingTicket {false}; // Stay connected until a resumption ticket arrives
+    bool Batching {false}; // Stream sends are collected in SendBatch
+    uint32_t SendBatchCount {0};
+    QUIC_STREAM_SEND_BATCH_ENTRY SendBatch[PERF_SEND_BATCH_SIZE];
     PerfClientConnection(_In_ PerfClient& Client, _In_ PerfClientWorker& Worker) : Client(Client), Worker(Worker) { }
     ~PerfClientConnection();
     void Initialize();
-    void StartNewStream();
+    void StartNewStream(_In_ uint64_t IntendedStartTime = 0);
+    void StartNewStreams(_In_ uint32_t Count);
+    void SendDatagrams(_In_reads_(Count) const uint64_t* IntendedStartTimes, _In_ uint32_t Count);
+    void OnDatagramReceived(_In_ const QUIC_BUFFER* Buffer);
+    void QueueSend(_In_ HQUIC Stream, _In_ QUIC_BUFFER* Buffer, _In_ QUIC_SEND_FLAGS Flags);
+    void FlushSendBatch();
+    void RemoveFromReadyList();
     void OnHandshakeComplete();
+    void OnStormHandshakeComplete(_In_ bool SessionResumed);
     void OnShutdownComplete();
     void OnStreamShutdown();
     void Shutdown();
+    void ReadTelemetry(bool Final);
     QUIC_STATUS ConnectionCallback(_Inout_ QUIC_CONNECTION_EVENT* Event);
     static QUIC_STATUS QUIC_API s_ConnectionCallback(HQUIC, void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
         return ((PerfClientConnection*)Context)->ConnectionCallback(Event);
@@ -70,7 +108,11 @@ struct PerfClientStream {
     uint64_t BytesOutstanding {0};
     uint64_t BytesAcked {0};
     uint64_t BytesReceived {0};
+    uint64_t UploadLength;
+    uint64_t DownloadLength;
+    uint64_t ResponseSize {0}; // Big endian, if DownloadLength isn't the default
     bool SendComplete {false};
+    QUIC_BUFFER ResponseSizeBuffer;
     QUIC_BUFFER LastBuffer;
     QUIC_STATUS QuicStreamCallback(_Inout_ QUIC_STREAM_EVENT* Event);
     void Send();
@@ -97,6 +139,30 @@ struct QUIC_CACHEALIGN PerfClientWorker {
     uint64_t StreamsCompleted {0};
     uint64_t UploadRate {0};
     uint64_t DownloadRate {0};
+    UniquePtr<PerfLatencyHistogram> Latency; // Allocated if tracking latency
+    // Open-loop request pacing
+    uint64_t RequestRate {0}; // This worker's share of PerfClient::RequestRate
+    uint64_t RequestsScheduled {0};
+    uint64_t ScheduleStartNs {0};
+    uint64_t NextRequestNs {0}; // Intended start time of the next request
+    uint64_t RequestsSkipped {0}; // Came due with no connection ready
+    uint64_t DatagramsSent {0}; // Echoed ones count as completed streams
+    CXPLAT_LIST_ENTRY ReadyConnections;
+    // Handshake storm pacing
+    uint64_t ConnectRate {0}; // This worker's share of PerfClient::ConnectRate
+    uint64_t ConnectsScheduled {0};
+    uint64_t ConnectStartTime {0};
+    uint64_t HandshakesResumed {0};
+    uint64_t HandshakesRetried {0};
+    uint64_t HandshakesRefused {0};
+    uint64_t HandshakesFailed {0};
+    UniquePtr<PerfLatencyHistogram> HandshakeLatency;
+    UniquePtr<uint8_t[]> ResumptionTicket; // Latest one received; guarded by Lock
+    uint32_t ResumptionTicketLength {0};
+    bool TicketRequested {false}; // A connection is waiting for a ticket
+#ifndef _KERNEL_MODE
+    std::mt19937_64 Random;
+#endif
     UniquePtr<char[]> Target;
     QuicAddr LocalAddr;
     QuicAddr RemoteAddr;
@@ -104,7 +170,7 @@ struct QUIC_CACHEALIGN PerfClientWorker {
     CxPlatPoolT<PerfClientStream> StreamPool;
     CxPlatPoolT<TcpConnection> TcpConnectionPool;
     CxPlatPoolT<TcpSendData> TcpSendDataPool;
-    PerfClientWorker() { }
+    PerfClientWorker() { CxPlatListInitializeHead(&ReadyConnections); }
     ~PerfClientWorker() { WaitForThread(); }
     void Uninitialize() { WaitForThread(); }
     void QueueNewConnection() {
@@ -112,6 +178,9 @@ struct QUIC_CACHEALIGN PerfClientWorker {
         WakeEvent.Set();
     }
     void OnConnectionComplete();
+    void OnConnectionReady(_In_ PerfClientConnection* Connection);
+    uint64_t NextRequestSize(_In_ uint64_t Mean);
+    void SaveResumptionTicket(_In_reads_(Length) const uint8_t* Ticket, _In_ uint32_t Length);
     static CXPLAT_THREAD_CALLBACK(s_WorkerThread, Context) {
         ((PerfClientWorker*)Context)->WorkerThread();
         CXPLAT_THREAD_RETURN(QUIC_STATUS_SUCCESS);
@@ -125,7 +194,11 @@ private:
             ThreadStarted = false;
         }
     }
-    void StartNewConnection();
+    void StartNewConnection(_In_ uint64_t IntendedStartTime = 0);
+    uint64_t ConnectOffset(_In_ uint64_t Index) const;
+    uint64_t StartDueConnections();
+    void ScheduleNextRequest();
+    uint64_t SendDueRequests();
     void WorkerThread();
 };
 
@@ -142,18 +215,20 @@ struct PerfClient {
         _In_z_ const char* target);
     QUIC_STATUS Start(_In_ CXPLAT_EVENT* StopEvent);
     QUIC_STATUS Wait(_In_ int Timeout);
+    void PrintLatencyInterval();
+    void PrintHandshakeStormResults();
     uint32_t GetExtraDataLength();
     void GetExtraData(_Out_writes_bytes_(Length) uint8_t* Data, _In_ uint32_t Length);
 
     bool Running {true};
     CXPLAT_EVENT* CompletionEvent {nullptr};
-    uint64_t MaxLatencyIndex {0};
-    uint64_t CurLatencyIndex {0};
-    uint64_t LatencyCount {0};
-    UniquePtr<uint32_t[]> LatencyValues {nullptr}; // TODO - Move to Worker
+    UniquePtr<PerfLatencyHistogram> LatencyTotal; // Merged from the workers
+    UniquePtr<PerfLatencyHistogram> LatencyPrevious; // For interval reporting
+    uint64_t LatencyIntervalStart {0};
     PerfClientWorker Workers[PERF_MAX_THREAD_COUNT];
 
     UniquePtr<TcpEngine> Engine;
+    PerfCompareTrace* Trace {nullptr}; // Set in comparison mode
     MsQuicCredentialConfig CredentialConfig {
         QUIC_CREDENTIAL_FLAG_CLIENT |
         QUIC_CREDENTIAL_FLAG_NO_CERTIFICATE_VALIDATION};
@@ -192,12 +267,14 @@ struct PerfClient {
     uint8_t UseEncryption {TRUE};
     uint8_t UsePacing {TRUE};
     uint8_t UseSendBuffering {FALSE};
+    uint8_t UseSendBatch {FALSE};
     uint8_t PrintThroughput {FALSE};
     uint8_t PrintConnThroughput {FALSE};
     uint8_t PrintIoRate {FALSE};
     uint8_t PrintConnections {FALSE};
     uint8_t PrintStreams {FALSE};
     uint8_t PrintLatency {FALSE};
+    uint32_t PrintLatencyIntervalMs {0};
     // Scenario parameters
     uint32_t ConnectionCount {1};
     uint32_t StreamCount {0};
@@ -208,7 +285,18 @@ struct PerfClient {
     //uint8_t SendInline {FALSE};
     uint8_t RepeatConnections {FALSE};
     uint8_t RepeatStreams {FALSE};
+    uint8_t HoldConnections {FALSE}; // Keep connections open, idle, until the run ends
     uint64_t RunTime {0};
+    // Open-loop parameters
+    uint64_t RequestRate {0}; // Requests per second across all workers; 0 is closed-loop
+    uint8_t PoissonArrivals {FALSE};
+    PERF_SIZE_DISTRIBUTION SizeDistribution {PERF_SIZE_DISTRIBUTION_FIXED};
+    uint8_t DatagramMode {FALSE}; // Requests are echoed datagrams
+    uint32_t DatagramBatch {1};
+    // Handshake storm parameters
+    uint64_t ConnectRate {0}; // Connection attempts per second, once ramped up
+    uint64_t RampTime {0};
+    uint8_t ResumePercent {0};
 
     struct PerfIoBuffer {
         QUIC_BUFFER* Buffer {nullptr};
@@ -267,6 +355,20 @@ struct PerfClient {
         }
         return UploadRate;
     }
+    uint64_t GetDatagramsSent() const {
+        uint64_t DatagramsSent = 0;
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            DatagramsSent += Workers[i].DatagramsSent;
+        }
+        return DatagramsSent;
+    }
+    uint64_t GetRequestsSkipped() const {
+        uint64_t RequestsSkipped = 0;
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            RequestsSkipped += Workers[i].RequestsSkipped;
+        }
+        return RequestsSkipped;
+    }
     uint64_t GetDownloadRate() const {
         uint64_t DownloadRate = 0;
         for (uint32_t i = 0; i < WorkerCount; ++i) {
@@ -0,0 +1,354 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Client-side comparison mode. The configured scenario is run once over QUIC
+    with Cubic, once over QUIC with BBR and once over kernel TCP (with whatever
+    congestion control the kernel is configured for). QUIC samples come from
+    the connection telemetry ring and TCP samples from TCP_INFO, both taken at
+    the same interval and timed relative to the start of their run, so the
+    three runs can be overlaid directly.
+
+    Both sources describe the sending side of the client's connections, so
+    the comparison is only meaningful for upload scenarios.
+
+--*/
+
+#include "PerfCompare.h"
+#include "PerfClient.h"
+#include "LatencyHelpers.h"
+
+static const char* const PerfCompareRunNames[PERF_COMPARE_RUN_COUNT] = {
+    "QUIC (cubic)",
+    "QUIC (bbr)",
+    "TCP"
+};
+
+PerfCompareTrace::~PerfCompareTrace() {
+    if (File) {
+        fclose(File);
+    }
+}
+
+QUIC_STATUS
+PerfCompareTrace::Init(
+    _In_opt_z_ const char* Path,
+    _In_ uint32_t IntervalUs
+    ) {
+    SampleIntervalUs = IntervalUs;
+    for (uint32_t i = 0; i < PERF_COMPARE_RUN_COUNT; ++i) {
+        Runs[i].Rtt.reset(new(std::nothrow) PerfLatencyHistogram);
+        if (!Runs[i].Rtt) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        Runs[i].Rtt->Reset();
+    }
+
+    if (Path == nullptr) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    File = fopen(Path, "wb");
+    if (File == nullptr) {
+        WriteOutput("Failed to open compare trace file: %s\n", Path);
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    const PERF_COMPARE_TRACE_HEADER Header = {
+        PERF_COMPARE_TRACE_MAGIC,
+        PERF_COMPARE_TRACE_VERSION,
+        sizeof(PERF_COMPARE_TRACE_SAMPLE),
+        SampleIntervalUs
+    };
+    if (fwrite(&Header, sizeof(Header), 1, File) != 1) {
+        WriteOutput("Failed to write compare trace file: %s\n", Path);
+        return QUIC_STATUS_INTERNAL_ERROR;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+void
+PerfCompareTrace::BeginRun(
+    _In_ PERF_COMPARE_RUN Run
+    ) {
+    Lock.Acquire();
+    CurrentRun = Run;
+    ConnectionCount = 0;
+    NextConnection = 0;
+    RunStartUs = CxPlatTimeUs64();
+    Lock.Release();
+}
+
+void
+PerfCompareTrace::EndRun(
+    _In_ uint64_t GoodputKbps
+    ) {
+    Lock.Acquire();
+    RunSummary& Summary = Runs[CurrentRun];
+    Summary.Completed = true;
+    Summary.DurationUs = CxPlatTimeDiff64(RunStartUs, CxPlatTimeUs64());
+    Summary.GoodputKbps = GoodputKbps;
+    for (uint32_t i = 0; i < ConnectionCount; ++i) {
+        Summary.SentPackets += Connections[i].SentPackets;
+        Summary.LostPackets += Connections[i].LostPackets;
+    }
+    Lock.Release();
+}
+
+void
+PerfCompareTrace::AddSample(
+    _In_ const PERF_COMPARE_TRACE_SAMPLE& Sample
+    ) {
+    //
+    // Called with the lock held.
+    //
+    if (File) {
+        fwrite(&Sample, sizeof(Sample), 1, File);
+    }
+
+    RunSummary& Summary = Runs[CurrentRun];
+    Summary.SampleCount++;
+    if (Sample.RttUs != 0) {
+        Summary.Rtt->Record(Sample.RttUs);
+    }
+
+    uint32_t i = 0;
+    while (i < ConnectionCount && Connections[i].Connection != Sample.Connection) {
+        ++i;
+    }
+    if (i == ConnectionCount) {
+        if (ConnectionCount == PERF_COMPARE_MAX_CONNECTIONS) {
+            return;
+        }
+        Connections[i].Connection = Sample.Connection;
+        Connections[i].SentPackets = 0;
+        Connections[i].LostPackets = 0;
+        ConnectionCount++;
+    }
+    if (Sample.SentPackets > Connections[i].SentPackets) {
+        Connections[i].SentPackets = Sample.SentPackets;
+    }
+    if (Sample.LostPackets > Connections[i].LostPackets) {
+        Connections[i].LostPackets = Sample.LostPackets;
+    }
+}
+
+void
+PerfCompareTrace::AddQuicSamples(
+    _In_ uint32_t Connection,
+    _In_ uint64_t ConnectionStartUs,
+    _In_reads_(Count) const QUIC_CONN_TELEMETRY_SAMPLE* Samples,
+    _In_ uint32_t Count
+    ) {
+    Lock.Acquire();
+    const uint64_t Offset = CxPlatTimeDiff64(RunStartUs, ConnectionStartUs);
+    for (uint32_t i = 0; i < Count; ++i) {
+        PERF_COMPARE_TRACE_SAMPLE Sample;
+        CxPlatZeroMemory(&Sample, sizeof(Sample));
+        Sample.TimeUs = Offset + Samples[i].TimeUs;
+        Sample.RttUs = Samples[i].SmoothedRttUs;
+        Sample.MinRttUs = Samples[i].MinRttUs;
+        Sample.BandwidthEstimate = Samples[i].BandwidthEstimate;
+        Sample.PacingRate = Samples[i].PacingRate;
+        Sample.CongestionWindow = Samples[i].CongestionWindow;
+        Sample.BytesInFlight = Samples[i].BytesInFlight;
+        Sample.SentPackets = Samples[i].SendTotalPackets;
+        Sample.LostPackets = Samples[i].SendLostPackets;
+        Sample.Connection = Connection;
+        Sample.Run = (uint8_t)CurrentRun;
+        AddSample(Sample);
+    }
+    Lock.Release();
+}
+
+void
+PerfCompareTrace::AddTcpSamples(
+    _In_ uint16_t TargetPort,
+    _In_reads_(Count) const TCP_SS_LOG_ENTRY* Entries,
+    _In_ uint32_t Count
+    ) {
+    Lock.Acquire();
+    for (uint32_t i = 0; i < Count; ++i) {
+        const TCP_SS_LOG_ENTRY* Entry = &Entries[i];
+        const uint64_t TimeUs = Entry->Timestamp / 1000;
+        if (Entry->DestPort != TargetPort || TimeUs < RunStartUs) {
+            continue; // Only the client side of this run's connections.
+        }
+
+        PERF_COMPARE_TRACE_SAMPLE Sample;
+        CxPlatZeroMemory(&Sample, sizeof(Sample));
+        Sample.TimeUs = TimeUs - RunStartUs;
+        Sample.RttUs = (uint64_t)(Entry->RttMs * 1000);
+        Sample.PacingRate = (uint64_t)(Entry->PacingRateBps / 8);
+        Sample.CongestionWindow = (uint64_t)Entry->SndCwnd * Entry->SndMss;
+        Sample.BytesInFlight = (uint64_t)Entry->PacketsInFlight * Entry->SndMss;
+        if (Entry->IsBBR) {
+            Sample.MinRttUs = (uint64_t)(Entry->BbrMinRttMs * 1000);
+            Sample.BandwidthEstimate = (uint64_t)(Entry->BbrBandwidthBps / 8);
+        } else {
+            Sample.BandwidthEstimate = (uint64_t)(Entry->DeliveryRateBps / 8);
+        }
+        if (Entry->SndMss != 0) {
+            Sample.SentPackets = Entry->BytesSent / Entry->SndMss;
+        }
+        Sample.LostPackets = Entry->RetransSegs;
+        Sample.Connection = Entry->SourcePort;
+        Sample.Run = (uint8_t)CurrentRun;
+        AddSample(Sample);
+    }
+    Lock.Release();
+}
+
+void
+PerfCompareTrace::PrintSummary() {
+    char TcpName[48] = "TCP";
+    FILE* CcFile = fopen("/proc/sys/net/ipv4/tcp_congestion_control", "r");
+    if (CcFile) {
+        char Cc[32] = {0};
+        if (fscanf(CcFile, "%31s", Cc) == 1) {
+            snprintf(TcpName, sizeof(TcpName), "TCP (%s)", Cc);
+        }
+        fclose(CcFile);
+    }
+
+    WriteOutput(
+        "\nComparison (client send side, %u ms samples):\n"
+        "  %-14s %14s %12s %12s %12s %9s %9s\n",
+        SampleIntervalUs / 1000,
+        "Run", "Goodput(kbps)", "RTT p50(us)", "RTT p90(us)", "RTT p99(us)", "Loss", "Samples");
+    for (uint32_t i = 0; i < PERF_COMPARE_RUN_COUNT; ++i) {
+        RunSummary& Summary = Runs[i];
+        const char* Name = i == PERF_COMPARE_RUN_TCP ? TcpName : PerfCompareRunNames[i];
+        if (!Summary.Completed) {
+            WriteOutput("  %-14s %14s\n", Name, "(not run)");
+            continue;
+        }
+
+        Statistics RttStats;
+        Percentiles RttPercentiles;
+        GetHistogramStatistics(Summary.Rtt.get(), &RttStats, &RttPercentiles);
+
+        const uint64_t LossBasisPoints =
+            Summary.SentPackets ? Summary.LostPackets * 10000 / Summary.SentPackets : 0;
+        WriteOutput(
+            "  %-14s %14llu %12u %12u %12u %5u.%02u%% %9llu\n",
+            Name,
+            (unsigned long long)Summary.GoodputKbps,
+            (uint32_t)RttPercentiles.P50,
+            (uint32_t)RttPercentiles.P90,
+            (uint32_t)RttPercentiles.P99,
+            (uint32_t)(LossBasisPoints / 100),
+            (uint32_t)(LossBasisPoints % 100),
+            (unsigned long long)Summary.SampleCount);
+    }
+}
+
+static
+QUIC_STATUS
+PerfCompareRunOne(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_z_ const char* Target,
+    _In_ int Timeout,
+    _In_ PerfCompareTrace& Trace,
+    _In_ PERF_COMPARE_RUN Run
+    ) {
+    //
+    // The client configuration picks up the congestion control algorithm when
+    // it is constructed.
+    //
+    PerfDefaultCongestionControl =
+        Run == PERF_COMPARE_RUN_QUIC_BBR ?
+            QUIC_CONGESTION_CONTROL_ALGORITHM_BBR :
+            QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
+
+    UniquePtr<PerfClient> Client(new(std::nothrow) PerfClient);
+    if (!Client) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    Client->Trace = &Trace;
+    Client->UseTCP = Run == PERF_COMPARE_RUN_TCP;
+
+    QUIC_STATUS Status = Client->Init(argc, argv, Target);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    TCP_SS_LOGGER* Logger = nullptr;
+    if (Run == PERF_COMPARE_RUN_TCP) {
+        Logger = TcpSsLoggerGetDefault();
+        if (QUIC_FAILED(TcpSsLoggerInitialize(Logger, PERF_COMPARE_TCP_LOG_ENTRIES, Client->TargetPort))) {
+            WriteOutput("Failed to initialize TCP_INFO sampling\n");
+            Logger = nullptr;
+        } else {
+            TcpSsLoggerSetSamplingIntervalUs(Logger, Trace.SampleIntervalUs);
+        }
+    }
+
+    WriteOutput("Running %s...\n", PerfCompareRunNames[Run]);
+    CxPlatEvent CompletionEvent {true};
+    Trace.BeginRun(Run);
+    if (Logger && QUIC_FAILED(TcpSsLoggerStart(Logger))) {
+        WriteOutput("Failed to start TCP_INFO sampling\n");
+    }
+    Status = Client->Start(&CompletionEvent.Handle);
+    if (QUIC_SUCCEEDED(Status)) {
+        Status = Client->Wait(Timeout);
+    }
+
+    if (Logger) {
+        TcpSsLoggerStop(Logger);
+        UniquePtr<TCP_SS_LOG_ENTRY[]> Entries(
+            new(std::nothrow) TCP_SS_LOG_ENTRY[PERF_COMPARE_TCP_LOG_ENTRIES]);
+        if (Entries) {
+            const uint32_t Count =
+                TcpSsLoggerCopyEntries(Logger, Entries.get(), PERF_COMPARE_TCP_LOG_ENTRIES);
+            Trace.AddTcpSamples(Client->TargetPort, Entries.get(), Count);
+        }
+        TcpSsLoggerCleanup(Logger);
+    }
+
+    Trace.EndRun(Client->GetUploadRate() + Client->GetDownloadRate());
+    return Status;
+}
+
+QUIC_STATUS
+PerfCompareRun(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_z_ const char* Target,
+    _In_ int Timeout
+    ) {
+    uint32_t IntervalMs = PERF_COMPARE_DEFAULT_INTERVAL_MS;
+    TryGetValue(argc, argv, "compare_interval", &IntervalMs);
+    if (IntervalMs == 0) {
+        IntervalMs = 1;
+    }
+
+    UniquePtr<PerfCompareTrace> Trace(new(std::nothrow) PerfCompareTrace);
+    if (!Trace) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    QUIC_STATUS Status = Trace->Init(GetValue(argc, argv, "compare_trace"), MS_TO_US(IntervalMs));
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    const QUIC_CONGESTION_CONTROL_ALGORITHM DefaultCongestionControl = PerfDefaultCongestionControl;
+    for (uint32_t Run = 0; Run < PERF_COMPARE_RUN_COUNT; ++Run) {
+        QUIC_STATUS RunStatus =
+            PerfCompareRunOne(argc, argv, Target, Timeout, *Trace, (PERF_COMPARE_RUN)Run);
+        if (QUIC_FAILED(RunStatus)) {
+            WriteOutput("%s failed, 0x%x\n", PerfCompareRunNames[Run], RunStatus);
+            Status = RunStatus;
+        }
+    }
+    PerfDefaultCongestionControl = DefaultCongestionControl;
+
+    Trace->PrintSummary();
+    return Status;
+}
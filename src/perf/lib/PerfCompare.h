@@ -0,0 +1,125 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Defines the types used by the client-side comparison mode, which runs the
+    same scenario over QUIC (Cubic), QUIC (BBR) and kernel TCP back to back and
+    records time-aligned congestion control samples for each in one trace.
+
+--*/
+
+#pragma once
+
+#include "SecNetPerf.h"
+#include "tcp_ss_logger.h"
+#include "LatencyHistogram.h"
+
+#define PERF_COMPARE_TRACE_MAGIC            0x504d4353  // "SCMP"
+#define PERF_COMPARE_TRACE_VERSION          1
+#define PERF_COMPARE_DEFAULT_INTERVAL_MS    10
+#define PERF_COMPARE_READ_INTERVAL_US       (100 * 1000)
+#define PERF_COMPARE_MAX_CONNECTIONS        256
+#define PERF_COMPARE_TCP_LOG_ENTRIES        (256 * 1024)
+
+enum PERF_COMPARE_RUN : uint8_t {
+    PERF_COMPARE_RUN_QUIC_CUBIC,
+    PERF_COMPARE_RUN_QUIC_BBR,
+    PERF_COMPARE_RUN_TCP,
+    PERF_COMPARE_RUN_COUNT
+};
+
+//
+// The trace file is one PERF_COMPARE_TRACE_HEADER followed by fixed size
+// PERF_COMPARE_TRACE_SAMPLE records, in host byte order. Samples from the
+// different connections of a run are interleaved in the order they were
+// collected.
+//
+struct PERF_COMPARE_TRACE_HEADER {
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t SampleSize;            // sizeof(PERF_COMPARE_TRACE_SAMPLE)
+    uint32_t SampleIntervalUs;
+};
+
+struct PERF_COMPARE_TRACE_SAMPLE {
+    uint64_t TimeUs;                // Since the start of the run.
+    uint64_t RttUs;                 // Smoothed RTT.
+    uint64_t MinRttUs;
+    uint64_t BandwidthEstimate;     // Bytes per second (TCP: delivery rate).
+    uint64_t PacingRate;            // Bytes per second; zero if not pacing.
+    uint64_t CongestionWindow;      // Bytes.
+    uint64_t BytesInFlight;
+    uint64_t SentPackets;           // Cumulative (TCP: bytes sent / MSS).
+    uint64_t LostPackets;           // Cumulative (TCP: retransmitted segments).
+    uint32_t Connection;            // Index within the run (TCP: local port).
+    uint8_t Run;                    // PERF_COMPARE_RUN
+    uint8_t Reserved[3];
+};
+
+struct PerfCompareTrace {
+    PerfCompareTrace() { }
+    ~PerfCompareTrace();
+    QUIC_STATUS Init(_In_opt_z_ const char* Path, _In_ uint32_t SampleIntervalUs);
+    void BeginRun(_In_ PERF_COMPARE_RUN Run);
+    void EndRun(_In_ uint64_t GoodputKbps);
+    uint32_t NewConnection() {
+        return (uint32_t)InterlockedIncrement64((int64_t*)&NextConnection) - 1;
+    }
+    void AddQuicSamples(
+        _In_ uint32_t Connection,
+        _In_ uint64_t ConnectionStartUs,
+        _In_reads_(Count) const QUIC_CONN_TELEMETRY_SAMPLE* Samples,
+        _In_ uint32_t Count);
+    void AddTcpSamples(
+        _In_ uint16_t TargetPort,
+        _In_reads_(Count) const TCP_SS_LOG_ENTRY* Entries,
+        _In_ uint32_t Count);
+    void PrintSummary();
+
+    uint32_t SampleIntervalUs {PERF_COMPARE_DEFAULT_INTERVAL_MS * 1000};
+    PERF_COMPARE_RUN CurrentRun {PERF_COMPARE_RUN_QUIC_CUBIC};
+    uint64_t RunStartUs {0};
+
+private:
+    void AddSample(_In_ const PERF_COMPARE_TRACE_SAMPLE& Sample);
+
+    CxPlatLock Lock;
+    FILE* File {nullptr};
+    uint64_t NextConnection {0};
+
+    //
+    // Cumulative counters from the latest sample of each connection in the
+    // current run.
+    //
+    struct ConnectionTotals {
+        uint32_t Connection;
+        uint64_t SentPackets;
+        uint64_t LostPackets;
+    } Connections[PERF_COMPARE_MAX_CONNECTIONS];
+    uint32_t ConnectionCount {0};
+
+    struct RunSummary {
+        bool Completed {false};
+        uint64_t DurationUs {0};
+        uint64_t GoodputKbps {0};
+        uint64_t SampleCount {0};
+        uint64_t SentPackets {0};
+        uint64_t LostPackets {0};
+        UniquePtr<PerfLatencyHistogram> Rtt;
+    } Runs[PERF_COMPARE_RUN_COUNT];
+};
+
+//
+// Runs the client scenario given on the command line once per
+// PERF_COMPARE_RUN and prints the comparison.
+//
+QUIC_STATUS
+PerfCompareRun(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_z_ const char* Target,
+    _In_ int Timeout
+    );
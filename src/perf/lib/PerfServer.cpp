@@ -11,6 +11,10 @@ Abstract:
 
 #include "PerfServer.h"
 
+#if defined(_WIN32) && !defined(_KERNEL_MODE)
+#include <psapi.h> // K32GetProcessMemoryInfo
+#endif
+
 #ifdef QUIC_CLOG
 #include "PerfServer.cpp.clog.h"
 #endif
@@ -30,6 +34,8 @@ PerfServer::Init(
     }
 
     TryGetValue(argc, argv, "stats", &PrintStats);
+    TryGetValue(argc, argv, "pcounters", &PrintCountersIntervalMs);
+    TryGetValue(argc, argv, "tickets", &SendResumptionTickets);
 
     const char* LocalAddress = nullptr;
     uint16_t Port = 0;
@@ -42,12 +48,17 @@ PerfServer::Init(
         QuicAddrSetPort(&LocalAddr, Port);
     }
 
+    MsQuicGlobalSettings GlobalSettings;
     uint32_t ServerId = 0;
     if (TryGetValue(argc, argv, "serverid", &ServerId)) {
-        MsQuicGlobalSettings GlobalSettings;
         GlobalSettings.SetFixedServerID(ServerId);
         GlobalSettings.SetLoadBalancingMode(QUIC_LOAD_BALANCING_SERVER_ID_FIXED);
-
+    }
+    uint16_t RetryMemoryLimit = 0;
+    if (TryGetValue(argc, argv, "retrymem", &RetryMemoryLimit)) {
+        GlobalSettings.SetRetryMemoryLimit(RetryMemoryLimit);
+    }
+    if (GlobalSettings.IsSetFlags != 0) {
         QUIC_STATUS Status;
         if (QUIC_FAILED(Status = GlobalSettings.Set())) {
             WriteOutput("Failed to set global settings %d\n", Status);
@@ -55,6 +66,30 @@ PerfServer::Init(
         }
     }
 
+    uint32_t MaxStatelessOperations = 0;
+    if (TryGetValue(argc, argv, "statelessops", &MaxStatelessOperations)) {
+        QUIC_STATUS Status;
+        if (QUIC_FAILED(Status = MsQuicSettings().SetMaxStatelessOperations(MaxStatelessOperations).SetGlobal())) {
+            WriteOutput("Failed to set MaxStatelessOperations %d\n", Status);
+            return Status;
+        }
+    }
+
+    uint32_t ArenaSlabSize = 0;
+    if (TryGetValue(argc, argv, "arena", &ArenaSlabSize)) {
+        QUIC_STATUS Status;
+        if (QUIC_FAILED(
+                Status =
+                    MsQuic->SetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE,
+                        sizeof(ArenaSlabSize),
+                        &ArenaSlabSize))) {
+            WriteOutput("Failed to set connection arena slab size %d\n", Status);
+            return Status;
+        }
+    }
+
     const char* CibirBytes = nullptr;
     if (TryGetValue(argc, argv, "cibir", &CibirBytes)) {
         uint32_t CibirIdLength;
@@ -149,7 +184,26 @@ QUIC_STATUS
 PerfServer::Wait(
     _In_ int Timeout
     ) {
-    if (Timeout > 0) {
+    if (PrintCountersIntervalMs) {
+        const uint64_t StartTime = CxPlatTimeMs64();
+        GetLoadCounters(PreviousCounters);
+        for (;;) {
+            uint32_t WaitTime = PrintCountersIntervalMs;
+            if (Timeout > 0) {
+                const uint64_t Elapsed = CxPlatTimeDiff64(StartTime, CxPlatTimeMs64());
+                if (Elapsed >= (uint64_t)Timeout) {
+                    break;
+                }
+                if ((uint64_t)Timeout - Elapsed < WaitTime) {
+                    WaitTime = (uint32_t)((uint64_t)Timeout - Elapsed);
+                }
+            }
+            if (CxPlatEventWaitWithTimeout(*StopEvent, WaitTime)) {
+                break;
+            }
+            PrintLoadCounters();
+        }
+    } else if (Timeout > 0) {
         CxPlatEventWaitWithTimeout(*StopEvent, Timeout);
     } else {
         CxPlatEventWaitForever(*StopEvent);
@@ -158,6 +212,90 @@ PerfServer::Wait(
     return QUIC_STATUS_SUCCESS;
 }
 
+void
+PerfServer::GetLoadCounters(
+    _Out_ uint64_t (&Counters)[QUIC_PERF_COUNTER_MAX]
+    )
+{
+    uint32_t BufferLength = sizeof(Counters);
+    if (QUIC_FAILED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PERF_COUNTERS,
+            &BufferLength,
+            Counters))) {
+        CxPlatZeroMemory(Counters, sizeof(Counters));
+    }
+}
+
+//
+// The resident memory of this process, in bytes, or zero if it can't be
+// queried on this platform.
+//
+static
+uint64_t
+GetProcessMemoryUsage(
+    )
+{
+#if defined(CX_PLATFORM_LINUX)
+    uint64_t Size = 0, Resident = 0;
+    FILE* File = fopen("/proc/self/statm", "r");
+    if (File) {
+        if (fscanf(File, "%" SCNu64 " %" SCNu64, &Size, &Resident) != 2) {
+            Resident = 0;
+        }
+        fclose(File);
+    }
+    return Resident * (uint64_t)sysconf(_SC_PAGESIZE);
+#elif defined(_WIN32) && !defined(_KERNEL_MODE)
+    PROCESS_MEMORY_COUNTERS MemoryCounters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &MemoryCounters, sizeof(MemoryCounters))) {
+        return MemoryCounters.WorkingSetSize;
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+void
+PerfServer::PrintLoadCounters(
+    )
+{
+    //
+    // These are library wide, so they include any client connections in this
+    // process too.
+    //
+    uint64_t Counters[QUIC_PERF_COUNTER_MAX];
+    GetLoadCounters(Counters);
+    const uint64_t Memory = GetProcessMemoryUsage();
+    if (Memory > PeakMemory) {
+        PeakMemory = Memory;
+    }
+
+#define PERF_COUNTER_DELTA(Counter) \
+    (unsigned long long)(Counters[Counter] - PreviousCounters[Counter])
+
+    const uint64_t Active = Counters[QUIC_PERF_COUNTER_CONN_ACTIVE];
+    WriteOutput(
+        "Server: +%llu conns, +%llu load rejected, +%llu retries, +%llu resumed, "
+        "+%llu handshake failures, %llu active, %llu KB memory (peak %llu KB), "
+        "%llu bytes/conn\n",
+        PERF_COUNTER_DELTA(QUIC_PERF_COUNTER_CONN_CREATED),
+        PERF_COUNTER_DELTA(QUIC_PERF_COUNTER_CONN_LOAD_REJECT),
+        PERF_COUNTER_DELTA(QUIC_PERF_COUNTER_SEND_STATELESS_RETRY),
+        PERF_COUNTER_DELTA(QUIC_PERF_COUNTER_CONN_RESUMED),
+        PERF_COUNTER_DELTA(QUIC_PERF_COUNTER_CONN_HANDSHAKE_FAIL),
+        (unsigned long long)Active,
+        (unsigned long long)(Memory / 1024),
+        (unsigned long long)(PeakMemory / 1024),
+        (unsigned long long)(Active ? Memory / Active : 0));
+
+#undef PERF_COUNTER_DELTA
+
+    CxPlatCopyMemory(PreviousCounters, Counters, sizeof(Counters));
+}
+
 void
 PerfServer::DatapathReceive(
     _In_ CXPLAT_SOCKET*,
@@ -199,6 +337,12 @@ PerfServer::ConnectionCallback(
     _Inout_ QUIC_CONNECTION_EVENT* Event
     ) {
     switch (Event->Type) {
+    case QUIC_CONNECTION_EVENT_CONNECTED:
+        if (SendResumptionTickets) {
+            MsQuic->ConnectionSendResumptionTicket(
+                ConnectionHandle, QUIC_SEND_RESUMPTION_FLAG_FINAL, 0, nullptr);
+        }
+        break;
     case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
         if (!Event->SHUTDOWN_COMPLETE.AppCloseInProgress) {
             if (PrintStats) {
@@ -219,6 +363,30 @@ PerfServer::ConnectionCallback(
         MsQuic->SetCallbackHandler(Event->PEER_STREAM_STARTED.Stream, (void*)Handler, Context);
         break;
     }
+    case QUIC_CONNECTION_EVENT_DATAGRAM_RECEIVED: {
+        //
+        // Datagram requests are echoed back as is, so the client can time them.
+        //
+        const QUIC_BUFFER* Buffer = Event->DATAGRAM_RECEIVED.Buffer;
+        auto Echo =
+            (QUIC_BUFFER*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_BUFFER) + Buffer->Length, QUIC_POOL_PERF);
+        if (!Echo) {
+            break;
+        }
+        Echo->Length = Buffer->Length;
+        Echo->Buffer = (uint8_t*)(Echo + 1);
+        CxPlatCopyMemory(Echo->Buffer, Buffer->Buffer, Buffer->Length);
+        if (QUIC_FAILED(
+            MsQuic->DatagramSend(ConnectionHandle, Echo, 1, QUIC_SEND_FLAG_NONE, Echo))) {
+            CXPLAT_FREE(Echo, QUIC_POOL_PERF);
+        }
+        break;
+    }
+    case QUIC_CONNECTION_EVENT_DATAGRAM_SEND_STATE_CHANGED:
+        if (QUIC_DATAGRAM_SEND_STATE_IS_FINAL(Event->DATAGRAM_SEND_STATE_CHANGED.State)) {
+            CXPLAT_FREE(Event->DATAGRAM_SEND_STATE_CHANGED.ClientContext, QUIC_POOL_PERF);
+        }
+        break;
     default:
         break;
     }
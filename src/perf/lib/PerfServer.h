@@ -154,6 +154,9 @@ private:
 
     void IntroduceFixedDelay(uint32_t DelayUs);
 
+    void GetLoadCounters(_Out_ uint64_t (&Counters)[QUIC_PERF_COUNTER_MAX]);
+    void PrintLoadCounters();
+
 #ifndef _KERNEL_MODE
     //
     // Variable delay methods are not included in Kernel mode
@@ -183,11 +186,16 @@ private:
             .SetCongestionControlAlgorithm(PerfDefaultCongestionControl)
             .SetEcnEnabled(PerfDefaultEcnEnabled)
             .SetEncryptionOffloadAllowed(PerfDefaultQeoAllowed)
-            .SetOneWayDelayEnabled(true)};
+            .SetOneWayDelayEnabled(true)
+            .SetDatagramReceiveEnabled(true)};
     MsQuicListener Listener {Registration, CleanUpManual, ListenerCallbackStatic, this};
     QUIC_ADDR LocalAddr;
     CXPLAT_EVENT* StopEvent {nullptr};
     uint8_t PrintStats {FALSE};
+    uint8_t SendResumptionTickets {FALSE};
+    uint32_t PrintCountersIntervalMs {0};
+    uint64_t PreviousCounters[QUIC_PERF_COUNTER_MAX];
+    uint64_t PeakMemory {0};
 
     TcpEngine Engine;
     TcpConfiguration TcpConfig;
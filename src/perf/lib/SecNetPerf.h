@@ -34,13 +34,14 @@ Abstract:
 #define PERF_DEFAULT_PORT                   4433
 #define PERF_DEFAULT_DISCONNECT_TIMEOUT     (10 * 1000)
 #define PERF_DEFAULT_IDLE_TIMEOUT           (30 * 1000)
+#define PERF_HOLD_KEEP_ALIVE_MS             (10 * 1000)
 #define PERF_DEFAULT_CONN_FLOW_CONTROL      0x8000000
 #define PERF_DEFAULT_STREAM_COUNT           10000
 #define PERF_DEFAULT_SEND_BUFFER_SIZE       0x20000
 #define PERF_DEFAULT_IO_SIZE                0x10000
+#define PERF_SEND_BATCH_SIZE                32
 
 #define PERF_MAX_THREAD_COUNT               128
-#define PERF_MAX_REQUESTS_PER_SECOND        2000000 // best guess - must increase if we can do better
 
 typedef enum TCP_EXECUTION_PROFILE {
     TCP_EXECUTION_PROFILE_LOW_LATENCY,
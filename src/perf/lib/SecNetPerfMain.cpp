@@ -12,6 +12,7 @@ Abstract:
 #include "SecNetPerf.h"
 #include "PerfServer.h"
 #include "PerfClient.h"
+#include "PerfCompare.h"
 #include "Tcp.h"
 
 // 使用新的TCP日志器接口替换旧的
@@ -34,6 +35,16 @@ uint8_t PerfDefaultEcnEnabled = false;
 uint8_t PerfDefaultQeoAllowed = false;
 uint8_t PerfDefaultHighPriority = false;
 uint8_t PerfDefaultAffinitizeThreads = false;
+uint8_t PrintProfile = false;
+uint8_t CompareMode = false;
+
+//
+// Deferred client arguments for comparison mode, which runs its own clients
+// from QuicMainWaitForCompletion.
+//
+static int CompareArgc;
+static char** CompareArgv;
+static const char* CompareTarget;
 
 #ifdef _KERNEL_MODE
 volatile int BufferCurrent;
@@ -88,6 +99,11 @@ PrintHelp(
         "  -delayType:<fixed/variable>    Optional delay type can be specified in conjunction with the 'delay' argument.\n"
         "                                 'fixed' - introduce the specified delay for each request (default).\n"
         "                                 'variable'- introduce a statistical variability to the specified delay (user mode only).\n"
+        "  -tickets:<0/1>           Send a resumption ticket on each new connection. (def:0)\n"
+        "  -pcounters:<####>        Print connection load counters and process memory every interval, in milliseconds. (def:0)\n"
+        "  -statelessops:<####>     Sets MaxStatelessOperations, the stateless operations that may be queued per worker.\n"
+        "  -retrymem:<####>         Sets RetryMemoryLimit, the handshake memory (in 65535ths of total) before requiring retry.\n"
+        "  -arena:<####>            Carves connection-lifetime allocations from per-connection slabs of this initial size. (def:0)\n"
         "\n"
         "Client: secnetperf -target:<hostname/ip> [options]\n"
         "\n"
@@ -108,18 +124,21 @@ PrintHelp(
         "\n"
         "  Config options:\n"
         "  -tcp:<0/1>               Disables/enables TCP usage (instead of QUIC). (def:0)\n"
-        "  -tcplog:<0/1>            Disables/enables TCP packet level logging via eBPF. (def:0)\n"
+        "  -tcplog:<0/1>            Disables/enables sampling TCP_INFO for the TCP connections. (def:0)\n"
+        "  -tcplog_interval_us:<#>  The TCP_INFO sampling interval, in microseconds. (def:100000)\n"
         "  -encrypt:<0/1>           Disables/enables encryption. (def:1)\n"
         "  -pacing:<0/1>            Disables/enables send pacing. (def:1)\n"
         "  -sendbuf:<0/1>           Disables/enables send buffering. (def:0)\n"
+        "  -sendbatch:<0/1>         Disables/enables batching the first sends of streams started together. (def:0)\n"
         "  -ptput:<0/1>             Print throughput information. (def:0)\n"
         "  -pconn:<0/1>             Print connection statistics. (def:0)\n"
         "  -pstream:<0/1>           Print stream statistics. (def:0)\n"
         "  -platency<0/1>           Print latency statistics. (def:0)\n"
+        "  -platinterval:<####>     Also print latency percentiles every interval, in milliseconds, while running. (def:0)\n"
         "\n"
         "  Scenario options:\n"
         "  -scenario:<profile>      Scenario profile to use.\n"
-        "                            - {upload, download, hps, rps, rps-multi, latency}.\n"
+        "                            - {upload, download, hps, storm, idle, rps, rps-multi, latency, datagram}.\n"
         "  -conns:<####>            The number of connections to use. (def:1)\n"
         "  -streams:<####>          The number of streams to send on at a time. (def:0)\n"
         "  -upload:<####>[unit]     The length of bytes to send on each stream, with an optional (time or length) unit. (def:0)\n"
@@ -128,7 +147,22 @@ PrintHelp(
         //"  -inline:<0/1>            Create new streams on callbacks. (def:0)\n"
         "  -rconn:<0/1>             Repeat the scenario at the connection level. (def:0)\n"
         "  -rstream:<0/1>           Repeat the scenario at the stream level. (def:0)\n"
+        "  -hold:<0/1>              Keep each connection open and idle until the run ends. (def:0)\n"
         "  -runtime:<####>[unit]    The total runtime, with an optional unit (def unit is us). Only relevant for repeat scenarios. (def:0)\n"
+        "  -rate:<####>             Open-loop: start requests at this total rate (per second), measuring latency from when each was due. (def:0)\n"
+        "  -arrival:<fixed/poisson> The request arrival process for 'rate'. (def:fixed)\n"
+        "  -sizedist:<dist>         The upload/download length distribution for 'rate', with the given lengths as the mean.\n"
+        "                            - {fixed, uniform, exp}. (def:fixed)\n"
+        "  -datagram:<0/1>          Each 'rate' request is an 'upload' length datagram, echoed by the server, instead of a stream. (def:0)\n"
+        "  -dgbatch:<####>          The most due datagrams queued on a connection with one DatagramSendBatch call. (def:1)\n"
+        "  -connrate:<####>         Handshake storm: start connections at this rate (per second), closing each once connected. (def:0)\n"
+        "  -ramp:<####>[unit]       The time to ramp 'connrate' up from zero, with an optional unit (def unit is us). (def:0)\n"
+        "  -resume:<0-100>          The percentage of 'connrate' attempts to resume with a ticket. (def:0)\n"
+        "\n"
+        "  Comparison options:\n"
+        "  -compare:<0/1>           Runs the scenario over QUIC (cubic), QUIC (bbr) and TCP in turn and compares them. (def:0)\n"
+        "  -compare_interval:<####> The congestion control sampling interval, in milliseconds. (def:%u)\n"
+        "  -compare_trace:<path>    Writes the time-aligned samples of all three runs to a binary trace file.\n"
         "\n"
         "Both (client & server) options:\n"
         "  -exec:<profile>          Execution profile to use.\n"
@@ -148,9 +182,11 @@ PrintHelp(
         "  -cpu:<cpu_index>         Specify the processor(s) to use.\n"
         "  -cipher:<value>          Decimal value of 1 or more QUIC_ALLOWED_CIPHER_SUITE_FLAGS.\n"
         "  -highpri:<0/1>           Configures MsQuic to run threads at high priority. (def:0)\n"
+        "  -profile:<0/1>           Prints MsQuic's sampled CPU cost breakdown on exit. (def:0)\n"
         "\n",
         PERF_DEFAULT_PORT,
-        PERF_DEFAULT_PORT
+        PERF_DEFAULT_PORT,
+        PERF_COMPARE_DEFAULT_INTERVAL_MS
         );
 }
 
@@ -177,6 +213,13 @@ QuicMainStart(
     TryGetValue(argc, argv, "maxruntime", &MaxRuntime);
     TryGetValue(argc, argv, "tcp", &UseTcp);
     TryGetValue(argc, argv, "tcplog", &EnableTcpLogging);
+    TryGetValue(argc, argv, "profile", &PrintProfile);
+    TryGetValue(argc, argv, "compare", &CompareMode);
+
+    if (CompareMode && (!Target || UseTcp)) {
+        WriteOutput("Comparison mode needs a client target and runs TCP itself; don't pass -tcp.\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
 
     QUIC_STATUS Status = QUIC_STATUS_OUT_OF_MEMORY;
     MsQuic = new(std::nothrow) MsQuicApi;
@@ -252,13 +295,16 @@ QuicMainStart(
     if (ScenarioStr != nullptr) {
         if (IsValue(ScenarioStr, "upload") ||
             IsValue(ScenarioStr, "download") ||
-            IsValue(ScenarioStr, "hps")) {
+            IsValue(ScenarioStr, "hps") ||
+            IsValue(ScenarioStr, "storm") ||
+            IsValue(ScenarioStr, "idle")) {
             PerfDefaultExecutionProfile = QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT;
             TcpDefaultExecutionProfile = TCP_EXECUTION_PROFILE_MAX_THROUGHPUT;
         } else if (
             IsValue(ScenarioStr, "rps") ||
             IsValue(ScenarioStr, "rps-multi") ||
-            IsValue(ScenarioStr, "latency")) {
+            IsValue(ScenarioStr, "latency") ||
+            IsValue(ScenarioStr, "datagram")) {
             PerfDefaultExecutionProfile = QUIC_EXECUTION_PROFILE_LOW_LATENCY;
             TcpDefaultExecutionProfile = TCP_EXECUTION_PROFILE_LOW_LATENCY;
         } else {
@@ -301,7 +347,7 @@ QuicMainStart(
 
     // 初始化TCP日志器（使用新的接口）
     if (UseTcp && EnableTcpLogging) {
-        WriteOutput("Initializing TCP packet level logging via ss command\n");
+        WriteOutput("Initializing TCP_INFO logging\n");
         
         TCP_LOGGER* Logger = TcpLoggerGetDefault();
         uint16_t TargetPort = (uint16_t)PERF_DEFAULT_PORT;
@@ -345,23 +391,15 @@ QuicMainStart(
             TryGetValue(argc, argv, "tcplog_interval", &SamplingInterval);
             if (SamplingInterval < 10) SamplingInterval = 10; // 至少10ms
             
-            WriteOutput("Using TCP logging sampling interval: %ums\n", SamplingInterval);
-            
             // 设置采样间隔和控制台输出
             TcpLoggerSetOutputOptions(Logger, EnableConsoleOutput, SamplingInterval);
             
-            // 在启动前手动测试ss命令，检查是否可以执行
-            WriteOutput("Testing ss command availability...\n");
-            FILE* testPipe = popen("ss -h 2>&1", "r");
-            if (testPipe) {
-                char testBuf[128];
-                if (fgets(testBuf, sizeof(testBuf), testPipe) != NULL) {
-                    WriteOutput("ss command test output: %s", testBuf);
-                }
-                pclose(testPipe);
-            } else {
-                WriteOutput("Warning: Unable to test ss command\n");
+            // 微秒级采样间隔（通过 sock_diag 采样时可低于1ms）
+            uint32_t SamplingIntervalUs = SamplingInterval * 1000;
+            if (TryGetValue(argc, argv, "tcplog_interval_us", &SamplingIntervalUs)) {
+                TcpLoggerSetSamplingIntervalUs(Logger, SamplingIntervalUs);
             }
+            WriteOutput("Using TCP logging sampling interval: %uus\n", SamplingIntervalUs);
             
             // Start the logger
             if (QUIC_SUCCEEDED(TcpLoggerStart(Logger))) {
@@ -396,7 +434,12 @@ QuicMainStart(
         return Status;
     }
 
-    if (Target) {
+    if (Target && CompareMode) {
+        CompareArgc = argc;
+        CompareArgv = argv;
+        CompareTarget = Target;
+        return QUIC_STATUS_SUCCESS;
+    } else if (Target) {
         Client = new(std::nothrow) PerfClient;
         if ((QUIC_SUCCEEDED(Status = Client->Init(argc, argv, Target)) &&
              QUIC_SUCCEEDED(Status = Client->Start(StopEvent)))) {
@@ -419,9 +462,69 @@ QuicMainStart(
 QUIC_STATUS
 QuicMainWaitForCompletion(
     ) {
+    if (CompareMode) {
+        return PerfCompareRun(CompareArgc, CompareArgv, CompareTarget, (int)MaxRuntime);
+    }
     return Client ? Client->Wait((int)MaxRuntime) : Server->Wait((int)MaxRuntime);
 }
 
+static
+void
+QuicMainPrintProfile(
+    )
+{
+    uint32_t BufferLength = 0;
+    if (MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PROFILE,
+            &BufferLength,
+            nullptr) != QUIC_STATUS_BUFFER_TOO_SMALL) {
+        WriteOutput("Failed to query profile size\n");
+        return;
+    }
+
+    const uint32_t EntryCount = BufferLength / sizeof(QUIC_PROFILE_ENTRY);
+    UniquePtr<QUIC_PROFILE_ENTRY[]> Entries(new(std::nothrow) QUIC_PROFILE_ENTRY[EntryCount]);
+    if (!Entries ||
+        QUIC_FAILED(
+            MsQuic->GetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_PROFILE,
+                &BufferLength,
+                Entries.get()))) {
+        WriteOutput("Failed to query profile\n");
+        return;
+    }
+
+    static const char* const CategoryNames[] = { "Operations", "API calls", "Frames" };
+    WriteOutput("MsQuic Profile (sampled cycles):\n");
+    for (uint32_t Category = 0; Category < ARRAYSIZE(CategoryNames); ++Category) {
+        uint64_t TotalCycles = 0;
+        for (uint32_t i = 0; i < EntryCount; ++i) {
+            if (Entries[i].Category == (QUIC_PROFILE_CATEGORY)Category) {
+                TotalCycles += Entries[i].Cycles;
+            }
+        }
+        if (TotalCycles == 0) {
+            continue;
+        }
+        WriteOutput("  %s:\n", CategoryNames[Category]);
+        for (uint32_t i = 0; i < EntryCount; ++i) {
+            const QUIC_PROFILE_ENTRY* Entry = &Entries[i];
+            if (Entry->Category != (QUIC_PROFILE_CATEGORY)Category || Entry->Samples == 0) {
+                continue;
+            }
+            WriteOutput(
+                "    %-42s %10llu samples %10llu avg %3u.%u%%\n",
+                Entry->Name,
+                (unsigned long long)Entry->Samples,
+                (unsigned long long)(Entry->Cycles / Entry->Samples),
+                (uint32_t)(Entry->Cycles * 100 / TotalCycles),
+                (uint32_t)(Entry->Cycles * 1000 / TotalCycles % 10));
+        }
+    }
+}
+
 void
 QuicMainFree(
     )
@@ -444,6 +547,10 @@ QuicMainFree(
         WriteOutput("TCP logging stopped and cleaned up\n");
     }
     
+    if (PrintProfile && MsQuic != nullptr) {
+        QuicMainPrintProfile();
+    }
+
     delete MsQuic;
     MsQuic = nullptr;
 
@@ -500,13 +607,14 @@ TryGetVariableUnitValue(
     }
     if (!value) { return false; }
 
-    // Search to see if the value has a time unit specified at the end.
+    // Search to see if the value has a time unit specified at the end. The
+    // value is left as is (atoi stops at the unit), since comparison mode
+    // parses the same arguments once per run.
     for (uint32_t i = 0; i < ARRAYSIZE(TimeUnits); ++i) {
         size_t len = strlen(TimeUnits[i]);
         if (len < strlen(value) &&
             _strnicmp(value + strlen(value) - len, TimeUnits[i], len) == 0) {
             if (isTimed) *isTimed = true;
-            value[strlen(value) - len] = '\0';
             *pValue = (T)(atoi(value) * TimeMult[i]);
             return true;
         }
@@ -517,7 +625,6 @@ TryGetVariableUnitValue(
         size_t len = strlen(SizeUnits[i]);
         if (len < strlen(value) &&
             _strnicmp(value + strlen(value) - len, SizeUnits[i], len) == 0) {
-            value[strlen(value) - len] = '\0';
             *pValue = (T)(atoi(value) * SizeMult[i]);
             return true;
         }
@@ -528,7 +635,6 @@ TryGetVariableUnitValue(
         size_t len = strlen(CountUnits[i]);
         if (len < strlen(value) &&
             _strnicmp(value + strlen(value) - len, CountUnits[i], len) == 0) {
-            value[strlen(value) - len] = '\0';
             *pValue = (T)(atoi(value) * CountMult[i]);
             return true;
         }
@@ -68,6 +68,16 @@ void TcpLoggerSetOutputOptions(
     TcpSsLoggerSetOutputOptions(Logger->SsLogger, EnableConsoleOutput, SamplingInterval);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void TcpLoggerSetSamplingIntervalUs(
+    _In_ TCP_LOGGER* Logger,
+    _In_ uint32_t SamplingIntervalUs
+    )
+{
+    if (Logger == NULL) return;
+    TcpSsLoggerSetSamplingIntervalUs(Logger->SsLogger, SamplingIntervalUs);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void TcpLoggerSetLogFile(_In_ TCP_LOGGER* Logger, _In_ const char* FilePath) {
     if (Logger == NULL) return;
@@ -76,6 +76,12 @@ void TcpLoggerSetOutputOptions(
     _In_ uint32_t SamplingInterval
     );
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void TcpLoggerSetSamplingIntervalUs(
+    _In_ TCP_LOGGER* Logger,
+    _In_ uint32_t SamplingIntervalUs
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void TcpLoggerSetLogFile(_In_ TCP_LOGGER* Logger, _In_ const char* FilePath);
 
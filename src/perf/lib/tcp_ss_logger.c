@@ -15,6 +15,13 @@
 #include <regex.h>
 #include <fcntl.h>
 #include <signal.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#include <linux/tcp.h>
 
 // 定义ss日志器的完整结构体
 struct _TCP_SS_LOGGER {
@@ -29,7 +36,8 @@ struct _TCP_SS_LOGGER {
     pthread_t PollingThread;        // 轮询线程
     volatile BOOLEAN Running;       // 运行标志
     BOOLEAN EnableConsoleOutput;    // 启用控制台输出
-    uint32_t SamplingIntervalMs;    // 采样间隔（毫秒）
+    uint32_t SamplingIntervalUs;    // 采样间隔（微秒）
+    int DiagSocket;                 // sock_diag 套接字，-1 时回退到 ss 命令
     char* LogFilePath;              // 日志文件路径
     FILE* LogFileHandle;            // 日志文件句柄
     BOOLEAN DetailedLogging;        // 是否启用详细日志
@@ -302,9 +310,6 @@ static uint32_t parse_ipv4_addr(const char* ip_str) {
 }
 
 // 识别BBR状态（通过启发式方法）
-#if defined(__GNUC__)
-__attribute__((unused))
-#endif
 static TCP_SS_BBR_STATE infer_bbr_state(double pacing_gain, uint32_t cwnd, double min_rtt) {
     // 防止编译器警告
     (void)min_rtt;  // 标记参数已使用，但实际不用
@@ -328,6 +333,209 @@ static TCP_SS_BBR_STATE infer_bbr_state(double pacing_gain, uint32_t cwnd, doubl
     return TCP_BBR_UNKNOWN;
 }
 
+// 将日志条目写入环形缓冲区、连接跟踪和日志文件
+static void record_log_entry(TCP_SS_LOGGER* logger, TCP_SS_LOG_ENTRY* entry) {
+    CxPlatLockAcquire(&logger->Lock);
+
+    // 记录日志条目
+    if (logger->Entries != NULL) {
+        logger->Entries[logger->CurrentIndex] = *entry;
+        logger->CurrentIndex = (logger->CurrentIndex + 1) % logger->MaxEntries;
+    }
+    logger->TotalEntries++;
+
+    CxPlatLockRelease(&logger->Lock);
+
+    // 更新连接跟踪
+    update_connection_tracking(logger, entry);
+
+    // 写入日志文件
+    if (logger->LogFileHandle) {
+        write_log_entry_to_file(logger, entry);
+    }
+}
+
+// 取出 sock_diag 地址中的IPv4地址（主机字节序），支持IPv4映射的IPv6地址，
+// 纯IPv6地址返回0
+static uint32_t diag_ipv4_addr(uint8_t family, const __be32* addr) {
+    if (family == AF_INET) {
+        return ntohl(addr[0]);
+    }
+    if (addr[0] == 0 && addr[1] == 0 && addr[2] == htonl(0xffff)) {
+        return ntohl(addr[3]);
+    }
+    return 0;
+}
+
+// 将一条 INET_DIAG 响应转换为日志条目（单位与ss输出一致），
+// 并生成与ss相同格式的详细行供日志文件使用
+static void parse_diag_msg(TCP_SS_LOGGER* logger, struct nlmsghdr* nlh, TCP_SS_LOG_ENTRY* entry) {
+    struct inet_diag_msg* msg = (struct inet_diag_msg*)NLMSG_DATA(nlh);
+    struct tcp_info info;
+    struct tcp_bbr_info bbr;
+    BOOLEAN has_info = FALSE;
+
+    memset(&info, 0, sizeof(info));
+    memset(&bbr, 0, sizeof(bbr));
+    memset(entry, 0, sizeof(*entry));
+    entry->Timestamp = get_timestamp_ns();
+    entry->SourceAddr = diag_ipv4_addr(msg->idiag_family, msg->id.idiag_src);
+    entry->DestAddr = diag_ipv4_addr(msg->idiag_family, msg->id.idiag_dst);
+    entry->SourcePort = ntohs(msg->id.idiag_sport);
+    entry->DestPort = ntohs(msg->id.idiag_dport);
+
+    // 内核的 tcp_info 可能比头文件中的长或短，只复制双方都有的部分
+    int attr_len = (int)(nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*msg)));
+    for (struct rtattr* attr = (struct rtattr*)(msg + 1);
+         RTA_OK(attr, attr_len);
+         attr = RTA_NEXT(attr, attr_len)) {
+        size_t len = RTA_PAYLOAD(attr);
+        if (attr->rta_type == INET_DIAG_INFO) {
+            memcpy(&info, RTA_DATA(attr), len < sizeof(info) ? len : sizeof(info));
+            has_info = TRUE;
+        } else if (attr->rta_type == INET_DIAG_BBRINFO) {
+            memcpy(&bbr, RTA_DATA(attr), len < sizeof(bbr) ? len : sizeof(bbr));
+            entry->IsBBR = TRUE;
+        }
+    }
+
+    if (!has_info) {
+        logger->LastDetailLine[0] = '\0';
+        return;
+    }
+
+    entry->SndCwnd = info.tcpi_snd_cwnd;
+    entry->SndMss = info.tcpi_snd_mss;
+    entry->RttMs = info.tcpi_rtt / 1000.0;
+    entry->RttVarMs = info.tcpi_rttvar / 1000.0;
+    entry->PacketsInFlight =
+        info.tcpi_unacked - info.tcpi_sacked - info.tcpi_lost + info.tcpi_retrans;
+    entry->LostPackets = info.tcpi_lost;
+    entry->RetransSegs = info.tcpi_total_retrans;
+    entry->SackedSegs = info.tcpi_sacked;
+    if (info.tcpi_rtt > 0) {
+        // 与ss的 "send" 字段计算方式相同
+        entry->SendRateBps =
+            (double)info.tcpi_snd_cwnd * info.tcpi_snd_mss * 8000000.0 / info.tcpi_rtt;
+    }
+    entry->PacingRateBps = info.tcpi_pacing_rate * 8.0;
+    entry->DeliveryRateBps = info.tcpi_delivery_rate * 8.0;
+    entry->BytesSent = info.tcpi_bytes_sent;
+    entry->BytesAcked = info.tcpi_bytes_acked;
+    entry->BytesRetrans = info.tcpi_bytes_retrans;
+
+    int n = snprintf(
+        logger->LastDetailLine, sizeof(logger->LastDetailLine),
+        "rtt:%.3f/%.3f cwnd:%u retrans:%u/%u lost:%u sacked:%u unacked:%u "
+        "bytes_sent:%llu bytes_acked:%llu bytes_retrans:%llu "
+        "send %.0fbps pacing_rate %.0fbps delivery_rate %.0fbps",
+        entry->RttMs, entry->RttVarMs, entry->SndCwnd,
+        info.tcpi_retrans, entry->RetransSegs, entry->LostPackets,
+        entry->SackedSegs, info.tcpi_unacked,
+        (unsigned long long)entry->BytesSent,
+        (unsigned long long)entry->BytesAcked,
+        (unsigned long long)entry->BytesRetrans,
+        entry->SendRateBps, entry->PacingRateBps, entry->DeliveryRateBps);
+
+    if (entry->IsBBR) {
+        entry->BbrBandwidthBps =
+            (double)(((uint64_t)bbr.bbr_bw_hi << 32) | bbr.bbr_bw_lo) * 8.0;
+        entry->BbrMinRttMs = bbr.bbr_min_rtt / 1000.0;
+        entry->BbrPacingGain = bbr.bbr_pacing_gain / 256.0;
+        entry->BbrCwndGain = bbr.bbr_cwnd_gain / 256.0;
+        entry->BbrState =
+            infer_bbr_state(entry->BbrPacingGain, entry->SndCwnd, entry->BbrMinRttMs);
+        if (n > 0 && (size_t)n < sizeof(logger->LastDetailLine)) {
+            snprintf(
+                logger->LastDetailLine + n, sizeof(logger->LastDetailLine) - n,
+                " bbr:(bw:%.0fbps,mrtt:%.3f,pacing_gain:%.2f,cwnd_gain:%.2f)",
+                entry->BbrBandwidthBps, entry->BbrMinRttMs,
+                entry->BbrPacingGain, entry->BbrCwndGain);
+        }
+    }
+}
+
+// 通过 sock_diag 导出一个地址族中已建立的TCP连接，失败时返回FALSE以便回退到ss
+static BOOLEAN fetch_diag_family(TCP_SS_LOGGER* logger, uint8_t family) {
+    struct {
+        struct nlmsghdr nlh;
+        struct inet_diag_req_v2 req;
+    } request;
+
+    memset(&request, 0, sizeof(request));
+    request.nlh.nlmsg_len = sizeof(request);
+    request.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.req.sdiag_family = family;
+    request.req.sdiag_protocol = IPPROTO_TCP;
+    request.req.idiag_states = 1 << 1; // TCP_ESTABLISHED（内核状态编号）
+    // INET_DIAG_BBRINFO 超出了8位扩展掩码，BBR 通过 VEGASINFO 位返回其状态（与ss相同）
+    request.req.idiag_ext =
+        (1 << (INET_DIAG_INFO - 1)) | (1 << (INET_DIAG_VEGASINFO - 1));
+
+    if (send(logger->DiagSocket, &request, sizeof(request), 0) < 0) {
+        return FALSE;
+    }
+
+    // 仅由轮询线程使用
+    static uint8_t buffer[32768] __attribute__((aligned(NLMSG_ALIGNTO)));
+    for (;;) {
+        ssize_t len = recv(logger->DiagSocket, buffer, sizeof(buffer), 0);
+        if (len <= 0) {
+            return FALSE;
+        }
+
+        int remaining = (int)len;
+        for (struct nlmsghdr* nlh = (struct nlmsghdr*)buffer;
+             NLMSG_OK(nlh, remaining);
+             nlh = NLMSG_NEXT(nlh, remaining)) {
+            if (nlh->nlmsg_type == NLMSG_DONE) {
+                return TRUE;
+            }
+            if (nlh->nlmsg_type == NLMSG_ERROR) {
+                return FALSE;
+            }
+            if (nlh->nlmsg_type != SOCK_DIAG_BY_FAMILY ||
+                nlh->nlmsg_len < NLMSG_LENGTH(sizeof(struct inet_diag_msg))) {
+                continue;
+            }
+
+            // 只记录目标端口的连接
+            struct inet_diag_msg* msg = (struct inet_diag_msg*)NLMSG_DATA(nlh);
+            if (ntohs(msg->id.idiag_sport) != logger->TargetPort &&
+                ntohs(msg->id.idiag_dport) != logger->TargetPort) {
+                continue;
+            }
+
+            TCP_SS_LOG_ENTRY entry;
+            parse_diag_msg(logger, nlh, &entry);
+            if (entry.SourceAddr != 0 && entry.DestAddr != 0) {
+                record_log_entry(logger, &entry);
+            }
+        }
+    }
+}
+
+// 在进程内读取目标端口连接的 TCP_INFO，无需为每次采样启动ss进程，
+// 因此采样间隔可以低于1毫秒
+static BOOLEAN fetch_diag_data(TCP_SS_LOGGER* logger) {
+    if (!logger || !logger->Initialized) return FALSE;
+
+    if (!fetch_diag_family(logger, AF_INET) ||
+        !fetch_diag_family(logger, AF_INET6)) {
+        return FALSE;
+    }
+
+    // 定期检查不活动连接
+    static uint64_t last_check_time = 0;
+    uint64_t current_time = get_timestamp_ns();
+    if (current_time - last_check_time > 10000000000ULL) {
+        check_inactive_connections(logger, current_time, 30000000000ULL); // 30秒超时
+        last_check_time = current_time;
+    }
+    return TRUE;
+}
+
 // 执行ss命令并获取TCP统计信息
 static void fetch_ss_data(TCP_SS_LOGGER* logger) {
     if (!logger || !logger->Initialized) return;
@@ -574,6 +782,11 @@ static void fetch_ss_data(TCP_SS_LOGGER* logger) {
                 // printf("DEBUG: Parsed cwnd: %u\n", entry.SndCwnd);
             }
             
+            // 解析发送MSS（前导空格避免匹配 rcvmss/advmss）
+            if (strstr(line, " mss:") != NULL) {
+                sscanf(strstr(line, " mss:"), " mss:%u", &entry.SndMss);
+            }
+            
             // 解析重传
             if (strstr(line, "retrans:") != NULL) {
                 char retrans_current[32] = {0};
@@ -704,27 +917,7 @@ static void fetch_ss_data(TCP_SS_LOGGER* logger) {
                 //        entry.DestAddr & 0xFF,
                 //        entry.DestPort);
                 
-                CxPlatLockAcquire(&logger->Lock);
-                
-                // 记录日志条目
-                if (logger->Entries != NULL) {
-                    logger->Entries[logger->CurrentIndex] = entry;
-                    logger->CurrentIndex = (logger->CurrentIndex + 1) % logger->MaxEntries;
-                }
-                logger->TotalEntries++;
-                
-                CxPlatLockRelease(&logger->Lock);
-                
-                // 更新连接跟踪
-                update_connection_tracking(logger, &entry);
-                
-                // 写入日志文件
-                if (logger->LogFileHandle) {
-                    // printf("DEBUG: Writing to log file %p\n", logger->LogFileHandle);
-                    write_log_entry_to_file(logger, &entry);
-                } else {
-                    // printf("ERROR: Log file handle is NULL, cannot write entry\n");
-                }
+                record_log_entry(logger, &entry);
                 
                 // 控制台输出
                 if (0) { // 永远不执行
@@ -789,10 +982,12 @@ static void* polling_thread_func(void* arg) {
     TCP_SS_LOGGER* logger = (TCP_SS_LOGGER*)arg;
     
     while (logger->Running) {
-        fetch_ss_data(logger);
+        if (logger->DiagSocket < 0 || !fetch_diag_data(logger)) {
+            fetch_ss_data(logger);
+        }
         
         // 等待采样间隔
-        usleep(logger->SamplingIntervalMs * 1000);
+        usleep(logger->SamplingIntervalUs);
     }
     
     return NULL;
@@ -818,7 +1013,8 @@ TcpSsLoggerInitialize(
     memset(Logger, 0, sizeof(TCP_SS_LOGGER));
     Logger->MaxEntries = MaxLogEntries > 0 ? MaxLogEntries : 10000;
     Logger->TargetPort = TargetPort;
-    Logger->SamplingIntervalMs = 200; // 默认采样间隔200ms
+    Logger->SamplingIntervalUs = 200 * 1000; // 默认采样间隔200ms
+    Logger->DiagSocket = -1;
     Logger->DetailedLogging = TRUE;   // 默认启用详细日志
     Logger->EnableConsoleOutput = FALSE; // 默认禁用控制台输出
     Logger->LastDetailLine[0] = '\0';  // 确保详细行为空字符串
@@ -835,11 +1031,7 @@ TcpSsLoggerInitialize(
     memset(Logger->Entries, 0, Logger->MaxEntries * sizeof(TCP_SS_LOG_ENTRY));
     
     // 默认日志文件路径
-<<<<<<< HEAD
-    TcpSsLoggerSetLogFile(Logger, "/home/wuq/msquic_cellular/bbr_logs/tcp_bbr.txt");
-=======
     TcpSsLoggerSetLogFile(Logger, "/root/msquic/bbr_logs/tcp_bbr.txt");
->>>>>>> 4442ae5884e7ef61884edd67d235299ae2e3d327
     
     Logger->Initialized = TRUE;
     return QUIC_STATUS_SUCCESS;
@@ -893,9 +1085,19 @@ QUIC_STATUS TcpSsLoggerStart(_In_ TCP_SS_LOGGER* Logger) {
         fflush(Logger->LogFileHandle);
     }
     
+    // 优先通过 sock_diag 在进程内读取 TCP_INFO，失败时每次采样回退到 ss 命令
+    Logger->DiagSocket = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (Logger->DiagSocket < 0) {
+        printf("WARNING: sock_diag unavailable (errno: %d), falling back to ss\n", errno);
+    }
+    
     // 创建轮询线程
     if (pthread_create(&Logger->PollingThread, NULL, polling_thread_func, Logger) != 0) {
         Logger->Running = FALSE;
+        if (Logger->DiagSocket >= 0) {
+            close(Logger->DiagSocket);
+            Logger->DiagSocket = -1;
+        }
         return QUIC_STATUS_INTERNAL_ERROR;
     }
     
@@ -909,6 +1111,11 @@ void TcpSsLoggerStop(_In_ TCP_SS_LOGGER* Logger) {
     
     Logger->Running = FALSE;
     pthread_join(Logger->PollingThread, NULL);
+    
+    if (Logger->DiagSocket >= 0) {
+        close(Logger->DiagSocket);
+        Logger->DiagSocket = -1;
+    }
 }
 
 // 打印所有日志
@@ -918,6 +1125,9 @@ void TcpSsLoggerPrintAll(_In_ const TCP_SS_LOGGER* Logger) {
     
     printf("\n--- TCP SS Log (Total: %u events) ---\n", Logger->TotalEntries);
     
+    // 环形缓冲区未写满时最旧的条目在0处，写满后在 CurrentIndex 处
+    uint32_t oldest = Logger->TotalEntries > Logger->MaxEntries ? Logger->CurrentIndex : 0;
+    
     // 打印BBR事件统计
     uint32_t bbr_startup_events = 0;
     uint32_t bbr_drain_events = 0;
@@ -926,7 +1136,7 @@ void TcpSsLoggerPrintAll(_In_ const TCP_SS_LOGGER* Logger) {
     uint32_t bbr_unknown_events = 0;
     
     for (uint32_t i = 0; i < Logger->MaxEntries && i < Logger->TotalEntries; i++) {
-        uint32_t idx = (Logger->CurrentIndex + i) % Logger->MaxEntries;
+        uint32_t idx = (oldest + i) % Logger->MaxEntries;
         switch (Logger->Entries[idx].BbrState) {
             case TCP_BBR_STARTUP: bbr_startup_events++; break;
             case TCP_BBR_DRAIN: bbr_drain_events++; break;
@@ -948,7 +1158,7 @@ void TcpSsLoggerPrintAll(_In_ const TCP_SS_LOGGER* Logger) {
     uint32_t rtt_samples = 0;
     
     for (uint32_t i = 0; i < Logger->MaxEntries && i < Logger->TotalEntries; i++) {
-        uint32_t idx = (Logger->CurrentIndex + i) % Logger->MaxEntries;
+        uint32_t idx = (oldest + i) % Logger->MaxEntries;
         if (Logger->Entries[idx].RttMs > 0) {
             if (min_rtt == 0 || Logger->Entries[idx].RttMs < min_rtt) {
                 min_rtt = Logger->Entries[idx].RttMs;
@@ -977,7 +1187,7 @@ void TcpSsLoggerPrintAll(_In_ const TCP_SS_LOGGER* Logger) {
     uint64_t max_bytes_retrans = 0;
     
     for (uint32_t i = 0; i < Logger->MaxEntries && i < Logger->TotalEntries; i++) {
-        uint32_t idx = (Logger->CurrentIndex + i) % Logger->MaxEntries;
+        uint32_t idx = (oldest + i) % Logger->MaxEntries;
         if (Logger->Entries[idx].RetransSegs > 0) {
             retrans_events++;
             if (Logger->Entries[idx].RetransSegs > max_retrans) {
@@ -1006,7 +1216,46 @@ void TcpSsLoggerSetOutputOptions(
     if (!Logger) return;
     
     Logger->EnableConsoleOutput = EnableConsoleOutput;
-    Logger->SamplingIntervalMs = (SamplingInterval > 0) ? SamplingInterval : 200; // 最小为10ms
+    Logger->SamplingIntervalUs = ((SamplingInterval > 0) ? SamplingInterval : 200) * 1000;
+}
+
+// 设置微秒级采样间隔
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void TcpSsLoggerSetSamplingIntervalUs(
+    _In_ TCP_SS_LOGGER* Logger,
+    _In_ uint32_t SamplingIntervalUs
+    )
+{
+    if (!Logger) return;
+    
+    Logger->SamplingIntervalUs = (SamplingIntervalUs > 0) ? SamplingIntervalUs : 1;
+}
+
+// 复制日志条目（从旧到新）
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t TcpSsLoggerCopyEntries(
+    _In_ TCP_SS_LOGGER* Logger,
+    TCP_SS_LOG_ENTRY* Entries,
+    _In_ uint32_t MaxEntries
+    )
+{
+    if (!Logger || !Logger->Initialized || !Entries || !Logger->Entries) return 0;
+    
+    CxPlatLockAcquire(&Logger->Lock);
+    
+    uint32_t available =
+        Logger->TotalEntries < Logger->MaxEntries ? Logger->TotalEntries : Logger->MaxEntries;
+    uint32_t oldest = Logger->TotalEntries > Logger->MaxEntries ? Logger->CurrentIndex : 0;
+    
+    // 缓冲区不足时保留最新的条目
+    uint32_t count = available < MaxEntries ? available : MaxEntries;
+    uint32_t skip = available - count;
+    for (uint32_t i = 0; i < count; i++) {
+        Entries[i] = Logger->Entries[(oldest + skip + i) % Logger->MaxEntries];
+    }
+    
+    CxPlatLockRelease(&Logger->Lock);
+    return count;
 }
 
 // 设置日志文件
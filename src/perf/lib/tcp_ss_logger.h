@@ -5,7 +5,8 @@
 
 Abstract:
 
-    Public API for the TCP socket statistics logger using ss command.
+    Public API for the TCP socket statistics logger. Samples TCP_INFO over
+    sock_diag, falling back to the ss command.
 
 --*/
 
@@ -43,7 +44,8 @@ typedef struct TCP_SS_LOG_ENTRY {
     uint32_t DestAddr;           // 目标地址
     uint16_t SourcePort;         // 源端口
     uint16_t DestPort;           // 目标端口
-    uint32_t SndCwnd;            // 发送拥塞窗口
+    uint32_t SndCwnd;            // 发送拥塞窗口 (段)
+    uint32_t SndMss;             // 发送MSS (字节)
     double   RttMs;              // RTT (ms)
     double   RttVarMs;           // RTT 方差 (ms)
     uint32_t PacketsInFlight;    // 传输中的包数量
@@ -112,6 +114,20 @@ void TcpSsLoggerSetOutputOptions(
     _In_ uint32_t SamplingInterval
     );
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void TcpSsLoggerSetSamplingIntervalUs(
+    _In_ TCP_SS_LOGGER* Logger,
+    _In_ uint32_t SamplingIntervalUs
+    );
+
+// 按时间顺序（从旧到新）复制环形缓冲区中的日志条目，返回复制的条目数
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t TcpSsLoggerCopyEntries(
+    _In_ TCP_SS_LOGGER* Logger,
+    TCP_SS_LOG_ENTRY* Entries,
+    _In_ uint32_t MaxEntries
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void TcpSsLoggerSetLogFile(_In_ TCP_SS_LOGGER* Logger, _In_ const char* FilePath);
 
@@ -510,7 +510,8 @@ DataPathIsPaddingPreferred(
 QUIC_STATUS
 CxPlatSocketConfigureRss(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
-    _In_ uint32_t SocketCount
+    _In_ uint32_t SocketCount,
+    _In_opt_ const CXPLAT_UDP_CONFIG* Config
     )
 {
 #ifdef SO_ATTACH_REUSEPORT_CBPF
@@ -523,9 +524,59 @@ CxPlatSocketConfigureRss(
         {BPF_RET | BPF_A, 0, 0, 0} // Return
     };
 
+    //
+    // Steer short header packets by the partition ID the server encoded in its
+    // own CIDs, so that a connection's packets always land on the socket (and
+    // therefore the worker) owning the connection, even after the client's
+    // address changes (NAT rebinding or migration). Long header packets carry
+    // client chosen CIDs and fall back to the CPU based steering above.
+    //
+    // The partition index is only the index of the matching socket when there
+    // is one socket per partition. Otherwise, all packets use the CPU based
+    // steering.
+    //
+    // N.B. For reuseport programs the packet data starts at the UDP payload.
+    // The PID is written into the CID in host byte order.
+    //
+    const BOOLEAN CidSteering =
+        Config != NULL &&
+        Config->CidPartitionIdMask != 0 &&
+        Config->CidPartitionCount == SocketCount;
+    const uint32_t PidOffset = 1 + (CidSteering ? Config->CidPartitionIdOffset : 0); // Skip first byte
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const uint32_t PidLowOffset = PidOffset;
+    const uint32_t PidHighOffset = PidOffset + 1;
+#else
+    const uint32_t PidLowOffset = PidOffset + 1;
+    const uint32_t PidHighOffset = PidOffset;
+#endif
+
+    struct sock_filter CidBpfCode[] = {
+        {BPF_LD | BPF_W | BPF_LEN, 0, 0, 0}, // Load payload length
+        {BPF_JMP | BPF_JGE | BPF_K, 0, 10, PidOffset + 2}, // Too short for the 2 byte PID, use CPU
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, 0}, // Load first byte
+        {BPF_JMP | BPF_JSET | BPF_K, 8, 0, 0x80}, // Long header, use CPU
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, PidHighOffset}, // Load PID high byte
+        {BPF_ALU | BPF_LSH | BPF_K, 0, 0, 8},
+        {BPF_MISC | BPF_TAX, 0, 0, 0},
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, PidLowOffset}, // Load PID low byte
+        {BPF_ALU | BPF_OR | BPF_X, 0, 0, 0}, // Combine into the PID
+        {BPF_ALU | BPF_AND | BPF_K, 0, 0, CidSteering ? Config->CidPartitionIdMask : 0}, // Partition index bits
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, SocketCount}, // MOD by PartitionCount (== SocketCount)
+        {BPF_RET | BPF_A, 0, 0, 0}, // Return
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF | SKF_AD_CPU}, // Load CPU number
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, SocketCount}, // MOD by SocketCount
+        {BPF_RET | BPF_A, 0, 0, 0} // Return
+    };
+
     struct sock_fprog BpfConfig = {0};
-	BpfConfig.len = ARRAYSIZE(BpfCode);
-    BpfConfig.filter = BpfCode;
+    if (CidSteering) {
+        BpfConfig.len = ARRAYSIZE(CidBpfCode);
+        BpfConfig.filter = CidBpfCode;
+    } else {
+        BpfConfig.len = ARRAYSIZE(BpfCode);
+        BpfConfig.filter = BpfCode;
+    }
 
     Result =
         setsockopt(
@@ -548,6 +599,7 @@ CxPlatSocketConfigureRss(
 #else
     UNREFERENCED_PARAMETER(SocketContext);
     UNREFERENCED_PARAMETER(SocketCount);
+    UNREFERENCED_PARAMETER(Config);
     return QUIC_STATUS_NOT_SUPPORTED;
 #endif
 }
@@ -1344,7 +1396,7 @@ SocketCreateUdp(
         // round robin, but each flow will be sent to the same socket, just not
         // based on RSS.
         //
-        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount, Config);
     }
 
     CxPlatConvertFromMappedV6(&Binding->LocalAddress, &Binding->LocalAddress);
@@ -1640,7 +1692,7 @@ SocketCreateTcpListener(
     // than the default round-robin strategy, but it's good to keep TCP behavior
     // consistent with UDP.
     //
-    (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+    (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount, NULL);
 
     for (uint32_t i = 0; i < SocketCount; i++) {
         CxPlatSocketContextSetEvents(&Binding->SocketContexts[i], EPOLL_CTL_ADD, EPOLLIN);
@@ -97,6 +97,21 @@ struct UdpRecvContext {
     }
 };
 
+struct UdpCidSteeringContext {
+    uint32_t SocketCount;
+    uint32_t PartitionCount;
+    long Received {0};
+    long Mismatched {0};
+    long ExpectedCount {0};
+    CXPLAT_EVENT AllReceived;
+    UdpCidSteeringContext() {
+        CxPlatEventInitialize(&AllReceived, TRUE, FALSE);
+    }
+    ~UdpCidSteeringContext() {
+        CxPlatEventUninitialize(AllReceived);
+    }
+};
+
 struct TcpClientContext {
     bool Connected : 1;
     bool Disconnected : 1;
@@ -333,6 +348,30 @@ protected:
         CxPlatRecvDataReturn(RecvDataChain);
     }
 
+    static void
+    UdpCidSteeringRecvCallback(
+        _In_ CXPLAT_SOCKET* /* Socket */,
+        _In_ void* Context,
+        _In_ CXPLAT_RECV_DATA* RecvDataChain
+        )
+    {
+        UdpCidSteeringContext* SteeringContext = (UdpCidSteeringContext*)Context;
+        for (CXPLAT_RECV_DATA* RecvData = RecvDataChain; RecvData != NULL; RecvData = RecvData->Next) {
+            //
+            // The last byte is the socket the packet's PID selects, and socket
+            // i is on partition i % PartitionCount.
+            //
+            const uint8_t Socket = RecvData->Buffer[RecvData->BufferLength - 1];
+            if (RecvData->PartitionIndex != Socket % SteeringContext->PartitionCount) {
+                InterlockedIncrement(&SteeringContext->Mismatched);
+            }
+            if (InterlockedIncrement(&SteeringContext->Received) == SteeringContext->ExpectedCount) {
+                CxPlatEventSet(SteeringContext->AllReceived);
+            }
+        }
+        CxPlatRecvDataReturn(RecvDataChain);
+    }
+
     static QUIC_STATUS
     EmptyAcceptCallback(
         _In_ CXPLAT_SOCKET* /* ListenerSocket */,
@@ -427,6 +466,11 @@ protected:
         EmptyUnreachableCallback,
     };
 
+    const CXPLAT_UDP_DATAPATH_CALLBACKS UdpCidSteeringCallbacks = {
+        UdpCidSteeringRecvCallback,
+        EmptyUnreachableCallback,
+    };
+
     const CXPLAT_TCP_DATAPATH_CALLBACKS EmptyTcpCallbacks = {
         EmptyAcceptCallback,
         EmptyConnectCallback,
@@ -1083,6 +1127,66 @@ TEST_P(DataPathTest, MultiBindListenerSingleProcessor) {
     ASSERT_EQ(QUIC_STATUS_ADDRESS_IN_USE, Server2.GetInitStatus());
 }
 
+#ifdef __linux__
+TEST_P(DataPathTest, UdpCidSteering)
+{
+    UdpCidSteeringContext Context;
+    CxPlatDataPath Datapath(&UdpCidSteeringCallbacks);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    Context.SocketCount = CxPlatProcCount();
+    Context.PartitionCount = CxPlatWorkerPoolGetCount(Datapath.WorkerPool);
+    if (Context.PartitionCount < 2) {
+        GTEST_SKIP_("Server sockets aren't per processor");
+    }
+
+    const uint8_t PidOffset = 2;
+    const uint16_t PidMask = 0xFF;
+
+    auto unspecAddress = GetNewUnspecAddr();
+    CxPlatSocket Server;
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = &unspecAddress.SockAddr;
+    UdpConfig.CallbackContext = &Context;
+    UdpConfig.CidPartitionIdOffset = PidOffset;
+    UdpConfig.CidPartitionIdMask = PidMask;
+    UdpConfig.CidPartitionCount = (uint16_t)Context.SocketCount;
+    Server.InitStatus = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server.Socket);
+    while (Server.InitStatus == QUIC_STATUS_ADDRESS_IN_USE) {
+        unspecAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.InitStatus = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server.Socket);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+    CxPlatSocketGetLocalAddress(Server, &Server.Route.LocalAddress);
+
+    auto serverAddress = GetNewLocalAddr();
+    serverAddress.SockAddr.Ipv4.sin_port = Server.Route.LocalAddress.Ipv4.sin_port;
+    CxPlatSocket Client(Datapath, nullptr, &serverAddress.SockAddr, &Context);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+    //
+    // Send a short header packet for each socket, from the same client address,
+    // with bits outside the mask set in the PID.
+    //
+    Context.ExpectedCount = (long)(2 * Context.SocketCount);
+    for (uint32_t i = 0; i < 2 * Context.SocketCount; ++i) {
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+        ASSERT_NE(nullptr, ClientSendData);
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, 32);
+        ASSERT_NE(nullptr, ClientBuffer);
+        CxPlatZeroMemory(ClientBuffer->Buffer, 32);
+        ClientBuffer->Buffer[0] = 0x40;
+        const uint16_t Pid = (uint16_t)(0xAB00 | i);
+        CxPlatCopyMemory(ClientBuffer->Buffer + 1 + PidOffset, &Pid, sizeof(Pid));
+        ClientBuffer->Buffer[31] = (uint8_t)((Pid & PidMask) % Context.SocketCount);
+        Client.Send(ClientSendData);
+    }
+
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(Context.AllReceived, 2000));
+    ASSERT_EQ(0, Context.Mismatched);
+}
+#endif
+
 TEST_F(DataPathTest, TcpListener)
 {
     CxPlatDataPath Datapath(nullptr, &EmptyTcpCallbacks);
@@ -214,3 +214,72 @@ TEST(PlatformTest, EventQueueWorker)
 
     CxPlatEventQCleanup(&queue);
 }
+
+TEST(PlatformTest, PoolCrossThreadFree)
+{
+    struct PoolContext {
+        CXPLAT_POOL* Pool;
+        void* volatile* Slots;
+        uint32_t SlotCount;
+        uint32_t Rounds;
+        bool Failed;
+        //
+        // Frees whatever the main thread has put in the slots, so most frees
+        // happen on a different thread than the allocation.
+        //
+        static CXPLAT_THREAD_CALLBACK(FreeCallback, Context) {
+            auto ctx = (PoolContext*)Context;
+            for (uint32_t Freed = 0; Freed < ctx->SlotCount * ctx->Rounds;) {
+                for (uint32_t i = 0; i < ctx->SlotCount; ++i) {
+                    void* Memory = InterlockedExchangePointer(&ctx->Slots[i], NULL);
+                    if (Memory != NULL) {
+                        if (*(uint32_t*)Memory != i) {
+                            ctx->Failed = true;
+                        }
+                        CxPlatPoolFree(Memory);
+                        Freed++;
+                    }
+                }
+            }
+            CXPLAT_THREAD_RETURN(0);
+        }
+    };
+
+    const uint32_t SlotCount = 64;
+    const uint32_t Rounds = 100;
+    void* volatile Slots[SlotCount] = { 0 };
+
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, sizeof(uint64_t), QUIC_POOL_TEST, &Pool);
+
+    PoolContext context = { &Pool, Slots, SlotCount, Rounds, false };
+    CXPLAT_THREAD_CONFIG config = { 0, 0, NULL, PoolContext::FreeCallback, &context };
+    CXPLAT_THREAD thread;
+    ASSERT_TRUE(QUIC_SUCCEEDED(CxPlatThreadCreate(&config, &thread)));
+
+    for (uint32_t Round = 0; Round < Rounds; ++Round) {
+        for (uint32_t i = 0; i < SlotCount; ++i) {
+            void* Memory = CxPlatPoolAlloc(&Pool);
+            ASSERT_NE(nullptr, Memory);
+            *(uint32_t*)Memory = i;
+            while (InterlockedCompareExchangePointer(&Slots[i], Memory, NULL) != NULL) {
+                CxPlatSchedulerYield();
+            }
+        }
+    }
+
+    CxPlatThreadWait(&thread);
+    CxPlatThreadDelete(&thread);
+    ASSERT_FALSE(context.Failed);
+
+    //
+    // Everything freed above is cached, and pruning releases all of it.
+    //
+    void* Memory = CxPlatPoolAlloc(&Pool);
+    ASSERT_NE(nullptr, Memory);
+    CxPlatPoolFree(Memory);
+    while (CxPlatPoolPrune(&Pool)) { }
+    ASSERT_FALSE(CxPlatPoolPrune(&Pool));
+
+    CxPlatPoolUninitialize(&Pool);
+}
@@ -68,6 +68,9 @@ typedef union QUIC_STREAM_FLAGS {
         BOOLEAN SendDelayed             : 1;    // A delayed send is currently queued.
         BOOLEAN CancelOnLoss            : 1;    // Indicates that the stream is to be canceled
                                                 // if loss is detected.
+        BOOLEAN SendExpiring            : 1;    // Sends with an expiry time have been queued.
+        BOOLEAN SendExpired             : 1;    // The send path was reset because a send expired.
+        BOOLEAN SendFileReadFailed      : 1;    // The send path is being reset because a file read failed.
 
         BOOLEAN HandleSendShutdown      : 1;    // Send shutdown complete callback delivered.
         BOOLEAN HandleShutdown          : 1;    // Shutdown callback delivered.
@@ -190,12 +193,6 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN TestTransportParameterSet : 1;
 
-        //
-        // Indicates the connection is using the round robin stream scheduling
-        // scheme.
-        //
-        BOOLEAN UseRoundRobinStreamScheduling : 1;
-
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -396,6 +396,11 @@ QuicTestNatAddrRebind(
     _In_ bool RebindDatapathAddr
     );
 
+void
+QuicTestNatAddrRebindBack(
+    _In_ int Family
+    );
+
 void
 QuicTestPathValidationTimeout(
     _In_ int Family
@@ -443,6 +448,11 @@ QuicTestConnectAndIdleForDestCidChange(
     void
     );
 
+void
+QuicTestConnectAndHibernate(
+    void
+    );
+
 void
 QuicTestServerDisconnect(
     void
@@ -576,6 +586,24 @@ void
 QuicTestStreamPriorityInfiniteLoop(
     );
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+void
+QuicTestStreamSchedulingWeightedFair(
+    );
+
+void
+QuicTestStreamSchedulingDeadline(
+    );
+
+void
+QuicTestStreamSchedulingFlowControlBlocked(
+    );
+
+void
+QuicTestStreamSendBatch(
+    );
+#endif
+
 void
 QuicTestStreamDifferentAbortErrors(
     );
@@ -596,6 +624,26 @@ void
 QuicTestStreamReliableResetMultipleSends(
     );
 
+void
+QuicTestStreamSendExpiry(
+    );
+
+void
+QuicTestStreamSendExpiryReliableReset(
+    );
+
+void
+QuicTestStreamSendNoCopy(
+    );
+
+void
+QuicTestStreamSendFile(
+    );
+
+void
+QuicTestStreamSendFileReadFailure(
+    );
+
 void
 QuicTestStreamMultiReceive(
     );
@@ -678,6 +726,16 @@ QuicTestDatagramDrop(
     _In_ int Family
     );
 
+void
+QuicTestDatagramPriority(
+    _In_ int Family
+    );
+
+void
+QuicTestDatagramReplace(
+    _In_ int Family
+    );
+
 //
 // Storage tests
 //
@@ -1403,4 +1461,40 @@ struct QUIC_RUN_CONNECTION_POOL_CREATE_PARAMS {
 #define IOCTL_QUIC_RUN_VALIDATE_CONNECTION_POOL_CREATE \
     QUIC_CTL_CODE(133, METHOD_BUFFERED, FILE_WRITE_DATA)
 
-#define QUIC_MAX_IOCTL_FUNC_CODE 133
+#define IOCTL_QUIC_RUN_STREAM_SCHEDULING_WEIGHTED_FAIR \
+    QUIC_CTL_CODE(134, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_STREAM_SCHEDULING_DEADLINE \
+    QUIC_CTL_CODE(135, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_STREAM_SEND_EXPIRY \
+    QUIC_CTL_CODE(136, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_STREAM_SEND_EXPIRY_RELIABLE_RESET \
+    QUIC_CTL_CODE(137, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_NAT_ADDR_REBIND_BACK \
+    QUIC_CTL_CODE(138, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_CONNECT_AND_HIBERNATE \
+    QUIC_CTL_CODE(139, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_STREAM_SEND_NO_COPY \
+    QUIC_CTL_CODE(140, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_DATAGRAM_PRIORITY \
+    QUIC_CTL_CODE(141, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_DATAGRAM_REPLACE \
+    QUIC_CTL_CODE(142, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_STREAM_SCHEDULING_FLOW_CONTROL_BLOCKED \
+    QUIC_CTL_CODE(143, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_STREAM_SEND_BATCH \
+    QUIC_CTL_CODE(144, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define QUIC_MAX_IOCTL_FUNC_CODE 144
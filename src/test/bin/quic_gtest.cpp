@@ -1649,6 +1649,23 @@ TEST_P(WithFamilyArgs, RebindAddr) {
     }
 }
 
+TEST_P(WithFamilyArgs, RebindAddrBack) {
+#if defined(QUIC_API_ENABLE_PREVIEW_FEATURES)
+    if (UseQTIP) {
+        //
+        // NAT rebind doesn't make sense for TCP and QTIP.
+        //
+        return;
+    }
+#endif
+    TestLoggerT<ParamType> Logger("QuicTestNatAddrRebindBack", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_NAT_ADDR_REBIND_BACK, GetParam().Family));
+    } else {
+        QuicTestNatAddrRebindBack(GetParam().Family);
+    }
+}
+
 TEST_P(WithFamilyArgs, RebindDatapathAddr) {
 #if defined(QUIC_API_ENABLE_PREVIEW_FEATURES)
     if (UseQTIP || !UseDuoNic) {
@@ -2032,6 +2049,15 @@ TEST(Misc, IdleDestCidChange) {
     }
 }
 
+TEST(Misc, Hibernate) {
+    TestLogger Logger("QuicTestConnectAndHibernate");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_CONNECT_AND_HIBERNATE));
+    } else {
+        QuicTestConnectAndHibernate();
+    }
+}
+
 TEST(Misc, ServerDisconnect) {
     TestLogger Logger("QuicTestServerDisconnect");
     if (TestingKernelMode) {
@@ -2270,6 +2296,44 @@ TEST(Misc, StreamPriorityInfiniteLoop) {
     }
 }
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+TEST(Misc, StreamSchedulingWeightedFair) {
+    TestLogger Logger("StreamSchedulingWeightedFair");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SCHEDULING_WEIGHTED_FAIR));
+    } else {
+        QuicTestStreamSchedulingWeightedFair();
+    }
+}
+
+TEST(Misc, StreamSchedulingDeadline) {
+    TestLogger Logger("StreamSchedulingDeadline");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SCHEDULING_DEADLINE));
+    } else {
+        QuicTestStreamSchedulingDeadline();
+    }
+}
+
+TEST(Misc, StreamSchedulingFlowControlBlocked) {
+    TestLogger Logger("StreamSchedulingFlowControlBlocked");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SCHEDULING_FLOW_CONTROL_BLOCKED));
+    } else {
+        QuicTestStreamSchedulingFlowControlBlocked();
+    }
+}
+
+TEST(Misc, StreamSendBatch) {
+    TestLogger Logger("StreamSendBatch");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SEND_BATCH));
+    } else {
+        QuicTestStreamSendBatch();
+    }
+}
+#endif
+
 TEST(Misc, StreamDifferentAbortErrors) {
     TestLogger Logger("StreamDifferentAbortErrors");
     if (TestingKernelMode) {
@@ -2317,7 +2381,56 @@ TEST(Misc, StreamReliableResetMultipleSends) {
 }
 #endif // QUIC_PARAM_STREAM_RELIABLE_OFFSET
 
+#if QUIC_TEST_DATAPATH_HOOKS_ENABLED
+#ifdef QUIC_PARAM_STREAM_SEND_EXPIRY
+TEST(Misc, StreamSendExpiry) {
+    TestLogger Logger("StreamSendExpiry");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SEND_EXPIRY));
+    } else {
+        QuicTestStreamSendExpiry();
+    }
+}
+
+TEST(Misc, StreamSendExpiryReliableReset) {
+    TestLogger Logger("StreamSendExpiryReliableReset");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SEND_EXPIRY_RELIABLE_RESET));
+    } else {
+        QuicTestStreamSendExpiryReliableReset();
+    }
+}
+#endif // QUIC_PARAM_STREAM_SEND_EXPIRY
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+TEST(Misc, StreamSendNoCopy) {
+    TestLogger Logger("StreamSendNoCopy");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SEND_NO_COPY));
+    } else {
+        QuicTestStreamSendNoCopy();
+    }
+}
+#endif // QUIC_API_ENABLE_PREVIEW_FEATURES
+#endif // QUIC_TEST_DATAPATH_HOOKS_ENABLED
+
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+TEST(Misc, StreamSendFile) {
+    TestLogger Logger("StreamSendFile");
+    if (TestingKernelMode) {
+        GTEST_SKIP_("StreamSendFile is not supported in kernel mode");
+    }
+    QuicTestStreamSendFile();
+}
+
+TEST(Misc, StreamSendFileReadFailure) {
+    TestLogger Logger("StreamSendFileReadFailure");
+    if (TestingKernelMode) {
+        GTEST_SKIP_("StreamSendFile is not supported in kernel mode");
+    }
+    QuicTestStreamSendFileReadFailure();
+}
+
 TEST(Misc, StreamMultiReceive) {
     TestLogger Logger("StreamMultiReceive");
     if (TestingKernelMode) {
@@ -2471,6 +2584,24 @@ TEST_P(WithFamilyArgs, DatagramDrop) {
     }
 }
 
+TEST_P(WithFamilyArgs, DatagramPriority) {
+    TestLoggerT<ParamType> Logger("QuicTestDatagramPriority", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_DATAGRAM_PRIORITY, GetParam().Family));
+    } else {
+        QuicTestDatagramPriority(GetParam().Family);
+    }
+}
+
+TEST_P(WithFamilyArgs, DatagramReplace) {
+    TestLoggerT<ParamType> Logger("QuicTestDatagramReplace", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_DATAGRAM_REPLACE, GetParam().Family));
+    } else {
+        QuicTestDatagramReplace(GetParam().Family);
+    }
+}
+
 #ifdef _WIN32 // Storage tests only supported on Windows
 
 static BOOLEAN CanRunStorageTests = FALSE;
@@ -532,6 +532,17 @@ size_t QUIC_IOCTL_BUFFER_SIZES[] =
     sizeof(INT32),
     sizeof(QUIC_RUN_CONNECTION_POOL_CREATE_PARAMS),
     0,
+    0,
+    0,
+    0,
+    0,
+    sizeof(INT32),
+    0,
+    0,
+    sizeof(INT32),
+    sizeof(INT32),
+    0,
+    0,
 };
 
 CXPLAT_STATIC_ASSERT(
@@ -968,6 +979,20 @@ QuicTestCtlEvtIoDeviceControl(
                 Params->Family));
         break;
 
+    case IOCTL_QUIC_RUN_DATAGRAM_PRIORITY:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestDatagramPriority(
+                Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_DATAGRAM_REPLACE:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestDatagramReplace(
+                Params->Family));
+        break;
+
     case IOCTL_QUIC_RUN_NAT_PORT_REBIND:
         CXPLAT_FRE_ASSERT(Params != nullptr);
         QuicTestCtlRun(
@@ -985,6 +1010,17 @@ QuicTestCtlEvtIoDeviceControl(
                 FALSE));
         break;
 
+    case IOCTL_QUIC_RUN_NAT_ADDR_REBIND_BACK:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestNatAddrRebindBack(
+                Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_CONNECT_AND_HIBERNATE:
+        QuicTestCtlRun(QuicTestConnectAndHibernate());
+        break;
+
     case IOCTL_QUIC_RUN_CHANGE_MAX_STREAM_ID:
         CXPLAT_FRE_ASSERT(Params != nullptr);
         QuicTestCtlRun(
@@ -1456,6 +1492,34 @@ QuicTestCtlEvtIoDeviceControl(
     case IOCTL_QUIC_RUN_STREAM_RELIABLE_RESET_MULTIPLE_SENDS:
         QuicTestCtlRun(QuicTestStreamReliableResetMultipleSends());
         break;
+
+    case IOCTL_QUIC_RUN_STREAM_SCHEDULING_WEIGHTED_FAIR:
+        QuicTestCtlRun(QuicTestStreamSchedulingWeightedFair());
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_SCHEDULING_DEADLINE:
+        QuicTestCtlRun(QuicTestStreamSchedulingDeadline());
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_SCHEDULING_FLOW_CONTROL_BLOCKED:
+        QuicTestCtlRun(QuicTestStreamSchedulingFlowControlBlocked());
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_SEND_BATCH:
+        QuicTestCtlRun(QuicTestStreamSendBatch());
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_SEND_EXPIRY:
+        QuicTestCtlRun(QuicTestStreamSendExpiry());
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_SEND_EXPIRY_RELIABLE_RESET:
+        QuicTestCtlRun(QuicTestStreamSendExpiryReliableReset());
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_SEND_NO_COPY:
+        QuicTestCtlRun(QuicTestStreamSendNoCopy());
+        break;
 #endif
 
     case IOCTL_QUIC_RUN_STATELESS_RESET_KEY:
@@ -937,6 +937,25 @@ void QuicTestValidateConnection()
                 0,
                 QUIC_SEND_FLAG_NONE,
                 nullptr));
+
+        QUIC_DATAGRAM_SEND_BATCH_ENTRY Entries[] = {
+            { &DatagramBuffer, 1, QUIC_SEND_FLAG_NONE, nullptr },
+            { &DatagramBuffer, 0, QUIC_SEND_FLAG_NONE, nullptr }
+        };
+
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->DatagramSendBatch(
+                Connection.Handle,
+                Entries,
+                0));
+
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->DatagramSendBatch(
+                Connection.Handle,
+                Entries,
+                ARRAYSIZE(Entries)));
     }
 
     //
@@ -962,6 +981,18 @@ void QuicTestValidateConnection()
                 1,
                 QUIC_SEND_FLAG_NONE,
                 nullptr));
+
+        QUIC_DATAGRAM_SEND_BATCH_ENTRY Entries[] = {
+            { &DatagramBuffer, 1, QUIC_SEND_FLAG_NONE, nullptr, 0, 0 },
+            { &DatagramBuffer, 1, QUIC_SEND_FLAG_NONE, nullptr, 1, 7 },
+            { &DatagramBuffer, 1, QUIC_SEND_FLAG_NONE, nullptr, 1, 7 } // Replaces the previous one
+        };
+
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->DatagramSendBatch(
+                Connection.Handle,
+                Entries,
+                ARRAYSIZE(Entries)));
     }
 
     //
@@ -1516,6 +1547,35 @@ void QuicTestValidateStream(bool Connect)
                     QUIC_SEND_FLAG_NONE,
                     nullptr));
 
+#ifndef _KERNEL_MODE
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->StreamSendFile(
+                    nullptr,
+                    QUIC_FILE{},
+                    0,
+                    1,
+                    QUIC_SEND_FLAG_NONE,
+                    nullptr));
+#endif
+
+            //
+            // Invalid batch sends.
+            //
+            {
+                QUIC_STREAM_SEND_BATCH_ENTRY Entry = {
+                    nullptr, Buffers, ARRAYSIZE(Buffers), QUIC_SEND_FLAG_NONE, nullptr, QUIC_STATUS_SUCCESS };
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamSendBatch(nullptr, &Entry, 1));
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamSendBatch(Client.GetConnection(), nullptr, 1));
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamSendBatch(Client.GetConnection(), &Entry, 1));
+            }
+
             //
             // Never started (close).
             //
@@ -2346,6 +2406,95 @@ void QuicTestGlobalParam()
         }
     }
 
+    //
+    // QUIC_PARAM_GLOBAL_PERF_HISTOGRAMS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_PERF_HISTOGRAMS");
+        {
+            TestScopeLogger LogScope1("SetParam");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PERF_HISTOGRAMS,
+                    0,
+                    nullptr));
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(
+                nullptr,
+                QUIC_PARAM_GLOBAL_PERF_HISTOGRAMS,
+                QUIC_PERF_HISTOGRAM_MAX * QUIC_PERF_HISTOGRAM_BUCKET_COUNT * sizeof(int64_t),
+                nullptr,
+                true);
+
+            //
+            // Truncate length case
+            //
+            {
+                TestScopeLogger LogScope2("Truncate length case");
+                int64_t ActualBuffer[QUIC_PERF_HISTOGRAM_BUCKET_COUNT] = {};
+                uint32_t Length = sizeof(ActualBuffer) + 4;
+
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_PERF_HISTOGRAMS,
+                        &Length,
+                        ActualBuffer));
+                TEST_EQUAL(Length, sizeof(ActualBuffer));
+            }
+        }
+    }
+
+    //
+    // QUIC_PARAM_GLOBAL_PROFILE
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_PROFILE");
+        {
+            TestScopeLogger LogScope1("SetParam");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PROFILE,
+                    0,
+                    nullptr));
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PROFILE,
+                    &Length,
+                    nullptr));
+            TEST_NOT_EQUAL(Length, 0u);
+            TEST_EQUAL(Length % sizeof(QUIC_PROFILE_ENTRY), 0u);
+
+            //
+            // Truncate length case
+            //
+            QUIC_PROFILE_ENTRY ActualBuffer[2] = {};
+            Length = sizeof(ActualBuffer) + 4;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PROFILE,
+                    &Length,
+                    ActualBuffer));
+            TEST_EQUAL(Length, sizeof(ActualBuffer));
+            TEST_NOT_EQUAL(ActualBuffer[0].Name[0], '\0');
+        }
+    }
+
     //
     // QUIC_PARAM_GLOBAL_LIBRARY_VERSION
     //
@@ -2796,7 +2945,9 @@ void QuicTestGlobalParam()
             QUIC_STATISTICS_V2_SIZE_1,
             QUIC_STATISTICS_V2_SIZE_2,
             QUIC_STATISTICS_V2_SIZE_3,
-            QUIC_STATISTICS_V2_SIZE_4
+            QUIC_STATISTICS_V2_SIZE_4,
+            QUIC_STATISTICS_V2_SIZE_5,
+            QUIC_STATISTICS_V2_SIZE_6
         };
 
         //
@@ -4817,6 +4968,155 @@ void QuicTest_QUIC_PARAM_CONN_SEND_DSCP(MsQuicRegistration& Registration)
     }
 }
 
+void QuicTest_QUIC_PARAM_CONN_TELEMETRY(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_TELEMETRY");
+    {
+        TestScopeLogger LogScope1("SetParam null buffer");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint32_t Dummy = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_TELEMETRY_INTERVAL,
+                sizeof(Dummy),
+                nullptr));
+    }
+    {
+        TestScopeLogger LogScope1("GetParam Default");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint32_t Interval = 0;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_TELEMETRY_INTERVAL, sizeof(Interval), &Interval);
+
+        QUIC_CONN_TELEMETRY Telemetry = {};
+        uint32_t BufferSize = sizeof(Telemetry);
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_STATE,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_TELEMETRY,
+                &BufferSize,
+                &Telemetry));
+    }
+    {
+        TestScopeLogger LogScope1("Enable and read");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint32_t Interval = 10;
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_TELEMETRY_INTERVAL,
+                sizeof(Interval),
+                &Interval));
+        uint32_t GetValue = 0;
+        uint32_t BufferSize = sizeof(GetValue);
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_TELEMETRY_INTERVAL,
+                &BufferSize,
+                &GetValue));
+        TEST_EQUAL(GetValue, Interval);
+
+        BufferSize = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_BUFFER_TOO_SMALL,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_TELEMETRY,
+                &BufferSize,
+                nullptr));
+        TEST_EQUAL(BufferSize, sizeof(QUIC_CONN_TELEMETRY));
+
+        QUIC_CONN_TELEMETRY Telemetry = {};
+        BufferSize = sizeof(Telemetry);
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_TELEMETRY,
+                &BufferSize,
+                &Telemetry));
+        TEST_EQUAL(BufferSize, sizeof(Telemetry));
+        TEST_EQUAL(Telemetry.SampleCount, 0u);
+        TEST_EQUAL(Telemetry.DroppedCount, 0u);
+        TEST_EQUAL(Telemetry.Cursor, 0u);
+
+        Interval = 0;
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_TELEMETRY_INTERVAL,
+                sizeof(Interval),
+                &Interval));
+        BufferSize = sizeof(Telemetry);
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_STATE,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_TELEMETRY,
+                &BufferSize,
+                &Telemetry));
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_ARENA_STATISTICS(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_ARENA_STATISTICS");
+    {
+        TestScopeLogger LogScope1("SetParam invalid slab size");
+        uint32_t SlabSize = 1;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE,
+                sizeof(SlabSize),
+                &SlabSize));
+    }
+    {
+        TestScopeLogger LogScope1("GetParam Default");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        QUIC_CONN_ARENA_STATISTICS Stats;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_ARENA_STATISTICS, sizeof(Stats), nullptr);
+        uint32_t BufferSize = sizeof(Stats);
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_ARENA_STATISTICS,
+                &BufferSize,
+                &Stats));
+        TEST_EQUAL(Stats.SlabCount, 0u);
+        TEST_NOT_EQUAL(Stats.HeapBytes, 0u); // The client's initial destination CID.
+    }
+    {
+        TestScopeLogger LogScope1("Arena enabled");
+        uint32_t SlabSize = 1024;
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE,
+                sizeof(SlabSize),
+                &SlabSize));
+        MsQuicConnection Connection(Registration);
+        SlabSize = 0;
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_CONN_ARENA_SLAB_SIZE,
+                sizeof(SlabSize),
+                &SlabSize));
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+        QUIC_CONN_ARENA_STATISTICS Stats;
+        uint32_t BufferSize = sizeof(Stats);
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_ARENA_STATISTICS,
+                &BufferSize,
+                &Stats));
+        TEST_EQUAL(Stats.SlabCount, 1u);
+        TEST_NOT_EQUAL(Stats.UsedBytes, 0u);
+        TEST_TRUE(Stats.SlabBytes > Stats.UsedBytes);
+        TEST_EQUAL(Stats.HeapBytes, 0u);
+    }
+}
+
 void QuicTestConnectionParam()
 {
     MsQuicAlpn Alpn("MsQuicTest");
@@ -4851,6 +5151,8 @@ void QuicTestConnectionParam()
     QuicTest_QUIC_PARAM_CONN_STATISTICS_V2_PLAT(Registration);
     QuicTest_QUIC_PARAM_CONN_ORIG_DEST_CID(Registration, ClientConfiguration);
     QuicTest_QUIC_PARAM_CONN_SEND_DSCP(Registration);
+    QuicTest_QUIC_PARAM_CONN_TELEMETRY(Registration);
+    QuicTest_QUIC_PARAM_CONN_ARENA_STATISTICS(Registration);
 }
 
 //
@@ -5580,6 +5882,62 @@ void QuicTestStreamParam()
         }
     }
 #endif // QUIC_PARAM_STREAM_RELIABLE_OFFSET
+
+#ifdef QUIC_PARAM_STREAM_SCHEDULING_DEADLINE
+    //
+    // QUIC_PARAM_STREAM_SCHEDULING_DEADLINE
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_STREAM_SCHEDULING_DEADLINE");
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_NONE);
+        uint64_t Expected = 5000;
+        //
+        // SetParam
+        //
+        {
+            TestScopeLogger LogScope1("SetParam");
+            uint32_t Invalid = 1;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_SCHEDULING_DEADLINE,
+                    sizeof(Invalid),
+                    &Invalid));
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_SCHEDULING_DEADLINE,
+                    sizeof(Expected),
+                    &Expected));
+        }
+
+        //
+        // GetParam
+        //
+        {
+            TestScopeLogger LogScope1("GetParam");
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                MsQuic->GetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_SCHEDULING_DEADLINE,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(uint64_t));
+
+            uint64_t Deadline = 0;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_SCHEDULING_DEADLINE,
+                    &Length,
+                    &Deadline));
+            TEST_EQUAL(Deadline, Expected);
+        }
+    }
+#endif // QUIC_PARAM_STREAM_SCHEDULING_DEADLINE
 }
 
 void
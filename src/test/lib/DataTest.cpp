@@ -3145,6 +3145,219 @@ QuicTestStreamPriorityInfiniteLoop(
     TEST_TRUE(Context.AllReceivesComplete.WaitTimeout(TestWaitTimeout));
 }
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+void
+QuicTestStreamSchedulingWeightedFair(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(3), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamPriorityTestContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamPriorityTestContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+    QUIC_STREAM_SCHEDULING_SCHEME Value = QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR;
+    TEST_QUIC_SUCCEEDED(Connection.SetParam(QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, sizeof(Value), &Value));
+
+    uint8_t RawBuffer[100];
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    //
+    // Each stream fits in a single packet, so the one with the highest weight
+    // (smallest virtual finish time) is sent first.
+    //
+    MsQuicStream Stream1(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream1.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream1.SetPriority(0));
+    TEST_QUIC_SUCCEEDED(Stream1.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    MsQuicStream Stream2(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream2.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream2.SetPriority(0xFFFF));
+    TEST_QUIC_SUCCEEDED(Stream2.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    MsQuicStream Stream3(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream3.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream3.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    TEST_TRUE(Context.AllReceivesComplete.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.ReceiveEvents[0] == Stream2.ID());
+    TEST_TRUE(Context.ReceiveEvents[1] == Stream3.ID());
+    TEST_TRUE(Context.ReceiveEvents[2] == Stream1.ID());
+}
+
+void
+QuicTestStreamSchedulingDeadline(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(3), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamPriorityTestContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamPriorityTestContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+    QUIC_STREAM_SCHEDULING_SCHEME Value = QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE;
+    TEST_QUIC_SUCCEEDED(Connection.SetParam(QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, sizeof(Value), &Value));
+
+    uint8_t RawBuffer[100];
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    //
+    // Streams with a deadline go first, earliest deadline first. Priority
+    // only matters for streams without one.
+    //
+    uint64_t Deadline = S_TO_US(1);
+    MsQuicStream Stream1(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream1.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(MsQuic->SetParam(Stream1.Handle, QUIC_PARAM_STREAM_SCHEDULING_DEADLINE, sizeof(Deadline), &Deadline));
+    TEST_QUIC_SUCCEEDED(Stream1.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    MsQuicStream Stream2(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream2.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream2.SetPriority(0xFFFF));
+    TEST_QUIC_SUCCEEDED(Stream2.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    Deadline = 1000;
+    MsQuicStream Stream3(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream3.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(MsQuic->SetParam(Stream3.Handle, QUIC_PARAM_STREAM_SCHEDULING_DEADLINE, sizeof(Deadline), &Deadline));
+    TEST_QUIC_SUCCEEDED(Stream3.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    TEST_TRUE(Context.AllReceivesComplete.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.ReceiveEvents[0] == Stream3.ID());
+    TEST_TRUE(Context.ReceiveEvents[1] == Stream1.ID());
+    TEST_TRUE(Context.ReceiveEvents[2] == Stream2.ID());
+}
+
+struct StreamSchedulingBlockedTestContext {
+    int16_t CompleteCount {0};
+    CxPlatEvent AllComplete;
+
+    static QUIC_STATUS StreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (StreamSchedulingBlockedTestContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN) {
+            if (InterlockedIncrement16(&TestContext->CompleteCount) == 3) {
+                TestContext->AllComplete.Set();
+            }
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, StreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestStreamSchedulingFlowControlBlocked(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    //
+    // Small stream and connection windows keep the streams blocked on flow
+    // control most of the time, so they are repeatedly taken out of the
+    // scheduling heap and put back in when the peer opens the window.
+    //
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetPeerUnidiStreamCount(3);
+    ServerSettings.SetStreamRecvWindowDefault(4096);
+    ServerSettings.SetConnFlowControlWindow(8192);
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", ServerSettings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamSchedulingBlockedTestContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamSchedulingBlockedTestContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    QUIC_STREAM_SCHEDULING_SCHEME Schemes[] = {
+        QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR,
+        QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE
+    };
+
+    for (auto Scheme : Schemes) {
+        TestScopeLogger LogScope(
+            Scheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR ?
+                "Weighted fair" : "Deadline");
+        Context.CompleteCount = 0;
+        Context.AllComplete.Reset();
+
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Connection.SetParam(QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, sizeof(Scheme), &Scheme));
+
+        UniquePtr<uint8_t[]> RawBuffer(new(std::nothrow) uint8_t[0x10000]);
+        TEST_NOT_EQUAL(nullptr, RawBuffer);
+        QUIC_BUFFER Buffer { 0x10000, RawBuffer.get() };
+
+        uint64_t Deadline = 1000;
+        MsQuicStream Stream1(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream1.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(MsQuic->SetParam(Stream1.Handle, QUIC_PARAM_STREAM_SCHEDULING_DEADLINE, sizeof(Deadline), &Deadline));
+        TEST_QUIC_SUCCEEDED(Stream1.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+        MsQuicStream Stream2(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream2.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Stream2.SetPriority(0xFFFF));
+        TEST_QUIC_SUCCEEDED(Stream2.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+        MsQuicStream Stream3(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream3.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Stream3.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+        TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+        TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Connection.HandshakeComplete);
+
+        TEST_TRUE(Context.AllComplete.WaitTimeout(TestWaitTimeout));
+    }
+}
+#endif
+
 struct StreamDifferentAbortErrors {
     QUIC_UINT62 PeerSendAbortErrorCode {0};
     QUIC_UINT62 PeerRecvAbortErrorCode {0};
@@ -4091,6 +4304,116 @@ QuicTestConnectAndIdleForDestCidChange(
     }
 }
 
+void
+QuicTestConnectAndHibernate(
+    void
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetIdleTimeoutMs(5000);
+    ServerSettings.SetPeerBidiStreamCount(1);
+    ServerSettings.SetHibernateTimeoutMs(300);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, ServerSettings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    MsQuicSettings ClientSettings;
+    ClientSettings.SetIdleTimeoutMs(5000);
+    ClientSettings.SetKeepAlive(100);
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, ClientSettings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    {
+        TestListener Listener(Registration, ListenerAcceptConnectionAndStreams, ServerConfiguration);
+        TEST_TRUE(Listener.IsValid());
+        TEST_QUIC_SUCCEEDED(Listener.Start(Alpn));
+
+        QuicAddr ServerLocalAddr;
+        TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+        {
+            UniquePtr<TestConnection> Server;
+            ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+            Listener.Context = &ServerAcceptCtx;
+
+            {
+                TestConnection Client(Registration);
+                TEST_TRUE(Client.IsValid());
+
+                TEST_QUIC_SUCCEEDED(
+                    Client.Start(
+                        ClientConfiguration,
+                        QUIC_ADDRESS_FAMILY_UNSPEC,
+                        QUIC_TEST_LOOPBACK_FOR_AF(
+                            QuicAddrGetFamily(&ServerLocalAddr.SockAddr)),
+                        ServerLocalAddr.GetPort()));
+
+                if (!Client.WaitForConnectionComplete()) {
+                    return;
+                }
+                TEST_TRUE(Client.GetIsConnected());
+
+                TEST_NOT_EQUAL(nullptr, Server);
+                if (!Server->WaitForConnectionComplete()) {
+                    return;
+                }
+                TEST_TRUE(Server->GetIsConnected());
+
+                //
+                // The client's keep alive PINGs (and the ACKs for them) keep the
+                // connection open, but don't wake the server up.
+                //
+                CxPlatSleep(1500);
+                TEST_FALSE(Server->GetIsShutdown());
+
+                QUIC_STATISTICS_V2 Stats = Server->GetStatistics();
+                TEST_EQUAL(Stats.HibernationCount, 1u);
+                TEST_EQUAL(Stats.RehydrationCount, 0u);
+
+                //
+                // The ACKs for the keep alives are tracked in the sent packet
+                // store, which is freed again while hibernated.
+                //
+                TEST_QUIC_SUCCEEDED(Client.SetKeepAlive(0));
+                CxPlatSleep(700);
+                TEST_EQUAL(Server->GetSentPacketStoreCapacity(), 0u);
+                Stats = Server->GetStatistics();
+                TEST_EQUAL(Stats.RehydrationCount, 0u);
+
+                //
+                // Stream data does.
+                //
+                {
+                    TestStream* Stream =
+                        Client.NewStream(
+                            +[](TestStream*){},
+                            QUIC_STREAM_OPEN_FLAG_NONE,
+                            NEW_STREAM_START_SYNC);
+                    TEST_TRUE(Stream->IsValid());
+                    TEST_TRUE(Stream->StartPing(1));
+                    delete Stream;
+                }
+
+                CxPlatSleep(200);
+                Stats = Server->GetStatistics();
+                TEST_EQUAL(Stats.RehydrationCount, 1u);
+
+                Client.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_NONE, QUIC_TEST_NO_ERROR);
+                if (!Client.WaitForShutdownComplete()) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
 #define BUFFER_SIZE 30000
 #define RELIABLE_SIZE 5000
 #define BUFFER_SIZE_MULTI_SENDS 10000
@@ -4306,24 +4629,638 @@ QuicTestStreamReliableResetMultipleSends(
 }
 #endif // QUIC_PARAM_STREAM_RELIABLE_OFFSET
 
-#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
-#define MultiRecvNumSend 10
-struct MultiReceiveTestContext {
-    CxPlatEvent PktRecvd[MultiRecvNumSend];
-    MsQuicStream* ServerStream {nullptr};
-    int Recvd {0};
-    uint8_t RecvdSignatures[MultiRecvNumSend] {0};
-    uint64_t PseudoProcessingLength {0};
-    CXPLAT_LOCK Lock;
-    uint64_t TotalReceivedBytes {0};
-    uint64_t TotalSendBytes {0};
-    UniquePtr<uint8_t[]> RecvBuffer {nullptr};
+#if QUIC_TEST_DATAPATH_HOOKS_ENABLED
+#ifdef QUIC_PARAM_STREAM_SEND_EXPIRY
+#define SEND_EXPIRY_SIZE 100
+struct StreamSendExpiryContext {
+    uint64_t ReceivedBufferSize {0};
+    bool PeerSendShutdown {false};
+    bool PeerSendAborted {false};
+    QUIC_UINT62 PeerSendAbortErrorCode {0};
+    CxPlatEvent FirstReceive;
+    CxPlatEvent ServerStreamShutdownComplete;
 
-    MultiReceiveTestContext() {
-        CxPlatLockInitialize(&Lock);
-    }
-    ~MultiReceiveTestContext() {
-        CxPlatLockUninitialize(&Lock);
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (StreamSendExpiryContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            TestContext->ReceivedBufferSize += Event->RECEIVE.TotalBufferLength;
+            TestContext->FirstReceive.Set();
+        } else if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN) {
+            TestContext->PeerSendShutdown = true;
+        } else if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_ABORTED) {
+            TestContext->PeerSendAborted = true;
+            TestContext->PeerSendAbortErrorCode = Event->PEER_SEND_ABORTED.ErrorCode;
+        } else if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            TestContext->ServerStreamShutdownComplete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+//
+// Sends one buffer that gets delivered, then one that expires right away and
+// whose first transmission is dropped. Returns once the server side of the
+// stream has shut down.
+//
+static
+void
+QuicTestStreamSendExpiryRun(
+    _In_ MsQuicConnection& Connection,
+    _In_ StreamSendExpiryContext& Context,
+    _In_ uint64_t AppReliableOffset,
+    _Out_opt_ uint64_t* ReliableOffset
+    )
+{
+    uint8_t RawBuffer[SEND_EXPIRY_SIZE] = {0};
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+    SelectiveLossHelper LossHelper;
+
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+    uint64_t Expiry = 1;
+    TEST_QUIC_SUCCEEDED(MsQuic->SetParam(Stream.Handle, QUIC_PARAM_STREAM_SEND_EXPIRY, sizeof(Expiry), &Expiry));
+
+    TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_START));
+    TEST_TRUE(Context.FirstReceive.WaitTimeout(TestWaitTimeout));
+    CxPlatSleep(100); // Let the ACKs go out before dropping anything.
+
+    LossHelper.DropPackets(1);
+    TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_EXPIRES | QUIC_SEND_FLAG_FIN));
+    if (AppReliableOffset != 0) {
+        TEST_QUIC_SUCCEEDED(Stream.SetReliableOffset(AppReliableOffset));
+    }
+
+    TEST_TRUE(Context.ServerStreamShutdownComplete.WaitTimeout(TestWaitTimeout));
+    if (ReliableOffset != nullptr) {
+        TEST_QUIC_SUCCEEDED(Stream.GetReliableOffset(ReliableOffset));
+    }
+}
+
+void
+QuicTestStreamSendExpiry(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicSettings Settings;
+    Settings.SetPeerUnidiStreamCount(1);
+    Settings.SetMinimumMtu(1280).SetMaximumMtu(1280);
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", Settings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", Settings, MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamSendExpiryContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamSendExpiryContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+    CxPlatSleep(50); // Wait for things to idle out
+
+    //
+    // Without reliable reset the expired data is dropped with a plain reset.
+    //
+    QuicTestStreamSendExpiryRun(Connection, Context, 0, nullptr);
+    TEST_TRUE(Context.PeerSendAborted);
+    TEST_FALSE(Context.PeerSendShutdown);
+    TEST_EQUAL(Context.PeerSendAbortErrorCode, 0);
+    TEST_EQUAL(Context.ReceivedBufferSize, SEND_EXPIRY_SIZE);
+}
+
+void
+QuicTestStreamSendExpiryReliableReset(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicSettings Settings;
+    Settings.SetReliableResetEnabled(true);
+    Settings.SetPeerUnidiStreamCount(2);
+    Settings.SetMinimumMtu(1280).SetMaximumMtu(1280);
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", Settings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", Settings, MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamSendExpiryContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamSendExpiryContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+    CxPlatSleep(50); // Wait for things to idle out
+
+    {
+        //
+        // The stream is reliably reset at the start of the expired send, so
+        // everything before it is still delivered.
+        //
+        TestScopeLogger LogScope("Expired send");
+        uint64_t ReliableOffset;
+        QuicTestStreamSendExpiryRun(Connection, Context, 0, &ReliableOffset);
+        TEST_EQUAL(ReliableOffset, SEND_EXPIRY_SIZE);
+        TEST_TRUE(Context.PeerSendAborted);
+        TEST_FALSE(Context.PeerSendShutdown);
+        TEST_EQUAL(Context.PeerSendAbortErrorCode, 0);
+        TEST_EQUAL(Context.ReceivedBufferSize, SEND_EXPIRY_SIZE);
+    }
+
+    Context.ReceivedBufferSize = 0;
+    Context.PeerSendAborted = false;
+    Context.FirstReceive.Reset();
+    Context.ServerStreamShutdownComplete.Reset();
+
+    {
+        //
+        // An app provided reliable offset covering the expiring send is never
+        // lowered, so the data is retransmitted and the stream finishes.
+        //
+        TestScopeLogger LogScope("App reliable offset");
+        uint64_t ReliableOffset;
+        QuicTestStreamSendExpiryRun(Connection, Context, 2 * SEND_EXPIRY_SIZE, &ReliableOffset);
+        TEST_EQUAL(ReliableOffset, 2 * SEND_EXPIRY_SIZE);
+        TEST_FALSE(Context.PeerSendAborted);
+        TEST_TRUE(Context.PeerSendShutdown);
+        TEST_EQUAL(Context.ReceivedBufferSize, 2 * SEND_EXPIRY_SIZE);
+    }
+}
+#endif // QUIC_PARAM_STREAM_SEND_EXPIRY
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#define SEND_NO_COPY_SIZE 100
+struct NoCopySend {
+    bool Canceled {false};
+    uint32_t Order {0};
+    CxPlatEvent Complete;
+};
+
+struct StreamSendNoCopyContext {
+    uint64_t ReceivedBufferSize {0};
+    uint32_t CompletionCount {0};
+    CxPlatEvent FirstReceive;
+    CxPlatEvent ServerStreamShutdownComplete;
+
+    void Reset() {
+        ReceivedBufferSize = 0;
+        CompletionCount = 0;
+        FirstReceive.Reset();
+        ServerStreamShutdownComplete.Reset();
+    }
+
+    static QUIC_STATUS ClientStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (StreamSendNoCopyContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_SEND_COMPLETE &&
+            Event->SEND_COMPLETE.ClientContext != nullptr) {
+            auto Send = (NoCopySend*)Event->SEND_COMPLETE.ClientContext;
+            Send->Canceled = Event->SEND_COMPLETE.Canceled;
+            Send->Order = ++TestContext->CompletionCount;
+            Send->Complete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (StreamSendNoCopyContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            TestContext->ReceivedBufferSize += Event->RECEIVE.TotalBufferLength;
+            TestContext->FirstReceive.Set();
+        } else if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            TestContext->ServerStreamShutdownComplete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestStreamSendNoCopy(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicSettings Settings;
+    Settings.SetSendBufferingEnabled(true);
+    Settings.SetPeerUnidiStreamCount(3);
+    Settings.SetMinimumMtu(1280).SetMaximumMtu(1280);
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", Settings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", Settings, MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamSendNoCopyContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamSendNoCopyContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+    CxPlatSleep(50); // Wait for things to idle out
+
+    uint8_t RawBuffer[SEND_NO_COPY_SIZE] = {0};
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    {
+        //
+        // Without loss, the sends complete in order once they are acknowledged.
+        //
+        TestScopeLogger LogScope("In order");
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, CleanUpManual, StreamSendNoCopyContext::ClientStreamCallback, &Context);
+        TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+
+        NoCopySend Sends[3];
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_NO_COPY, &Sends[0]));
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_NO_COPY, &Sends[1]));
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_NO_COPY | QUIC_SEND_FLAG_FIN, &Sends[2]));
+        for (uint32_t i = 0; i < ARRAYSIZE(Sends); ++i) {
+            TEST_TRUE(Sends[i].Complete.WaitTimeout(TestWaitTimeout));
+            TEST_FALSE(Sends[i].Canceled);
+            TEST_EQUAL(Sends[i].Order, i + 1);
+        }
+
+        TEST_TRUE(Context.ServerStreamShutdownComplete.WaitTimeout(TestWaitTimeout));
+        TEST_EQUAL(Context.ReceivedBufferSize, 3 * SEND_NO_COPY_SIZE);
+    }
+
+    Context.Reset();
+
+    {
+        //
+        // The first send's packet is dropped, so the second one is SACKed and
+        // completes first. The first one still completes (just once) after it
+        // is retransmitted.
+        //
+        TestScopeLogger LogScope("SACKed");
+        SelectiveLossHelper LossHelper;
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, CleanUpManual, StreamSendNoCopyContext::ClientStreamCallback, &Context);
+        TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_START));
+        TEST_TRUE(Context.FirstReceive.WaitTimeout(TestWaitTimeout));
+        CxPlatSleep(100); // Let the ACKs go out before dropping anything.
+
+        NoCopySend First, Second;
+        LossHelper.DropPackets(1);
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_NO_COPY, &First));
+        for (uint32_t i = 0; i < TestWaitTimeout && LossHelper.DropPacketCount != 0; ++i) {
+            CxPlatSleep(1);
+        }
+        TEST_EQUAL(LossHelper.DropPacketCount, 0);
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_NO_COPY | QUIC_SEND_FLAG_FIN, &Second));
+
+        TEST_TRUE(First.Complete.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Second.Complete.WaitTimeout(TestWaitTimeout));
+        TEST_FALSE(First.Canceled);
+        TEST_FALSE(Second.Canceled);
+        TEST_EQUAL(Second.Order, 1u);
+        TEST_EQUAL(First.Order, 2u);
+
+        TEST_TRUE(Context.ServerStreamShutdownComplete.WaitTimeout(TestWaitTimeout));
+        TEST_EQUAL(Context.ReceivedBufferSize, 3 * SEND_NO_COPY_SIZE);
+        TEST_EQUAL(Context.CompletionCount, 2u);
+    }
+
+    Context.Reset();
+
+    {
+        //
+        // Sends that are never acknowledged are canceled, in order, when the
+        // app aborts the stream.
+        //
+        TestScopeLogger LogScope("Abort");
+        SelectiveLossHelper LossHelper;
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, CleanUpManual, StreamSendNoCopyContext::ClientStreamCallback, &Context);
+        TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_START));
+        TEST_TRUE(Context.FirstReceive.WaitTimeout(TestWaitTimeout));
+        CxPlatSleep(100); // Let the ACKs go out before dropping anything.
+
+        NoCopySend First, Second;
+        LossHelper.DropPackets(UINT32_MAX);
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_NO_COPY, &First));
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_NO_COPY, &Second));
+        TEST_QUIC_SUCCEEDED(Stream.Shutdown(0, QUIC_STREAM_SHUTDOWN_FLAG_ABORT_SEND));
+
+        TEST_TRUE(First.Complete.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Second.Complete.WaitTimeout(TestWaitTimeout));
+        LossHelper.DropPackets(0);
+        TEST_TRUE(First.Canceled);
+        TEST_TRUE(Second.Canceled);
+        TEST_EQUAL(First.Order, 1u);
+        TEST_EQUAL(Second.Order, 2u);
+
+        TEST_TRUE(Context.ServerStreamShutdownComplete.WaitTimeout(TestWaitTimeout));
+    }
+}
+#endif // QUIC_API_ENABLE_PREVIEW_FEATURES
+#endif // QUIC_TEST_DATAPATH_HOOKS_ENABLED
+
+#if defined(QUIC_API_ENABLE_PREVIEW_FEATURES) && !defined(_KERNEL_MODE)
+static
+uint8_t
+SendFilePattern(
+    _In_ uint64_t FileOffset
+    )
+{
+    return (uint8_t)(FileOffset % 251);
+}
+
+//
+// A temporary file filled with SendFilePattern, deleted once closed.
+//
+struct SendFileTempFile {
+    QUIC_FILE File;
+    bool Valid {false};
+
+    SendFileTempFile(_In_ uint32_t Length) {
+#ifdef _WIN32
+        char Dir[MAX_PATH], Path[MAX_PATH];
+        if (GetTempPathA(sizeof(Dir), Dir) == 0 ||
+            GetTempFileNameA(Dir, "msq", 0, Path) == 0) {
+            return;
+        }
+        File =
+            CreateFileA(
+                Path,
+                GENERIC_READ | GENERIC_WRITE,
+                0,
+                NULL,
+                CREATE_ALWAYS,
+                FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                NULL);
+        if (File == INVALID_HANDLE_VALUE) {
+            return;
+        }
+#else
+        char Path[] = "/tmp/msquictestXXXXXX";
+        File = mkstemp(Path);
+        if (File < 0) {
+            return;
+        }
+        unlink(Path);
+#endif
+        uint8_t Chunk[4096];
+        for (uint32_t Offset = 0; Offset < Length; Offset += sizeof(Chunk)) {
+            const uint32_t ChunkLength = CXPLAT_MIN((uint32_t)sizeof(Chunk), Length - Offset);
+            for (uint32_t i = 0; i < ChunkLength; ++i) {
+                Chunk[i] = SendFilePattern(Offset + i);
+            }
+#ifdef _WIN32
+            DWORD Written;
+            if (!WriteFile(File, Chunk, ChunkLength, &Written, NULL) || Written != ChunkLength) {
+                return;
+            }
+#else
+            if (write(File, Chunk, ChunkLength) != (ssize_t)ChunkLength) {
+                return;
+            }
+#endif
+        }
+        Valid = true;
+    }
+
+    ~SendFileTempFile() {
+#ifdef _WIN32
+        if (File != INVALID_HANDLE_VALUE) {
+            CloseHandle(File);
+        }
+#else
+        if (File >= 0) {
+            close(File);
+        }
+#endif
+    }
+};
+
+struct SendFileCompletion {
+    bool Canceled {false};
+    QUIC_STATUS Status {QUIC_STATUS_PENDING};
+    CxPlatEvent Complete;
+};
+
+struct StreamSendFileContext {
+    uint64_t FileOffset {0}; // The file offset sent at stream offset zero.
+    uint64_t ReceivedBufferSize {0};
+    bool DataMismatch {false};
+    bool PeerSendShutdown {false};
+    bool PeerSendAborted {false};
+    QUIC_UINT62 PeerSendAbortErrorCode {0};
+    CxPlatEvent ServerStreamShutdownComplete;
+
+    static QUIC_STATUS ClientStreamCallback(_In_ MsQuicStream*, _In_opt_ void*, _Inout_ QUIC_STREAM_EVENT* Event) {
+        if (Event->Type == QUIC_STREAM_EVENT_SEND_COMPLETE &&
+            Event->SEND_COMPLETE.ClientContext != nullptr) {
+            auto Send = (SendFileCompletion*)Event->SEND_COMPLETE.ClientContext;
+            Send->Canceled = Event->SEND_COMPLETE.Canceled;
+            Send->Status = Event->SEND_COMPLETE.Status;
+            Send->Complete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (StreamSendFileContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            uint64_t FileOffset = TestContext->FileOffset + Event->RECEIVE.AbsoluteOffset;
+            for (uint32_t i = 0; i < Event->RECEIVE.BufferCount; ++i) {
+                const QUIC_BUFFER* Buffer = &Event->RECEIVE.Buffers[i];
+                for (uint32_t j = 0; j < Buffer->Length; ++j) {
+                    if (Buffer->Buffer[j] != SendFilePattern(FileOffset++)) {
+                        TestContext->DataMismatch = true;
+                    }
+                }
+            }
+            TestContext->ReceivedBufferSize += Event->RECEIVE.TotalBufferLength;
+        } else if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN) {
+            TestContext->PeerSendShutdown = true;
+        } else if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_ABORTED) {
+            TestContext->PeerSendAborted = true;
+            TestContext->PeerSendAbortErrorCode = Event->PEER_SEND_ABORTED.ErrorCode;
+        } else if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            TestContext->ServerStreamShutdownComplete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+//
+// Sends Length bytes of File from FileOffset, followed by one (uncopied)
+// buffer send with FIN, on a new unidirectional stream, and waits for the
+// server side of the stream to shut down.
+//
+static
+void
+QuicTestStreamSendFileRun(
+    _In_ QUIC_FILE File,
+    _In_ uint64_t FileOffset,
+    _In_ uint32_t Length,
+    _In_ StreamSendFileContext& Context,
+    _In_ SendFileCompletion& FileSend,
+    _In_ SendFileCompletion& BufferSend
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicSettings Settings;
+    Settings.SetPeerUnidiStreamCount(1);
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", Settings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", Settings, MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    Context.FileOffset = FileOffset;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamSendFileContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, CleanUpManual, StreamSendFileContext::ClientStreamCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+
+    uint8_t RawBuffer[100];
+    for (uint32_t i = 0; i < sizeof(RawBuffer); ++i) {
+        RawBuffer[i] = SendFilePattern(FileOffset + Length + i);
+    }
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    TEST_QUIC_SUCCEEDED(Stream.SendFile(File, FileOffset, Length, QUIC_SEND_FLAG_START, &FileSend));
+    TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_NO_COPY | QUIC_SEND_FLAG_FIN, &BufferSend));
+
+    TEST_TRUE(FileSend.Complete.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(BufferSend.Complete.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.ServerStreamShutdownComplete.WaitTimeout(TestWaitTimeout));
+}
+
+void
+QuicTestStreamSendFile(
+    )
+{
+    const uint32_t FileLength = 3 * QUIC_SEND_FILE_READ_AHEAD;
+    SendFileTempFile TempFile(FileLength);
+    TEST_TRUE(TempFile.Valid);
+
+    //
+    // Send all but the first and last 1000 bytes, crossing several read-ahead
+    // windows, and check the peer gets exactly those bytes of the file.
+    //
+    StreamSendFileContext Context;
+    SendFileCompletion FileSend, BufferSend;
+    QuicTestStreamSendFileRun(TempFile.File, 1000, FileLength - 2000, Context, FileSend, BufferSend);
+
+    TEST_FALSE(FileSend.Canceled);
+    TEST_QUIC_SUCCEEDED(FileSend.Status);
+    TEST_FALSE(BufferSend.Canceled);
+    TEST_QUIC_SUCCEEDED(BufferSend.Status);
+    TEST_TRUE(Context.PeerSendShutdown);
+    TEST_FALSE(Context.PeerSendAborted);
+    TEST_FALSE(Context.DataMismatch);
+    TEST_EQUAL(Context.ReceivedBufferSize, FileLength - 2000 + 100);
+}
+
+void
+QuicTestStreamSendFileReadFailure(
+    )
+{
+    const uint32_t FileLength = 10000;
+    SendFileTempFile TempFile(FileLength);
+    TEST_TRUE(TempFile.Valid);
+
+    //
+    // The range runs past the end of the file, so a read fails part way
+    // through. The send direction is aborted, the file send completes with the
+    // read's status, and the send queued after it is just aborted.
+    //
+    StreamSendFileContext Context;
+    SendFileCompletion FileSend, BufferSend;
+    QuicTestStreamSendFileRun(TempFile.File, 0, 2 * FileLength, Context, FileSend, BufferSend);
+
+    TEST_TRUE(FileSend.Canceled);
+    TEST_QUIC_STATUS(QUIC_STATUS_INVALID_STATE, FileSend.Status);
+    TEST_TRUE(BufferSend.Canceled);
+    TEST_QUIC_STATUS(QUIC_STATUS_ABORTED, BufferSend.Status);
+    TEST_TRUE(Context.PeerSendAborted);
+    TEST_FALSE(Context.PeerSendShutdown);
+    TEST_EQUAL(Context.PeerSendAbortErrorCode, 0);
+    TEST_FALSE(Context.DataMismatch);
+    TEST_TRUE(Context.ReceivedBufferSize <= FileLength);
+}
+#endif // QUIC_API_ENABLE_PREVIEW_FEATURES && !_KERNEL_MODE
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#define MultiRecvNumSend 10
+struct MultiReceiveTestContext {
+    CxPlatEvent PktRecvd[MultiRecvNumSend];
+    MsQuicStream* ServerStream {nullptr};
+    int Recvd {0};
+    uint8_t RecvdSignatures[MultiRecvNumSend] {0};
+    uint64_t PseudoProcessingLength {0};
+    CXPLAT_LOCK Lock;
+    uint64_t TotalReceivedBytes {0};
+    uint64_t TotalSendBytes {0};
+    UniquePtr<uint8_t[]> RecvBuffer {nullptr};
+
+    MultiReceiveTestContext() {
+        CxPlatLockInitialize(&Lock);
+    }
+    ~MultiReceiveTestContext() {
+        CxPlatLockUninitialize(&Lock);
     }
 
     static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream* Stream, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
@@ -4920,4 +5857,184 @@ QuicTestStreamAppProvidedBuffersZeroWindow(
         TEST_EQUAL(0, memcmp(SendDataBuffer.get(), ReceiveDataBuffer.get(), BufferSize));
     }
 }
+
+#define SEND_BATCH_SIZE 1000
+
+struct StreamSendBatchContext {
+    uint64_t ReceivedBytes[4] {0}; // Indexed by the client's stream index.
+    int16_t PeerSendShutdownCount {0};
+    int16_t ExpectedPeerSendShutdownCount {0};
+    CxPlatEvent AllReceived;
+
+    QUIC_STREAM_SEND_BATCH_ENTRY* InlineEntries {nullptr};
+    uint32_t InlineEntryCount {0};
+    QUIC_STATUS InlineStatus {QUIC_STATUS_SUCCESS};
+    CxPlatEvent InlineSendComplete;
+
+    void Reset(int16_t ExpectedCount) {
+        CxPlatZeroMemory(ReceivedBytes, sizeof(ReceivedBytes));
+        PeerSendShutdownCount = 0;
+        ExpectedPeerSendShutdownCount = ExpectedCount;
+        AllReceived.Reset();
+    }
+
+    uint64_t GetReceivedBytes(MsQuicStream& Stream) {
+        return ReceivedBytes[Stream.ID() >> 2];
+    }
+
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream* Stream, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (StreamSendBatchContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            const QUIC_UINT62 Index = Stream->ID() >> 2;
+            if (Index < ARRAYSIZE(TestContext->ReceivedBytes)) {
+                TestContext->ReceivedBytes[Index] += Event->RECEIVE.TotalBufferLength;
+            }
+        } else if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN) {
+            if (InterlockedIncrement16(&TestContext->PeerSendShutdownCount) ==
+                TestContext->ExpectedPeerSendShutdownCount) {
+                TestContext->AllReceived.Set();
+            }
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ServerConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ClientConnCallback(_In_ MsQuicConnection* Connection, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        auto TestContext = (StreamSendBatchContext*)Context;
+        if (Event->Type == QUIC_CONNECTION_EVENT_CONNECTED &&
+            TestContext->InlineEntries != nullptr) {
+            //
+            // Called on the connection's worker thread, so the sends are
+            // queued and flushed inline.
+            //
+            TestContext->InlineStatus =
+                Connection->SendBatch(TestContext->InlineEntries, TestContext->InlineEntryCount);
+            TestContext->InlineSendComplete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestStreamSendBatch(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(4), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    //
+    // Sends are only flushed inline (on the worker thread) without send
+    // buffering.
+    //
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetSendBufferingEnabled(false), MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamSendBatchContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamSendBatchContext::ServerConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    uint8_t RawBuffer[SEND_BATCH_SIZE] = {0};
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    {
+        //
+        // Batched from the app's thread. Each entry gets its own status: the
+        // stream whose send direction was shut down fails while the others
+        // are queued. The stream listed twice is only flushed for its first
+        // entry; its second send rides on that flush.
+        //
+        TestScopeLogger LogScope("Queued");
+        Context.Reset(3);
+
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+        TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Connection.HandshakeComplete);
+
+        MsQuicStream Stream1(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream1.GetInitStatus());
+        MsQuicStream Stream2(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream2.GetInitStatus());
+        MsQuicStream Stream3(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream3.GetInitStatus());
+        MsQuicStream ShutdownStream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(ShutdownStream.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(ShutdownStream.Shutdown(0, QUIC_STREAM_SHUTDOWN_FLAG_ABORT_SEND));
+
+        //
+        // Wait for the shutdown to be processed (blocking parameter calls are
+        // processed in order on the connection).
+        //
+        QUIC_STATISTICS_V2 Stats;
+        TEST_QUIC_SUCCEEDED(Connection.GetStatistics(&Stats));
+
+        QUIC_STREAM_SEND_BATCH_ENTRY Entries[] = {
+            { Stream1.Handle, &Buffer, 1, QUIC_SEND_FLAG_START, nullptr, QUIC_STATUS_SUCCESS },
+            { Stream2.Handle, &Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN, nullptr, QUIC_STATUS_SUCCESS },
+            { Stream1.Handle, &Buffer, 1, QUIC_SEND_FLAG_FIN, nullptr, QUIC_STATUS_SUCCESS },
+            { ShutdownStream.Handle, &Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN, nullptr, QUIC_STATUS_SUCCESS },
+            { Stream3.Handle, &Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN, nullptr, QUIC_STATUS_SUCCESS },
+        };
+        TEST_QUIC_STATUS(QUIC_STATUS_INVALID_STATE, Connection.SendBatch(Entries, ARRAYSIZE(Entries)));
+        TEST_QUIC_STATUS(QUIC_STATUS_PENDING, Entries[0].Status);
+        TEST_QUIC_STATUS(QUIC_STATUS_PENDING, Entries[1].Status);
+        TEST_QUIC_STATUS(QUIC_STATUS_PENDING, Entries[2].Status);
+        TEST_QUIC_STATUS(QUIC_STATUS_INVALID_STATE, Entries[3].Status);
+        TEST_QUIC_STATUS(QUIC_STATUS_PENDING, Entries[4].Status);
+
+        TEST_TRUE(Context.AllReceived.WaitTimeout(TestWaitTimeout));
+        TEST_EQUAL(Context.GetReceivedBytes(Stream1), 2 * SEND_BATCH_SIZE);
+        TEST_EQUAL(Context.GetReceivedBytes(Stream2), SEND_BATCH_SIZE);
+        TEST_EQUAL(Context.GetReceivedBytes(Stream3), SEND_BATCH_SIZE);
+    }
+
+    {
+        //
+        // Batched from a callback, on the connection's worker thread.
+        //
+        TestScopeLogger LogScope("Inline");
+        Context.Reset(2);
+
+        MsQuicConnection Connection(Registration, CleanUpManual, StreamSendBatchContext::ClientConnCallback, &Context);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+        MsQuicStream Stream1(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream1.GetInitStatus());
+        MsQuicStream Stream2(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream2.GetInitStatus());
+
+        QUIC_STREAM_SEND_BATCH_ENTRY Entries[] = {
+            { Stream1.Handle, &Buffer, 1, QUIC_SEND_FLAG_START, nullptr, QUIC_STATUS_SUCCESS },
+            { Stream2.Handle, &Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN, nullptr, QUIC_STATUS_SUCCESS },
+            { Stream1.Handle, &Buffer, 1, QUIC_SEND_FLAG_FIN, nullptr, QUIC_STATUS_SUCCESS },
+        };
+        Context.InlineEntries = Entries;
+        Context.InlineEntryCount = ARRAYSIZE(Entries);
+
+        TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+        TEST_TRUE(Context.InlineSendComplete.WaitTimeout(TestWaitTimeout));
+        TEST_QUIC_STATUS(QUIC_STATUS_PENDING, Context.InlineStatus);
+        for (uint32_t i = 0; i < ARRAYSIZE(Entries); ++i) {
+            TEST_QUIC_STATUS(QUIC_STATUS_PENDING, Entries[i].Status);
+        }
+
+        TEST_TRUE(Context.AllReceived.WaitTimeout(TestWaitTimeout));
+        TEST_EQUAL(Context.GetReceivedBytes(Stream1), 2 * SEND_BATCH_SIZE);
+        TEST_EQUAL(Context.GetReceivedBytes(Stream2), SEND_BATCH_SIZE);
+        Context.InlineEntries = nullptr;
+    }
+}
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
@@ -367,3 +367,159 @@ QuicTestDatagramDrop(
         }
     }
 }
+
+struct DatagramOrderTestContext {
+    static const uint32_t MaxDatagrams = 16;
+    uint8_t Received[MaxDatagrams];
+    uint32_t ReceivedCount {0};
+    uint32_t ExpectedCount {0};
+    CxPlatEvent AllReceived;
+    uintptr_t Canceled[MaxDatagrams];
+    uint32_t CanceledCount {0};
+
+    static QUIC_STATUS ServerCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        auto TestContext = (DatagramOrderTestContext*)Context;
+        if (Event->Type == QUIC_CONNECTION_EVENT_DATAGRAM_RECEIVED &&
+            TestContext->ReceivedCount < MaxDatagrams) {
+            TestContext->Received[TestContext->ReceivedCount++] =
+                Event->DATAGRAM_RECEIVED.Buffer->Buffer[0];
+            if (TestContext->ReceivedCount == TestContext->ExpectedCount) {
+                TestContext->AllReceived.Set();
+            }
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ClientCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        auto TestContext = (DatagramOrderTestContext*)Context;
+        if (Event->Type == QUIC_CONNECTION_EVENT_DATAGRAM_SEND_STATE_CHANGED &&
+            Event->DATAGRAM_SEND_STATE_CHANGED.State == QUIC_DATAGRAM_SEND_CANCELED &&
+            TestContext->CanceledCount < MaxDatagrams) {
+            TestContext->Canceled[TestContext->CanceledCount++] =
+                (uintptr_t)Event->DATAGRAM_SEND_STATE_CHANGED.ClientContext;
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+//
+// Queues the batch before the handshake, so it is all in the send queue at
+// once, and checks the first byte of each datagram the server gets.
+//
+static
+void
+QuicTestDatagramOrder(
+    _In_ int Family,
+    _In_ DatagramOrderTestContext* Context,
+    _In_reads_(EntryCount) const QUIC_DATAGRAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount,
+    _In_reads_(ExpectedCount) const uint8_t* Expected,
+    _In_ uint32_t ExpectedCount
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicSettings Settings;
+    Settings.SetDatagramReceiveEnabled(true);
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", Settings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", Settings, MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    Context->ExpectedCount = ExpectedCount;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, DatagramOrderTestContext::ServerCallback, Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration, CleanUpManual, DatagramOrderTestContext::ClientCallback, Context);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(MsQuic->DatagramSendBatch(Connection.Handle, Entries, EntryCount));
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, QuicAddrFamily, QUIC_TEST_LOOPBACK_FOR_AF(QuicAddrFamily), ServerLocalAddr.GetPort()));
+
+    TEST_TRUE(Context->AllReceived.WaitTimeout(TestWaitTimeout));
+    CxPlatSleep(50); // Let anything unexpected arrive.
+    TEST_EQUAL(ExpectedCount, Context->ReceivedCount);
+    for (uint32_t i = 0; i < ExpectedCount; ++i) {
+        TEST_EQUAL(Expected[i], Context->Received[i]);
+    }
+
+    Connection.Shutdown(QUIC_TEST_NO_ERROR);
+}
+
+void
+QuicTestDatagramPriority(
+    _In_ int Family
+    )
+{
+    uint8_t Payload[] = { 0, 1, 2, 3, 4, 5, 6 };
+    QUIC_BUFFER Buffers[ARRAYSIZE(Payload)];
+    for (uint32_t i = 0; i < ARRAYSIZE(Payload); ++i) {
+        Buffers[i] = { 1, &Payload[i] };
+    }
+
+    //
+    // Higher priorities go first, QUIC_SEND_FLAG_DGRAM_PRIORITY above all of
+    // them, and datagrams with the same priority keep their order.
+    //
+    QUIC_DATAGRAM_SEND_BATCH_ENTRY Entries[] = {
+        { &Buffers[0], 1, QUIC_SEND_FLAG_NONE, nullptr, 0, 0 },
+        { &Buffers[1], 1, QUIC_SEND_FLAG_NONE, nullptr, 2, 0 },
+        { &Buffers[2], 1, QUIC_SEND_FLAG_NONE, nullptr, 1, 0 },
+        { &Buffers[3], 1, QUIC_SEND_FLAG_DGRAM_PRIORITY, nullptr, 0, 0 },
+        { &Buffers[4], 1, QUIC_SEND_FLAG_NONE, nullptr, 2, 0 },
+        { &Buffers[5], 1, QUIC_SEND_FLAG_NONE, nullptr, 0, 0 },
+        { &Buffers[6], 1, QUIC_SEND_FLAG_NONE, nullptr, UINT8_MAX, 0 },
+    };
+    const uint8_t Expected[] = { 3, 6, 1, 4, 2, 0, 5 };
+
+    DatagramOrderTestContext Context;
+    QuicTestDatagramOrder(
+        Family, &Context, Entries, ARRAYSIZE(Entries), Expected, ARRAYSIZE(Expected));
+    TEST_EQUAL(0u, Context.CanceledCount);
+}
+
+void
+QuicTestDatagramReplace(
+    _In_ int Family
+    )
+{
+    uint8_t Payload[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    QUIC_BUFFER Buffers[ARRAYSIZE(Payload)];
+    for (uint32_t i = 0; i < ARRAYSIZE(Payload); ++i) {
+        Buffers[i] = { 1, &Payload[i] };
+    }
+
+    //
+    // Only the latest datagram for a key is sent. With the same priority it
+    // takes the place of the one it replaces (key 1), otherwise it is queued
+    // by its own priority (key 2).
+    //
+    QUIC_DATAGRAM_SEND_BATCH_ENTRY Entries[] = {
+        { &Buffers[0], 1, QUIC_SEND_FLAG_NONE, (void*)(uintptr_t)0, 0, 1 },
+        { &Buffers[1], 1, QUIC_SEND_FLAG_NONE, (void*)(uintptr_t)1, 0, 0 },
+        { &Buffers[2], 1, QUIC_SEND_FLAG_NONE, (void*)(uintptr_t)2, 0, 2 },
+        { &Buffers[3], 1, QUIC_SEND_FLAG_NONE, (void*)(uintptr_t)3, 0, 1 },
+        { &Buffers[4], 1, QUIC_SEND_FLAG_NONE, (void*)(uintptr_t)4, 1, 0 },
+        { &Buffers[5], 1, QUIC_SEND_FLAG_NONE, (void*)(uintptr_t)5, 0, 1 },
+        { &Buffers[6], 1, QUIC_SEND_FLAG_NONE, (void*)(uintptr_t)6, 1, 2 },
+        { &Buffers[7], 1, QUIC_SEND_FLAG_NONE, (void*)(uintptr_t)7, 0, 3 },
+    };
+    const uint8_t Expected[] = { 4, 6, 5, 1, 7 };
+
+    DatagramOrderTestContext Context;
+    QuicTestDatagramOrder(
+        Family, &Context, Entries, ARRAYSIZE(Entries), Expected, ARRAYSIZE(Expected));
+
+    const uintptr_t ExpectedCanceled[] = { 0, 3, 2 };
+    TEST_EQUAL((uint32_t)ARRAYSIZE(ExpectedCanceled), Context.CanceledCount);
+    for (uint32_t i = 0; i < ARRAYSIZE(ExpectedCanceled); ++i) {
+        TEST_EQUAL(ExpectedCanceled[i], Context.Canceled[i]);
+    }
+}
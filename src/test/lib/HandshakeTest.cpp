@@ -448,15 +448,17 @@ QuicTestConnect(
 
 struct RebindContext {
     bool Connected {false};
+    HQUIC Server {nullptr};
     CxPlatEvent HandshakeCompleteEvent;
     CxPlatEvent PeerAddrChangedEvent;
     QuicAddr PeerAddr;
-    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection* Conn, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
         auto This = static_cast<RebindContext*>(Context);
         if (Event->Type == QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE) {
             This->PeerAddrChangedEvent.Set();
             This->HandshakeCompleteEvent.Set();
         } else if (Event->Type == QUIC_CONNECTION_EVENT_CONNECTED) {
+            This->Server = Conn->Handle;
             This->Connected = true;
             This->HandshakeCompleteEvent.Set();
         } else if (Event->Type == QUIC_CONNECTION_EVENT_PEER_ADDRESS_CHANGED) {
@@ -513,6 +515,19 @@ QuicTestNatPortRebind(
     TEST_TRUE(Context.PeerAddrChangedEvent.WaitTimeout(1000))
     TEST_TRUE(QuicAddrCompare(&AddrHelper.New, &Context.PeerAddr.SockAddr));
 
+    //
+    // A port only change isn't a migration.
+    //
+    QUIC_STATISTICS_V2 Stats;
+    uint32_t StatsSize = sizeof(Stats);
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            Context.Server,
+            QUIC_PARAM_CONN_STATISTICS_V2,
+            &StatsSize,
+            &Stats));
+    TEST_EQUAL(0u, Stats.MigrationCount);
+
     Connection.Shutdown(1);
 }
 
@@ -572,6 +587,72 @@ QuicTestNatAddrRebind(
     Connection.Shutdown(1);
 }
 
+void
+QuicTestNatAddrRebindBack(
+    _In_ int Family
+    )
+{
+    RebindContext Context;
+    MsQuicRegistration Registration(true);
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, RebindContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest", &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.Connected);
+    CxPlatSleep(10);
+
+    QuicAddr OrigLocalAddr;
+    TEST_QUIC_SUCCEEDED(Connection.GetLocalAddr(OrigLocalAddr));
+    Connection.SetSettings(MsQuicSettings{}.SetKeepAlive(1));
+
+    {
+        ReplaceAddressHelper AddrHelper(OrigLocalAddr.SockAddr, OrigLocalAddr.SockAddr);
+        AddrHelper.IncrementAddr();
+
+        TEST_TRUE(Context.PeerAddrChangedEvent.WaitTimeout(1000))
+        TEST_TRUE(QuicAddrCompare(&AddrHelper.New, &Context.PeerAddr.SockAddr));
+        Context.PeerAddrChangedEvent.Reset();
+    }
+
+    //
+    // Removing the hook moves the client back to its original address, which
+    // the server has cached congestion control state for.
+    //
+    TEST_TRUE(Context.PeerAddrChangedEvent.WaitTimeout(1000))
+    TEST_TRUE(QuicAddrCompare(&OrigLocalAddr.SockAddr, &Context.PeerAddr.SockAddr));
+
+    QUIC_STATISTICS_V2 Stats;
+    uint32_t StatsSize = sizeof(Stats);
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            Context.Server,
+            QUIC_PARAM_CONN_STATISTICS_V2,
+            &StatsSize,
+            &Stats));
+    TEST_EQUAL(2u, Stats.MigrationCount);
+    TEST_EQUAL(1u, Stats.MigrationCachedCcCount);
+
+    Connection.Shutdown(1);
+}
+
 void
 QuicTestPathValidationTimeout(
     _In_ int Family
@@ -625,6 +625,23 @@ TestConnection::GetStatistics()
     return value;
 }
 
+uint32_t
+TestConnection::GetSentPacketStoreCapacity()
+{
+    uint32_t value = 0;
+    uint32_t valueSize = sizeof(value);
+    QUIC_STATUS Status =
+        MsQuic->GetParam(
+            QuicConnection,
+            QUIC_PARAM_CONN_SENT_PACKET_STORE_CAPACITY,
+            &valueSize,
+            &value);
+    if (QUIC_FAILED(Status)) {
+        TEST_FAILURE("MsQuic->GetParam(CONN_SENT_PACKET_STORE_CAPACITY) failed, 0x%x.", Status);
+    }
+    return value;
+}
+
 bool
 TestConnection::GetUseSendBuffer()
 {
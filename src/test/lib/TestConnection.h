@@ -283,6 +283,8 @@ public:
 
     QUIC_STATISTICS_V2 GetStatistics();
 
+    uint32_t GetSentPacketStoreCapacity();
+
     bool GetUseSendBuffer();
     QUIC_STATUS SetUseSendBuffer(bool value);
 